@@ -71,6 +71,12 @@ typedef struct {
 
   /* used by DMDASetMatPreallocateOnly() */
   PetscBool             prealloc_only;
+
+  /* used by DMDASetLocalFunctionOverlap() */
+  PetscBool             overlaplocal;
+
+  /* used by DMDASetLocalFDJacobian() */
+  PetscBool             localfdjacobian;
   PetscInt              preallocCenterDim; /* Dimension of the points which connect adjacent points for preallocation */
 } DM_DA;
 
@@ -29,9 +29,19 @@ struct _p_DMNetworkComponentValue {
 
 typedef struct {
   char     name[32-sizeof(PetscInt)];
-  PetscInt size;
+  PetscInt size;  /* storage size in DMNetworkComponentGenericDataType units, rounded up */
+  size_t   bytes; /* storage size in bytes given to DMNetworkRegisterComponent() */
 } DMNetworkComponent PETSC_ATTRIBUTEALIGNED(PetscMax(sizeof(double),sizeof(PetscScalar)));
 
+/* Local components of one key stored contiguously, see DMNetworkSetComponentBatching() */
+typedef struct {
+  PetscInt                          n;        /* number of local components with this key */
+  PetscInt                          *points;  /* network points holding the components, in increasing order */
+  PetscInt                          *offset;  /* local vector offset of the first variable of each component */
+  PetscInt                          *nvar;    /* number of variables of each component */
+  DMNetworkComponentGenericDataType *data;    /* the components, n consecutive blocks of the registered component size */
+} DMNetworkComponentBatch;
+
 /* Indexing data structures for vertex and edges */
 typedef struct {
   PetscSection                      DofSection;
@@ -49,13 +59,13 @@ typedef struct {
 
 /*
   Shared vertex - a vertex in DMNetwork that is shared by 2 or more subnetworks. sv provides the mapping from the subnetwork vertices to the global DMNetwork vertex (merged network).
-  sv is organized as (see SVtxCreate())
+  sv is organized as (see DMNetworkSharedVerticesSetUp_private())
         sv(net[0],idx[0]) --> sv(net[1],idx[1])
                           --> sv(net[1],idx[1])
                           ...
                           --> sv(net[n-1],idx[n-1])
         and net[0] < net[1] < ... < net[n-1]
-        where sv[0] has SVFROM type, sv[i], i>0, has SVTO type.
+        where sv[0] has SVFROM type, sv[i], i>0, has SVTO type. The table is replicated on all processes.
 */
 typedef struct {
   PetscInt gidx;                /* global index of the shared vertices in dmplex */
@@ -99,13 +109,18 @@ typedef struct {
   PetscInt                          dataheadersize;
   DMNetworkComponentGenericDataType *componentdataarray; /* Array to hold the data */
 
+  PetscBool                         batching;                /* Store the components grouped by key after DMSetUp() */
+  DMNetworkComponentBatch           batch[MAX_COMPONENTS];   /* Local components grouped by key */
+  PetscInt                          *batchptr,*batchpos;     /* component i at point p is batchpos[batchptr[p-pStart]+i] in its batch */
+
   PetscInt                          nsubnet,Nsubnet; /* Local and global number of subnetworks */
   DMSubnetwork                      *subnet;         /* Subnetworks */
   PetscInt                          *subnetvtx;      /* Maps local vertex to local subnetwork's vertex */
   SVtx                              *svtx;           /* Array of vertices shared by subnetworks */
   PetscInt                          nsvtx,Nsvtx;     /* Local and global num of entries in svtx */
   PetscInt                          *svertices;      /* Array of local subnetwork vertices that are merged/shared */
-  PetscInt                          *sedgelist;      /* Edge list of shared vertices */
+  PetscInt                          *sedgelist;      /* Local edge list of shared vertices, 4 entries (anet,aidx,bnet,bidx) per pair */
+  PetscInt                          nsedgelist,maxsedgelist; /* Num of pairs in sedgelist and its capacity */
   PetscTable                        svtable;         /* hash table for finding shared vertex info */
 
   PetscBool                         userEdgeJacobian,userVertexJacobian;  /* Global flag for using user's sub Jacobians */
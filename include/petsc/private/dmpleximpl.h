@@ -23,6 +23,8 @@ PETSC_EXTERN PetscLogEvent DMPLEX_DistributeField;
 PETSC_EXTERN PetscLogEvent DMPLEX_DistributeData;
 PETSC_EXTERN PetscLogEvent DMPLEX_Migrate;
 PETSC_EXTERN PetscLogEvent DMPLEX_InterpolateSF;
+PETSC_EXTERN PetscLogEvent DMPLEX_InterpolateFaces;
+PETSC_EXTERN PetscLogEvent DMPLEX_InterpolateOrient;
 PETSC_EXTERN PetscLogEvent DMPLEX_GlobalToNaturalBegin;
 PETSC_EXTERN PetscLogEvent DMPLEX_GlobalToNaturalEnd;
 PETSC_EXTERN PetscLogEvent DMPLEX_NaturalToGlobalBegin;
@@ -30,6 +32,7 @@ PETSC_EXTERN PetscLogEvent DMPLEX_NaturalToGlobalEnd;
 PETSC_EXTERN PetscLogEvent DMPLEX_Stratify;
 PETSC_EXTERN PetscLogEvent DMPLEX_Symmetrize;
 PETSC_EXTERN PetscLogEvent DMPLEX_Preallocate;
+PETSC_EXTERN PetscLogEvent DMPLEX_PreallocateAdj;
 PETSC_EXTERN PetscLogEvent DMPLEX_ResidualFEM;
 PETSC_EXTERN PetscLogEvent DMPLEX_JacobianFEM;
 PETSC_EXTERN PetscLogEvent DMPLEX_InterpolatorFEM;
@@ -41,6 +44,11 @@ PETSC_EXTERN PetscLogEvent DMPLEX_CreateFromFile;
 PETSC_EXTERN PetscLogEvent DMPLEX_BuildFromCellList;
 PETSC_EXTERN PetscLogEvent DMPLEX_BuildCoordinatesFromCellList;
 PETSC_EXTERN PetscLogEvent DMPLEX_LocatePoints;
+PETSC_EXTERN PetscLogEvent DMPLEX_Refine;
+PETSC_EXTERN PetscLogEvent DMPLEX_RefineCones;
+PETSC_EXTERN PetscLogEvent DMPLEX_RefineSF;
+PETSC_EXTERN PetscLogEvent DMPLEX_RefineLabels;
+PETSC_EXTERN PetscLogEvent DMPLEX_RefineCoordinates;
 
 typedef struct _DMPlexCellRefinerOps *DMPlexCellRefinerOps;
 struct _DMPlexCellRefinerOps {
@@ -76,6 +84,8 @@ struct _p_DMPlexCellRefiner {
   PetscInt              *ctStart;    /* [ct]: The number for the first cell of each polytope type in the original mesh */
   PetscInt              *ctStartNew; /* [ctNew]: The number for the first cell of each polytope type in the new mesh */
   PetscInt              *offset;     /* [ct/rt][ctNew]: The offset in the new point numbering of a point of type ctNew produced from an old point of type ct or refine type rt */
+  PetscInt              *ctNumNew;   /* [ct][ctNew]: The number of points of type ctNew produced from an old point of type ct, or NULL if this depends on the refine type */
+  DMPolytopeType        *cellType;   /* [p]: The cell type of each point in the original mesh */
   PetscFE               *coordFE;    /* Finite element for each cell type, used for localized coordinate interpolation */
   PetscFEGeom           **refGeom;   /* Geometry of the reference cell for each cell type */
   DMLabel               adaptLabel;  /* Optional label indicating cells to be refined */
@@ -94,15 +104,19 @@ typedef struct {
 } FluentSection;
 
 struct _PetscGridHash {
-  PetscInt     dim;
-  PetscReal    lower[3];    /* The lower-left corner */
-  PetscReal    upper[3];    /* The upper-right corner */
-  PetscReal    extent[3];   /* The box size */
-  PetscReal    h[3];        /* The subbox size */
-  PetscInt     n[3];        /* The number of subboxes */
-  PetscSection cellSection; /* Offsets for cells in each subbox*/
-  IS           cells;       /* List of cells in each subbox */
-  DMLabel      cellsSparse; /* Sparse storage for cell map */
+  PetscInt         dim;
+  PetscReal        lower[3];     /* The lower-left corner */
+  PetscReal        upper[3];     /* The upper-right corner */
+  PetscReal        extent[3];    /* The box size */
+  PetscReal        h[3];         /* The subbox size */
+  PetscInt         n[3];         /* The number of subboxes */
+  PetscSection     cellSection;  /* Offsets for cells in each subbox*/
+  IS               cells;        /* List of cells in each subbox */
+  DMLabel          cellsSparse;  /* Sparse storage for cell map */
+  PetscInt         cStart, cEnd; /* The cells covered by the hash */
+  PetscReal       *bounds;       /* Padded bounding box (lower[dim], upper[dim]) of each cell, to reject candidate cells cheaply */
+  PetscObjectId    coordId;      /* The local coordinate vector the hash was built from */
+  PetscObjectState coordState;   /* Its state when the hash was built */
 };
 
 /* Point Numbering in Plex:
@@ -180,6 +194,9 @@ typedef struct {
   PetscBool            useAnchors;        /* Replace constrained points with their anchors in adjacency lists */
   PetscErrorCode      (*useradjacency)(DM,PetscInt,PetscInt*,PetscInt[],void*); /* User callback for adjacency */
   void                *useradjacencyctx;  /* User context for callback */
+  PetscBool            cacheAdjacency;    /* Keep the point adjacency used for preallocation between matrix creations */
+  PetscSection         adjSection[4];     /* Layout of the point adjacency for each (useCone, useClosure), indexed by useCone + 2*useClosure */
+  PetscInt            *adjPoints[4];      /* Points adjacent to each point, with constrained points replaced by their anchors */
 
   /* Projection */
   PetscInt             maxProjectionHeight; /* maximum height of cells used in DMPlexProject functions */
@@ -201,6 +218,10 @@ typedef struct {
   /* Neighbors */
   PetscMPIInt*         neighbors;
 
+  /* Assembly */
+  PetscBool            coloredAssembly;   /* Scatter cell contributions color by color, so that cells of one color can be processed concurrently */
+  ISColoring           cellColoring;      /* Coloring of cells such that cells of one color share no closure points */
+
   /* Debugging */
   PetscBool            printSetValues;
   PetscInt             printFEM;
@@ -266,8 +287,10 @@ PETSC_EXTERN PetscErrorCode VecViewPlex_ExodusII_Zonal_Internal(Vec, int, int);
 PETSC_EXTERN PetscErrorCode VecLoadPlex_ExodusII_Zonal_Internal(Vec, int, int);
 PETSC_INTERN PetscErrorCode DMPlexVTKGetCellType_Internal(DM,PetscInt,PetscInt,PetscInt*);
 PETSC_INTERN PetscErrorCode DMPlexGetAdjacency_Internal(DM,PetscInt,PetscBool,PetscBool,PetscBool,PetscInt*,PetscInt*[]);
+PETSC_INTERN PetscErrorCode DMPlexResetAdjacencyGraph_Internal(DM);
 PETSC_INTERN PetscErrorCode DMPlexGetRawFaces_Internal(DM,DMPolytopeType,const PetscInt[],PetscInt*,const DMPolytopeType*[],const PetscInt*[],const PetscInt*[]);
 PETSC_INTERN PetscErrorCode DMPlexRestoreRawFaces_Internal(DM,DMPolytopeType,const PetscInt[],PetscInt*,const DMPolytopeType*[],const PetscInt*[],const PetscInt*[]);
+PETSC_INTERN PetscErrorCode DMPlexVecSetClosureColored_Internal(DM, PetscSection, Vec, PetscInt, PetscInt, PetscInt, const PetscScalar[], InsertMode, PetscBool *);
 PETSC_INTERN PetscErrorCode CellRefinerInCellTest_Internal(DMPolytopeType, const PetscReal[], PetscBool *);
 PETSC_INTERN PetscErrorCode DMPlexCellRefinerAdaptLabel(DM, DMLabel, DM *);
 PETSC_INTERN PetscErrorCode DMPlexComputeCellType_Internal(DM, PetscInt, PetscInt, DMPolytopeType *);
@@ -57,5 +57,10 @@ PETSC_INTERN PetscErrorCode DMStagPopulateLocalToGlobalInjective_3d(DM);
 PETSC_INTERN PetscErrorCode DMStagSetUniformCoordinatesExplicit_1d(DM,PetscReal,PetscReal);
 PETSC_INTERN PetscErrorCode DMStagSetUniformCoordinatesExplicit_2d(DM,PetscReal,PetscReal,PetscReal,PetscReal);
 PETSC_INTERN PetscErrorCode DMStagSetUniformCoordinatesExplicit_3d(DM,PetscReal,PetscReal,PetscReal,PetscReal,PetscReal,PetscReal);
+PETSC_INTERN PetscErrorCode DMStagStencilToIndexLocal(DM,PetscInt,const DMStagStencil*,PetscInt*);
+PETSC_INTERN PetscErrorCode DMStagGetUniformCoordinateBounds(DM,PetscBool*,PetscReal[],PetscReal[]);
+PETSC_INTERN PetscErrorCode DMRefine_Stag(DM,MPI_Comm,DM*);
+PETSC_INTERN PetscErrorCode DMCoarsen_Stag(DM,MPI_Comm,DM*);
+PETSC_INTERN PetscErrorCode DMCreateInterpolation_Stag(DM,DM,Mat*,Vec*);
 
 #endif
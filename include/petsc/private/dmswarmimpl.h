@@ -12,6 +12,8 @@ PETSC_EXTERN PetscLogEvent DMSWARM_SetSizes;
 PETSC_EXTERN PetscLogEvent DMSWARM_AddPoints;
 PETSC_EXTERN PetscLogEvent DMSWARM_RemovePoints;
 PETSC_EXTERN PetscLogEvent DMSWARM_Sort;
+PETSC_EXTERN PetscLogEvent DMSWARM_ProjectFields;
+PETSC_EXTERN PetscLogEvent DMSWARM_InterpolateFields;
 PETSC_EXTERN PetscLogEvent DMSWARM_DataExchangerTopologySetup;
 PETSC_EXTERN PetscLogEvent DMSWARM_DataExchangerBegin;
 PETSC_EXTERN PetscLogEvent DMSWARM_DataExchangerEnd;
@@ -21,6 +23,7 @@ PETSC_EXTERN PetscLogEvent DMSWARM_DataExchangerPack;
 typedef struct _p_DMSwarmDataField* DMSwarmDataField;
 typedef struct _p_DMSwarmDataBucket* DMSwarmDataBucket;
 typedef struct _p_DMSwarmSort* DMSwarmSort;
+typedef struct _p_DMSwarmMigrator* DMSwarmMigrator;
 
 typedef struct {
   DMSwarmDataBucket db;
@@ -44,10 +47,12 @@ typedef struct {
   DM        dmcell;
 
   PetscBool migrate_error_on_missing_point;
+  PetscBool sort_points_by_cell; /* keep the local points stored in increasing cell order */
 
   PetscBool collect_view_active;
   PetscInt  collect_view_reset_nlocal;
   DMSwarmSort sort_context;
+  DMSwarmMigrator migrator;
 } DM_Swarm;
 
 typedef struct {
@@ -62,9 +67,40 @@ struct _p_DMSwarmSort {
   SwarmPoint *list;
 };
 
+/*
+ Persistent state of the neighbour-only migration used by DMSwarmMigrateBegin()/DMSwarmMigrateEnd().
+ The neighbour ranks of the cell DM and the message tags are kept across migrations;
+ the message lists and buffers only live between a Begin and the matching End.
+*/
+struct _p_DMSwarmMigrator {
+  DM               dmcell;            /* cell DM the neighbour ranks were obtained from */
+  PetscObjectState dmcellstate;       /* state of the cell DM when they were obtained */
+  PetscMPIInt nneighbors,*neighbors;  /* symmetric list of neighbour ranks, excluding this rank */
+  PetscMPIInt tag_count,tag_data;
+  char        **fieldnames;           /* fields to communicate, NULL means all registered fields */
+
+  PetscBool   active;                 /* inside a DMSwarmMigrateBegin()/DMSwarmMigrateEnd() pair */
+  PetscBool   remove_sent_points;
+  PetscInt    npoints_prior,npointsg;
+  PetscInt    nfields,*fields;        /* indices of the communicated fields in the data bucket */
+  size_t      unit_size;              /* bytes per point over the communicated fields */
+  PetscMPIInt nsend,*sendranks;
+  PetscInt    *sendoffsets,*sendpoints;
+  PetscMPIInt nrecv,*recvranks;
+  PetscInt    *recvoffsets;
+  char        *sendbuf,*recvbuf;
+  PetscMPIInt nrequests;
+  MPI_Request *requests;
+};
 
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_Push_Basic(DM, PetscBool);
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_CellDMScatter(DM,PetscBool);
+PETSC_INTERN PetscErrorCode DMSwarmMigrateBegin_Push_Basic(DM,PetscBool);
+PETSC_INTERN PetscErrorCode DMSwarmMigrateEnd_Push_Basic(DM);
+PETSC_INTERN PetscErrorCode DMSwarmMigrateBegin_CellDMScatter(DM,PetscBool);
+PETSC_INTERN PetscErrorCode DMSwarmMigrateEnd_CellDMScatter(DM);
+PETSC_INTERN PetscErrorCode DMSwarmMigratorCreate(DM,DMSwarmMigrator*);
+PETSC_INTERN PetscErrorCode DMSwarmMigratorDestroy(DMSwarmMigrator*);
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_CellDMExact(DM,PetscBool);
 
 #endif /* _SWARMIMPL_H */
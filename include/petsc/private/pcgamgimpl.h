@@ -16,6 +16,16 @@ struct _PCGAMGOps {
   PetscErrorCode (*destroy)(PC);
   PetscErrorCode (*view)(PC,PetscViewer);
 };
+/* Measurements and decision of the automatic process reduction for one coarse grid */
+typedef struct {
+  PetscMPIInt nactive;   /* number of active processes on the grid before the reduction, 0 if the model was not used */
+  PetscMPIInt new_size;  /* number of active processes chosen by the model */
+  PetscMPIInt used_size; /* number of active processes used, after new_size is adjusted to the process layout */
+  PetscInt    nneigh;    /* largest number of neighbors of a process in MatMult() */
+  PetscReal   nz_time;   /* measured time per nonzero of the local part of MatMult() */
+  PetscReal   latency;   /* measured message latency */
+  PetscReal   cost[2];   /* predicted time of MatMult() on nactive and new_size processes */
+} PCGAMGReductionModel;
 /* Private context for the GAMG preconditioner */
 typedef struct gamg_TAG {
   PCGAMGType type;
@@ -31,6 +41,8 @@ typedef struct gamg_TAG {
   PetscReal threshold_scale;
   PetscReal threshold[PETSC_MG_MAXLEVELS]; /* common quatity to many AMG methods so keep it up here */
   PetscInt  level_reduction_factors[PETSC_MG_MAXLEVELS];
+  PetscBool auto_rank_reduction;
+  PCGAMGReductionModel reduction_model[PETSC_MG_MAXLEVELS];
   PetscInt  current_level; /* stash construction state */
   /* these 4 are all related to the method data and should be in the subctx */
   PetscInt  data_sz;      /* nloc*data_rows*data_cols */
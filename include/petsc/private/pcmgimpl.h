@@ -33,6 +33,10 @@ typedef struct {
   Mat           interpolate;
   Mat           restrct;                       /* restrict is a reserved word in C99 and on Cray */
   Mat           inject;                        /* Used for moving state if provided. */
+  Mat           sinterpolate;                  /* Jacobi smoothed interpolation, only used by PC_MG_MULTADDITIVE */
+  Mat           sinterpolateAP;                /* product A P it is formed from, kept for MAT_REUSE_MATRIX */
+  PetscObjectId    sinterpolateId[2];          /* ids of A and P when it was formed */
+  PetscObjectState sinterpolateNz[2];          /* nonzero states of A and P when it was formed */
   Vec           rscale;                        /* scaling of restriction matrix */
   PetscLogEvent eventsmoothsetup;              /* if logging times for each level */
   PetscLogEvent eventsmoothsolve;
@@ -46,6 +50,7 @@ typedef struct {
 typedef struct {
   PCMGType            am;                     /* Multiplicative, additive or full */
   PetscInt            cyclesperpcapply;       /* Number of cycles to use in each PCApply(), multiplicative only*/
+  PetscReal           madamping;              /* Jacobi damping used to smooth the interpolation, mult-additive only */
   PetscInt            maxlevels;              /* total number of levels allocated */
   PCMGGalerkinType    galerkin;               /* use Galerkin process to compute coarser matrices */
   PetscBool           usedmfornumberoflevels; /* sets the number of levels by getting this information out of the DM */
@@ -85,6 +90,7 @@ PETSC_INTERN PetscErrorCode DMSetBasisFunction_Internal(PetscInt, PetscBool, Pet
 PETSC_INTERN PetscErrorCode PCMGComputeCoarseSpace_Internal(PC, PetscInt, PCMGCoarseSpaceType, PetscInt, const Vec[], Vec *[]);
 PETSC_INTERN PetscErrorCode PCMGAdaptInterpolator_Internal(PC, PetscInt, KSP, KSP, PetscInt, Vec[], Vec[]);
 PETSC_INTERN PetscErrorCode PCMGRecomputeLevelOperators_Internal(PC, PetscInt);
+PETSC_INTERN PetscErrorCode PCMGMultAdditiveSetUp_Private(PC);
 
 
 #endif
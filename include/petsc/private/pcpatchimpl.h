@@ -100,6 +100,8 @@ typedef struct {
   PetscObject         *solver;             /* Solvers for each patch TODO Do we need a new KSP for each patch? */
   PetscBool            denseinverse;       /* Should the patch inverse by applied by computing the inverse and a matmult? (Skips KSP/PC etc...) */
   PetscErrorCode      (*densesolve)(Mat, Vec, Vec); /* Matmult for dense solve (used with denseinverse) */
+  PetscScalar         *denseStorage;       /* Contiguous storage for all dense patch inverses (used with denseinverse) */
+  PetscInt            *denseOffsets;       /* [patch]: offset of the patch inverse in denseStorage */
   PetscErrorCode     (*setupsolver)(PC);
   PetscErrorCode     (*applysolver)(PC, PetscInt, Vec, Vec);
   PetscErrorCode     (*resetsolver)(PC);
@@ -43,6 +43,8 @@ struct _p_PetscSection {
   PetscClPerm                   clHash;       /* Hash of (depth, size) to perm and invPerm */
   PetscSection                  clSection;    /* Section giving the number of points in each closure */
   IS                            clPoints;     /* Points in each closure */
+  PetscSection                  clDofSection; /* Section giving the number of dofs in each closure */
+  IS                            clDofIndices; /* Dof indices in each closure, with permutations applied and constrained dofs encoded as -(idx+1) */
   PetscSectionSym               sym;          /* Symmetries of the data */
 };
 
@@ -403,6 +403,7 @@ PETSC_EXTERN PetscErrorCode DMCopyDMTS(DM,DM);
 PETSC_EXTERN PetscErrorCode DMTSView(DMTS,PetscViewer);
 PETSC_EXTERN PetscErrorCode DMTSLoad(DMTS,PetscViewer);
 PETSC_EXTERN PetscErrorCode DMTSCopy(DMTS,DMTS);
+PETSC_INTERN PetscErrorCode DMDATSComputeRHSStages_Private(TS,PetscInt,const PetscReal[],const PetscReal[],PetscReal,PetscReal,Vec,Vec[],Vec[],PetscBool*);
 
 typedef enum {TSEVENT_NONE,TSEVENT_LOCATED_INTERVAL,TSEVENT_PROCESSING,TSEVENT_ZERO,TSEVENT_RESET_NEXTSTEP} TSEventStatus;
 
@@ -30,6 +30,10 @@ M*/
 
 PETSC_EXTERN PetscErrorCode DMDASetInterpolationType(DM,DMDAInterpolationType);
 PETSC_EXTERN PetscErrorCode DMDAGetInterpolationType(DM,DMDAInterpolationType*);
+PETSC_EXTERN PetscErrorCode DMDASetLocalFunctionOverlap(DM,PetscBool);
+PETSC_EXTERN PetscErrorCode DMDAGetLocalFunctionOverlap(DM,PetscBool*);
+PETSC_EXTERN PetscErrorCode DMDASetLocalFDJacobian(DM,PetscBool);
+PETSC_EXTERN PetscErrorCode DMDAGetLocalFDJacobian(DM,PetscBool*);
 PETSC_EXTERN PetscErrorCode DMDACreateAggregates(DM,DM,Mat*);
 
 /* FEM */
@@ -52,6 +56,7 @@ PETSC_EXTERN PetscErrorCode DMDACreate3d(MPI_Comm,DMBoundaryType,DMBoundaryType,
 
 PETSC_EXTERN PetscErrorCode DMDAGlobalToNaturalBegin(DM,Vec,InsertMode,Vec);
 PETSC_EXTERN PetscErrorCode DMDAGlobalToNaturalEnd(DM,Vec,InsertMode,Vec);
+PETSC_EXTERN PetscErrorCode DMDAGlobalToLocalOwned(DM,Vec,Vec);
 PETSC_EXTERN PetscErrorCode DMDANaturalToGlobalBegin(DM,Vec,InsertMode,Vec);
 PETSC_EXTERN PetscErrorCode DMDANaturalToGlobalEnd(DM,Vec,InsertMode,Vec);
 PETSC_DEPRECATED_FUNCTION("Use DMLocalToLocalBegin() (since version 3.5)") PETSC_STATIC_INLINE PetscErrorCode DMDALocalToLocalBegin(DM dm,Vec g,InsertMode mode,Vec l) {return DMLocalToLocalBegin(dm,g,mode,l);}
@@ -182,6 +187,7 @@ M*/
 typedef struct {PetscScalar x,y,z;} DMDACoor3d;
 
 PETSC_EXTERN PetscErrorCode DMDAGetLocalInfo(DM,DMDALocalInfo*);
+PETSC_EXTERN PetscErrorCode DMDAGetLocalInfoSplit(DM,DMDALocalInfo*,PetscInt*,DMDALocalInfo[]);
 
 PETSC_EXTERN PetscErrorCode MatRegisterDAAD(void);
 PETSC_EXTERN PetscErrorCode MatCreateDAAD(DM,Mat*);
@@ -190,6 +196,10 @@ PETSC_EXTERN PetscErrorCode MatCreateSeqUSFFT(Vec,DM,Mat*);
 PETSC_EXTERN PetscErrorCode DMDASetGetMatrix(DM,PetscErrorCode (*)(DM, Mat *));
 PETSC_EXTERN PetscErrorCode DMDASetBlockFills(DM,const PetscInt*,const PetscInt*);
 PETSC_EXTERN PetscErrorCode DMDASetBlockFillsSparse(DM,const PetscInt*,const PetscInt*);
+PETSC_EXTERN PetscErrorCode DMDACreateStencilOperator(DM,PetscInt,const MatStencil[],Mat*);
+PETSC_EXTERN PetscErrorCode DMDAStencilOperatorSetCoefficients(Mat,const PetscScalar[]);
+PETSC_EXTERN PetscErrorCode DMDAStencilOperatorGetCoefficientDM(Mat,DM*);
+PETSC_EXTERN PetscErrorCode DMDAStencilOperatorSetVariableCoefficients(Mat,Vec);
 PETSC_EXTERN PetscErrorCode DMDASetRefinementFactor(DM,PetscInt,PetscInt,PetscInt);
 PETSC_EXTERN PetscErrorCode DMDAGetRefinementFactor(DM,PetscInt*,PetscInt*,PetscInt*);
 
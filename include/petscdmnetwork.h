@@ -29,6 +29,9 @@ PETSC_EXTERN PetscErrorCode DMNetworkGetComponent(DM,PetscInt,PetscInt,PetscInt*
 PETSC_EXTERN PetscErrorCode DMNetworkGetNumComponents(DM,PetscInt,PetscInt*);
 PETSC_EXTERN PetscErrorCode DMNetworkGetLocalVecOffset(DM,PetscInt,PetscInt,PetscInt*);
 PETSC_EXTERN PetscErrorCode DMNetworkGetGlobalVecOffset(DM,PetscInt,PetscInt,PetscInt*);
+PETSC_EXTERN PetscErrorCode DMNetworkSetComponentBatching(DM,PetscBool);
+PETSC_EXTERN PetscErrorCode DMNetworkGetComponentBatch(DM,PetscInt,PetscInt*,const PetscInt**,void**,const PetscInt**,const PetscInt**);
+PETSC_EXTERN PetscErrorCode DMNetworkComponentBatchApply(DM,PetscInt,PetscInt,PetscErrorCode (*)(DM,PetscInt,PetscInt,const PetscInt[],void*,const PetscInt[],const PetscInt[],void*),void*);
 
 PETSC_EXTERN PetscErrorCode DMNetworkGetEdgeOffset(DM,PetscInt,PetscInt*);
 PETSC_EXTERN PetscErrorCode DMNetworkGetVertexOffset(DM,PetscInt,PetscInt*);
@@ -75,11 +75,27 @@ E*/
 typedef enum{DMSTAG_STENCIL_NONE=0,DMSTAG_STENCIL_STAR,DMSTAG_STENCIL_BOX} DMStagStencilType;
 PETSC_EXTERN const char *const DMStagStencilTypes[]; /* Corresponding strings (see stagstencil.c) */
 
+/*E
+  DMStagOperatorType - Matrix-free staggered-grid operator created by DMStagCreateOperator()
+
+$ DMSTAG_OPERATOR_GRADIENT - pressure gradient, from elements to faces
+$ DMSTAG_OPERATOR_DIVERGENCE - velocity divergence, from faces to elements
+$ DMSTAG_OPERATOR_VISCOUS - variable-viscosity vector Laplacian on faces
+$ DMSTAG_OPERATOR_STOKES - the saddle point operator of the Stokes equations
+
+  Level: intermediate
+
+.seealso: DMSTAG, DMStagCreateOperator()
+E*/
+typedef enum {DMSTAG_OPERATOR_GRADIENT,DMSTAG_OPERATOR_DIVERGENCE,DMSTAG_OPERATOR_VISCOUS,DMSTAG_OPERATOR_STOKES} DMStagOperatorType;
+PETSC_EXTERN const char *const DMStagOperatorTypes[]; /* Corresponding strings (see stagoperator.c) */
+
 PETSC_EXTERN PetscErrorCode DMCreate_Stag(DM);
 PETSC_EXTERN PetscErrorCode DMStagCreate1d(MPI_Comm,DMBoundaryType,PetscInt,PetscInt,PetscInt,DMStagStencilType,PetscInt,const PetscInt[],DM*);
 PETSC_EXTERN PetscErrorCode DMStagCreate2d(MPI_Comm,DMBoundaryType,DMBoundaryType,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,DMStagStencilType,PetscInt,const PetscInt[],const PetscInt[],DM*);
 PETSC_EXTERN PetscErrorCode DMStagCreate3d(MPI_Comm,DMBoundaryType,DMBoundaryType,DMBoundaryType,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,DMStagStencilType,PetscInt,const PetscInt[],const PetscInt[],const PetscInt[],DM*);
 PETSC_EXTERN PetscErrorCode DMStagCreateCompatibleDMStag(DM,PetscInt,PetscInt,PetscInt,PetscInt,DM*);
+PETSC_EXTERN PetscErrorCode DMStagCreateOperator(DM,DMStagOperatorType,Mat*);
 PETSC_EXTERN PetscErrorCode DMStagGetBoundaryTypes(DM,DMBoundaryType*,DMBoundaryType*,DMBoundaryType*);
 PETSC_EXTERN PetscErrorCode DMStagGetCorners(DM,PetscInt*,PetscInt*,PetscInt*,PetscInt*,PetscInt*,PetscInt*,PetscInt*,PetscInt*,PetscInt*);
 PETSC_EXTERN PetscErrorCode DMStagGetDOF(DM,PetscInt*,PetscInt*,PetscInt*,PetscInt*);
@@ -102,6 +118,8 @@ PETSC_EXTERN PetscErrorCode DMStagGetStencilWidth(DM,PetscInt*);
 PETSC_EXTERN PetscErrorCode DMStagMatGetValuesStencil(DM,Mat,PetscInt,const DMStagStencil*,PetscInt,const DMStagStencil*,PetscScalar*);
 PETSC_EXTERN PetscErrorCode DMStagMatSetValuesStencil(DM,Mat,PetscInt,const DMStagStencil*,PetscInt,const DMStagStencil*,const PetscScalar*,InsertMode);
 PETSC_EXTERN PetscErrorCode DMStagMigrateVec(DM,Vec,DM,Vec);
+PETSC_EXTERN PetscErrorCode DMStagOperatorGetViscosityDM(Mat,DM*);
+PETSC_EXTERN PetscErrorCode DMStagOperatorSetViscosity(Mat,Vec);
 PETSC_EXTERN PetscErrorCode DMStagPopulateLocalToGlobalInjective(DM);
 PETSC_EXTERN PetscErrorCode DMStagRestoreProductCoordinateArrays(DM,void*,void*,void*);
 PETSC_EXTERN PetscErrorCode DMStagRestoreProductCoordinateArraysRead(DM,void*,void*,void*);
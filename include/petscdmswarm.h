@@ -84,11 +84,15 @@ PETSC_EXTERN PetscErrorCode DMSwarmAddPoint(DM);
 PETSC_EXTERN PetscErrorCode DMSwarmAddNPoints(DM,PetscInt);
 PETSC_EXTERN PetscErrorCode DMSwarmRemovePoint(DM);
 PETSC_EXTERN PetscErrorCode DMSwarmRemovePointAtIndex(DM,PetscInt);
+PETSC_EXTERN PetscErrorCode DMSwarmRemovePoints(DM,PetscInt,const PetscInt[]);
 PETSC_EXTERN PetscErrorCode DMSwarmCopyPoint(DM dm,PetscInt,PetscInt);
 
 PETSC_EXTERN PetscErrorCode DMSwarmGetLocalSize(DM,PetscInt*);
 PETSC_EXTERN PetscErrorCode DMSwarmGetSize(DM,PetscInt*);
 PETSC_EXTERN PetscErrorCode DMSwarmMigrate(DM,PetscBool);
+PETSC_EXTERN PetscErrorCode DMSwarmMigrateBegin(DM,PetscBool);
+PETSC_EXTERN PetscErrorCode DMSwarmMigrateEnd(DM);
+PETSC_EXTERN PetscErrorCode DMSwarmSetMigrateFields(DM,PetscInt,const char*[]);
 
 PETSC_EXTERN PetscErrorCode DMSwarmCollectViewCreate(DM);
 PETSC_EXTERN PetscErrorCode DMSwarmCollectViewDestroy(DM);
@@ -111,8 +115,12 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM,PetscInt,PetscInt*,Pe
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetNumberOfPointsPerCell(DM,PetscInt,PetscInt*);
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetIsValid(DM,PetscBool*);
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetSizes(DM,PetscInt*,PetscInt*);
+PETSC_EXTERN PetscErrorCode DMSwarmSortPointsByCell(DM);
+PETSC_EXTERN PetscErrorCode DMSwarmSetSortPointsByCell(DM,PetscBool);
+PETSC_EXTERN PetscErrorCode DMSwarmGetSortPointsByCell(DM,PetscBool*);
 
 PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM,PetscInt,const char**,Vec**,PetscBool);
+PETSC_EXTERN PetscErrorCode DMSwarmInterpolateFields(DM,PetscInt,const char**,Vec[]);
 PETSC_EXTERN PetscErrorCode DMSwarmCreateMassMatrixSquare(DM,DM,Mat*);
 
 #endif
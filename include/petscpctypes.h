@@ -254,13 +254,18 @@ typedef const char *PCGAMGClassicalType;
             to the next, performs a cycle etc. This is much like the F-cycle presented in "Multigrid" by Trottenberg, Oosterlee, Schuller page 49, but that
             algorithm supports smoothing on before the restriction on each level in the initial restriction to the coarsest stage. In addition that algorithm
             calls the V-cycle only on the coarser level and has a post-smoother instead.
--  PC_MG_KASKADE - like full multigrid except one never goes back to a coarser level
+.  PC_MG_KASKADE - like full multigrid except one never goes back to a coarser level
                from a finer
+-  PC_MG_MULTADDITIVE - additive multigrid in which the interpolation (and its transpose, the restriction)
+               is smoothed with damped Jacobi, the "mult-additive" method of Vassilevski and Yang. All the level
+               corrections are computed independently from a single restriction chain, as with PC_MG_ADDITIVE,
+               but the convergence is close to that of a V-cycle. The level operators and interpolations must be
+               AIJ matrices; levels with other types, such as MATMAIJ or MATSHELL, use the unsmoothed interpolation
 
 .seealso: PCMGSetType(), PCMGSetCycleType(), PCMGSetCycleTypeOnLevel()
 
 E*/
-typedef enum { PC_MG_MULTIPLICATIVE,PC_MG_ADDITIVE,PC_MG_FULL,PC_MG_KASKADE } PCMGType;
+typedef enum { PC_MG_MULTIPLICATIVE,PC_MG_ADDITIVE,PC_MG_FULL,PC_MG_KASKADE,PC_MG_MULTADDITIVE } PCMGType;
 #define PC_MG_CASCADE PC_MG_KASKADE;
 
 /*E
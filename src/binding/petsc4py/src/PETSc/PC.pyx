@@ -78,6 +78,7 @@ class PCMGType(object):
     ADDITIVE       = PC_MG_ADDITIVE
     FULL           = PC_MG_FULL
     KASKADE        = PC_MG_KASKADE
+    MULTADDITIVE   = PC_MG_MULTADDITIVE
 
 class PCMGCycleType(object):
     V = PC_MG_CYCLE_V
@@ -74,6 +74,7 @@ cdef extern from * nogil:
         PC_MG_ADDITIVE
         PC_MG_FULL
         PC_MG_KASKADE
+        PC_MG_MULTADDITIVE
 
     ctypedef enum PetscPCMGCycleType "PCMGCycleType":
         PC_MG_CYCLE_V
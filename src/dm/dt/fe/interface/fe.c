@@ -2262,24 +2262,24 @@ PetscErrorCode PetscFEUpdateElementMat_Internal(PetscFE feI, PetscFE feJ, PetscI
   }
   ierr = PetscFEPushforward(feJ, fegeom, NbJ, tmpBasisJ);CHKERRQ(ierr);
   ierr = PetscFEPushforwardGradient(feJ, fegeom, NbJ, tmpBasisDerJ);CHKERRQ(ierr);
-  for (f = 0; f < NbI; ++f) {
-    for (fc = 0; fc < NcI; ++fc) {
-      const PetscInt fidx = f*NcI+fc; /* Test function basis index */
-      const PetscInt i    = offsetI+f; /* Element matrix row */
-      for (g = 0; g < NbJ; ++g) {
-        for (gc = 0; gc < NcJ; ++gc) {
-          const PetscInt gidx = g*NcJ+gc; /* Trial function basis index */
-          const PetscInt j    = offsetJ+g; /* Element matrix column */
-          const PetscInt fOff = eOffset+i*totDim+j;
-
-          elemMat[fOff] += tmpBasisI[fidx]*g0[fc*NcJ+gc]*tmpBasisJ[gidx];
-          for (df = 0; df < dE; ++df) {
-            elemMat[fOff] += tmpBasisI[fidx]*g1[(fc*NcJ+gc)*dE+df]*tmpBasisDerJ[gidx*dE+df];
-            elemMat[fOff] += tmpBasisDerI[fidx*dE+df]*g2[(fc*NcJ+gc)*dE+df]*tmpBasisJ[gidx];
-            for (dg = 0; dg < dE; ++dg) {
-              elemMat[fOff] += tmpBasisDerI[fidx*dE+df]*g3[((fc*NcJ+gc)*dE+df)*dE+dg]*tmpBasisDerJ[gidx*dE+dg];
-            }
-          }
+  /* Contract the pointwise Jacobians with the trial function first, so that each entry only needs a (dE+1) dot product.
+     The contractions are accumulated one derivative direction at a time, which needs no scratch space of size dE. */
+  for (g = 0; g < NbJ; ++g) {
+    for (gc = 0; gc < NcJ; ++gc) {
+      const PetscInt gidx = g*NcJ+gc; /* Trial function basis index */
+      const PetscInt j    = offsetJ+g; /* Element matrix column */
+
+      for (fc = 0; fc < NcI; ++fc) {
+        const PetscInt fgc = fc*NcJ+gc;
+        PetscScalar    t0, t1;
+
+        t0 = g0[fgc]*tmpBasisJ[gidx];
+        for (df = 0; df < dE; ++df) t0 += g1[fgc*dE+df]*tmpBasisDerJ[gidx*dE+df];
+        for (f = 0; f < NbI; ++f) elemMat[eOffset+(offsetI+f)*totDim+j] += tmpBasisI[f*NcI+fc]*t0;
+        for (df = 0; df < dE; ++df) {
+          t1 = g2[fgc*dE+df]*tmpBasisJ[gidx];
+          for (dg = 0; dg < dE; ++dg) t1 += g3[(fgc*dE+df)*dE+dg]*tmpBasisDerJ[gidx*dE+dg];
+          for (f = 0; f < NbI; ++f) elemMat[eOffset+(offsetI+f)*totDim+j] += tmpBasisDerI[(f*NcI+fc)*dE+df]*t1;
         }
       }
     }
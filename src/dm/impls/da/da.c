@@ -648,6 +648,134 @@ PetscErrorCode  DMDAGetInterpolationType(DM da,DMDAInterpolationType *ctype)
   PetscFunctionReturn(0);
 }
 
+/*@
+   DMDASetLocalFunctionOverlap - Sets whether the DMDA local functions of SNES and TS overlap the ghost update with
+   computation
+
+   Logically Collective on da
+
+   Input Parameters:
++  da  - the distributed array
+-  flg - PETSC_TRUE to overlap
+
+   Options Database:
+.  -da_local_function_overlap - overlap the ghost update with the local function
+
+   Notes:
+   When set, the residual callbacks of DMDASNESSetFunctionLocal(), DMDATSSetRHSFunctionLocal() and
+   DMDATSSetIFunctionLocal() with INSERT_VALUES start the ghost update, call the local function on the interior box of
+   DMDAGetLocalInfoSplit() while the messages are in flight, complete the update and then call the local function once
+   for each boundary slab. The local function must therefore compute exactly the points xs <= i < xs+xm (and likewise
+   for j and k) of the DMDALocalInfo it is given, and must not rely on being called once per evaluation.
+
+   Level: intermediate
+
+.seealso: DMDAGetLocalFunctionOverlap(), DMDAGetLocalInfoSplit(), DMDASNESSetFunctionLocal(), DMDATSSetRHSFunctionLocal()
+@*/
+PetscErrorCode DMDASetLocalFunctionOverlap(DM da,PetscBool flg)
+{
+  DM_DA *dd = (DM_DA*)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidLogicalCollectiveBool(da,flg,2);
+  dd->overlaplocal = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMDAGetLocalFunctionOverlap - Gets whether the DMDA local functions of SNES and TS overlap the ghost update with
+   computation
+
+   Not Collective
+
+   Input Parameter:
+.  da - the distributed array
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the ghost update is overlapped
+
+   Level: intermediate
+
+.seealso: DMDASetLocalFunctionOverlap()
+@*/
+PetscErrorCode DMDAGetLocalFunctionOverlap(DM da,PetscBool *flg)
+{
+  DM_DA *dd = (DM_DA*)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidBoolPointer(flg,2);
+  *flg = dd->overlaplocal;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMDASetLocalFDJacobian - Sets whether the finite difference Jacobian of the DMDA local residual function of SNES is
+   computed from a single ghost update instead of with MatFDColoring
+
+   Logically Collective on da
+
+   Input Parameters:
++  da  - the distributed array
+-  flg - PETSC_TRUE to compute the Jacobian locally
+
+   Options Database:
+.  -da_local_fd_jacobian - compute the finite difference Jacobian locally
+
+   Notes:
+   This is used when the residual is set with DMDASNESSetFunctionLocal() and INSERT_VALUES and no Jacobian is
+   provided. The ghost points of the state are updated once; each color of a stencil coloring of the ghosted points is
+   then perturbed in the local vector, including the ghost copies, and the local function is called on the owned box.
+   No messages are sent per color. The differences are gathered in the row block of each owned point, which is inserted
+   into the matrix created by DMCreateMatrix() with a single MatSetValuesLocal() once its last color is done. The
+   differencing parameters are those of MatFDColoring, -mat_fd_coloring_err and -mat_fd_coloring_umin.
+
+   The DMDA must have DM_BOUNDARY_NONE or DM_BOUNDARY_PERIODIC boundaries and no block fills; otherwise, or when no
+   stencil coloring fits the periodic sizes, MatFDColoring is used.
+
+   Level: intermediate
+
+.seealso: DMDAGetLocalFDJacobian(), DMDASNESSetFunctionLocal(), MatFDColoringCreate(), DMDASetLocalFunctionOverlap()
+@*/
+PetscErrorCode DMDASetLocalFDJacobian(DM da,PetscBool flg)
+{
+  DM_DA *dd = (DM_DA*)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidLogicalCollectiveBool(da,flg,2);
+  dd->localfdjacobian = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMDAGetLocalFDJacobian - Gets whether the finite difference Jacobian of the DMDA local residual function of SNES is
+   computed from a single ghost update
+
+   Not Collective
+
+   Input Parameter:
+.  da - the distributed array
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the Jacobian is computed locally
+
+   Level: intermediate
+
+.seealso: DMDASetLocalFDJacobian()
+@*/
+PetscErrorCode DMDAGetLocalFDJacobian(DM da,PetscBool *flg)
+{
+  DM_DA *dd = (DM_DA*)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidBoolPointer(flg,2);
+  *flg = dd->localfdjacobian;
+  PetscFunctionReturn(0);
+}
+
 /*@C
       DMDAGetNeighbors - Gets an array containing the MPI rank of all the current
         processes neighbors.
@@ -976,6 +1104,8 @@ PetscErrorCode  DMRefine_DA(DM da,MPI_Comm comm,DM *daref)
   /* da2->ops->createinterpolation = da->ops->createinterpolation; this causes problem with SNESVI */
   da2->ops->getcoloring = da->ops->getcoloring;
   dd2->interptype       = dd->interptype;
+  dd2->overlaplocal     = dd->overlaplocal;
+  dd2->localfdjacobian  = dd->localfdjacobian;
 
   /* copy fill information if given */
   if (dd->dfill) {
@@ -1138,6 +1268,8 @@ PetscErrorCode  DMCoarsen_DA(DM dmf, MPI_Comm comm,DM *dmc)
   dmc2->ops->creatematrix = dmf->ops->creatematrix;
   dmc2->ops->getcoloring  = dmf->ops->getcoloring;
   dd2->interptype         = dd->interptype;
+  dd2->overlaplocal       = dd->overlaplocal;
+  dd2->localfdjacobian    = dd->localfdjacobian;
 
   /* copy fill information if given */
   if (dd->dfill) {
@@ -26,6 +26,8 @@ PetscErrorCode  DMSetFromOptions_DA(PetscOptionItems *PetscOptionsObject,DM da)
   if (dim > 1) {ierr = PetscOptionsBoundedInt("-da_overlap_y","Decomposition overlap in y direction","DMDASetOverlap",dd->yol,&dd->yol,NULL,0);CHKERRQ(ierr);}
   if (dim > 2) {ierr = PetscOptionsBoundedInt("-da_overlap_z","Decomposition overlap in z direction","DMDASetOverlap",dd->zol,&dd->zol,NULL,0);CHKERRQ(ierr);}
 
+  ierr = PetscOptionsBool("-da_local_fd_jacobian","Compute the finite difference Jacobian of the local function without communication","DMDASetLocalFDJacobian",dd->localfdjacobian,&dd->localfdjacobian,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-da_local_function_overlap","Overlap the ghost update with the local function","DMDASetLocalFunctionOverlap",dd->overlaplocal,&dd->overlaplocal,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBoundedInt("-da_local_subdomains","","DMDASetNumLocalSubdomains",dd->Nsub,&dd->Nsub,&flg,PETSC_DECIDE);CHKERRQ(ierr);
   if (flg) {ierr = DMDASetNumLocalSubDomains(da,dd->Nsub);CHKERRQ(ierr);}
 
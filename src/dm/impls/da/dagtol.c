@@ -30,6 +30,55 @@ PetscErrorCode  DMGlobalToLocalEnd_DA(DM da,Vec g,InsertMode mode,Vec l)
   PetscFunctionReturn(0);
 }
 
+/*@
+   DMDAGlobalToLocalOwned - Copies the owned values of a global vector into a local vector, leaving the ghost points alone
+
+   Not Collective
+
+   Input Parameters:
++  da - the distributed array
+-  g  - the global vector
+
+   Output Parameter:
+.  l - the local vector
+
+   Notes:
+   Call this before DMGlobalToLocalBegin(), which locks the local vector for writing until DMGlobalToLocalEnd(). The
+   owned part of the local vector may then be read with DMDAVecGetArrayRead() while the ghost update is in flight,
+   whatever VecScatter implementation performs it.
+
+   Level: developer
+
+.seealso: DMGlobalToLocalBegin(), DMDAGetLocalInfoSplit(), DMDASetLocalFunctionOverlap()
+@*/
+PetscErrorCode DMDAGlobalToLocalOwned(DM da,Vec g,Vec l)
+{
+  DM_DA             *dd = (DM_DA*)da->data;
+  const PetscScalar *ga;
+  PetscScalar       *la;
+  PetscInt          xm,ym,zm,gxm,gym,ox,oy,oz,j,k;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidHeaderSpecific(g,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(l,VEC_CLASSID,3);
+  /* x extents are in scalars, y and z in grid points */
+  xm  = dd->xe - dd->xs; ym = dd->ye - dd->ys; zm = dd->ze - dd->zs;
+  gxm = dd->Xe - dd->Xs; gym = dd->Ye - dd->Ys;
+  ox  = dd->xs - dd->Xs; oy = dd->ys - dd->Ys; oz = dd->zs - dd->Zs;
+  ierr = VecGetArrayRead(g,&ga);CHKERRQ(ierr);
+  ierr = VecGetArray(l,&la);CHKERRQ(ierr);
+  for (k = 0; k < zm; ++k) {
+    for (j = 0; j < ym; ++j) {
+      ierr = PetscArraycpy(la + ((k+oz)*gym + j+oy)*gxm + ox,ga + (k*ym + j)*xm,xm);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArray(l,&la);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(g,&ga);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode  DMLocalToGlobalBegin_DA(DM da,Vec l,InsertMode mode,Vec g)
 {
   PetscErrorCode ierr;
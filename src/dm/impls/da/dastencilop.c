@@ -0,0 +1,517 @@
+/*
+  Matrix-free stencil operators on a DMDA.
+
+  The operator is y_p = sum_e C_e(p) x_{p+o_e} over a fixed list of stencil offsets o_e, where C_e is a dof x dof block
+  that is either the same at every grid point or read from a vector of the compatible DMDA with nentries*dof*dof
+  components. Entries reaching across a non-periodic boundary are dropped, exactly as MatSetValuesStencil() drops them.
+*/
+#include <petsc/private/dmdaimpl.h>    /*I   "petscdmda.h"   I*/
+
+typedef struct {
+  DM           da;
+  PetscInt     dim,dof,nentries;
+  MatStencil   *offsets;
+  PetscInt     *loffsets;               /* offsets of the entries in the ghosted local array, in grid points */
+  PetscScalar  *coeffs;                 /* constant coefficients [nentries][dof][dof], row major blocks */
+  DM           cda;                     /* DMDA for the variable coefficients, NULL until requested */
+  Vec          vcoeffs;                 /* variable coefficients, a global vector of cda */
+  PetscInt     M[3];                    /* global grid sizes */
+  PetscBool    periodic[3];
+  PetscInt     s[3],e[3];               /* owned box */
+  PetscInt     gs[3],gm[3];             /* ghosted box */
+  PetscInt     lo[3],hi[3];             /* owned points whose entries all lie inside the domain */
+  PetscInt     tile[3];                 /* tile sizes for the apply in the i, j and k directions */
+} DMDAStencilOp;
+
+/* Row kernel for the points [i0,i1) of row (j,k), all of whose stencil entries lie inside the domain */
+static void DMDAStencilOpApplyRow_Private(const DMDAStencilOp *op,PetscInt j,PetscInt k,PetscInt i0,PetscInt i1,const PetscScalar *xa,const PetscScalar *ca,PetscScalar *ya)
+{
+  const PetscInt    ne = op->nentries,dof = op->dof,bs2 = dof*dof;
+  const PetscInt    lrow = ((k-op->gs[2])*op->gm[1] + (j-op->gs[1]))*op->gm[0] - op->gs[0];
+  const PetscInt    orow = ((k-op->s[2])*(op->e[1]-op->s[1]) + (j-op->s[1]))*(op->e[0]-op->s[0]) - op->s[0];
+  const PetscScalar *x = xa + lrow*dof;
+  PetscScalar       *y = ya + orow*dof;
+  PetscInt          i,e,r,c;
+
+  if (dof == 1) {
+    PetscPragmaSIMD
+    for (i = i0; i < i1; ++i) y[i] = 0.0;
+    for (e = 0; e < ne; ++e) {
+      const PetscScalar *xe = x + op->loffsets[e];
+
+      if (ca) {
+        const PetscScalar *ce = ca + orow*ne + e;
+
+        PetscPragmaSIMD
+        for (i = i0; i < i1; ++i) y[i] += ce[i*ne]*xe[i];
+      } else {
+        const PetscScalar ce = op->coeffs[e];
+
+        PetscPragmaSIMD
+        for (i = i0; i < i1; ++i) y[i] += ce*xe[i];
+      }
+    }
+    return;
+  }
+  for (i = i0; i < i1; ++i) {
+    PetscScalar *yi = y + i*dof;
+
+    for (r = 0; r < dof; ++r) yi[r] = 0.0;
+    for (e = 0; e < ne; ++e) {
+      const PetscScalar *xe = x + (i + op->loffsets[e])*dof;
+      const PetscScalar *ce = ca ? ca + ((orow + i)*ne + e)*bs2 : op->coeffs + e*bs2;
+
+      for (r = 0; r < dof; ++r) for (c = 0; c < dof; ++c) yi[r] += ce[r*dof+c]*xe[c];
+    }
+  }
+}
+
+/* Point kernel which checks each entry against the non-periodic boundaries */
+static void DMDAStencilOpApplyPoint_Private(const DMDAStencilOp *op,PetscInt i,PetscInt j,PetscInt k,const PetscScalar *xa,const PetscScalar *ca,PetscScalar *ya)
+{
+  const PetscInt ne = op->nentries,dof = op->dof,bs2 = dof*dof;
+  const PetscInt l = ((k-op->gs[2])*op->gm[1] + (j-op->gs[1]))*op->gm[0] + (i-op->gs[0]);
+  const PetscInt o = ((k-op->s[2])*(op->e[1]-op->s[1]) + (j-op->s[1]))*(op->e[0]-op->s[0]) + (i-op->s[0]);
+  PetscScalar    *y = ya + o*dof;
+  PetscInt       e,r,c;
+
+  for (r = 0; r < dof; ++r) y[r] = 0.0;
+  for (e = 0; e < ne; ++e) {
+    const PetscInt    p[3] = {i + op->offsets[e].i,j + op->offsets[e].j,k + op->offsets[e].k};
+    const PetscScalar *xe,*ce;
+    PetscInt          d;
+
+    for (d = 0; d < 3; ++d) if (!op->periodic[d] && (p[d] < 0 || p[d] >= op->M[d])) break;
+    if (d < 3) continue;
+    xe = xa + (l + op->loffsets[e])*dof;
+    ce = ca ? ca + (o*ne + e)*bs2 : op->coeffs + e*bs2;
+    for (r = 0; r < dof; ++r) for (c = 0; c < dof; ++c) y[r] += ce[r*dof+c]*xe[c];
+  }
+}
+
+/* Applies the operator to the ghosted local array xa, tile by tile, writing the owned array ya */
+static PetscErrorCode DMDAStencilOpApply_Private(const DMDAStencilOp *op,const PetscScalar *xa,const PetscScalar *ca,PetscScalar *ya)
+{
+  PetscInt ib,jb,kb,i,j,k;
+
+  PetscFunctionBegin;
+  for (kb = op->s[2]; kb < op->e[2]; kb += op->tile[2]) {
+    for (jb = op->s[1]; jb < op->e[1]; jb += op->tile[1]) {
+      for (ib = op->s[0]; ib < op->e[0]; ib += op->tile[0]) {
+        const PetscInt i1 = PetscMin(ib + op->tile[0],op->e[0]);
+        const PetscInt j1 = PetscMin(jb + op->tile[1],op->e[1]);
+        const PetscInt k1 = PetscMin(kb + op->tile[2],op->e[2]);
+
+        for (k = kb; k < k1; ++k) {
+          for (j = jb; j < j1; ++j) {
+            const PetscInt ilo = PetscMax(ib,op->lo[0]),ihi = PetscMin(i1,op->hi[0]);
+
+            if (k < op->lo[2] || k >= op->hi[2] || j < op->lo[1] || j >= op->hi[1] || ilo >= ihi) {
+              for (i = ib; i < i1; ++i) DMDAStencilOpApplyPoint_Private(op,i,j,k,xa,ca,ya);
+              continue;
+            }
+            for (i = ib; i < ilo; ++i) DMDAStencilOpApplyPoint_Private(op,i,j,k,xa,ca,ya);
+            DMDAStencilOpApplyRow_Private(op,j,k,ilo,ihi,xa,ca,ya);
+            for (i = ihi; i < i1; ++i) DMDAStencilOpApplyPoint_Private(op,i,j,k,xa,ca,ya);
+          }
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMDAStencilOpCheckCoefficients_Private(Mat A,DMDAStencilOp *op)
+{
+  PetscFunctionBegin;
+  if (!op->coeffs && !op->vcoeffs) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"Stencil coefficients have not been set, call DMDAStencilOperatorSetCoefficients() or DMDAStencilOperatorSetVariableCoefficients()");
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_DMDAStencilOp(Mat A,Vec x,Vec y)
+{
+  DMDAStencilOp     *op;
+  Vec               xl;
+  const PetscScalar *xa,*ca = NULL;
+  PetscScalar       *ya;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  ierr = DMDAStencilOpCheckCoefficients_Private(A,op);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(op->da,&xl);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(op->da,x,INSERT_VALUES,xl);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(op->da,x,INSERT_VALUES,xl);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xl,&xa);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&ya);CHKERRQ(ierr);
+  if (op->vcoeffs) {ierr = VecGetArrayRead(op->vcoeffs,&ca);CHKERRQ(ierr);}
+  ierr = DMDAStencilOpApply_Private(op,xa,ca,ya);CHKERRQ(ierr);
+  if (op->vcoeffs) {ierr = VecRestoreArrayRead(op->vcoeffs,&ca);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(y,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xl,&xa);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(op->da,&xl);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*op->nentries*op->dof*op->dof*(op->e[0]-op->s[0])*(op->e[1]-op->s[1])*(op->e[2]-op->s[2]));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetDiagonal_DMDAStencilOp(Mat A,Vec D)
+{
+  DMDAStencilOp     *op;
+  const PetscScalar *ca = NULL;
+  PetscScalar       *d;
+  PetscInt          n,p,e,r;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  ierr = DMDAStencilOpCheckCoefficients_Private(A,op);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(D,&n);CHKERRQ(ierr);
+  ierr = VecGetArray(D,&d);CHKERRQ(ierr);
+  if (op->vcoeffs) {ierr = VecGetArrayRead(op->vcoeffs,&ca);CHKERRQ(ierr);}
+  for (p = 0; p < n/op->dof; ++p) {
+    for (r = 0; r < op->dof; ++r) d[p*op->dof+r] = 0.0;
+    for (e = 0; e < op->nentries; ++e) {
+      const PetscScalar *ce;
+
+      if (op->offsets[e].i || op->offsets[e].j || op->offsets[e].k) continue;
+      ce = ca ? ca + (p*op->nentries + e)*op->dof*op->dof : op->coeffs + e*op->dof*op->dof;
+      for (r = 0; r < op->dof; ++r) d[p*op->dof+r] += ce[r*op->dof+r];
+    }
+  }
+  if (op->vcoeffs) {ierr = VecRestoreArrayRead(op->vcoeffs,&ca);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(D,&d);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+/* Assembles the operator into a matrix of the given type created by DMCreateMatrix() on the DMDA */
+static PetscErrorCode MatConvert_DMDAStencilOp(Mat A,MatType newtype,MatReuse reuse,Mat *B)
+{
+  DMDAStencilOp     *op;
+  Mat               M;
+  MatType           otype;
+  char              *savedtype;
+  MatStencil        *rows,*cols;
+  PetscScalar       *vals;
+  const PetscScalar *ca = NULL;
+  PetscInt          ne,dof,bs2,i,j,k,e,r,c,d,n,ncols;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  ierr = DMDAStencilOpCheckCoefficients_Private(A,op);CHKERRQ(ierr);
+  ne   = op->nentries; dof = op->dof; bs2 = dof*dof;
+  if (reuse == MAT_REUSE_MATRIX) {
+    M    = *B;
+    ierr = MatZeroEntries(M);CHKERRQ(ierr);
+  } else {
+    ierr = DMGetMatType(op->da,&otype);CHKERRQ(ierr);
+    ierr = PetscStrallocpy(otype,&savedtype);CHKERRQ(ierr);
+    ierr = DMSetMatType(op->da,newtype);CHKERRQ(ierr);
+    ierr = DMCreateMatrix(op->da,&M);CHKERRQ(ierr);
+    ierr = DMSetMatType(op->da,savedtype);CHKERRQ(ierr);
+    ierr = PetscFree(savedtype);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc3(dof,&rows,ne*dof,&cols,dof*ne*dof,&vals);CHKERRQ(ierr);
+  if (op->vcoeffs) {ierr = VecGetArrayRead(op->vcoeffs,&ca);CHKERRQ(ierr);}
+  for (k = op->s[2], n = 0; k < op->e[2]; ++k) {
+    for (j = op->s[1]; j < op->e[1]; ++j) {
+      for (i = op->s[0]; i < op->e[0]; ++i, ++n) {
+        PetscInt nkept = 0;
+
+        for (r = 0; r < dof; ++r) {rows[r].i = i; rows[r].j = j; rows[r].k = k; rows[r].c = r;}
+        for (e = 0; e < ne; ++e) {
+          const PetscInt p[3] = {i + op->offsets[e].i,j + op->offsets[e].j,k + op->offsets[e].k};
+
+          for (d = 0; d < 3; ++d) if (!op->periodic[d] && (p[d] < 0 || p[d] >= op->M[d])) break;
+          if (d < 3) continue;
+          for (c = 0; c < dof; ++c) {
+            cols[nkept*dof+c].i = p[0]; cols[nkept*dof+c].j = p[1]; cols[nkept*dof+c].k = p[2]; cols[nkept*dof+c].c = c;
+          }
+          ++nkept;
+        }
+        ncols = nkept*dof;
+        for (e = 0, nkept = 0; e < ne; ++e) {
+          const PetscInt    p[3] = {i + op->offsets[e].i,j + op->offsets[e].j,k + op->offsets[e].k};
+          const PetscScalar *ce  = ca ? ca + (n*ne + e)*bs2 : op->coeffs + e*bs2;
+
+          for (d = 0; d < 3; ++d) if (!op->periodic[d] && (p[d] < 0 || p[d] >= op->M[d])) break;
+          if (d < 3) continue;
+          for (r = 0; r < dof; ++r) for (c = 0; c < dof; ++c) vals[r*ncols + nkept*dof + c] = ce[r*dof+c];
+          ++nkept;
+        }
+        ierr = MatSetValuesStencil(M,dof,rows,ncols,cols,vals,ADD_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  if (op->vcoeffs) {ierr = VecRestoreArrayRead(op->vcoeffs,&ca);CHKERRQ(ierr);}
+  ierr = PetscFree3(rows,cols,vals);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(M,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(M,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  if (reuse == MAT_INPLACE_MATRIX) {
+    ierr = MatHeaderReplace(A,&M);CHKERRQ(ierr);
+  } else if (reuse == MAT_INITIAL_MATRIX) *B = M;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_DMDAStencilOp(Mat A)
+{
+  DMDAStencilOp  *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  ierr = PetscFree2(op->offsets,op->loffsets);CHKERRQ(ierr);
+  ierr = PetscFree(op->coeffs);CHKERRQ(ierr);
+  ierr = VecDestroy(&op->vcoeffs);CHKERRQ(ierr);
+  ierr = DMDestroy(&op->cda);CHKERRQ(ierr);
+  ierr = DMDestroy(&op->da);CHKERRQ(ierr);
+  ierr = PetscFree(op);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"DMDAStencilOperatorSetCoefficients_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"DMDAStencilOperatorGetCoefficientDM_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"DMDAStencilOperatorSetVariableCoefficients_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMDAStencilOperatorSetCoefficients_DMDAStencilOp(Mat A,const PetscScalar coeffs[])
+{
+  DMDAStencilOp  *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  if (!op->coeffs) {ierr = PetscMalloc1(op->nentries*op->dof*op->dof,&op->coeffs);CHKERRQ(ierr);}
+  ierr = PetscArraycpy(op->coeffs,coeffs,op->nentries*op->dof*op->dof);CHKERRQ(ierr);
+  ierr = VecDestroy(&op->vcoeffs);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMDAStencilOperatorGetCoefficientDM_DMDAStencilOp(Mat A,DM *cdm)
+{
+  DMDAStencilOp  *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  if (!op->cda) {ierr = DMDACreateCompatibleDMDA(op->da,op->nentries*op->dof*op->dof,&op->cda);CHKERRQ(ierr);}
+  *cdm = op->cda;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMDAStencilOperatorSetVariableCoefficients_DMDAStencilOp(Mat A,Vec coeffs)
+{
+  DMDAStencilOp  *op;
+  PetscInt       n,npoints;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(coeffs,&n);CHKERRQ(ierr);
+  npoints = (op->e[0]-op->s[0])*(op->e[1]-op->s[1])*(op->e[2]-op->s[2]);
+  if (n != npoints*op->nentries*op->dof*op->dof) SETERRQ2(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_SIZ,"Coefficient vector local size %D should be %D, use a global vector of DMDAStencilOperatorGetCoefficientDM()",n,npoints*op->nentries*op->dof*op->dof);
+  ierr = PetscObjectReference((PetscObject)coeffs);CHKERRQ(ierr);
+  ierr = VecDestroy(&op->vcoeffs);CHKERRQ(ierr);
+  op->vcoeffs = coeffs;
+  ierr = PetscFree(op->coeffs);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMDACreateStencilOperator - Creates a matrix-free operator y_p = sum_e C_e x_{p+o_e} for a list of stencil offsets on a DMDA
+
+   Collective on da
+
+   Input Parameters:
++  da       - the DMDA
+.  nentries - the number of stencil entries
+-  offsets  - the offsets o_e of the entries; only the i, j and k fields are used, the c field is ignored
+
+   Output Parameter:
+.  A - the operator, a MATSHELL
+
+   Options Database:
+.  -da_stencil_tile <ti,tj,tk> - tile sizes used by MatMult() in the i, j and k directions
+
+   Notes:
+   Each entry couples all dof components of a grid point to all dof components of its neighbor through a dof x dof
+   block of coefficients, which must be given by DMDAStencilOperatorSetCoefficients() or
+   DMDAStencilOperatorSetVariableCoefficients() before the operator is used. The offsets must lie within the stencil
+   width of the DMDA, and for DMDA_STENCIL_STAR have at most one nonzero component. Entries that reach across a
+   non-periodic boundary are dropped.
+
+   MatMult() performs a single ghost update and then sweeps the owned box tile by tile; the rows whose entries are all
+   inside the domain are applied with a vectorizable loop over the entries, the remaining points check each entry.
+   MatGetDiagonal() is supported, so the operator may be used with Jacobi and Chebyshev smoothers, and
+   MatConvert() to MATAIJ, MATSELL or any other type supported by DMCreateMatrix() assembles it with the preallocation
+   of the DMDA.
+
+   Level: intermediate
+
+.seealso: DMDAStencilOperatorSetCoefficients(), DMDAStencilOperatorSetVariableCoefficients(), DMDAStencilOperatorGetCoefficientDM(), MatSetValuesStencil(), DMCreateMatrix()
+@*/
+PetscErrorCode DMDACreateStencilOperator(DM da,PetscInt nentries,const MatStencil offsets[],Mat *A)
+{
+  DMDAStencilOp   *op;
+  DMBoundaryType  bx,by,bz;
+  DMDAStencilType st;
+  PetscInt        dim,M,N,P,dof,sw,e,d,xs,ys,zs,xm,ym,zm,gxs,gys,gzs,gxm,gym,gzm,ntile = 3;
+  PetscBool       flg;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidPointer(offsets,3);
+  PetscValidPointer(A,4);
+  if (nentries < 1) SETERRQ1(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_OUTOFRANGE,"Number of stencil entries %D must be positive",nentries);
+  ierr = DMDAGetInfo(da,&dim,&M,&N,&P,NULL,NULL,NULL,&dof,&sw,&bx,&by,&bz,&st);CHKERRQ(ierr);
+  ierr = DMDAGetCorners(da,&xs,&ys,&zs,&xm,&ym,&zm);CHKERRQ(ierr);
+  ierr = DMDAGetGhostCorners(da,&gxs,&gys,&gzs,&gxm,&gym,&gzm);CHKERRQ(ierr);
+  for (e = 0; e < nentries; ++e) {
+    const PetscInt o[3] = {offsets[e].i,offsets[e].j,offsets[e].k};
+    PetscInt       nnz  = 0;
+
+    for (d = 0; d < 3; ++d) {
+      if (d >= dim && o[d]) SETERRQ3(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_OUTOFRANGE,"Stencil entry %D has a nonzero offset in direction %D of a %D-dimensional DMDA",e,d,dim);
+      if (PetscAbsInt(o[d]) > sw) SETERRQ3(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_OUTOFRANGE,"Stencil entry %D has offset %D beyond the stencil width %D",e,o[d],sw);
+      if (o[d]) ++nnz;
+    }
+    if (st == DMDA_STENCIL_STAR && nnz > 1) SETERRQ1(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_OUTOFRANGE,"Stencil entry %D is diagonal, which needs a DMDA_STENCIL_BOX DMDA",e);
+  }
+
+  ierr = PetscNew(&op);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)da);CHKERRQ(ierr);
+  op->da       = da;
+  op->dim      = dim;
+  op->dof      = dof;
+  op->nentries = nentries;
+  op->M[0] = M;   op->M[1] = N;   op->M[2] = P;
+  op->periodic[0] = bx == DM_BOUNDARY_PERIODIC ? PETSC_TRUE : PETSC_FALSE;
+  op->periodic[1] = by == DM_BOUNDARY_PERIODIC ? PETSC_TRUE : PETSC_FALSE;
+  op->periodic[2] = bz == DM_BOUNDARY_PERIODIC ? PETSC_TRUE : PETSC_FALSE;
+  op->s[0]  = xs;  op->s[1]  = ys;  op->s[2]  = zs;
+  op->e[0]  = xs+xm; op->e[1] = ys+ym; op->e[2] = zs+zm;
+  op->gs[0] = gxs; op->gs[1] = gys; op->gs[2] = gzs;
+  op->gm[0] = gxm; op->gm[1] = gym; op->gm[2] = gzm;
+  ierr = PetscMalloc2(nentries,&op->offsets,nentries,&op->loffsets);CHKERRQ(ierr);
+  ierr = PetscArraycpy(op->offsets,offsets,nentries);CHKERRQ(ierr);
+  for (e = 0; e < nentries; ++e) op->loffsets[e] = (op->offsets[e].k*gym + op->offsets[e].j)*gxm + op->offsets[e].i;
+  for (d = 0; d < 3; ++d) {
+    PetscInt omin = 0,omax = 0;
+
+    for (e = 0; e < nentries; ++e) {
+      const PetscInt o = d == 0 ? offsets[e].i : (d == 1 ? offsets[e].j : offsets[e].k);
+
+      omin = PetscMin(omin,o);
+      omax = PetscMax(omax,o);
+    }
+    if (op->periodic[d]) {
+      op->lo[d] = op->s[d];
+      op->hi[d] = op->e[d];
+    } else {
+      op->lo[d] = PetscMax(op->s[d],-omin);
+      op->hi[d] = PetscMax(op->lo[d],PetscMin(op->e[d],op->M[d]-omax));
+    }
+  }
+  /* Whole rows keep the inner loop long; in 3d blocking j keeps the planes touched by a tile in cache as k advances */
+  op->tile[0] = xm;
+  op->tile[1] = dim == 3 ? 8 : ym;
+  op->tile[2] = zm;
+  ierr = PetscOptionsGetIntArray(((PetscObject)da)->options,((PetscObject)da)->prefix,"-da_stencil_tile",op->tile,&ntile,&flg);CHKERRQ(ierr);
+  for (d = 0; d < 3; ++d) {
+    if (flg && d >= ntile) op->tile[d] = d == 0 ? xm : (d == 1 ? ym : zm);
+    op->tile[d] = PetscMax(op->tile[d],1);
+  }
+
+  ierr = MatCreateShell(PetscObjectComm((PetscObject)da),xm*ym*zm*dof,xm*ym*zm*dof,M*N*P*dof,M*N*P*dof,op,A);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(*A,dof);CHKERRQ(ierr);
+  ierr = MatSetDM(*A,da);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_MULT,(void (*)(void))MatMult_DMDAStencilOp);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_GET_DIAGONAL,(void (*)(void))MatGetDiagonal_DMDAStencilOp);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_CONVERT,(void (*)(void))MatConvert_DMDAStencilOp);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_DESTROY,(void (*)(void))MatDestroy_DMDAStencilOp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)*A,"DMDAStencilOperatorSetCoefficients_C",DMDAStencilOperatorSetCoefficients_DMDAStencilOp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)*A,"DMDAStencilOperatorGetCoefficientDM_C",DMDAStencilOperatorGetCoefficientDM_DMDAStencilOp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)*A,"DMDAStencilOperatorSetVariableCoefficients_C",DMDAStencilOperatorSetVariableCoefficients_DMDAStencilOp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMDAStencilOperatorSetCoefficients - Sets coefficients of a stencil operator that are the same at every grid point
+
+   Logically Collective on A
+
+   Input Parameters:
++  A      - the operator from DMDACreateStencilOperator()
+-  coeffs - the coefficients, nentries blocks of dof x dof values, each block stored by rows
+
+   Level: intermediate
+
+.seealso: DMDACreateStencilOperator(), DMDAStencilOperatorSetVariableCoefficients()
+@*/
+PetscErrorCode DMDAStencilOperatorSetCoefficients(Mat A,const PetscScalar coeffs[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidScalarPointer(coeffs,2);
+  ierr = PetscUseMethod(A,"DMDAStencilOperatorSetCoefficients_C",(Mat,const PetscScalar[]),(A,coeffs));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMDAStencilOperatorGetCoefficientDM - Gets the DMDA whose global vectors hold spatially varying coefficients of a stencil operator
+
+   Not Collective
+
+   Input Parameter:
+.  A - the operator from DMDACreateStencilOperator()
+
+   Output Parameter:
+.  cdm - a DMDA with the layout of the operator's DMDA and nentries*dof*dof components; owned by the operator, do not destroy
+
+   Notes:
+   Component (e*dof + r)*dof + c at a grid point is the coefficient coupling component r of that point to component c of
+   its neighbor at offset e.
+
+   Level: intermediate
+
+.seealso: DMDACreateStencilOperator(), DMDAStencilOperatorSetVariableCoefficients()
+@*/
+PetscErrorCode DMDAStencilOperatorGetCoefficientDM(Mat A,DM *cdm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidPointer(cdm,2);
+  ierr = PetscUseMethod(A,"DMDAStencilOperatorGetCoefficientDM_C",(Mat,DM*),(A,cdm));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMDAStencilOperatorSetVariableCoefficients - Sets spatially varying coefficients of a stencil operator
+
+   Logically Collective on A
+
+   Input Parameters:
++  A      - the operator from DMDACreateStencilOperator()
+-  coeffs - a global vector of the DMDA from DMDAStencilOperatorGetCoefficientDM()
+
+   Notes:
+   The vector is referenced, not copied, so later changes to its values are seen by the operator.
+
+   Level: intermediate
+
+.seealso: DMDACreateStencilOperator(), DMDAStencilOperatorGetCoefficientDM(), DMDAStencilOperatorSetCoefficients()
+@*/
+PetscErrorCode DMDAStencilOperatorSetVariableCoefficients(Mat A,Vec coeffs)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidHeaderSpecific(coeffs,VEC_CLASSID,2);
+  ierr = PetscUseMethod(A,"DMDAStencilOperatorSetVariableCoefficients_C",(Mat,Vec),(A,coeffs));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -227,3 +227,88 @@ PetscErrorCode  DMDAGetLocalInfo(DM da,DMDALocalInfo *info)
   info->gzm = (dd->Ze - dd->Zs);
   PetscFunctionReturn(0);
 }
+
+static void DMDALocalInfoSetBox_Private(const DMDALocalInfo *info,const PetscInt s[],const PetscInt e[],DMDALocalInfo *box)
+{
+  *box    = *info;
+  box->xs = s[0]; box->xm = e[0] - s[0];
+  box->ys = s[1]; box->ym = e[1] - s[1];
+  box->zs = s[2]; box->zm = e[2] - s[2];
+}
+
+/*@C
+   DMDAGetLocalInfoSplit - Splits the locally owned box of a distributed array into an interior box, whose stencils
+   reach no ghost points, and boundary slabs covering the remaining owned points
+
+   Not Collective
+
+   Input Parameter:
+.  da - the distributed array
+
+   Output Parameters:
++  interior  - the local info with xs,ys,zs,xm,ym,zm describing the interior box, which may be empty
+.  nboundary - the number of boundary slabs, at most 2*dim
+-  boundary  - the local infos of the boundary slabs, an array of at least 6 entries
+
+   Level: developer
+
+   Notes:
+   All fields other than the starts and widths are those of DMDAGetLocalInfo(), so a local function which only loops over
+   xs <= i < xs+xm (and likewise for j and k) computes on the given box. The interior box is the owned box shrunk by the
+   stencil width on every side that has ghost points; it can therefore be computed from the owned values of a local
+   vector while DMGlobalToLocalBegin()/DMGlobalToLocalEnd() are still filling the ghost points. The slabs are disjoint,
+   the larger ones (normal to the last direction) come first.
+
+.seealso: DMDAGetLocalInfo(), DMDASetLocalFunctionOverlap(), DMDAGlobalToLocalOwned()
+@*/
+PetscErrorCode DMDAGetLocalInfoSplit(DM da,DMDALocalInfo *interior,PetscInt *nboundary,DMDALocalInfo boundary[])
+{
+  DMDALocalInfo  info;
+  PetscInt       s[3],e[3],gs[3],ge[3],lo[3],hi[3],d,nb = 0;
+  PetscBool      empty = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidPointer(interior,2);
+  PetscValidIntPointer(nboundary,3);
+  PetscValidPointer(boundary,4);
+  ierr = DMDAGetLocalInfo(da,&info);CHKERRQ(ierr);
+  s[0]  = info.xs;  s[1]  = info.ys;  s[2]  = info.zs;
+  e[0]  = info.xs+info.xm;   e[1]  = info.ys+info.ym;   e[2]  = info.zs+info.zm;
+  gs[0] = info.gxs; gs[1] = info.gys; gs[2] = info.gzs;
+  ge[0] = info.gxs+info.gxm; ge[1] = info.gys+info.gym; ge[2] = info.gzs+info.gzm;
+  for (d = 0; d < 3; ++d) {
+    lo[d] = s[d] + (d < info.dim && gs[d] < s[d] ? info.sw : 0);
+    hi[d] = e[d] - (d < info.dim && ge[d] > e[d] ? info.sw : 0);
+    if (lo[d] >= hi[d]) empty = PETSC_TRUE;
+  }
+  if (empty) {
+    *interior    = info;
+    interior->xm = interior->ym = interior->zm = 0;
+    if (info.xm && info.ym && info.zm) boundary[nb++] = info;
+    *nboundary = nb;
+    PetscFunctionReturn(0);
+  }
+  for (d = info.dim-1; d >= 0; --d) {
+    if (lo[d] > s[d]) {
+      const PetscInt ed = e[d];
+
+      e[d] = lo[d];
+      DMDALocalInfoSetBox_Private(&info,s,e,&boundary[nb++]);
+      e[d] = ed;
+    }
+    if (hi[d] < e[d]) {
+      const PetscInt sd = s[d];
+
+      s[d] = hi[d];
+      DMDALocalInfoSetBox_Private(&info,s,e,&boundary[nb++]);
+      s[d] = sd;
+    }
+    s[d] = lo[d];
+    e[d] = hi[d];
+  }
+  DMDALocalInfoSetBox_Private(&info,s,e,interior);
+  *nboundary = nb;
+  PetscFunctionReturn(0);
+}
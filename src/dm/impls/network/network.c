@@ -170,389 +170,184 @@ PetscErrorCode DMNetworkAddSubnetwork(DM dm,const char* name,PetscInt nv,PetscIn
 }
 
 /*
-  SetUp a single svtx struct. See SVtx defined in dmnetworkimpl.h
-  Set gidx and type if input v=(net,idx) is a from_vertex;
-  Get gid, type and index in the svtx array if input v=(net,idx) is a to_vertex.
-
-  Input:  Nsvtx, svtx, net, idx, gidx
-  Output: gidx, svtype, svtx_idx
- */
-static PetscErrorCode SVtxSetUp(PetscInt Nsvtx,SVtx *svtx,PetscInt net,PetscInt idx,PetscInt *gidx,SVtxType *svtype,PetscInt *svtx_idx)
+  Returns the subnetwork that holds the un-merged global vertex index g, i.e., subnet[net].vStart <= g < subnet[net].vEnd
+*/
+PETSC_STATIC_INLINE PetscErrorCode DMNetworkGetSubnetFromVertex_private(DM_Network *network,PetscInt g,PetscInt *net)
 {
-  PetscInt i,j,*svto;
-  SVtxType vtype;
+  PetscInt lo = 0,hi = network->Nsubnet-1,mid;
 
   PetscFunctionBegin;
-  if (!Nsvtx) PetscFunctionReturn(0);
-
-  vtype = SVNONE;
-  for (i=0; i<Nsvtx; i++) {
-    if (net == svtx[i].sv[0] && idx == svtx[i].sv[1]) {
-      /* (1) input vertex net.idx is a shared from_vertex, set its global index and output its svtype */
-      svtx[i].gidx = *gidx; /* set gidx */
-      vtype        = SVFROM;
-    } else { /* loop over svtx[i].n */
-      for (j=1; j<svtx[i].n; j++) {
-        svto = svtx[i].sv + 2*j;
-        if (net == svto[0] && idx == svto[1]) {
-          /* input vertex net.idx is a shared to_vertex, output its global index and its svtype */
-          *gidx = svtx[i].gidx; /* output gidx for to_vertex */
-          vtype = SVTO;
-        }
-      }
-    }
-    if (vtype != SVNONE) break;
+  while (lo < hi) {
+    mid = (lo + hi + 1)/2;
+    if (network->subnet[mid].vStart <= g) lo = mid;
+    else hi = mid - 1;
   }
-  if (svtype)   *svtype   = vtype;
-  if (svtx_idx) *svtx_idx = i;
+  *net = lo;
   PetscFunctionReturn(0);
 }
 
 /*
- Add a new shared vertex sv=(net,idx) to table svtas[ita]
-*/
-static PetscErrorCode TableAddSVtx(PetscTable *svtas,PetscInt ita,PetscInt* tdata,PetscInt *sv_wk,PetscInt *ii,PetscInt *sedgelist,PetscInt k,DM_Network *network,PetscInt **ta2sv)
-{
-  PetscInt       net,idx,gidx,i=*ii;
-  PetscErrorCode ierr;
-
-  PetscFunctionBegin;
-  net = sv_wk[2*i]   = sedgelist[k];
-  idx = sv_wk[2*i+1] = sedgelist[k+1];
-  gidx = network->subnet[net].vStart + idx;
-  ierr = PetscTableAdd(svtas[ita],gidx+1,tdata[ita]+1,INSERT_VALUES);CHKERRQ(ierr);
-  *(ta2sv[ita] + tdata[ita]) = i; /* maps tdata to index of sv_wk; sv_wk keeps (net,idx) info */
-  tdata[ita]++; (*ii)++;
-  PetscFunctionReturn(0);
-}
+  Merge the shared vertices given by DMNetworkAddSharedVertices() and set up the table of shared vertices. See SVtx in dmnetworkimpl.h
 
-/*
-  Create an array of shared vertices. See SVtx and SVtxType in dmnetworkimpl.h
-
-  Input:  dm, Nsedgelist, sedgelist
-  Output: Nsvtx,svtx
-
-  Note: Output svtx is organized as
-        sv(net[0],idx[0]) --> sv(net[1],idx[1])
-                          --> sv(net[1],idx[1])
-                          ...
-                          --> sv(net[n-1],idx[n-1])
-        and net[0] < net[1] < ... < net[n-1]
-        where sv[0] has SVFROM type, sv[i], i>0, has SVTO type.
- */
-static PetscErrorCode SVtxCreate(DM dm,PetscInt Nsedgelist,PetscInt *sedgelist,PetscInt *Nsvtx,SVtx **svtx)
-{
-  PetscErrorCode ierr;
-  SVtx           *sedges = NULL;
-  PetscInt       *sv,k,j,nsv,*tdata,**ta2sv;
-  PetscTable     *svtas;
-  PetscInt       gidx,net,idx,i,nta,ita,idx_from,idx_to,n,*sv_wk;
-  DM_Network     *network = (DM_Network*)dm->data;
-  PetscTablePosition ppos;
+  Input:  dm, vmap - layout of the un-merged vertices, vertex g=subnet[net].vStart+idx is owned by the process holding g in vmap
+  Output: vmerged - global index of the merged network for each owned un-merged vertex
+          nto     - number of owned un-merged vertices that are merged into a vertex with a smaller index
 
-  PetscFunctionBegin;
-  /* (1) Crete ctables svtas */
-  ierr = PetscCalloc4(Nsedgelist,&svtas,Nsedgelist,&tdata,4*Nsedgelist,&sv_wk,2*Nsedgelist,&ta2sv);CHKERRQ(ierr);
-
-  j   = 0;   /* sedgelist counter */
-  k   = 0;   /* sedgelist vertex counter j = 4*k */
-  i   = 0;   /* sv_wk (vertices added to the ctables) counter */
-  nta = 0;   /* num of sv tables created */
-
-  /* for j=0 */
-  ierr = PetscTableCreate(2*Nsedgelist,network->NVertices+1,&svtas[nta]);CHKERRQ(ierr);
-  ierr = PetscMalloc1(2*Nsedgelist,&ta2sv[nta]);CHKERRQ(ierr);
-
-  ierr = TableAddSVtx(svtas,nta,tdata,sv_wk,&i,sedgelist,k,network,ta2sv);CHKERRQ(ierr);
-  ierr = TableAddSVtx(svtas,nta,tdata,sv_wk,&i,sedgelist,k+2,network,ta2sv);CHKERRQ(ierr);
-  nta++; k += 4;
-
-  for (j = 1; j < Nsedgelist; j++) {
-    for (ita = 0; ita < nta; ita++) {
-      /* vfrom */
-      net = sedgelist[k]; idx = sedgelist[k+1];
-      gidx = network->subnet[net].vStart + idx; /* global index of the vertex net.idx before merging shared vertices */
-      ierr = PetscTableFind(svtas[ita],gidx+1,&idx_from);CHKERRQ(ierr);
-
-      /* vto */
-      net = sedgelist[k+2]; idx = sedgelist[k+3];
-      gidx = network->subnet[net].vStart + idx;
-      ierr = PetscTableFind(svtas[ita],gidx+1,&idx_to);CHKERRQ(ierr);
-
-      if (idx_from || idx_to) { /* vfrom or vto is on table svtas[ita] */
-        idx_from--; idx_to--;
-        if (idx_from < 0) { /* vto is on svtas[ita] */
-          ierr = TableAddSVtx(svtas,ita,tdata,sv_wk,&i,sedgelist,k,network,ta2sv);CHKERRQ(ierr);
-          break;
-        } else if (idx_to < 0) {
-          ierr = TableAddSVtx(svtas,ita,tdata,sv_wk,&i,sedgelist,k+2,network,ta2sv);CHKERRQ(ierr);
-          break;
-        }
-      }
-    }
-
-    if (ita == nta) {
-      ierr = PetscTableCreate(2*Nsedgelist,network->NVertices+1,&svtas[nta]);CHKERRQ(ierr);
-      ierr = PetscMalloc1(2*Nsedgelist, &ta2sv[nta]);CHKERRQ(ierr);
-
-      ierr = TableAddSVtx(svtas,nta,tdata,sv_wk,&i,sedgelist,k,network,ta2sv);CHKERRQ(ierr);
-      ierr = TableAddSVtx(svtas,nta,tdata,sv_wk,&i,sedgelist,k+2,network,ta2sv);CHKERRQ(ierr);
-      nta++;
-    }
-    k += 4;
-  }
-
-  /* (2) Construct sedges from ctable
-     sedges: edges connect vertex sv[0]=(net[0],idx[0]) to vertices sv[k], k=1,...,n-1;
-     net[k], k=0, ...,n-1, are in ascending order */
-  ierr = PetscMalloc1(nta,&sedges);CHKERRQ(ierr);
-  for (nsv = 0; nsv < nta; nsv++) {
-    /* for a single svtx, put shared vertices in ascending order of gidx */
-    ierr = PetscTableGetCount(svtas[nsv],&n);CHKERRQ(ierr);
-    ierr = PetscCalloc1(2*n,&sv);CHKERRQ(ierr);
-    sedges[nsv].sv   = sv;
-    sedges[nsv].n    = n;
-    sedges[nsv].gidx = -1; /* initialization */
-
-    ierr = PetscTableGetHeadPosition(svtas[nsv],&ppos);CHKERRQ(ierr);
-    for (k=0; k<n; k++) { /* gidx is sorted in ascending order */
-      ierr = PetscTableGetNext(svtas[nsv],&ppos,&gidx,&i);CHKERRQ(ierr);
-      gidx--; i--;
-
-      j = ta2sv[nsv][i]; /* maps i to index of sv_wk */
-      sv[2*k]   = sv_wk[2*j];
-      sv[2*k+1] = sv_wk[2*j + 1];
-    }
-  }
-
-  for (j=0; j<nta; j++) {
-    ierr = PetscTableDestroy(&svtas[j]);CHKERRQ(ierr);
-    ierr = PetscFree(ta2sv[j]);CHKERRQ(ierr);
-  }
-  ierr = PetscFree4(svtas,tdata,sv_wk,ta2sv);CHKERRQ(ierr);
-
-  *Nsvtx = nta;
-  *svtx  = sedges;
-  PetscFunctionReturn(0);
-}
-
-static PetscErrorCode DMNetworkLayoutSetUp_Coupling(DM dm)
+  Notes:
+  Each process only holds the pairs it added. The pairs are sent to the owners of their vertices, where the groups of
+  vertices that are identified with each other (connected components of the pairs) are found by iteratively propagating
+  the smallest index of the group. The vertex with the smallest index in a group represents the group; the others are
+  merged into it and removed from the numbering. The owner of the representative collects the members of its group;
+  only the table of groups, O(number of shared vertices), is replicated on all processes.
+*/
+static PetscErrorCode DMNetworkSharedVerticesSetUp_private(DM dm,PetscLayout vmap,PetscInt *vmerged,PetscInt *nto)
 {
   PetscErrorCode ierr;
   DM_Network     *network = (DM_Network*)dm->data;
-  PetscInt       i,j,ctr,np,*edges,*subnetvtx,vStart;
-  PetscInt       k,*vidxlTog,Nsv=0,Nsubnet=network->Nsubnet;
-  PetscInt       *sedgelist=network->sedgelist;
-  const PetscInt *cone;
   MPI_Comm       comm;
-  PetscMPIInt    size,rank,*recvcounts=NULL,*displs=NULL;
-  PetscInt       net,idx,gidx,nmerged,e,v,vfrom,vto,*vrange,*eowners,gidx_from,net_from,sv_idx;
-  SVtxType       svtype = SVNONE;
-  SVtx           *svtx=NULL;
-  PetscSection   sectiong;
+  PetscMPIInt    size,rank,*recvcounts,*displs;
+  PetscSF        sf;
+  PetscInt       i,k,n,net,rstart,nroots=network->nVertices,npairs=network->nsedgelist,*sedgelist=network->sedgelist;
+  PetscInt       *pairidx,*rlabel,*rlabelold,*llabel,*ilocal,*iremote,*lmerged,*members,*sendbuf,*recvbuf;
+  PetscInt       nshared,nlocal,nmembers,nsend,nrecv,ngroups,offset,changed,nmerged;
+  const PetscInt *degree;
+  SVtx           *svtx;
 
   PetscFunctionBegin;
-  /* This implementation requires user input each subnet by a single processor, thus subnet[net].nvtx=subnet[net].Nvtx */
-  for (net=0; net<Nsubnet; net++) {
-    if (network->subnet[net].nvtx && network->subnet[net].nvtx != network->subnet[net].Nvtx) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_SUP,"subnetwork %D local num of vertices %D != %D global num",net,network->subnet[net].nvtx,network->subnet[net].Nvtx);
-  }
-
   ierr = PetscObjectGetComm((PetscObject)dm,&comm);CHKERRQ(ierr);
-  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
-  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
-
-  /* (1) Create svtx[] from sedgelist */
-  /* -------------------------------- */
-  /* Nsv: global number of SVtx; svtx: shared vertices, see SVtx in dmnetworkimpl.h */
-  ierr = SVtxCreate(dm,network->Nsvtx,sedgelist,&Nsv,&svtx);CHKERRQ(ierr);
-
-  /* (2) Setup svtx; Shared vto vertices are merged to their vfrom vertex with same global vetex index (gidx) */
-  /* -------------------------------------------------------------------------------------------------------- */
-  /* (2.1) compute vrage[rank]: global index of 1st local vertex in proc[rank] */
-  ierr = PetscMalloc3(size+1,&vrange,size,&displs,size,&recvcounts);CHKERRQ(ierr);
-  for (i=0; i<size; i++) {displs[i] = i; recvcounts[i] = 1;}
-
-  vrange[0] = 0;
-  ierr = MPI_Allgatherv(&network->nVertices,1,MPIU_INT,vrange+1,recvcounts,displs,MPIU_INT,comm);CHKERRMPI(ierr);
-  for (i=2; i<size+1; i++) {
-    vrange[i] += vrange[i-1];
-  }
-
-  /* (2.2) Create vidxlTog: maps UN-MERGED local vertex index i to global index gidx (plex, excluding ghost vertices) */
-  ierr = PetscMalloc1(network->nVertices,&vidxlTog);CHKERRQ(ierr);
-  i = 0; gidx = 0;
-  nmerged = 0; /* local num of merged vertices */
-  network->nsvtx = 0;
-  for (net=0; net<Nsubnet; net++) {
-    for (idx=0; idx<network->subnet[net].Nvtx; idx++) {
-      gidx_from = gidx;
-      sv_idx    = -1;
-
-      ierr = SVtxSetUp(Nsv,svtx,net,idx,&gidx_from,&svtype,&sv_idx);CHKERRQ(ierr);
-      if (svtype == SVTO) {
-        if (network->subnet[net].nvtx) {/* this proc owns sv_to */
-          net_from = svtx[sv_idx].sv[0]; /* subnet num of its shared vertex */
-          if (network->subnet[net_from].nvtx == 0) {
-            /* this proc does not own v_from, thus a new local coupling vertex */
-            network->nsvtx++;
-          }
-          vidxlTog[i++] = gidx_from;
-          nmerged++; /* a coupling vertex -- merged */
-        }
-      } else {
-        if (svtype == SVFROM) {
-          if (network->subnet[net].nvtx) {
-            /* this proc owns this v_from, a new local coupling vertex */
-            network->nsvtx++;
-          }
-        }
-        if (network->subnet[net].nvtx) vidxlTog[i++] = gidx;
-        gidx++;
-      }
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
+  ierr = PetscLayoutGetRange(vmap,&rstart,NULL);CHKERRQ(ierr);
+
+  /* (1) Send the local pairs (un-merged global vertex indices) to the owners of their vertices */
+  ierr = PetscMalloc1(2*npairs,&pairidx);CHKERRQ(ierr);
+  for (k=0; k<npairs; k++) {
+    pairidx[2*k]   = network->subnet[sedgelist[4*k]].vStart + sedgelist[4*k+1];
+    pairidx[2*k+1] = network->subnet[sedgelist[4*k+2]].vStart + sedgelist[4*k+3];
+  }
+  ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf,vmap,2*npairs,NULL,PETSC_OWN_POINTER,pairidx);CHKERRQ(ierr);
+  ierr = PetscFree(pairidx);CHKERRQ(ierr);
+
+  /* (2) Label each vertex with the smallest vertex index of its group until no label changes */
+  ierr = PetscMalloc3(nroots,&rlabel,nroots,&rlabelold,2*npairs,&llabel);CHKERRQ(ierr);
+  for (i=0; i<nroots; i++) rlabel[i] = rstart + i;
+  do {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,rlabel,llabel);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,rlabel,llabel);CHKERRQ(ierr);
+    for (k=0; k<npairs; k++) llabel[2*k] = llabel[2*k+1] = PetscMin(llabel[2*k],llabel[2*k+1]);
+    ierr = PetscArraycpy(rlabelold,rlabel,nroots);CHKERRQ(ierr);
+    ierr = PetscSFReduceBegin(sf,MPIU_INT,llabel,rlabel,MPI_MIN);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sf,MPIU_INT,llabel,rlabel,MPI_MIN);CHKERRQ(ierr);
+    for (changed=0,i=0; i<nroots; i++) {
+      if (rlabel[i] != rlabelold[i]) {changed = 1; break;}
     }
-  }
-#if defined(PETSC_USE_DEBUG)
-  if (i != network->nVertices) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_NULL,"%D != %D nVertices",i,network->nVertices);
-#endif
+    ierr = MPIU_Allreduce(MPI_IN_PLACE,&changed,1,MPIU_INT,MPI_MAX,comm);CHKERRMPI(ierr);
+  } while (changed);
 
-  /* (2.3) Setup svtable for querry shared vertices */
-  for (v=0; v<Nsv; v++) {
-    gidx = svtx[v].gidx;
-    ierr = PetscTableAdd(network->svtable,gidx+1,v+1,INSERT_VALUES);CHKERRQ(ierr);
-  }
-
-  /* (2.4) Shared vertices in the subnetworks are merged, update global NVertices: np = sum(local nmerged) */
-  ierr = MPI_Allreduce(&nmerged,&np,1,MPIU_INT,MPI_SUM,comm);CHKERRMPI(ierr);
-  network->NVertices -= np;
-
-  ierr = PetscCalloc1(2*network->nEdges,&edges);CHKERRQ(ierr);
-  ierr = PetscCalloc1(network->nVertices+network->nsvtx,&network->subnetvtx);CHKERRQ(ierr);
-
-  ctr = 0;
-  for (net=0; net<Nsubnet; net++) {
-    for (j = 0; j < network->subnet[net].nedge; j++) {
-      /* vfrom: */
-      i = network->subnet[net].edgelist[2*j] + (network->subnet[net].vStart - vrange[rank]);
-      edges[2*ctr] = vidxlTog[i];
-
-      /* vto */
-      i = network->subnet[net].edgelist[2*j+1] + (network->subnet[net].vStart - vrange[rank]);
-      edges[2*ctr+1] = vidxlTog[i];
-      ctr++;
+  /* The vertices referenced by a pair are shared; those not representing their group are merged */
+  ierr = PetscSFComputeDegreeBegin(sf,&degree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(sf,&degree);CHKERRQ(ierr);
+  nshared = 0; *nto = 0;
+  for (i=0; i<nroots; i++) {
+    if (!degree[i]) rlabel[i] = -1;
+    else {
+      nshared++;
+      if (rlabel[i] < rstart + i) (*nto)++;
     }
   }
-  ierr = PetscFree3(vrange,displs,recvcounts);CHKERRQ(ierr);
-  ierr = PetscFree(vidxlTog);CHKERRQ(ierr);
-
-  /* (3) Create network->plex */
-  ierr = DMCreate(comm,&network->plex);CHKERRQ(ierr);
-  ierr = DMSetType(network->plex,DMPLEX);CHKERRQ(ierr);
-  ierr = DMSetDimension(network->plex,1);CHKERRQ(ierr);
-  if (size == 1) {
-    ierr = DMPlexBuildFromCellList(network->plex,network->nEdges,network->nVertices-nmerged,2,edges);CHKERRQ(ierr);
-  } else {
-    ierr = DMPlexBuildFromCellListParallel(network->plex,network->nEdges,network->nVertices-nmerged,PETSC_DECIDE,2,edges,NULL);CHKERRQ(ierr);
-  }
-
-  ierr = DMPlexGetChart(network->plex,&network->pStart,&network->pEnd);CHKERRQ(ierr);
-  ierr = DMPlexGetHeightStratum(network->plex,0,&network->eStart,&network->eEnd);CHKERRQ(ierr);
-  ierr = DMPlexGetHeightStratum(network->plex,1,&network->vStart,&network->vEnd);CHKERRQ(ierr);
-  vStart = network->vStart;
-
-  ierr = PetscSectionCreate(comm,&network->DataSection);CHKERRQ(ierr);
-  ierr = PetscSectionCreate(comm,&network->DofSection);CHKERRQ(ierr);
-  ierr = PetscSectionSetChart(network->DataSection,network->pStart,network->pEnd);CHKERRQ(ierr);
-  ierr = PetscSectionSetChart(network->DofSection,network->pStart,network->pEnd);CHKERRQ(ierr);
-
-  network->dataheadersize = sizeof(struct _p_DMNetworkComponentHeader)/sizeof(DMNetworkComponentGenericDataType);
-  np = network->pEnd - network->pStart;
-  ierr = PetscCalloc2(np,&network->header,np,&network->cvalue);CHKERRQ(ierr);
-
-  /* (4) Create vidxlTog: maps MERGED plex local vertex index (including ghosts) to User's global vertex index (without merging shared vertices) */
-  np = network->vEnd - vStart; /* include ghost vertices */
-  ierr = PetscMalloc2(np,&vidxlTog,size+1,&eowners);CHKERRQ(ierr);
-
-  ctr = 0;
-  for (e=network->eStart; e<network->eEnd; e++) {
-    ierr = DMNetworkGetConnectedVertices(dm,e,&cone);CHKERRQ(ierr);
-    vidxlTog[cone[0] - vStart] = edges[2*ctr];
-    vidxlTog[cone[1] - vStart] = edges[2*ctr+1];
-    ctr++;
-  }
-  ierr = PetscFree(edges);CHKERRQ(ierr);
-
-  /* (5) Create vertices and edges array for the subnetworks */
-  subnetvtx = network->subnetvtx;
-  for (j=0; j < Nsubnet; j++) {
-    ierr = PetscCalloc1(network->subnet[j].nedge,&network->subnet[j].edges);CHKERRQ(ierr);
-    network->subnet[j].vertices = subnetvtx;
-    subnetvtx                  += network->subnet[j].nvtx;
-  }
-  network->svertices                = subnetvtx;
-
-  /* Get edge ownership */
-  np = network->eEnd - network->eStart; /* num of local edges */
-  ierr = MPI_Allgather(&np,1,MPIU_INT,eowners+1,1,MPIU_INT,comm);CHKERRMPI(ierr);
-  eowners[0] = 0;
-  for (i=2; i<=size; i++) eowners[i] += eowners[i-1];
-
-  e = 0;
-  for (i=0; i < Nsubnet; i++) {
-    v = 0;
-    for (j = 0; j < network->subnet[i].nedge; j++) {
-
-      /* edge e */
-      network->header[e].index    = e + eowners[rank]; /* Global edge index */
-      network->header[e].subnetid = i;                 /* Subnetwork id */
-      network->subnet[i].edges[j] = e;
-      network->header[e].ndata           = 0;
-      network->header[e].offset[0]       = 0;
-      network->header[e].offsetvarrel[0] = 0;
-      ierr = PetscSectionAddDof(network->DataSection,e,network->dataheadersize);CHKERRQ(ierr);
-
-      /* connected vertices */
-      ierr = DMPlexGetCone(network->plex,e,&cone);CHKERRQ(ierr);
-
-      /* vertex cone[0] */
-      vfrom = network->subnet[i].edgelist[2*v];
-      network->header[cone[0]].index = vidxlTog[cone[0]-vStart]; /*  Global vertex index */
-      network->header[cone[0]].subnetid = i;                     /* Subnetwork id */
-      network->subnet[i].vertices[vfrom] = cone[0];              /* user's subnet[].dix = petsc's v */
-
-      /* vertex cone[1] */
-      vto = network->subnet[i].edgelist[2*v+1];
-      network->header[cone[1]].index = vidxlTog[cone[1]-vStart]; /*  Global vertex index */
-      network->header[cone[1]].subnetid   = i;
-      network->subnet[i].vertices[vto]= cone[1];
-
-      e++; v++;
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+
+  /* (3) Number the merged vertices: the un-merged ordering with the merged vertices skipped */
+  ierr = MPI_Exscan(nto,&offset,1,MPIU_INT,MPI_SUM,comm);CHKERRMPI(ierr);
+  if (!rank) offset = 0;
+  for (n=0,i=0; i<nroots; i++) {
+    if (rlabel[i] >= 0 && rlabel[i] < rstart + i) {vmerged[i] = -1; n++;}
+    else vmerged[i] = rstart + i - offset - n;
+  }
+
+  /* Merged vertices take the index of their representative */
+  ierr = PetscMalloc3(nshared,&ilocal,nshared,&iremote,nshared,&lmerged);CHKERRQ(ierr);
+  for (n=0,i=0; i<nroots; i++) {
+    if (vmerged[i] < 0) {ilocal[n] = i; iremote[n++] = rlabel[i];}
+  }
+  ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf,vmap,*nto,NULL,PETSC_OWN_POINTER,iremote);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf,MPIU_INT,vmerged,lmerged);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf,MPIU_INT,vmerged,lmerged);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  for (k=0; k<*nto; k++) vmerged[ilocal[k]] = lmerged[k];
+
+  /* (4) Gather the members of each group at the owner of its representative */
+  for (n=0,i=0; i<nroots; i++) {
+    if (rlabel[i] >= 0) {ilocal[n] = rstart + i; iremote[n++] = rlabel[i];}
+  }
+  ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf,vmap,nshared,NULL,PETSC_OWN_POINTER,iremote);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeBegin(sf,&degree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(sf,&degree);CHKERRQ(ierr);
+  nlocal = nmembers = 0;
+  for (i=0; i<nroots; i++) {
+    if (degree[i]) {nlocal++; nmembers += degree[i];}
+  }
+  ierr = PetscMalloc1(nmembers,&members);CHKERRQ(ierr);
+  ierr = PetscSFGatherBegin(sf,MPIU_INT,ilocal,members);CHKERRQ(ierr);
+  ierr = PetscSFGatherEnd(sf,MPIU_INT,ilocal,members);CHKERRQ(ierr);
+
+  /* Pack the local groups as [gidx, n, (net, idx) x n] with the members in ascending order of their un-merged index */
+  nsend = 2*nlocal + 2*nmembers;
+  ierr = PetscMalloc1(nsend,&sendbuf);CHKERRQ(ierr);
+  for (n=0,k=0,i=0; i<nroots; i++) {
+    PetscInt j,*mb = members + k;
+
+    if (!degree[i]) continue;
+    ierr = PetscSortInt(degree[i],mb);CHKERRQ(ierr);
+    sendbuf[n++] = vmerged[i];
+    sendbuf[n++] = degree[i];
+    for (j=0; j<degree[i]; j++) {
+      ierr = DMNetworkGetSubnetFromVertex_private(network,mb[j],&net);CHKERRQ(ierr);
+      sendbuf[n++] = net;
+      sendbuf[n++] = mb[j] - network->subnet[net].vStart;
     }
-  }
-
-  /* Set vertex array for the subnetworks */
-  k = 0;
-  for (v=vStart; v<network->vEnd; v++) { /* local vertices, including ghosts */
-    network->header[v].ndata           = 0;
-    network->header[v].offset[0]       = 0;
-    network->header[v].offsetvarrel[0] = 0;
-    ierr = PetscSectionAddDof(network->DataSection,v,network->dataheadersize);CHKERRQ(ierr);
-
-    /* shared vertex */
-    ierr = PetscTableFind(network->svtable,vidxlTog[v-vStart]+1,&i);CHKERRQ(ierr);
-    if (i) network->svertices[k++] = v;
-  }
-#if defined(PETSC_USE_DEBUG)
-  if (k != network->nsvtx) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"k %D != %D nsvtx",k,network->nsvtx);
-#endif
-
-  ierr = PetscFree2(vidxlTog,eowners);CHKERRQ(ierr);
-
+    k += degree[i];
+  }
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree3(ilocal,iremote,lmerged);CHKERRQ(ierr);
+  ierr = PetscFree3(rlabel,rlabelold,llabel);CHKERRQ(ierr);
+  ierr = PetscFree(members);CHKERRQ(ierr);
+
+  /* (5) Replicate the table of shared vertices, ordered by the global index of the merged vertex */
+  ierr = PetscMalloc2(size,&recvcounts,size+1,&displs);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(nsend,&recvcounts[rank]);CHKERRQ(ierr);
+  ierr = MPI_Allgather(MPI_IN_PLACE,1,MPI_INT,recvcounts,1,MPI_INT,comm);CHKERRMPI(ierr);
+  displs[0] = 0;
+  for (i=0; i<size; i++) displs[i+1] = displs[i] + recvcounts[i];
+  nrecv = displs[size];
+  ierr = PetscMalloc1(nrecv,&recvbuf);CHKERRQ(ierr);
+  ierr = MPI_Allgatherv(sendbuf,recvcounts[rank],MPIU_INT,recvbuf,recvcounts,displs,MPIU_INT,comm);CHKERRMPI(ierr);
+  ierr = PetscFree2(recvcounts,displs);CHKERRQ(ierr);
+  ierr = PetscFree(sendbuf);CHKERRQ(ierr);
+
+  for (ngroups=0,n=0; n<nrecv; ngroups++) n += 2 + 2*recvbuf[n+1];
+  ierr = PetscMalloc1(ngroups,&svtx);CHKERRQ(ierr);
+  for (k=0,n=0; k<ngroups; k++) {
+    svtx[k].gidx = recvbuf[n];
+    svtx[k].n    = recvbuf[n+1];
+    ierr = PetscMalloc1(2*svtx[k].n,&svtx[k].sv);CHKERRQ(ierr);
+    ierr = PetscArraycpy(svtx[k].sv,recvbuf+n+2,2*svtx[k].n);CHKERRQ(ierr);
+    ierr = PetscTableAdd(network->svtable,svtx[k].gidx+1,k+1,INSERT_VALUES);CHKERRQ(ierr);
+    n += 2 + 2*svtx[k].n;
+  }
+  ierr = PetscFree(recvbuf);CHKERRQ(ierr);
   network->svtx  = svtx;
-  network->Nsvtx = Nsv;
-  ierr = PetscFree(sedgelist);CHKERRQ(ierr);
+  network->Nsvtx = ngroups;
 
-  /* Create a global section to be used by DMNetworkIsGhostVertex() which is a non-collective routine */
-  ierr = DMGetGlobalSection(network->plex,&sectiong);CHKERRQ(ierr);
+  /* Shared vertices in the subnetworks are merged, update global NVertices */
+  ierr = MPIU_Allreduce(nto,&nmerged,1,MPIU_INT,MPI_SUM,comm);CHKERRMPI(ierr);
+  network->NVertices -= nmerged;
+
+  ierr = PetscFree(network->sedgelist);CHKERRQ(ierr);
+  network->nsedgelist = network->maxsedgelist = 0;
   PetscFunctionReturn(0);
 }
 
@@ -570,37 +365,54 @@ static PetscErrorCode DMNetworkLayoutSetUp_Coupling(DM dm)
 
   All the components should be registered before calling this routine.
 
+  Each process provides only its own part of the edges and of the shared vertices. No process gathers the
+  whole network; the shared vertices are merged through a star forest (PetscSF) rendezvous with the processes
+  owning the vertices.
+
   Level: beginner
 
-.seealso: DMNetworkSetNumSubNetworks(), DMNetworkAddSubnetwork()
+.seealso: DMNetworkSetNumSubNetworks(), DMNetworkAddSubnetwork(), DMNetworkAddSharedVertices()
 @*/
 PetscErrorCode DMNetworkLayoutSetUp(DM dm)
 {
   PetscErrorCode ierr;
   DM_Network     *network = (DM_Network*)dm->data;
-  PetscInt       i,j,ctr,Nsubnet=network->Nsubnet,*eowners,np,*edges,*subnetvtx;
-  PetscInt       e,v,vfrom,vto;
+  PetscInt       i,j,k,ctr,Nsubnet=network->Nsubnet,np,*edges,*subnetvtx,*vmerged,*vidx,*vidxsub,*vsub;
+  PetscInt       e,v,nto=0,coupling,estart,nvtx;
   const PetscInt *cone;
   MPI_Comm       comm;
   PetscMPIInt    size,rank;
+  PetscLayout    vmap;
+  PetscSF        sf;
+  PetscSection   sectiong;
 
   PetscFunctionBegin;
   if (network->nsubnet != network->Nsubnet) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Must call DMNetworkAddSubnetwork() %D times",network->Nsubnet);
 
-  /* Create svtable for querry shared vertices */
-  ierr = PetscTableCreate(network->Nsvtx,network->NVertices+1,&network->svtable);CHKERRQ(ierr);
-
-  if (network->Nsvtx) {
-    ierr = DMNetworkLayoutSetUp_Coupling(dm);CHKERRQ(ierr);
-    PetscFunctionReturn(0);
-  }
-
   ierr = PetscObjectGetComm((PetscObject)dm,&comm);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm,&rank);CHKERRMPI(ierr);
   ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
 
+  /* Create svtable for querry shared vertices */
+  ierr = PetscTableCreate(network->nsedgelist,network->NVertices+1,&network->svtable);CHKERRQ(ierr);
+
+  /* The un-merged vertex subnet[net].vStart+idx is owned by the process holding it in vmap, i.e., the vertices are
+     distributed as the user provided their local numbers */
+  ierr = PetscLayoutCreate(comm,&vmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(vmap,network->nVertices);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(vmap,1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(vmap);CHKERRQ(ierr);
+
+  /* Merge the shared vertices */
+  coupling = network->nsedgelist;
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&coupling,1,MPIU_INT,MPI_MAX,comm);CHKERRMPI(ierr);
+  ierr = PetscMalloc1(network->nVertices,&vmerged);CHKERRQ(ierr);
+  if (coupling) {
+    ierr = DMNetworkSharedVerticesSetUp_private(dm,vmap,vmerged,&nto);CHKERRQ(ierr);
+  }
+
   /* Create LOCAL edgelist for the network by concatenating local input edgelists of the subnetworks */
-  ierr = PetscCalloc1(2*network->nEdges,&edges);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*network->nEdges,&edges);CHKERRQ(ierr);
   ctr = 0;
   for (i=0; i < Nsubnet; i++) {
     for (j = 0; j < network->subnet[i].nedge; j++) {
@@ -610,16 +422,26 @@ PetscErrorCode DMNetworkLayoutSetUp(DM dm)
     }
   }
 
+  /* Map the vertices of the edges to the merged network from the owners of the vertices */
+  if (coupling) {
+    ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sf,vmap,2*network->nEdges,NULL,PETSC_OWN_POINTER,edges);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,vmerged,edges);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,vmerged,edges);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(vmerged);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&vmap);CHKERRQ(ierr);
+
   /* Create network->plex; One dimensional network, numCorners=2 */
   ierr = DMCreate(comm,&network->plex);CHKERRQ(ierr);
   ierr = DMSetType(network->plex,DMPLEX);CHKERRQ(ierr);
   ierr = DMSetDimension(network->plex,1);CHKERRQ(ierr);
   if (size == 1) {
-    ierr = DMPlexBuildFromCellList(network->plex,network->nEdges,network->nVertices,2,edges);CHKERRQ(ierr);
+    ierr = DMPlexBuildFromCellList(network->plex,network->nEdges,network->nVertices-nto,2,edges);CHKERRQ(ierr);
   } else {
-    ierr = DMPlexBuildFromCellListParallel(network->plex,network->nEdges,network->nVertices,PETSC_DECIDE,2,edges,NULL);CHKERRQ(ierr);
+    ierr = DMPlexBuildFromCellListParallel(network->plex,network->nEdges,network->nVertices-nto,PETSC_DECIDE,2,edges,NULL);CHKERRQ(ierr);
   }
-  ierr = PetscFree(edges);CHKERRQ(ierr); /* local edge list with global idx used by DMPlexBuildFromCellList() */
 
   ierr = DMPlexGetChart(network->plex,&network->pStart,&network->pEnd);CHKERRQ(ierr);
   ierr = DMPlexGetHeightStratum(network->plex,0,&network->eStart,&network->eEnd);CHKERRQ(ierr);
@@ -634,41 +456,30 @@ PetscErrorCode DMNetworkLayoutSetUp(DM dm)
   np = network->pEnd - network->pStart;
   ierr = PetscCalloc2(np,&network->header,np,&network->cvalue);CHKERRQ(ierr);
 
-  /* Create edge and vertex arrays for the subnetworks */
-  for (j=0; j < network->Nsubnet; j++) {
-    ierr = PetscCalloc1(network->subnet[j].nedge,&network->subnet[j].edges);CHKERRQ(ierr);
+  /* Global vertex index of the local plex vertices (including ghosts), read off the cones of the local edges */
+  np = network->vEnd - network->vStart;
+  ierr = PetscMalloc1(np,&vidx);CHKERRQ(ierr);
+  for (v=0; v<np; v++) vidx[v] = (size == 1) ? v : -1; /* vertices not covered by any edge exist only in serial */
+  for (e=network->eStart; e<network->eEnd; e++) {
+    ierr = DMPlexGetCone(network->plex,e,&cone);CHKERRQ(ierr);
+    vidx[cone[0]-network->vStart] = edges[2*(e-network->eStart)];
+    vidx[cone[1]-network->vStart] = edges[2*(e-network->eStart)+1];
   }
+  ierr = PetscFree(edges);CHKERRQ(ierr);
 
   /* Get edge ownership */
-  ierr = PetscMalloc1(size+1,&eowners);CHKERRQ(ierr);
   np = network->eEnd - network->eStart;
-  ierr = MPI_Allgather(&np,1,MPIU_INT,eowners+1,1,MPIU_INT,comm);CHKERRMPI(ierr);
-  eowners[0] = 0;
-  for (i=2; i<=size; i++) eowners[i] += eowners[i-1];
-
-  /* Set network->subnet[*].vertices on array network->subnetvtx */
-  np = 0;
-  for (j=0; j<network->Nsubnet; j++) {
-    /* sum up subnet[j].Nvtx instead of subnet[j].nvtx, because a subnet might be owned by more than one processor;
-       below, subnet[i].vertices[vfrom/vto] requires vfrom/vto =0, ...,Nvtx-1
-     */
-    if (network->subnet[j].nvtx) np += network->subnet[j].Nvtx;
-  }
-
-  ierr = PetscCalloc1(np,&network->subnetvtx);CHKERRQ(ierr); /* Maps local vertex to local subnetwork's vertex */
-  subnetvtx = network->subnetvtx;
-  for (j=0; j<network->Nsubnet; j++) {
-    network->subnet[j].vertices = subnetvtx;
-    if (network->subnet[j].nvtx) subnetvtx += network->subnet[j].Nvtx;
-  }
+  ierr = MPI_Exscan(&np,&estart,1,MPIU_INT,MPI_SUM,comm);CHKERRMPI(ierr);
+  if (!rank) estart = 0;
 
-  /* Setup edge and vertex arrays for subnetworks */
+  /* Setup edge arrays for subnetworks and collect the (subnet index, plex vertex) of the edge endpoints */
+  ierr = PetscMalloc2(2*network->nEdges,&vidxsub,2*network->nEdges,&vsub);CHKERRQ(ierr);
   e = 0;
   for (i=0; i < Nsubnet; i++) {
-    v = 0;
+    ierr = PetscCalloc1(network->subnet[i].nedge,&network->subnet[i].edges);CHKERRQ(ierr);
     for (j = 0; j < network->subnet[i].nedge; j++) {
       /* edge e */
-      network->header[e].index    = e + eowners[rank];   /* Global edge index */
+      network->header[e].index    = e + estart;   /* Global edge index */
       network->header[e].subnetid = i;
       network->subnet[i].edges[j] = e;
 
@@ -679,29 +490,65 @@ PetscErrorCode DMNetworkLayoutSetUp(DM dm)
 
       /* connected vertices */
       ierr = DMPlexGetCone(network->plex,e,&cone);CHKERRQ(ierr);
+      for (k=0; k<2; k++) {
+        network->header[cone[k]].index    = vidx[cone[k]-network->vStart]; /* Global vertex index */
+        network->header[cone[k]].subnetid = i;                             /* Subnetwork id */
+        vidxsub[2*e+k] = network->subnet[i].edgelist[2*j+k];               /* user's subnet[].idx */
+        vsub[2*e+k]    = cone[k];                                          /* petsc's v */
+      }
+      e++;
+    }
+  }
 
-      /* vertex cone[0] */
-      vfrom = network->subnet[i].edgelist[2*v];     /* =subnet[i].idx, Global index! */
-      network->header[cone[0]].index     = vfrom + network->subnet[i].vStart; /* Global vertex index */
-      network->header[cone[0]].subnetid  = i;       /* Subnetwork id */
-      network->subnet[i].vertices[vfrom] = cone[0]; /* user's subnet[].dix = petsc's v */
-
-      /* vertex cone[1] */
-      vto   = network->subnet[i].edgelist[2*v+1];   /* =subnet[i].idx, Global index! */
-      network->header[cone[1]].index    = vto + network->subnet[i].vStart;  /* Global vertex index */
-      network->header[cone[1]].subnetid = i;
-      network->subnet[i].vertices[vto]  = cone[1];  /* user's subnet[].dix = petsc's v */
+  /* Local vertices of each subnetwork, sorted by the user's subnet[].idx */
+  np = 0;
+  for (i=0; i < Nsubnet; i++) {
+    nvtx = 2*network->subnet[i].nedge;
+    ierr = PetscSortIntWithArray(nvtx,vidxsub+2*network->subnet[i].eStart,vsub+2*network->subnet[i].eStart);CHKERRQ(ierr);
+    for (k=0,j=0; j<nvtx; j++) {
+      if (j && vidxsub[2*network->subnet[i].eStart+j] == vidxsub[2*network->subnet[i].eStart+j-1]) continue;
+      vsub[2*network->subnet[i].eStart+k++] = vsub[2*network->subnet[i].eStart+j];
+    }
+    network->subnet[i].nvtx = k;
+    np += k;
+  }
 
-      e++; v++;
+  /* Local shared vertices, including ghosts */
+  network->nsvtx = 0;
+  if (network->Nsvtx) {
+    for (v=0; v<network->vEnd-network->vStart; v++) {
+      ierr = PetscTableFind(network->svtable,vidx[v]+1,&k);CHKERRQ(ierr);
+      if (k) network->nsvtx++;
     }
   }
-  ierr = PetscFree(eowners);CHKERRQ(ierr);
 
+  ierr = PetscMalloc1(np+network->nsvtx,&network->subnetvtx);CHKERRQ(ierr); /* Maps local vertex to local subnetwork's vertex */
+  subnetvtx = network->subnetvtx;
+  for (i=0; i<Nsubnet; i++) {
+    network->subnet[i].vertices = subnetvtx;
+    ierr = PetscArraycpy(subnetvtx,vsub+2*network->subnet[i].eStart,network->subnet[i].nvtx);CHKERRQ(ierr);
+    subnetvtx += network->subnet[i].nvtx;
+  }
+  network->svertices = subnetvtx;
+  ierr = PetscFree2(vidxsub,vsub);CHKERRQ(ierr);
+
+  k = 0;
   for (v = network->vStart; v < network->vEnd; v++) {
     network->header[v].ndata           = 0;
     network->header[v].offset[0]       = 0;
     network->header[v].offsetvarrel[0] = 0;
     ierr = PetscSectionAddDof(network->DataSection,v,network->dataheadersize);CHKERRQ(ierr);
+
+    if (network->Nsvtx) {
+      ierr = PetscTableFind(network->svtable,vidx[v-network->vStart]+1,&i);CHKERRQ(ierr);
+      if (i) network->svertices[k++] = v;
+    }
+  }
+  ierr = PetscFree(vidx);CHKERRQ(ierr);
+
+  if (coupling) {
+    /* Create a global section to be used by DMNetworkIsGhostVertex() which is a non-collective routine */
+    ierr = DMGetGlobalSection(network->plex,&sectiong);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -724,6 +571,9 @@ PetscErrorCode DMNetworkLayoutSetUp(DM dm)
   Notes:
   Cannot call this routine before DMNetworkLayoutSetup()
 
+  The local vertices are those connected to the local edges, including ghost and shared vertices. Before
+  DMNetworkDistribute() they are sorted by the vertex index in the subnetwork given in the edgelist.
+
   Level: intermediate
 
 .seealso: DMNetworkCreate(), DMNetworkAddSubnetwork(), DMNetworkLayoutSetUp()
@@ -744,7 +594,7 @@ PetscErrorCode DMNetworkGetSubnetwork(DM dm,PetscInt netnum,PetscInt *nv,PetscIn
 /*@
   DMNetworkAddSharedVertices - Add shared vertices that connect two given subnetworks
 
-  Collective on dm
+  Not collective
 
   Input Parameters:
 + dm - the dm object
@@ -754,6 +604,11 @@ PetscErrorCode DMNetworkGetSubnetwork(DM dm,PetscInt netnum,PetscInt *nv,PetscIn
 . asvtx - vertex index in the first subnetwork
 - bsvtx - vertex index in the second subnetwork
 
+  Notes:
+  A pair of shared vertices needs to be added by only one process, usually the one that holds the edges
+  touching them; the same pair may also be added by several processes. Chains of pairs are merged, e.g.,
+  pairs (a,b) and (b,c) make a, b and c a single vertex of the network.
+
   Level: beginner
 
 .seealso: DMNetworkCreate(), DMNetworkAddSubnetwork(), DMNetworkGetSharedVertices()
@@ -762,24 +617,32 @@ PetscErrorCode DMNetworkAddSharedVertices(DM dm,PetscInt anetnum,PetscInt bnetnu
 {
   PetscErrorCode ierr;
   DM_Network     *network = (DM_Network*)dm->data;
-  PetscInt       i,nsubnet = network->Nsubnet,*sedgelist,Nsvtx=network->Nsvtx;
+  PetscInt       i,*sedgelist,n = network->nsedgelist;
 
   PetscFunctionBegin;
-  if (anetnum == bnetnum) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_USER,"Subnetworks must have different netnum");
-  if (anetnum < 0 || bnetnum < 0) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_USER,"netnum cannot be negative");
-  if (!Nsvtx) {
-    /* allocate network->sedgelist to hold at most 2*nsubnet pairs of shared vertices */
-    ierr = PetscMalloc1(2*4*nsubnet,&network->sedgelist);CHKERRQ(ierr);
+  if (anetnum == bnetnum) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Subnetworks must have different netnum");
+  if (anetnum < 0 || bnetnum < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"netnum cannot be negative");
+  if (anetnum >= network->nsubnet || bnetnum >= network->nsubnet) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"netnum must be a subnetwork added by DMNetworkAddSubnetwork(), currently %D",network->nsubnet);
+  if (network->plex) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Must be called before DMNetworkLayoutSetUp()");
+
+  if (n + nsvtx > network->maxsedgelist) {
+    /* grow network->sedgelist geometrically, 4 entries per pair of shared vertices */
+    network->maxsedgelist = PetscMax(2*network->maxsedgelist,n + nsvtx);
+    ierr = PetscMalloc1(4*network->maxsedgelist,&sedgelist);CHKERRQ(ierr);
+    ierr = PetscArraycpy(sedgelist,network->sedgelist,4*n);CHKERRQ(ierr);
+    ierr = PetscFree(network->sedgelist);CHKERRQ(ierr);
+    network->sedgelist = sedgelist;
   }
 
   sedgelist = network->sedgelist;
   for (i=0; i<nsvtx; i++) {
-    sedgelist[4*Nsvtx]   = anetnum; sedgelist[4*Nsvtx+1] = asvtx[i];
-    sedgelist[4*Nsvtx+2] = bnetnum; sedgelist[4*Nsvtx+3] = bsvtx[i];
-    Nsvtx++;
+    if (asvtx[i] < 0 || asvtx[i] >= network->subnet[anetnum].Nvtx) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Vertex %D is not in subnetwork %D with %D vertices",asvtx[i],anetnum,network->subnet[anetnum].Nvtx);
+    if (bsvtx[i] < 0 || bsvtx[i] >= network->subnet[bnetnum].Nvtx) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Vertex %D is not in subnetwork %D with %D vertices",bsvtx[i],bnetnum,network->subnet[bnetnum].Nvtx);
+    sedgelist[4*n]   = anetnum; sedgelist[4*n+1] = asvtx[i];
+    sedgelist[4*n+2] = bnetnum; sedgelist[4*n+3] = bsvtx[i];
+    n++;
   }
-  if (Nsvtx > 2*nsubnet) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"allocate more space for coupling edgelist");
-  network->Nsvtx = Nsvtx;
+  network->nsedgelist = n;
   PetscFunctionReturn(0);
 }
 
@@ -858,7 +721,9 @@ PetscErrorCode DMNetworkRegisterComponent(DM dm,const char *name,size_t size,Pet
   }
 
   ierr = PetscStrcpy(component->name,name);CHKERRQ(ierr);
-  component->size = size/sizeof(DMNetworkComponentGenericDataType);
+  /* Round up so that no byte of the component is dropped; the padding is zero */
+  component->size  = (size+sizeof(DMNetworkComponentGenericDataType)-1)/sizeof(DMNetworkComponentGenericDataType);
+  component->bytes = size;
   *key = network->ncomponent;
   network->ncomponent++;
   PetscFunctionReturn(0);
@@ -1228,8 +1093,13 @@ PetscErrorCode DMNetworkGetComponent(DM dm,PetscInt p,PetscInt compnum,PetscInt
   if (compnum >= 0) {
     if (compkey) *compkey = header->key[compnum];
     if (component) {
-      offset += network->dataheadersize+header->offset[compnum];
-      *component = network->componentdataarray+offset;
+      if (network->batchpos) { /* the components are stored grouped by key */
+        PetscInt key = header->key[compnum];
+        *component = network->batch[key].data + network->component[key].size*network->batchpos[network->batchptr[p-network->pStart]+compnum];
+      } else {
+        offset += network->dataheadersize+header->offset[compnum];
+        *component = network->componentdataarray+offset;
+      }
     }
   }
 
@@ -1237,6 +1107,237 @@ PetscErrorCode DMNetworkGetComponent(DM dm,PetscInt p,PetscInt compnum,PetscInt
   PetscFunctionReturn(0);
 }
 
+/*@
+  DMNetworkSetComponentBatching - Sets whether the components are stored grouped by their key
+
+  Logically Collective on dm
+
+  Input Parameters:
++ dm - the DMNetwork object
+- flg - PETSC_TRUE to store the components of each key in one contiguous array
+
+  Options Database Key:
+. -dmnetwork_component_batching - store the components grouped by key
+
+  Notes:
+  Must be called before DMSetUp(). With batching, DMSetUp() and DMNetworkDistribute() copy the local components of each
+  key into one contiguous array, with the points holding them and the local vector offsets and numbers of their variables
+  in separate arrays. DMNetworkGetComponent() then returns the component in this array, and DMNetworkGetComponentBatch()
+  and DMNetworkComponentBatchApply() give access to all the components of a key at once, so that residual and Jacobian
+  evaluations can loop over components of the same type without per-point lookups.
+
+  Level: intermediate
+
+.seealso: DMNetworkGetComponentBatch(), DMNetworkComponentBatchApply(), DMNetworkGetComponent()
+@*/
+PetscErrorCode DMNetworkSetComponentBatching(DM dm,PetscBool flg)
+{
+  DM_Network *network = (DM_Network*)dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  PetscValidLogicalCollectiveBool(dm,flg,2);
+  if (dm->setupcalled) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_WRONGSTATE,"Must be called before DMSetUp()");
+  network->batching = flg;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMNetworkComponentBatchDestroy_private(DM_Network *network)
+{
+  PetscErrorCode ierr;
+  PetscInt       key;
+
+  PetscFunctionBegin;
+  for (key=0; key<MAX_COMPONENTS; key++) {
+    DMNetworkComponentBatch *batch = &network->batch[key];
+
+    ierr = PetscFree4(batch->points,batch->offset,batch->nvar,batch->data);CHKERRQ(ierr);
+    batch->n = 0;
+  }
+  ierr = PetscFree2(network->batchptr,network->batchpos);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Copy the local components of each key from componentdataarray into a contiguous batch; requires the local section of the plex
+*/
+static PetscErrorCode DMNetworkComponentBatchSetUp_private(DM dm)
+{
+  PetscErrorCode           ierr;
+  DM_Network               *network = (DM_Network*)dm->data;
+  PetscInt                 p,i,k,key,offsetd,offsetp,np = network->pEnd - network->pStart,*batchptr;
+  PetscSection             section;
+  DMNetworkComponentHeader header;
+  DMNetworkComponentBatch  *batch;
+
+  PetscFunctionBegin;
+  ierr = DMNetworkComponentBatchDestroy_private(network);CHKERRQ(ierr);
+  ierr = DMGetLocalSection(network->plex,&section);CHKERRQ(ierr);
+
+  /* Count the components of each key */
+  ierr = PetscMalloc1(np+1,&batchptr);CHKERRQ(ierr);
+  batchptr[0] = 0;
+  for (p=network->pStart; p<network->pEnd; p++) {
+    ierr = PetscSectionGetOffset(network->DataSection,p,&offsetd);CHKERRQ(ierr);
+    header = (DMNetworkComponentHeader)(network->componentdataarray+offsetd);
+    batchptr[p-network->pStart+1] = batchptr[p-network->pStart] + header->ndata;
+    for (i=0; i<header->ndata; i++) network->batch[header->key[i]].n++;
+  }
+  ierr = PetscMalloc2(np+1,&network->batchptr,batchptr[np],&network->batchpos);CHKERRQ(ierr);
+  ierr = PetscArraycpy(network->batchptr,batchptr,np+1);CHKERRQ(ierr);
+  ierr = PetscFree(batchptr);CHKERRQ(ierr);
+
+  for (key=0; key<network->ncomponent; key++) {
+    batch = &network->batch[key];
+    ierr = PetscMalloc4(batch->n,&batch->points,batch->n,&batch->offset,batch->n,&batch->nvar,batch->n*network->component[key].size,&batch->data);CHKERRQ(ierr);
+    batch->n = 0;
+  }
+
+  /* Copy the components and their variable info in order of the points */
+  for (p=network->pStart; p<network->pEnd; p++) {
+    ierr = PetscSectionGetOffset(network->DataSection,p,&offsetd);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(section,p,&offsetp);CHKERRQ(ierr);
+    header = (DMNetworkComponentHeader)(network->componentdataarray+offsetd);
+    for (i=0; i<header->ndata; i++) {
+      key   = header->key[i];
+      batch = &network->batch[key];
+      k     = batch->n++;
+      batch->points[k] = p;
+      batch->offset[k] = offsetp + header->offsetvarrel[i];
+      batch->nvar[k]   = header->nvar[i];
+      ierr = PetscArraycpy(batch->data+k*network->component[key].size,network->componentdataarray+offsetd+network->dataheadersize+header->offset[i],network->component[key].size);CHKERRQ(ierr);
+      network->batchpos[network->batchptr[p-network->pStart]+i] = k;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  Copy the batched components back into componentdataarray, e.g., before it is distributed
+*/
+static PetscErrorCode DMNetworkComponentBatchRestore_private(DM dm)
+{
+  PetscErrorCode           ierr;
+  DM_Network               *network = (DM_Network*)dm->data;
+  PetscInt                 p,i,key,offsetd;
+  DMNetworkComponentHeader header;
+
+  PetscFunctionBegin;
+  if (!network->batchpos) PetscFunctionReturn(0);
+  for (p=network->pStart; p<network->pEnd; p++) {
+    ierr = PetscSectionGetOffset(network->DataSection,p,&offsetd);CHKERRQ(ierr);
+    header = (DMNetworkComponentHeader)(network->componentdataarray+offsetd);
+    for (i=0; i<header->ndata; i++) {
+      key  = header->key[i];
+      ierr = PetscArraycpy(network->componentdataarray+offsetd+network->dataheadersize+header->offset[i],network->batch[key].data+network->component[key].size*network->batchpos[network->batchptr[p-network->pStart]+i],network->component[key].size);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  DMNetworkGetComponentBatch - Gets all the local components with a given key, stored contiguously
+
+  Not Collective
+
+  Input Parameters:
++ dm - the DMNetwork object
+- key - the key obtained when registering the component
+
+  Output Parameters:
++ n - number of local components with this key
+. points - the network points (edges, then vertices, including ghost vertices) holding the components
+. components - the components, n consecutive blocks whose stride is the size given to DMNetworkRegisterComponent() rounded up to a multiple of sizeof(PetscInt)
+. offsets - local vector offset of the first variable of each component
+- nvar - number of variables of each component
+
+  Notes:
+  Requires DMNetworkSetComponentBatching() and DMSetUp(). The stride equals the size of a component struct holding a
+  PetscInt, PetscReal, or PetscScalar, so components can then be indexed as an array of that struct. A point holding
+  several components of the same key appears once for each of them. The arrays are owned by the DMNetwork; changes to the components are seen by DMNetworkGetComponent().
+
+  Level: intermediate
+
+.seealso: DMNetworkSetComponentBatching(), DMNetworkComponentBatchApply(), DMNetworkGetComponent(), DMNetworkGetLocalVecOffset()
+@*/
+PetscErrorCode DMNetworkGetComponentBatch(DM dm,PetscInt key,PetscInt *n,const PetscInt **points,void **components,const PetscInt **offsets,const PetscInt **nvar)
+{
+  DM_Network              *network = (DM_Network*)dm->data;
+  DMNetworkComponentBatch *batch;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  if (!network->batchpos) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call DMNetworkSetComponentBatching() and DMSetUp() first");
+  if (key < 0 || key >= network->ncomponent) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Component key %D is not in [0,%D)",key,network->ncomponent);
+  batch = &network->batch[key];
+  if (n)          *n          = batch->n;
+  if (points)     *points     = batch->points;
+  if (components) *components = batch->data;
+  if (offsets)    *offsets    = batch->offset;
+  if (nvar)       *nvar       = batch->nvar;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  DMNetworkComponentBatchApply - Calls a function on batches of local components of the same key
+
+  Not Collective
+
+  Input Parameters:
++ dm - the DMNetwork object
+. key - the key obtained when registering the component, or ALL_COMPONENTS for every registered key in turn
+. bs - the maximum number of components in a batch, or PETSC_DECIDE to pass all the local components of a key at once
+. f - the function
+- ctx - optional user context passed to f
+
+  Calling sequence of f:
+$ PetscErrorCode f(DM dm,PetscInt key,PetscInt n,const PetscInt points[],void *components,const PetscInt offsets[],const PetscInt nvar[],void *ctx)
++ dm - the DMNetwork object
+. key - the key of the components in this batch
+. n - number of components in this batch
+. points - the network points holding the components
+. components - the components, n consecutive blocks whose stride is the size given to DMNetworkRegisterComponent() rounded up to a multiple of sizeof(PetscInt)
+. offsets - local vector offset of the first variable of each component
+. nvar - number of variables of each component
+- ctx - the user context
+
+  Notes:
+  Requires DMNetworkSetComponentBatching() and DMSetUp(). The batches are slices of the arrays returned by
+  DMNetworkGetComponentBatch(), in increasing order of the points. Ghost vertices are included, use DMNetworkIsGhostVertex()
+  on points[] when a function must skip them.
+
+  Level: intermediate
+
+.seealso: DMNetworkSetComponentBatching(), DMNetworkGetComponentBatch(), DMNetworkGetComponent()
+@*/
+PetscErrorCode DMNetworkComponentBatchApply(DM dm,PetscInt key,PetscInt bs,PetscErrorCode (*f)(DM,PetscInt,PetscInt,const PetscInt[],void*,const PetscInt[],const PetscInt[],void*),void *ctx)
+{
+  PetscErrorCode          ierr;
+  DM_Network              *network = (DM_Network*)dm->data;
+  DMNetworkComponentBatch *batch;
+  PetscInt                k,kStart,kEnd,i,n,size;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  if (!network->batchpos) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call DMNetworkSetComponentBatching() and DMSetUp() first");
+  if (key == ALL_COMPONENTS) {kStart = 0; kEnd = network->ncomponent;}
+  else {
+    if (key < 0 || key >= network->ncomponent) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Component key %D is not in [0,%D)",key,network->ncomponent);
+    kStart = key; kEnd = key+1;
+  }
+  if (bs != PETSC_DECIDE && bs < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Batch size %D must be positive",bs);
+
+  for (k=kStart; k<kEnd; k++) {
+    batch = &network->batch[k];
+    size  = network->component[k].size;
+    for (i=0; i<batch->n; i+=n) {
+      n    = (bs == PETSC_DECIDE) ? batch->n : PetscMin(bs,batch->n-i);
+      ierr = (*f)(dm,k,n,batch->points+i,(void*)(batch->data+i*size),batch->offset+i,batch->nvar+i,ctx);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
  Sets up the array that holds the data for all components and its associated section.
  It copies the data for all components in a contiguous array called componentdataarray. The component data is stored pointwise with an additional header (metadata) stored for each point. The header has metadata information such as number of components at each point, number of variables for each component, offsets for the components data, etc.
@@ -1301,7 +1402,7 @@ PetscErrorCode DMNetworkComponentSetUp(DM dm)
 
   ierr = PetscSectionSetUp(network->DataSection);CHKERRQ(ierr);
   ierr = PetscSectionGetStorageSize(network->DataSection,&arr_size);CHKERRQ(ierr);
-  ierr = PetscMalloc1(arr_size,&network->componentdataarray);CHKERRQ(ierr);
+  ierr = PetscCalloc1(arr_size,&network->componentdataarray);CHKERRQ(ierr);
   componentdataarray = network->componentdataarray;
   for (p = network->pStart; p < network->pEnd; p++) {
     ierr = PetscSectionGetOffset(network->DataSection,p,&offsetp);CHKERRQ(ierr);
@@ -1314,7 +1415,7 @@ PetscErrorCode DMNetworkComponentSetUp(DM dm)
 
     for (i = 0; i < ncomp; i++) {
       offset = offsetp + network->dataheadersize + header->offset[i];
-      ierr = PetscMemcpy(componentdataarray+offset,cvalue->data[i],header->size[i]*sizeof(DMNetworkComponentGenericDataType));CHKERRQ(ierr);
+      ierr = PetscMemcpy(componentdataarray+offset,cvalue->data[i],network->component[header->key[i]].bytes);CHKERRQ(ierr);
     }
   }
   PetscFunctionReturn(0);
@@ -1379,9 +1480,9 @@ static PetscErrorCode DMNetworkVariablesSetUp(DM dm)
 
     /* Leaves reset receved/remote nvar to dm */
     for (i=0; i<nsv; i++) {
+      p = svtx[i];
       ierr = DMNetworkIsGhostVertex(dm,p,&ghost);CHKERRQ(ierr);
       if (!ghost) continue;
-      p = svtx[i];
       /* printf("[%d] leaf reset nvar %d at p= %d \n",rank,remote_nvar[p],p); */
       /* DMNetworkSetNumVariables(dm,p,remote_nvar[p]) */
       ierr = PetscSectionSetDof(network->DofSection,p,remote_nvar[p]);CHKERRQ(ierr);
@@ -1533,6 +1634,12 @@ PetscErrorCode DMNetworkDistribute(DM *dm,PetscInt overlap)
   ierr = DMPlexGetPartitioner(oldDMnetwork->plex,&part);CHKERRQ(ierr);
   ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
 
+  /* Components stored grouped by key are moved with the pointwise componentdataarray */
+  ierr = DMNetworkComponentBatchRestore_private(*dm);CHKERRQ(ierr);
+  newDMnetwork->batching   = oldDMnetwork->batching;
+  newDMnetwork->ncomponent = oldDMnetwork->ncomponent;
+  ierr = PetscArraycpy(newDMnetwork->component,oldDMnetwork->component,oldDMnetwork->ncomponent);CHKERRQ(ierr);
+
   /* Distribute plex dm */
   ierr = DMPlexDistribute(oldDMnetwork->plex,overlap,&pointsf,&newDMnetwork->plex);CHKERRQ(ierr);
 
@@ -1655,6 +1762,8 @@ PetscErrorCode DMNetworkDistribute(DM *dm,PetscInt overlap)
   }
   newDMnetwork->nsvtx = nv;   /* num of local shared vertices */
 
+  if (newDMnetwork->batching) {ierr = DMNetworkComponentBatchSetUp_private(newDM);CHKERRQ(ierr);}
+
   newDM->setupcalled = (*dm)->setupcalled;
   newDMnetwork->distributecalled = PETSC_TRUE;
 
@@ -1877,6 +1986,7 @@ PetscErrorCode DMSetUp_Network(DM dm)
 
   ierr = DMSetLocalSection(network->plex,network->DofSection);CHKERRQ(ierr);
   ierr = DMGetGlobalSection(network->plex,&network->GlobalDofSection);CHKERRQ(ierr);
+  if (network->batching) {ierr = DMNetworkComponentBatchSetUp_private(dm);CHKERRQ(ierr);}
 
   dm->setupcalled = PETSC_TRUE;
   ierr = DMViewFromOptions(dm,NULL,"-dm_view");CHKERRQ(ierr);
@@ -2518,8 +2628,10 @@ PetscErrorCode DMDestroy_Network(DM dm)
   if (network->subnetvtx) {ierr = PetscFree(network->subnetvtx);CHKERRQ(ierr);}
 
   ierr = PetscTableDestroy(&network->svtable);CHKERRQ(ierr);
+  ierr = PetscFree(network->sedgelist);CHKERRQ(ierr);
   ierr = PetscFree(network->subnet);CHKERRQ(ierr);
   ierr = PetscFree(network->componentdataarray);CHKERRQ(ierr);
+  ierr = DMNetworkComponentBatchDestroy_private(network);CHKERRQ(ierr);
   ierr = PetscFree2(network->header,network->cvalue);CHKERRQ(ierr);
   ierr = PetscFree(network);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -5,10 +5,12 @@
 PetscErrorCode  DMSetFromOptions_Network(PetscOptionItems *PetscOptionsObject,DM dm)
 {
   PetscErrorCode ierr;
+  DM_Network     *network = (DM_Network*)dm->data;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   ierr = PetscOptionsHead(PetscOptionsObject,"DMNetwork Options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dmnetwork_component_batching","Store the components grouped by key","DMNetworkSetComponentBatching",network->batching,&network->batching,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
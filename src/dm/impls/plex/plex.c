@@ -8,7 +8,7 @@
 #include <petscdmfield.h>
 
 /* Logging support */
-PetscLogEvent DMPLEX_Interpolate, DMPLEX_Partition, DMPLEX_Distribute, DMPLEX_DistributeCones, DMPLEX_DistributeLabels, DMPLEX_DistributeSF, DMPLEX_DistributeOverlap, DMPLEX_DistributeField, DMPLEX_DistributeData, DMPLEX_Migrate, DMPLEX_InterpolateSF, DMPLEX_GlobalToNaturalBegin, DMPLEX_GlobalToNaturalEnd, DMPLEX_NaturalToGlobalBegin, DMPLEX_NaturalToGlobalEnd, DMPLEX_Stratify, DMPLEX_Symmetrize, DMPLEX_Preallocate, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM, DMPLEX_InterpolatorFEM, DMPLEX_InjectorFEM, DMPLEX_IntegralFEM, DMPLEX_CreateGmsh, DMPLEX_RebalanceSharedPoints, DMPLEX_PartSelf, DMPLEX_PartLabelInvert, DMPLEX_PartLabelCreateSF, DMPLEX_PartStratSF, DMPLEX_CreatePointSF,DMPLEX_LocatePoints;
+PetscLogEvent DMPLEX_Interpolate, DMPLEX_Partition, DMPLEX_Distribute, DMPLEX_DistributeCones, DMPLEX_DistributeLabels, DMPLEX_DistributeSF, DMPLEX_DistributeOverlap, DMPLEX_DistributeField, DMPLEX_DistributeData, DMPLEX_Migrate, DMPLEX_InterpolateSF, DMPLEX_InterpolateFaces, DMPLEX_InterpolateOrient, DMPLEX_GlobalToNaturalBegin, DMPLEX_GlobalToNaturalEnd, DMPLEX_NaturalToGlobalBegin, DMPLEX_NaturalToGlobalEnd, DMPLEX_Stratify, DMPLEX_Symmetrize, DMPLEX_Preallocate, DMPLEX_PreallocateAdj, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM, DMPLEX_InterpolatorFEM, DMPLEX_InjectorFEM, DMPLEX_IntegralFEM, DMPLEX_CreateGmsh, DMPLEX_RebalanceSharedPoints, DMPLEX_PartSelf, DMPLEX_PartLabelInvert, DMPLEX_PartLabelCreateSF, DMPLEX_PartStratSF, DMPLEX_CreatePointSF,DMPLEX_LocatePoints, DMPLEX_Refine, DMPLEX_RefineCones, DMPLEX_RefineSF, DMPLEX_RefineLabels, DMPLEX_RefineCoordinates;
 
 PETSC_EXTERN PetscErrorCode VecView_MPI(Vec, PetscViewer);
 
@@ -1405,6 +1405,8 @@ PetscErrorCode DMDestroy_Plex(DM dm)
   ierr = DMDestroy(&mesh->referenceTree);CHKERRQ(ierr);
   ierr = PetscGridHashDestroy(&mesh->lbox);CHKERRQ(ierr);
   ierr = PetscFree(mesh->neighbors);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&mesh->cellColoring);CHKERRQ(ierr);
+  ierr = DMPlexResetAdjacencyGraph_Internal(dm);CHKERRQ(ierr);
   /* This was originally freed in DMDestroy(), but that prevents reference counting of backend objects */
   ierr = PetscFree(mesh);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1589,6 +1591,8 @@ PetscErrorCode DMPlexSetChart(DM dm, PetscInt pStart, PetscInt pEnd)
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   ierr = PetscSectionSetChart(mesh->coneSection, pStart, pEnd);CHKERRQ(ierr);
   ierr = PetscSectionSetChart(mesh->supportSection, pStart, pEnd);CHKERRQ(ierr);
+  ierr = DMPlexResetAdjacencyGraph_Internal(dm);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&mesh->cellColoring);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1930,6 +1934,19 @@ PetscErrorCode DMPlexRestoreConeRecursive(DM dm, IS points, PetscInt *depth, IS
   PetscFunctionReturn(0);
 }
 
+/* Changing a cone or support of a symmetrized mesh invalidates the adjacency graph and the cell coloring built from it */
+static PetscErrorCode DMPlexResetTopologyCache_Static(DM dm)
+{
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!mesh->supports) PetscFunctionReturn(0);
+  ierr = DMPlexResetAdjacencyGraph_Internal(dm);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&mesh->cellColoring);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexSetCone - Set the points on the in-edges for this point in the DAG; that is these are the points that cover the specific point
 
@@ -1969,6 +1986,7 @@ PetscErrorCode DMPlexSetCone(DM dm, PetscInt p, const PetscInt cone[])
     if ((cone[c] < pStart) || (cone[c] >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone point %D is not in the valid range [%D, %D)", cone[c], pStart, pEnd);
     mesh->cones[off+c] = cone[c];
   }
+  ierr = DMPlexResetTopologyCache_Static(dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2093,6 +2111,7 @@ PetscErrorCode DMPlexInsertCone(DM dm, PetscInt p, PetscInt conePos, PetscInt co
   ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
   if ((conePos < 0) || (conePos >= dof)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone position %D of point %D is not in the valid range [0, %D)", conePos, p, dof);
   mesh->cones[off+conePos] = conePoint;
+  ierr = DMPlexResetTopologyCache_Static(dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2262,6 +2281,7 @@ PetscErrorCode DMPlexSetSupport(DM dm, PetscInt p, const PetscInt support[])
     if ((support[c] < pStart) || (support[c] >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Support point %D is not in the valid range [%D, %D)", support[c], pStart, pEnd);
     mesh->supports[off+c] = support[c];
   }
+  ierr = DMPlexResetTopologyCache_Static(dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2296,6 +2316,7 @@ PetscErrorCode DMPlexInsertSupport(DM dm, PetscInt p, PetscInt supportPos, Petsc
   if ((supportPoint < pStart) || (supportPoint >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Support point %D is not in the valid range [%D, %D)", supportPoint, pStart, pEnd);
   if (supportPos >= dof) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Support position %D of point %D is not in the valid range [0, %D)", supportPos, p, dof);
   mesh->supports[off+supportPos] = supportPoint;
+  ierr = DMPlexResetTopologyCache_Static(dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2769,6 +2790,8 @@ PetscErrorCode DMPlexSymmetrize(DM dm)
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   if (mesh->supports) SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_WRONGSTATE, "Supports were already setup in this DMPlex");
   ierr = PetscLogEventBegin(DMPLEX_Symmetrize,dm,0,0,0);CHKERRQ(ierr);
+  ierr = DMPlexResetAdjacencyGraph_Internal(dm);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&mesh->cellColoring);CHKERRQ(ierr);
   /* Calculate support sizes */
   ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
   for (p = pStart; p < pEnd; ++p) {
@@ -4669,6 +4692,24 @@ PetscErrorCode DMPlexRestoreCompressedClosure(DM dm, PetscSection section, Petsc
   PetscFunctionReturn(0);
 }
 
+/* Returns clDofIS == NULL if there is no closure dof index for this point, see DMPlexCreateClosureDofIndex() */
+PETSC_STATIC_INLINE PetscErrorCode DMPlexGetClosureDofIndex_Private(DM dm, PetscSection idxSection, PetscInt point, IS *clDofIS, PetscInt *numIndices, PetscInt *offset, const PetscInt **cldofs)
+{
+  PetscSection   clDofSection;
+  PetscInt       pStart, pEnd;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginHot;
+  ierr = PetscSectionGetClosureDofIndex(idxSection, (PetscObject) dm, &clDofSection, clDofIS);CHKERRQ(ierr);
+  if (!*clDofIS) PetscFunctionReturn(0);
+  ierr = PetscSectionGetChart(clDofSection, &pStart, &pEnd);CHKERRQ(ierr);
+  if ((point < pStart) || (point >= pEnd)) {*clDofIS = NULL; PetscFunctionReturn(0);}
+  ierr = PetscSectionGetDof(clDofSection, point, numIndices);CHKERRQ(ierr);
+  ierr = PetscSectionGetOffset(clDofSection, point, offset);CHKERRQ(ierr);
+  ierr = ISGetIndices(*clDofIS, cldofs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PETSC_STATIC_INLINE PetscErrorCode DMPlexVecGetClosure_Static(DM dm, PetscSection section, PetscInt numPoints, const PetscInt points[], const PetscInt clperm[], const PetscScalar vArray[], PetscInt *size, PetscScalar array[])
 {
   PetscInt          offset = 0, p;
@@ -4810,10 +4851,10 @@ $  PetscFree(values);
 PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt point, PetscInt *csize, PetscScalar *values[])
 {
   PetscSection       clSection;
-  IS                 clPoints;
+  IS                 clPoints, clDofIS;
   PetscInt          *points = NULL;
-  const PetscInt    *clp, *perm;
-  PetscInt           depth, numFields, numPoints, asize;
+  const PetscInt    *clp, *perm, *cldofs;
+  PetscInt           depth, numFields, numPoints, asize, cloff;
   PetscErrorCode     ierr;
 
   PetscFunctionBeginHot;
@@ -4827,6 +4868,30 @@ PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt
     ierr = DMPlexVecGetClosure_Depth1_Static(dm, section, v, point, csize, values);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
+  /* Use the closure dof index as a single gather */
+  ierr = DMPlexGetClosureDofIndex_Private(dm, section, point, &clDofIS, &asize, &cloff, &cldofs);CHKERRQ(ierr);
+  if (clDofIS) {
+    if (values) {
+      const PetscScalar *vArray;
+      PetscScalar       *array;
+      PetscInt           i;
+
+      if (*values) {
+        if (PetscUnlikely(*csize < asize)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Provided array size %D not sufficient to hold closure size %D", *csize, asize);
+      } else {ierr = DMGetWorkArray(dm, asize, MPIU_SCALAR, values);CHKERRQ(ierr);}
+      array = *values;
+      ierr  = VecGetArrayRead(v, &vArray);CHKERRQ(ierr);
+      for (i = 0; i < asize; ++i) {
+        const PetscInt idx = cldofs[cloff+i];
+
+        array[i] = vArray[idx < 0 ? -(idx+1) : idx];
+      }
+      ierr = VecRestoreArrayRead(v, &vArray);CHKERRQ(ierr);
+    }
+    if (csize) *csize = asize;
+    ierr = ISRestoreIndices(clDofIS, &cldofs);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   /* Get points */
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
   /* Get sizes */
@@ -5303,11 +5368,11 @@ PETSC_STATIC_INLINE PetscErrorCode DMPlexVecSetClosure_Depth1_Static(DM dm, Pets
 PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt point, const PetscScalar values[], InsertMode mode)
 {
   PetscSection    clSection;
-  IS              clPoints;
+  IS              clPoints, clDofIS;
   PetscScalar    *array;
   PetscInt       *points = NULL;
-  const PetscInt *clp, *clperm = NULL;
-  PetscInt        depth, numFields, numPoints, p, clsize;
+  const PetscInt *clp, *clperm = NULL, *cldofs;
+  PetscInt        depth, numFields, numPoints, p, clsize, cloff;
   PetscErrorCode  ierr;
 
   PetscFunctionBeginHot;
@@ -5321,6 +5386,38 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
     ierr = DMPlexVecSetClosure_Depth1_Static(dm, section, v, point, values, mode);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
+  /* Use the closure dof index as a single scatter, where constrained dofs have negative indices */
+  ierr = DMPlexGetClosureDofIndex_Private(dm, section, point, &clDofIS, &clsize, &cloff, &cldofs);CHKERRQ(ierr);
+  if (clDofIS) {
+    const PetscInt *idx = &cldofs[cloff];
+
+    ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+    switch (mode) {
+    case INSERT_VALUES:
+      for (p = 0; p < clsize; ++p) if (idx[p] >= 0) array[idx[p]] = values[p];
+      break;
+    case INSERT_ALL_VALUES:
+      for (p = 0; p < clsize; ++p) array[idx[p] < 0 ? -(idx[p]+1) : idx[p]] = values[p];
+      break;
+    case INSERT_BC_VALUES:
+      for (p = 0; p < clsize; ++p) if (idx[p] < 0) array[-(idx[p]+1)] = values[p];
+      break;
+    case ADD_VALUES:
+      for (p = 0; p < clsize; ++p) if (idx[p] >= 0) array[idx[p]] += values[p];
+      break;
+    case ADD_ALL_VALUES:
+      for (p = 0; p < clsize; ++p) array[idx[p] < 0 ? -(idx[p]+1) : idx[p]] += values[p];
+      break;
+    case ADD_BC_VALUES:
+      for (p = 0; p < clsize; ++p) if (idx[p] < 0) array[-(idx[p]+1)] += values[p];
+      break;
+    default:
+      SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid insert mode %d", mode);
+    }
+    ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(clDofIS, &cldofs);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   /* Get points */
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
   for (clsize=0,p=0; p<numPoints; p++) {
@@ -6572,8 +6669,10 @@ PetscErrorCode DMPlexRestoreClosureIndices(DM dm, PetscSection section, PetscSec
 PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection globalSection, Mat A, PetscInt point, const PetscScalar values[], InsertMode mode)
 {
   DM_Plex           *mesh = (DM_Plex*) dm->data;
+  IS                 clDofIS;
   PetscInt          *indices;
-  PetscInt           numIndices;
+  const PetscInt    *cldofs;
+  PetscInt           numIndices, cloff;
   const PetscScalar *valuesOrig = values;
   PetscErrorCode     ierr;
 
@@ -6585,7 +6684,9 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
   PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
   PetscValidHeaderSpecific(A, MAT_CLASSID, 4);
 
-  ierr = DMPlexGetClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr);
+  ierr = DMPlexGetClosureDofIndex_Private(dm, globalSection, point, &clDofIS, &numIndices, &cloff, &cldofs);CHKERRQ(ierr);
+  if (clDofIS) indices = (PetscInt *) &cldofs[cloff];
+  else {ierr = DMPlexGetClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr);}
 
   if (mesh->printSetValues) {ierr = DMPlexPrintMatSetValues(PETSC_VIEWER_STDOUT_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr);}
   ierr = MatSetValues(A, numIndices, indices, numIndices, indices, values, mode);
@@ -6596,7 +6697,8 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
     ierr2 = MPI_Comm_rank(PetscObjectComm((PetscObject)A), &rank);CHKERRQ(ierr2);
     ierr2 = (*PetscErrorPrintf)("[%d]ERROR in DMPlexMatSetClosure\n", rank);CHKERRQ(ierr2);
     ierr2 = DMPlexPrintMatSetValues(PETSC_VIEWER_STDERR_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr2);
-    ierr2 = DMPlexRestoreClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr2);
+    if (clDofIS) {ierr2 = ISRestoreIndices(clDofIS, &cldofs);CHKERRQ(ierr2);}
+    else         {ierr2 = DMPlexRestoreClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr2);}
     if (values != valuesOrig) {ierr2 = DMRestoreWorkArray(dm, 0, MPIU_SCALAR, &values);CHKERRQ(ierr2);}
     CHKERRQ(ierr);
   }
@@ -6607,7 +6709,8 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
     ierr = PetscPrintf(PETSC_COMM_SELF, "\n");CHKERRQ(ierr);
   }
 
-  ierr = DMPlexRestoreClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr);
+  if (clDofIS) {ierr = ISRestoreIndices(clDofIS, &cldofs);CHKERRQ(ierr);}
+  else         {ierr = DMPlexRestoreClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr);}
   if (values != valuesOrig) {ierr = DMRestoreWorkArray(dm, 0, MPIU_SCALAR, &values);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
@@ -8351,6 +8454,7 @@ PetscErrorCode DMPlexSetAnchors(DM dm, PetscSection anchorSection, IS anchorIS)
   ierr = PetscObjectReference((PetscObject)anchorIS);CHKERRQ(ierr);
   ierr = ISDestroy(&plex->anchorIS);CHKERRQ(ierr);
   plex->anchorIS = anchorIS;
+  ierr = DMPlexResetAdjacencyGraph_Internal(dm);CHKERRQ(ierr);
 
   if (PetscUnlikelyDebug(anchorIS && anchorSection)) {
     PetscInt size, a, pStart, pEnd;
@@ -2318,12 +2318,14 @@ static PetscErrorCode DMPlexReplace_Static(DM dm, DM dmNew)
    - Swap the DM_Plex structure
    - Swap the coordinates
    - Swap the point PetscSF
+   - Swap the coordinate field
 */
 static PetscErrorCode DMPlexSwap_Static(DM dmA, DM dmB)
 {
   DM              coordDMA, coordDMB;
   Vec             coordsA,  coordsB;
   PetscSF         sfA,      sfB;
+  DMField         fieldTmp;
   void            *tmp;
   DMLabelLink     listTmp;
   DMLabel         depthTmp;
@@ -2352,6 +2354,10 @@ static PetscErrorCode DMPlexSwap_Static(DM dmA, DM dmB)
   ierr = DMSetCoordinatesLocal(dmB, coordsA);CHKERRQ(ierr);
   ierr = PetscObjectDereference((PetscObject) coordsA);CHKERRQ(ierr);
 
+  fieldTmp             = dmA->coordinateField;
+  dmA->coordinateField = dmB->coordinateField;
+  dmB->coordinateField = fieldTmp;
+
   tmp       = dmA->data;
   dmA->data = dmB->data;
   dmB->data = tmp;
@@ -2385,7 +2391,10 @@ PetscErrorCode DMSetFromOptions_NonRefinement_Plex(PetscOptionItems *PetscOption
   ierr = DMMonitorSetFromOptions(dm, "-dm_plex_monitor_throughput", "Monitor the simulation throughput", "DMPlexMonitorThroughput", DMPlexMonitorThroughput, NULL, &flg);CHKERRQ(ierr);
   if (flg) {ierr = PetscLogDefaultBegin();CHKERRQ(ierr);}
   /* Point Location */
-  ierr = PetscOptionsBool("-dm_plex_hash_location", "Use grid hashing for point location", "DMInterpolate", PETSC_FALSE, &mesh->useHashLocation, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dm_plex_hash_location", "Use a persistent grid hash for point location", "DMLocatePoints", mesh->useHashLocation, &mesh->useHashLocation, NULL);CHKERRQ(ierr);
+  /* Assembly */
+  ierr = PetscOptionsBool("-dm_plex_colored_assembly", "Scatter cell contributions color by color, threading each color", "DMPlexSetColoredAssembly", mesh->coloredAssembly, &mesh->coloredAssembly, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dm_plex_cache_adjacency", "Keep the point adjacency between matrix preallocations", "DMPlexPreallocateOperator", mesh->cacheAdjacency, &mesh->cacheAdjacency, NULL);CHKERRQ(ierr);
   /* Partitioning and distribution */
   ierr = PetscOptionsBool("-dm_plex_partition_balance", "Attempt to evenly divide points on partition boundary between processes", "DMPlexSetPartitionBalance", PETSC_FALSE, &mesh->partitionBalance, NULL);CHKERRQ(ierr);
   /* Generation and remeshing */
@@ -2419,6 +2428,20 @@ PetscErrorCode DMSetFromOptions_NonRefinement_Plex(PetscOptionItems *PetscOption
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode DMPlexViewOrderingMetrics_Static(DM dm, const char name[])
+{
+  PetscReal      span, maxSpan;
+  PetscInt       bw, maxBw;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexComputeOrderingMetrics(dm, &span, &bw);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&span, &maxSpan, 1, MPIU_REAL, MPIU_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&bw, &maxBw, 1, MPIU_INT, MPI_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "%s ordering: average closure span %g, cell bandwidth %D\n", name, (double) maxSpan, maxBw);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject,DM dm)
 {
   PetscReal      volume = -1.0;
@@ -2467,6 +2490,30 @@ static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject
       ierr = DMDestroy(&pdm);CHKERRQ(ierr);
     }
   }
+  /* Handle DMPlex reordering, before refinement so that the refined meshes inherit the locality */
+  {
+    char      otype[256];
+    PetscBool reorder, view = PETSC_FALSE;
+
+    ierr = PetscOptionsFList("-dm_plex_reorder", "Reorder the local mesh points for locality", "DMPlexGetOrdering", MatOrderingList, MATORDERINGRCM, otype, sizeof(otype), &reorder);CHKERRQ(ierr);
+    ierr = PetscOptionsBool("-dm_plex_reorder_view", "Print the locality of the mesh numbering before and after reordering", "DMPlexComputeOrderingMetrics", view, &view, NULL);CHKERRQ(ierr);
+    if (reorder) {
+      DM        pdm;
+      IS        perm;
+      PetscBool localized;
+
+      ierr = DMGetCoordinatesLocalized(dm, &localized);CHKERRQ(ierr);
+      if (localized || dm->useNatural) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Mesh reordering does not support localized coordinates or the natural ordering");
+      if (view) {ierr = DMPlexViewOrderingMetrics_Static(dm, "Original");CHKERRQ(ierr);}
+      ierr = DMPlexGetOrdering(dm, otype, NULL, &perm);CHKERRQ(ierr);
+      ierr = DMPlexPermute(dm, perm, &pdm);CHKERRQ(ierr);
+      ierr = DMPlexReplace_Static(dm, pdm);CHKERRQ(ierr);
+      if (pdm->localSection) {ierr = DMSetLocalSection(dm, pdm->localSection);CHKERRQ(ierr);}
+      ierr = DMDestroy(&pdm);CHKERRQ(ierr);
+      ierr = ISDestroy(&perm);CHKERRQ(ierr);
+      if (view) {ierr = DMPlexViewOrderingMetrics_Static(dm, otype);CHKERRQ(ierr);}
+    }
+  }
   /* Handle DMPlex refinement */
   ierr = PetscOptionsBoundedInt("-dm_refine", "The number of uniform refinements", "DMCreate", refine, &refine, NULL,0);CHKERRQ(ierr);
   ierr = PetscOptionsBoundedInt("-dm_refine_hierarchy", "The number of uniform refinements", "DMCreate", refine, &refine, &isHierarchy,0);CHKERRQ(ierr);
@@ -2699,7 +2746,11 @@ PETSC_INTERN PetscErrorCode DMClone_Plex(DM dm, DM *newdm)
 . -dm_distribute                     - Distribute mesh across processes
 . -dm_distribute_overlap             - Number of cells to overlap for distribution
 . -dm_refine                         - Refine mesh after distribution
-. -dm_plex_hash_location             - Use grid hashing for point location
+. -dm_plex_hash_location             - Use a persistent grid hash for point location, default true
+. -dm_plex_colored_assembly          - Scatter cell contributions color by color, threading each color
+. -dm_plex_cache_adjacency           - Keep the point adjacency between matrix preallocations
+. -dm_plex_reorder <type>            - Reorder the local mesh after distribution, e.g. rcm or hilbert
+. -dm_plex_reorder_view              - Print the average closure span and cell bandwidth before and after reordering
 . -dm_plex_partition_balance         - Attempt to evenly divide points on partition boundary between processes
 . -dm_plex_remesh_bd                 - Allow changes to the boundary on remeshing
 . -dm_plex_max_projection_height     - Maxmimum mesh point height used to project locally
@@ -2778,6 +2829,11 @@ PETSC_EXTERN PetscErrorCode DMCreate_Plex(DM dm)
 
   mesh->neighbors           = NULL;
 
+  mesh->coloredAssembly     = PETSC_FALSE;
+  mesh->cellColoring        = NULL;
+  mesh->cacheAdjacency      = PETSC_TRUE;
+  mesh->useHashLocation     = PETSC_TRUE;
+
   mesh->printSetValues = PETSC_FALSE;
   mesh->printFEM       = 0;
   mesh->printTol       = 1.0e-10;
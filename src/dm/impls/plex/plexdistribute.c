@@ -20,12 +20,14 @@
 @*/
 PetscErrorCode DMPlexSetAdjacencyUser(DM dm,PetscErrorCode (*user)(DM,PetscInt,PetscInt*,PetscInt[],void*),void *ctx)
 {
-  DM_Plex *mesh = (DM_Plex *)dm->data;
+  DM_Plex       *mesh = (DM_Plex *)dm->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   mesh->useradjacency = user;
   mesh->useradjacencyctx = ctx;
+  ierr = DMPlexResetAdjacencyGraph_Internal(dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
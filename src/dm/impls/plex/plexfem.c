@@ -4599,8 +4599,12 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, IS cellIS, PetscReal time,
     }
     /* Loop over domain */
     if (useFEM) {
+      PetscBool colored = PETSC_FALSE;
+
+      /* Cells of one color share no dofs, so they can be added without conflicts */
+      if (!cells && !ghostLabel && mesh->printFEM <= 1) {ierr = DMPlexVecSetClosureColored_Internal(dm, section, locF, cS, cE, totDim, &elemVec[(cS-cStart)*totDim], ADD_ALL_VALUES, &colored);CHKERRQ(ierr);}
       /* Add elemVec to locX */
-      for (c = cS; c < cE; ++c) {
+      for (c = cS; c < cE && !colored; ++c) {
         const PetscInt cell = cells ? cells[c] : c;
         const PetscInt cind = c - cStart;
 
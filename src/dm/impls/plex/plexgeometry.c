@@ -91,40 +91,6 @@ PetscErrorCode DMPlexFindVertices(DM dm, PetscInt npoints, const PetscReal coord
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode DMPlexGetLineIntersection_2D_Internal(const PetscReal segmentA[], const PetscReal segmentB[], PetscReal intersection[], PetscBool *hasIntersection)
-{
-  const PetscReal p0_x  = segmentA[0*2+0];
-  const PetscReal p0_y  = segmentA[0*2+1];
-  const PetscReal p1_x  = segmentA[1*2+0];
-  const PetscReal p1_y  = segmentA[1*2+1];
-  const PetscReal p2_x  = segmentB[0*2+0];
-  const PetscReal p2_y  = segmentB[0*2+1];
-  const PetscReal p3_x  = segmentB[1*2+0];
-  const PetscReal p3_y  = segmentB[1*2+1];
-  const PetscReal s1_x  = p1_x - p0_x;
-  const PetscReal s1_y  = p1_y - p0_y;
-  const PetscReal s2_x  = p3_x - p2_x;
-  const PetscReal s2_y  = p3_y - p2_y;
-  const PetscReal denom = (-s2_x * s1_y + s1_x * s2_y);
-
-  PetscFunctionBegin;
-  *hasIntersection = PETSC_FALSE;
-  /* Non-parallel lines */
-  if (denom != 0.0) {
-    const PetscReal s = (-s1_y * (p0_x - p2_x) + s1_x * (p0_y - p2_y)) / denom;
-    const PetscReal t = ( s2_x * (p0_y - p2_y) - s2_y * (p0_x - p2_x)) / denom;
-
-    if (s >= 0 && s <= 1 && t >= 0 && t <= 1) {
-      *hasIntersection = PETSC_TRUE;
-      if (intersection) {
-        intersection[0] = p0_x + (t * s1_x);
-        intersection[1] = p0_y + (t * s1_y);
-      }
-    }
-  }
-  PetscFunctionReturn(0);
-}
-
 static PetscErrorCode DMPlexLocatePoint_Simplex_2D_Internal(DM dm, const PetscScalar point[], PetscInt c, PetscInt *cell)
 {
   const PetscInt  embedDim = 2;
@@ -290,7 +256,7 @@ PetscErrorCode PetscGridHashCreate(MPI_Comm comm, PetscInt dim, const PetscScala
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = PetscMalloc1(1, box);CHKERRQ(ierr);
+  ierr = PetscCalloc1(1, box);CHKERRQ(ierr);
   ierr = PetscGridHashInitialize_Internal(*box, dim, point);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -377,7 +343,7 @@ PetscErrorCode PetscGridHashGetEnclosingBox(PetscGridHash box, PetscInt numPoint
                                              p, (double) PetscRealPart(points[p*dim+0]), dim > 1 ? (double) PetscRealPart(points[p*dim+1]) : 0.0, dim > 2 ? (double) PetscRealPart(points[p*dim+2]) : 0.0);
       dboxes[p*dim+d] = dbox;
     }
-    if (boxes) for (d = 1, boxes[p] = dboxes[p*dim]; d < dim; ++d) boxes[p] += dboxes[p*dim+d]*n[d-1];
+    if (boxes) for (d = dim-1, boxes[p] = 0; d >= 0; --d) boxes[p] = boxes[p]*n[d] + dboxes[p*dim+d];
   }
   PetscFunctionReturn(0);
 }
@@ -422,7 +388,7 @@ PetscErrorCode PetscGridHashGetEnclosingBoxQuery(PetscGridHash box, PetscInt num
       }
       dboxes[p*dim+d] = dbox;
     }
-    if (boxes) for (d = 1, boxes[p] = dboxes[p*dim]; d < dim; ++d) boxes[p] += dboxes[p*dim+d]*n[d-1];
+    if (boxes) for (d = dim-1, boxes[p] = 0; d >= 0; --d) boxes[p] = boxes[p]*n[d] + dboxes[p*dim+d];
   }
   *found = PETSC_TRUE;
   PetscFunctionReturn(0);
@@ -437,6 +403,7 @@ PetscErrorCode PetscGridHashDestroy(PetscGridHash *box)
     ierr = PetscSectionDestroy(&(*box)->cellSection);CHKERRQ(ierr);
     ierr = ISDestroy(&(*box)->cells);CHKERRQ(ierr);
     ierr = DMLabelDestroy(&(*box)->cellsSparse);CHKERRQ(ierr);
+    ierr = PetscFree((*box)->bounds);CHKERRQ(ierr);
   }
   ierr = PetscFree(*box);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -492,7 +459,7 @@ PetscErrorCode DMPlexClosestPoint_Internal(DM dm, PetscInt dim, const PetscScala
 /*
   DMPlexComputeGridHash_Internal - Create a grid hash structure covering the Plex
 
-  Collective on dm
+  Not collective
 
   Input Parameter:
 . dm - The Plex
@@ -500,129 +467,212 @@ PetscErrorCode DMPlexClosestPoint_Internal(DM dm, PetscInt dim, const PetscScala
   Output Parameter:
 . localBox - The grid hash object
 
+  Note: Each cell is entered in every subbox overlapped by its slightly padded bounding box, so that the list for a subbox holds, in increasing
+  order, every cell which could contain a point of that subbox. Unless -dm_plex_hash_box_nijk is given, the number of subboxes is chosen to
+  give about one cell per subbox.
+
   Level: developer
 
 .seealso: PetscGridHashCreate(), PetscGridHashGetEnclosingBox()
 */
 PetscErrorCode DMPlexComputeGridHash_Internal(DM dm, PetscGridHash *localBox)
 {
-  MPI_Comm           comm;
-  PetscGridHash      lbox;
-  Vec                coordinates;
-  PetscSection       coordSection;
-  Vec                coordsLocal;
-  const PetscScalar *coords;
-  PetscInt          *dboxes, *boxes;
-  PetscInt           n[3] = {10, 10, 10};
-  PetscInt           dim, N, cStart, cEnd, c, i;
-  PetscErrorCode     ierr;
+  PetscGridHash  lbox;
+  PetscSection   coordSection;
+  Vec            coordsLocal;
+  PetscReal     *bounds;
+  PetscInt      *lims, *cells, *fill;
+  PetscInt       n[3] = {1, 1, 1}, nijk = PETSC_DETERMINE;
+  PetscInt       dim, cStart, cEnd, numCells, numBoxes, numEntries, Nd = 0, c, d, i, j, k;
+  PetscReal      vol = 1.0;
+  PetscBool      flg;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
-  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
   ierr = DMGetCoordinateDim(dm, &dim);CHKERRQ(ierr);
-  if (dim != 2) SETERRQ(comm, PETSC_ERR_SUP, "I have only coded this for 2D");
-  ierr = VecGetLocalSize(coordinates, &N);CHKERRQ(ierr);
-  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
-  ierr = PetscGridHashCreate(comm, dim, coords, &lbox);CHKERRQ(ierr);
-  for (i = 0; i < N; i += dim) {ierr = PetscGridHashEnlarge(lbox, &coords[i]);CHKERRQ(ierr);}
-  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
-  ierr = PetscOptionsGetInt(NULL,NULL,"-dm_plex_hash_box_nijk",&n[0],NULL);CHKERRQ(ierr);
-  n[1] = n[0];
-  n[2] = n[0];
-  ierr = PetscGridHashSetGrid(lbox, n, NULL);CHKERRQ(ierr);
-#if 0
-  /* Could define a custom reduction to merge these */
-  ierr = MPIU_Allreduce(lbox->lower, gbox->lower, 3, MPIU_REAL, MPI_MIN, comm);CHKERRQ(ierr);
-  ierr = MPIU_Allreduce(lbox->upper, gbox->upper, 3, MPIU_REAL, MPI_MAX, comm);CHKERRQ(ierr);
-#endif
-  /* Is there a reason to snap the local bounding box to a division of the global box? */
-  /* Should we compute all overlaps of local boxes? We could do this with a rendevouz scheme partitioning the global box */
-  /* Create label */
-  ierr = DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
-  ierr = DMLabelCreate(PETSC_COMM_SELF, "cells", &lbox->cellsSparse);CHKERRQ(ierr);
-  ierr = DMLabelCreateIndex(lbox->cellsSparse, cStart, cEnd);CHKERRQ(ierr);
-  /* Compute boxes which overlap each cell: https://stackoverflow.com/questions/13790208/triangle-square-intersection-test-in-2d */
+  if (PetscUnlikely(dim > 3)) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Grid hashing is not supported for coordinate dimension %D > 3", dim);
   ierr = DMGetCoordinatesLocal(dm, &coordsLocal);CHKERRQ(ierr);
   ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
-  ierr = PetscCalloc2(16 * dim, &dboxes, 16, &boxes);CHKERRQ(ierr);
+  ierr = DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  numCells = cEnd - cStart;
+  ierr = PetscCalloc1(1, &lbox);CHKERRQ(ierr);
+  lbox->dim    = dim;
+  lbox->cStart = cStart;
+  lbox->cEnd   = cEnd;
+  for (d = 0; d < dim; ++d) {lbox->lower[d] = PETSC_MAX_REAL; lbox->upper[d] = PETSC_MIN_REAL;}
+  /* Compute the bounding box of each cell, and their union */
+  ierr = PetscMalloc1(numCells*2*dim, &bounds);CHKERRQ(ierr);
   for (c = cStart; c < cEnd; ++c) {
-    const PetscReal *h       = lbox->h;
-    PetscScalar     *ccoords = NULL;
-    PetscInt         csize   = 0;
-    PetscScalar      point[3];
-    PetscInt         dlim[6], d, e, i, j, k;
+    PetscReal   *cmin    = &bounds[(c-cStart)*2*dim], *cmax = &cmin[dim];
+    PetscScalar *ccoords = NULL;
+    PetscReal    pad     = 0.0;
+    PetscInt     csize   = 0, v;
 
-    /* Find boxes enclosing each vertex */
     ierr = DMPlexVecGetClosure(dm, coordSection, coordsLocal, c, &csize, &ccoords);CHKERRQ(ierr);
-    ierr = PetscGridHashGetEnclosingBox(lbox, csize/dim, ccoords, dboxes, boxes);CHKERRQ(ierr);
-    /* Mark cells containing the vertices */
-    for (e = 0; e < csize/dim; ++e) {ierr = DMLabelSetValue(lbox->cellsSparse, c, boxes[e]);CHKERRQ(ierr);}
-    /* Get grid of boxes containing these */
-    for (d = 0;   d < dim; ++d) {dlim[d*2+0] = dlim[d*2+1] = dboxes[d];}
-    for (d = dim; d < 3;   ++d) {dlim[d*2+0] = dlim[d*2+1] = 0;}
-    for (e = 1; e < dim+1; ++e) {
+    for (d = 0; d < dim; ++d) {cmin[d] = PETSC_MAX_REAL; cmax[d] = PETSC_MIN_REAL;}
+    for (v = 0; v < csize/dim; ++v) {
       for (d = 0; d < dim; ++d) {
-        dlim[d*2+0] = PetscMin(dlim[d*2+0], dboxes[e*dim+d]);
-        dlim[d*2+1] = PetscMax(dlim[d*2+1], dboxes[e*dim+d]);
-      }
-    }
-    /* Check for intersection of box with cell */
-    for (k = dlim[2*2+0], point[2] = lbox->lower[2] + k*h[2]; k <= dlim[2*2+1]; ++k, point[2] += h[2]) {
-      for (j = dlim[1*2+0], point[1] = lbox->lower[1] + j*h[1]; j <= dlim[1*2+1]; ++j, point[1] += h[1]) {
-        for (i = dlim[0*2+0], point[0] = lbox->lower[0] + i*h[0]; i <= dlim[0*2+1]; ++i, point[0] += h[0]) {
-          const PetscInt box = (k*lbox->n[1] + j)*lbox->n[0] + i;
-          PetscScalar    cpoint[3];
-          PetscInt       cell, edge, ii, jj, kk;
-
-          /* Check whether cell contains any vertex of these subboxes TODO vectorize this */
-          for (kk = 0, cpoint[2] = point[2]; kk < (dim > 2 ? 2 : 1); ++kk, cpoint[2] += h[2]) {
-            for (jj = 0, cpoint[1] = point[1]; jj < (dim > 1 ? 2 : 1); ++jj, cpoint[1] += h[1]) {
-              for (ii = 0, cpoint[0] = point[0]; ii < 2; ++ii, cpoint[0] += h[0]) {
-
-                ierr = DMPlexLocatePoint_Internal(dm, dim, cpoint, c, &cell);CHKERRQ(ierr);
-                if (cell >= 0) { ierr = DMLabelSetValue(lbox->cellsSparse, c, box);CHKERRQ(ierr); ii = jj = kk = 2;}
-              }
-            }
-          }
-          /* Check whether cell edge intersects any edge of these subboxes TODO vectorize this */
-          for (edge = 0; edge < dim+1; ++edge) {
-            PetscReal segA[6], segB[6];
-
-            if (PetscUnlikely(dim > 3)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Unexpected dim %d > 3",dim);
-            for (d = 0; d < dim; ++d) {segA[d] = PetscRealPart(ccoords[edge*dim+d]); segA[dim+d] = PetscRealPart(ccoords[((edge+1)%(dim+1))*dim+d]);}
-            for (kk = 0; kk < (dim > 2 ? 2 : 1); ++kk) {
-              if (dim > 2) {segB[2]     = PetscRealPart(point[2]);
-                            segB[dim+2] = PetscRealPart(point[2]) + kk*h[2];}
-              for (jj = 0; jj < (dim > 1 ? 2 : 1); ++jj) {
-                if (dim > 1) {segB[1]     = PetscRealPart(point[1]);
-                              segB[dim+1] = PetscRealPart(point[1]) + jj*h[1];}
-                for (ii = 0; ii < 2; ++ii) {
-                  PetscBool intersects;
-
-                  segB[0]     = PetscRealPart(point[0]);
-                  segB[dim+0] = PetscRealPart(point[0]) + ii*h[0];
-                  ierr = DMPlexGetLineIntersection_2D_Internal(segA, segB, NULL, &intersects);CHKERRQ(ierr);
-                  if (intersects) { ierr = DMLabelSetValue(lbox->cellsSparse, c, box);CHKERRQ(ierr); edge = ii = jj = kk = dim+1;}
-                }
-              }
-            }
-          }
-        }
+        cmin[d] = PetscMin(cmin[d], PetscRealPart(ccoords[v*dim+d]));
+        cmax[d] = PetscMax(cmax[d], PetscRealPart(ccoords[v*dim+d]));
+      }
+    }
+    ierr = DMPlexVecRestoreClosure(dm, coordSection, coordsLocal, c, &csize, &ccoords);CHKERRQ(ierr);
+    for (d = 0; d < dim; ++d) {
+      lbox->lower[d] = PetscMin(lbox->lower[d], cmin[d]);
+      lbox->upper[d] = PetscMax(lbox->upper[d], cmax[d]);
+      pad = PetscMax(pad, cmax[d] - cmin[d]);
+    }
+    /* The point-in-cell tests accept points slightly outside of the cell */
+    pad *= 4.0*PETSC_SQRT_MACHINE_EPSILON;
+    for (d = 0; d < dim; ++d) {cmin[d] -= pad; cmax[d] += pad;}
+  }
+  lbox->bounds = bounds;
+  /* Choose about one subbox per cell, ignoring directions in which the mesh is flat. Taking one more subbox than cells across keeps the
+     subbox faces off the cell faces of a structured mesh, where the padded cells would otherwise overlap three subboxes in each direction */
+  for (d = 0; d < dim; ++d) {
+    lbox->extent[d] = numCells ? lbox->upper[d] - lbox->lower[d] : 0.0;
+    if (lbox->extent[d] > 0.0) {vol *= lbox->extent[d]; ++Nd;}
+  }
+  ierr = PetscOptionsGetInt(NULL, NULL, "-dm_plex_hash_box_nijk", &nijk, &flg);CHKERRQ(ierr);
+  for (d = 0; d < dim; ++d) {
+    if (lbox->extent[d] > 0.0) {
+      const PetscReal h = PetscPowReal(vol/numCells, 1.0/Nd);
+
+      n[d]       = flg ? nijk : (PetscInt) PetscMin(PetscFloorReal(lbox->extent[d]/h + 0.5), (PetscReal) numCells) + 1;
+      n[d]       = PetscMax(n[d], 1);
+      lbox->h[d] = lbox->extent[d]/n[d];
+    } else {
+      lbox->h[d] = 1.0;
+    }
+    lbox->n[d] = n[d];
+  }
+  numBoxes = n[0]*n[1]*n[2];
+  /* Find the range of subboxes overlapped by each cell */
+  ierr = PetscMalloc1(numCells*6, &lims);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PETSC_COMM_SELF, &lbox->cellSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(lbox->cellSection, 0, numBoxes);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    const PetscReal *cmin = &bounds[c*2*dim], *cmax = &cmin[dim];
+    PetscInt        *lim  = &lims[c*6];
+
+    for (d = 0; d < 3; ++d) {
+      if (d < dim) {
+        const PetscReal lo = PetscFloorReal((cmin[d] - lbox->lower[d])/lbox->h[d]);
+        const PetscReal hi = PetscFloorReal((cmax[d] - lbox->lower[d])/lbox->h[d]);
+
+        lim[d*2+0] = lo < 0.0 ? 0 : (lo > n[d]-1 ? n[d]-1 : (PetscInt) lo);
+        lim[d*2+1] = hi < 0.0 ? 0 : (hi > n[d]-1 ? n[d]-1 : (PetscInt) hi);
+      } else {
+        lim[d*2+0] = lim[d*2+1] = 0;
       }
     }
-    ierr = DMPlexVecRestoreClosure(dm, coordSection, coordsLocal, c, NULL, &ccoords);CHKERRQ(ierr);
+    for (k = lim[4]; k <= lim[5]; ++k) for (j = lim[2]; j <= lim[3]; ++j) for (i = lim[0]; i <= lim[1]; ++i) {
+      ierr = PetscSectionAddDof(lbox->cellSection, (k*n[1] + j)*n[0] + i, 1);CHKERRQ(ierr);
+    }
   }
-  ierr = PetscFree2(dboxes, boxes);CHKERRQ(ierr);
-  ierr = DMLabelConvertToSection(lbox->cellsSparse, &lbox->cellSection, &lbox->cells);CHKERRQ(ierr);
-  ierr = DMLabelDestroy(&lbox->cellsSparse);CHKERRQ(ierr);
+  ierr = PetscSectionSetUp(lbox->cellSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(lbox->cellSection, &numEntries);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numEntries, &cells);CHKERRQ(ierr);
+  ierr = PetscCalloc1(numBoxes, &fill);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    const PetscInt *lim = &lims[c*6];
+
+    for (k = lim[4]; k <= lim[5]; ++k) for (j = lim[2]; j <= lim[3]; ++j) for (i = lim[0]; i <= lim[1]; ++i) {
+      const PetscInt box = (k*n[1] + j)*n[0] + i;
+      PetscInt       off;
+
+      ierr = PetscSectionGetOffset(lbox->cellSection, box, &off);CHKERRQ(ierr);
+      cells[off + fill[box]++] = c + cStart;
+    }
+  }
+  ierr = PetscFree(fill);CHKERRQ(ierr);
+  ierr = PetscFree(lims);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, numEntries, cells, PETSC_OWN_POINTER, &lbox->cells);CHKERRQ(ierr);
+  if (coordsLocal) {
+    ierr = PetscObjectGetId((PetscObject) coordsLocal, &lbox->coordId);CHKERRQ(ierr);
+    ierr = PetscObjectStateGet((PetscObject) coordsLocal, &lbox->coordState);CHKERRQ(ierr);
+  }
+  ierr = PetscInfo5(dm, "Grid hash with %D x %D x %D boxes holding %D entries for %D cells\n", n[0], n[1], n[2], numEntries, numCells);CHKERRQ(ierr);
   *localBox = lbox;
   PetscFunctionReturn(0);
 }
 
+/* Return the grid hash of the mesh, building it again if the cells or coordinates changed since it was made */
+static PetscErrorCode DMPlexGetGridHash_Static(DM dm, PetscGridHash *lbox)
+{
+  DM_Plex         *mesh = (DM_Plex *) dm->data;
+  Vec              coordsLocal;
+  PetscObjectId    id    = 0;
+  PetscObjectState state = 0;
+  PetscInt         cStart, cEnd;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (mesh->lbox) {
+    ierr = DMGetCoordinatesLocal(dm, &coordsLocal);CHKERRQ(ierr);
+    if (coordsLocal) {
+      ierr = PetscObjectGetId((PetscObject) coordsLocal, &id);CHKERRQ(ierr);
+      ierr = PetscObjectStateGet((PetscObject) coordsLocal, &state);CHKERRQ(ierr);
+    }
+    ierr = DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    if (id != mesh->lbox->coordId || state != mesh->lbox->coordState || cStart != mesh->lbox->cStart || cEnd != mesh->lbox->cEnd) {
+      ierr = PetscInfo(dm, "Mesh changed, discarding grid hash\n");CHKERRQ(ierr);
+      ierr = PetscGridHashDestroy(&mesh->lbox);CHKERRQ(ierr);
+    }
+  }
+  if (!mesh->lbox) {
+    ierr = PetscInfo(dm, "Initializing grid hashing\n");CHKERRQ(ierr);
+    ierr = DMPlexComputeGridHash_Internal(dm, &mesh->lbox);CHKERRQ(ierr);
+  }
+  *lbox = mesh->lbox;
+  PetscFunctionReturn(0);
+}
+
+/* Cheap rejection test against the padded bounding box of cell c */
+PETSC_STATIC_INLINE PetscBool PetscGridHashCellMayContain_Private(PetscGridHash lbox, PetscInt c, const PetscScalar point[])
+{
+  const PetscInt   dim  = lbox->dim;
+  const PetscReal *cmin = &lbox->bounds[(c - lbox->cStart)*2*dim], *cmax = &cmin[dim];
+  PetscInt         d;
+
+  for (d = 0; d < dim; ++d) {
+    const PetscReal x = PetscRealPart(point[d]);
+
+    if (x < cmin[d] || x > cmax[d]) return PETSC_FALSE;
+  }
+  return PETSC_TRUE;
+}
+
+/* Look for the point in the cells sharing a face with cell c (a vertex, for meshes which are not interpolated), so that points which moved a little are found without a brute force search */
+static PetscErrorCode DMPlexLocatePointNeighbors_Static(DM dm, PetscInt dim, const PetscScalar point[], PetscInt c, PetscInt cStart, PetscInt cEnd, PetscInt *cell)
+{
+  const PetscInt *cone, *support;
+  PetscInt        coneSize, supportSize, f, s;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  *cell = DMLOCATEPOINT_POINT_NOT_FOUND;
+  if (c < cStart || c >= cEnd) PetscFunctionReturn(0);
+  ierr = DMPlexGetConeSize(dm, c, &coneSize);CHKERRQ(ierr);
+  ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
+  for (f = 0; f < coneSize; ++f) {
+    ierr = DMPlexGetSupportSize(dm, cone[f], &supportSize);CHKERRQ(ierr);
+    ierr = DMPlexGetSupport(dm, cone[f], &support);CHKERRQ(ierr);
+    for (s = 0; s < supportSize; ++s) {
+      const PetscInt n = support[s];
+
+      if (n == c || n < cStart || n >= cEnd) continue;
+      ierr = DMPlexLocatePoint_Internal(dm, dim, point, n, cell);CHKERRQ(ierr);
+      if (*cell >= 0) PetscFunctionReturn(0);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, PetscSF cellSF)
 {
   DM_Plex        *mesh = (DM_Plex *) dm->data;
+  PetscGridHash   lbox = NULL;
   PetscBool       hash = mesh->useHashLocation, reuse = PETSC_FALSE;
   PetscInt        bs, numPoints, p, numFound, *found = NULL;
   PetscInt        dim, cStart, cEnd, numCells, c, d;
@@ -632,7 +682,7 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
   PetscMPIInt     result;
   PetscLogDouble  t0,t1;
   PetscReal       gmin[3],gmax[3];
-  PetscInt        terminating_query_type[] = { 0, 0, 0 };
+  PetscInt        terminating_query_type[] = { 0, 0, 0, 0 };
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
@@ -666,22 +716,19 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
       }
     }
   }
-  /* define domain bounding box */
-  {
+  if (hash) {
+    /* The hash persists on the mesh, and its box bounds the local cells, so that no communication is needed */
+    ierr = DMPlexGetGridHash_Static(dm, &lbox);CHKERRQ(ierr);
+    for (d = 0; d < dim; ++d) {gmin[d] = lbox->lower[d]; gmax[d] = lbox->upper[d];}
+    ierr = ISGetIndices(lbox->cells, &boxCells);CHKERRQ(ierr);
+  } else {
+    /* define domain bounding box */
     Vec coorglobal;
 
     ierr = DMGetCoordinates(dm,&coorglobal);CHKERRQ(ierr);
     ierr = VecStrideMaxAll(coorglobal,NULL,gmax);CHKERRQ(ierr);
     ierr = VecStrideMinAll(coorglobal,NULL,gmin);CHKERRQ(ierr);
   }
-  if (hash) {
-    if (!mesh->lbox) {ierr = PetscInfo(dm, "Initializing grid hashing");CHKERRQ(ierr);ierr = DMPlexComputeGridHash_Internal(dm, &mesh->lbox);CHKERRQ(ierr);}
-    /* Designate the local box for each point */
-    /* Send points to correct process */
-    /* Search cells that lie in each subbox */
-    /*   Should we bin points before doing search? */
-    ierr = ISGetIndices(mesh->lbox->cells, &boxCells);CHKERRQ(ierr);
-  }
   for (p = 0, numFound = 0; p < numPoints; ++p) {
     const PetscScalar *point = &a[p*bs];
     PetscInt           dbin[3] = {-1,-1,-1}, bin, cell = -1, cellOffset;
@@ -703,34 +750,41 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
     if (cells[p].index != DMLOCATEPOINT_POINT_NOT_FOUND) {
       c = cells[p].index;
       cells[p].index = DMLOCATEPOINT_POINT_NOT_FOUND;
-      ierr = DMPlexLocatePoint_Internal(dm, dim, point, c, &cell);CHKERRQ(ierr);
+      if (!lbox || c < cStart || c >= cEnd || PetscGridHashCellMayContain_Private(lbox, c, point)) {
+        ierr = DMPlexLocatePoint_Internal(dm, dim, point, c, &cell);CHKERRQ(ierr);
+      }
+      if (cell >= 0) {
+        terminating_query_type[1]++;
+      } else if (!hash) {
+        /* points which moved usually end up in a neighbor of their initial cell, which is much cheaper to search than the whole mesh */
+        ierr = DMPlexLocatePointNeighbors_Static(dm, dim, point, c, cStart, cEnd, &cell);CHKERRQ(ierr);
+        if (cell >= 0) terminating_query_type[2]++;
+      }
       if (cell >= 0) {
         cells[p].rank = 0;
         cells[p].index = cell;
         numFound++;
+        continue;
       }
     }
-    if (cells[p].index != DMLOCATEPOINT_POINT_NOT_FOUND) {
-      terminating_query_type[1]++;
-      continue;
-    }
 
     if (hash) {
       PetscBool found_box;
 
       /* allow for case that point is outside box - abort early */
-      ierr = PetscGridHashGetEnclosingBoxQuery(mesh->lbox, 1, point, dbin, &bin,&found_box);CHKERRQ(ierr);
+      ierr = PetscGridHashGetEnclosingBoxQuery(lbox, 1, point, dbin, &bin,&found_box);CHKERRQ(ierr);
       if (found_box) {
         /* TODO Lay an interface over this so we can switch between Section (dense) and Label (sparse) */
-        ierr = PetscSectionGetDof(mesh->lbox->cellSection, bin, &numCells);CHKERRQ(ierr);
-        ierr = PetscSectionGetOffset(mesh->lbox->cellSection, bin, &cellOffset);CHKERRQ(ierr);
+        ierr = PetscSectionGetDof(lbox->cellSection, bin, &numCells);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(lbox->cellSection, bin, &cellOffset);CHKERRQ(ierr);
         for (c = cellOffset; c < cellOffset + numCells; ++c) {
+          if (!PetscGridHashCellMayContain_Private(lbox, boxCells[c], point)) continue;
           ierr = DMPlexLocatePoint_Internal(dm, dim, point, boxCells[c], &cell);CHKERRQ(ierr);
           if (cell >= 0) {
             cells[p].rank = 0;
             cells[p].index = cell;
             numFound++;
-            terminating_query_type[2]++;
+            terminating_query_type[3]++;
             break;
           }
         }
@@ -742,13 +796,12 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
           cells[p].rank = 0;
           cells[p].index = cell;
           numFound++;
-          terminating_query_type[2]++;
+          terminating_query_type[3]++;
           break;
         }
       }
     }
   }
-  if (hash) {ierr = ISRestoreIndices(mesh->lbox->cells, &boxCells);CHKERRQ(ierr);}
   if (ltype == DM_POINTLOCATION_NEAREST && hash && numFound < numPoints) {
     for (p = 0; p < numPoints; p++) {
       const PetscScalar *point = &a[p*bs];
@@ -757,9 +810,9 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
 
       if (cells[p].index < 0) {
         ++numFound;
-        ierr = PetscGridHashGetEnclosingBox(mesh->lbox, 1, point, dbin, &bin);CHKERRQ(ierr);
-        ierr = PetscSectionGetDof(mesh->lbox->cellSection, bin, &numCells);CHKERRQ(ierr);
-        ierr = PetscSectionGetOffset(mesh->lbox->cellSection, bin, &cellOffset);CHKERRQ(ierr);
+        ierr = PetscGridHashGetEnclosingBox(lbox, 1, point, dbin, &bin);CHKERRQ(ierr);
+        ierr = PetscSectionGetDof(lbox->cellSection, bin, &numCells);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(lbox->cellSection, bin, &cellOffset);CHKERRQ(ierr);
         for (c = cellOffset; c < cellOffset + numCells; ++c) {
           ierr = DMPlexClosestPoint_Internal(dm, dim, point, boxCells[c], cpoint);CHKERRQ(ierr);
           for (d = 0; d < dim; ++d) diff[d] = cpoint[d] - PetscRealPart(point[d]);
@@ -775,6 +828,7 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
       }
     }
   }
+  if (hash) {ierr = ISRestoreIndices(lbox->cells, &boxCells);CHKERRQ(ierr);}
   /* This code is only be relevant when interfaced to parallel point location */
   /* Check for highest numbered proc that claims a point (do we care?) */
   if (ltype == DM_POINTLOCATION_REMOVE && numFound < numPoints) {
@@ -794,9 +848,9 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
   }
   ierr = PetscTime(&t1);CHKERRQ(ierr);
   if (hash) {
-    ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside initial cell] : %D [hash]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2]);CHKERRQ(ierr);
+    ierr = PetscInfo4(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside initial cell] : %D [neighbor of initial cell] : %D [hash]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2],terminating_query_type[3]);CHKERRQ(ierr);
   } else {
-    ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside initial cell] : %D [brute-force]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2]);CHKERRQ(ierr);
+    ierr = PetscInfo4(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside initial cell] : %D [neighbor of initial cell] : %D [brute-force]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2],terminating_query_type[3]);CHKERRQ(ierr);
   }
   ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] npoints %D : time(rank0) %1.2e (sec): points/sec %1.4e\n",numPoints,t1-t0,(double)((double)numPoints/(t1-t0)));CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DMPLEX_LocatePoints,0,0,0,0);CHKERRQ(ierr);
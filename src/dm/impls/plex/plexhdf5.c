@@ -1,5 +1,6 @@
 #include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
 #include <petsc/private/isimpl.h>
+#include <petsc/private/hashmapi.h>
 #include <petsc/private/vecimpl.h>
 #include <petsc/private/viewerhdf5impl.h>
 #include <petsclayouthdf5.h>
@@ -318,10 +319,10 @@ PetscErrorCode VecLoad_Plex_HDF5_Native_Internal(Vec v, PetscViewer viewer)
 
 static PetscErrorCode DMPlexWriteTopology_HDF5_Static(DM dm, IS globalPointNumbers, PetscViewer viewer)
 {
-  IS              orderIS, conesIS, cellsIS, orntsIS;
+  IS              orderIS, conesIS, cellsIS, orntsIS, partIS;
   const PetscInt *gpoint;
   PetscInt       *order, *sizes, *cones, *ornts;
-  PetscInt        dim, pStart, pEnd, p, conesSize = 0, cellsSize = 0, c = 0, s = 0;
+  PetscInt        dim, pStart, pEnd, cStart, cEnd, p, conesSize = 0, cellsSize = 0, numCells = 0, c = 0, s = 0;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
@@ -356,6 +357,11 @@ static PetscErrorCode DMPlexWriteTopology_HDF5_Static(DM dm, IS globalPointNumbe
   }
   if (s != conesSize) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_LIB, "Total number of points %d != %d", s, conesSize);
   if (c != cellsSize) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_LIB, "Total number of cone points %d != %d", c, cellsSize);
+  /* Record the number of cells owned by each process, so that a parallel load can reproduce the partition */
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  for (p = cStart; p < cEnd; ++p) if (gpoint[p] >= 0) ++numCells;
+  ierr = ISCreateGeneral(PetscObjectComm((PetscObject) dm), 1, &numCells, PETSC_COPY_VALUES, &partIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) partIS, "partition");CHKERRQ(ierr);
   ierr = ISCreateGeneral(PetscObjectComm((PetscObject) dm), conesSize, order, PETSC_OWN_POINTER, &orderIS);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject) orderIS, "order");CHKERRQ(ierr);
   ierr = ISCreateGeneral(PetscObjectComm((PetscObject) dm), conesSize, sizes, PETSC_OWN_POINTER, &conesIS);CHKERRQ(ierr);
@@ -370,7 +376,9 @@ static PetscErrorCode DMPlexWriteTopology_HDF5_Static(DM dm, IS globalPointNumbe
   ierr = ISView(cellsIS, viewer);CHKERRQ(ierr);
   ierr = PetscViewerHDF5WriteObjectAttribute(viewer, (PetscObject) cellsIS, "cell_dim", PETSC_INT, (void *) &dim);CHKERRQ(ierr);
   ierr = ISView(orntsIS, viewer);CHKERRQ(ierr);
+  ierr = ISView(partIS, viewer);CHKERRQ(ierr);
   ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = ISDestroy(&partIS);CHKERRQ(ierr);
   ierr = ISDestroy(&orderIS);CHKERRQ(ierr);
   ierr = ISDestroy(&conesIS);CHKERRQ(ierr);
   ierr = ISDestroy(&cellsIS);CHKERRQ(ierr);
@@ -821,11 +829,356 @@ PetscErrorCode DMPlexView_HDF5_Internal(DM dm, PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+/* Build the local topology of a distributed mesh directly from a point list read in parallel
+
+  Input Parameters:
++ dm        - The DMPlex
+. Np        - The global number of points
+. numPoints - The number of points read by this process
+. points    - The global number of each point read
+. coneSizes - The cone size of each point read
+. cones     - The cones of the points read, in global point numbers
+. ornts     - The cone orientations of the points read
+- numCells  - The number of cells, points with no support, given to this process, or PETSC_DECIDE
+
+  Output Parameters:
++ layout       - The layout of the global point numbers, used as a directory
+- globalPoints - The global number of each local point of dm
+
+  Note: The points read are first moved to the process owning their global number in layout. Each process then
+  gathers the closure of its cells from this directory, one level per round, so that no process ever holds more
+  than its part of the mesh. A point shared by several processes is owned by the highest rank.
+*/
+static PetscErrorCode DMPlexBuildFromPointListParallel_Static(DM dm, PetscInt Np, PetscInt numPoints, const PetscInt points[], const PetscInt coneSizes[], const PetscInt cones[], const PetscInt ornts[], PetscInt numCells, PetscLayout *layout, IS *globalPoints)
+{
+  MPI_Comm        comm;
+  PetscMPIInt     rank;
+  PetscSF         sfRead, sfDir, sfDirCone, sfPoint;
+  PetscSection    readSection, dirSection;
+  PetscSegBuffer  segPoints, segSizes, segCones, segOrnts;
+  PetscHMapI      g2l;
+  PetscLayout     cellLayout;
+  PetscInt       *remoteOffsets, *dirCones, *dirOrnts, *inCone, *tops, *front, *gpoints, *sizes, *lcones, *lornts, *offsets, *perm, *cone, *ornt;
+  PetscInt        roundStart[9], numRounds = 0, dirStart, dirEnd, nDir, numDirCones, numTops, NTops, topStart = 0, numFront, maxFront, numLocal = 0, maxConeSize = 0, p, c, r;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
+  /* Move the points read to the directory */
+  ierr = PetscLayoutCreate(comm, layout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(*layout, Np);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(*layout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRange(*layout, &dirStart, &dirEnd);CHKERRQ(ierr);
+  nDir = dirEnd - dirStart;
+  ierr = PetscSFCreate(comm, &sfRead);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sfRead, *layout, numPoints, NULL, PETSC_OWN_POINTER, points);CHKERRQ(ierr);
+  ierr = PetscSFCreateInverseSF(sfRead, &sfDir);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfRead);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PETSC_COMM_SELF, &readSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(readSection, 0, numPoints);CHKERRQ(ierr);
+  for (p = 0; p < numPoints; ++p) {ierr = PetscSectionSetDof(readSection, p, coneSizes[p]);CHKERRQ(ierr);}
+  ierr = PetscSectionSetUp(readSection);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PETSC_COMM_SELF, &dirSection);CHKERRQ(ierr);
+  ierr = PetscSFDistributeSection(sfDir, readSection, &remoteOffsets, dirSection);CHKERRQ(ierr);
+  ierr = PetscSFCreateSectionSF(sfDir, readSection, remoteOffsets, dirSection, &sfDirCone);CHKERRQ(ierr);
+  ierr = PetscFree(remoteOffsets);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(dirSection, &numDirCones);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numDirCones, &dirCones, numDirCones, &dirOrnts);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sfDirCone, MPIU_INT, cones, dirCones);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfDirCone, MPIU_INT, cones, dirCones);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sfDirCone, MPIU_INT, ornts, dirOrnts);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfDirCone, MPIU_INT, ornts, dirOrnts);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfDirCone);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfDir);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&readSection);CHKERRQ(ierr);
+  /* Cells are the points which appear in no cone */
+  {
+    PetscSF   sfCone;
+    PetscInt *ones;
+
+    ierr = PetscCalloc1(nDir, &inCone);CHKERRQ(ierr);
+    ierr = PetscMalloc1(numDirCones, &ones);CHKERRQ(ierr);
+    for (c = 0; c < numDirCones; ++c) ones[c] = 1;
+    ierr = PetscSFCreate(comm, &sfCone);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sfCone, *layout, numDirCones, NULL, PETSC_OWN_POINTER, dirCones);CHKERRQ(ierr);
+    ierr = PetscSFReduceBegin(sfCone, MPIU_INT, ones, inCone, MPI_MAX);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sfCone, MPIU_INT, ones, inCone, MPI_MAX);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfCone);CHKERRQ(ierr);
+    ierr = PetscFree(ones);CHKERRQ(ierr);
+  }
+  for (p = 0, numTops = 0; p < nDir; ++p) if (!inCone[p]) ++numTops;
+  ierr = MPI_Exscan(&numTops, &topStart, 1, MPIU_INT, MPI_SUM, comm);CHKERRMPI(ierr);
+  if (!rank) topStart = 0;
+  ierr = MPIU_Allreduce(&numTops, &NTops, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  /* Hand the cells out in blocks of their global numbering */
+  ierr = PetscLayoutCreate(comm, &cellLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(cellLayout, numCells);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(cellLayout, NTops);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(cellLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetLocalSize(cellLayout, &numCells);CHKERRQ(ierr);
+  {
+    PetscSF   sfTop;
+    PetscInt *topIdx, t;
+
+    ierr = PetscMalloc2(numTops, &tops, numTops, &topIdx);CHKERRQ(ierr);
+    for (p = 0, t = 0; p < nDir; ++p) if (!inCone[p]) {tops[t] = dirStart + p; topIdx[t] = topStart + t; ++t;}
+    ierr = PetscMalloc1(numCells, &front);CHKERRQ(ierr);
+    ierr = PetscSFCreate(comm, &sfTop);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sfTop, cellLayout, numTops, NULL, PETSC_OWN_POINTER, topIdx);CHKERRQ(ierr);
+    ierr = PetscSFReduceBegin(sfTop, MPIU_INT, tops, front, MPIU_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sfTop, MPIU_INT, tops, front, MPIU_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfTop);CHKERRQ(ierr);
+    ierr = PetscFree2(tops, topIdx);CHKERRQ(ierr);
+  }
+  ierr = PetscLayoutDestroy(&cellLayout);CHKERRQ(ierr);
+  ierr = PetscFree(inCone);CHKERRQ(ierr);
+  /* Gather the closure of the local cells, one level at a time */
+  ierr = PetscHMapICreate(&g2l);CHKERRQ(ierr);
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 1024, &segPoints);CHKERRQ(ierr);
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 1024, &segSizes);CHKERRQ(ierr);
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 1024, &segCones);CHKERRQ(ierr);
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 1024, &segOrnts);CHKERRQ(ierr);
+  numFront = numCells;
+  for (p = 0; p < numFront; ++p) {ierr = PetscHMapISet(g2l, front[p], p);CHKERRQ(ierr);}
+  while (1) {
+    PetscSF       sfFront, sfFrontCone;
+    PetscSection  frontSection;
+    PetscInt     *fcones, *fornts, *newFront, *buf, numFrontCones, numNew = 0;
+
+    ierr = MPIU_Allreduce(&numFront, &maxFront, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+    if (!maxFront) break;
+    if (numRounds >= 8) SETERRQ(comm, PETSC_ERR_ARG_WRONG, "Mesh closure is deeper than 7 levels");
+    roundStart[numRounds++] = numLocal;
+    ierr = PetscSFCreate(comm, &sfFront);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sfFront, *layout, numFront, NULL, PETSC_OWN_POINTER, front);CHKERRQ(ierr);
+    ierr = PetscSectionCreate(PETSC_COMM_SELF, &frontSection);CHKERRQ(ierr);
+    ierr = PetscSFDistributeSection(sfFront, dirSection, &remoteOffsets, frontSection);CHKERRQ(ierr);
+    ierr = PetscSFCreateSectionSF(sfFront, dirSection, remoteOffsets, frontSection, &sfFrontCone);CHKERRQ(ierr);
+    ierr = PetscFree(remoteOffsets);CHKERRQ(ierr);
+    ierr = PetscSectionGetStorageSize(frontSection, &numFrontCones);CHKERRQ(ierr);
+    ierr = PetscSegBufferGet(segCones, numFrontCones, &fcones);CHKERRQ(ierr);
+    ierr = PetscSegBufferGet(segOrnts, numFrontCones, &fornts);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfFrontCone, MPIU_INT, dirCones, fcones);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfFrontCone, MPIU_INT, dirCones, fcones);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfFrontCone, MPIU_INT, dirOrnts, fornts);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfFrontCone, MPIU_INT, dirOrnts, fornts);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfFrontCone);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfFront);CHKERRQ(ierr);
+    ierr = PetscSegBufferGet(segPoints, numFront, &buf);CHKERRQ(ierr);
+    ierr = PetscArraycpy(buf, front, numFront);CHKERRQ(ierr);
+    ierr = PetscSegBufferGet(segSizes, numFront, &buf);CHKERRQ(ierr);
+    for (p = 0; p < numFront; ++p) {
+      ierr = PetscSectionGetDof(frontSection, p, &buf[p]);CHKERRQ(ierr);
+      maxConeSize = PetscMax(maxConeSize, buf[p]);
+    }
+    ierr = PetscSectionDestroy(&frontSection);CHKERRQ(ierr);
+    numLocal += numFront;
+    /* The new front is made of the cone points not seen yet */
+    ierr = PetscMalloc1(numFrontCones, &newFront);CHKERRQ(ierr);
+    for (c = 0; c < numFrontCones; ++c) {
+      PetscInt lp;
+
+      ierr = PetscHMapIGet(g2l, fcones[c], &lp);CHKERRQ(ierr);
+      if (lp >= 0) continue;
+      ierr = PetscHMapISet(g2l, fcones[c], numLocal + numNew);CHKERRQ(ierr);
+      newFront[numNew++] = fcones[c];
+    }
+    ierr = PetscFree(front);CHKERRQ(ierr);
+    front    = newFront;
+    numFront = numNew;
+  }
+  ierr = PetscFree(front);CHKERRQ(ierr);
+  ierr = PetscFree2(dirCones, dirOrnts);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&dirSection);CHKERRQ(ierr);
+  ierr = PetscSegBufferExtractAlloc(segPoints, &gpoints);CHKERRQ(ierr);
+  ierr = PetscSegBufferExtractAlloc(segSizes, &sizes);CHKERRQ(ierr);
+  ierr = PetscSegBufferExtractAlloc(segCones, &lcones);CHKERRQ(ierr);
+  ierr = PetscSegBufferExtractAlloc(segOrnts, &lornts);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&segPoints);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&segSizes);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&segCones);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&segOrnts);CHKERRQ(ierr);
+  /* Number the levels as cells, vertices, and then the intermediate levels from the top */
+  roundStart[numRounds] = numLocal;
+  ierr = PetscMalloc2(numLocal, &perm, numLocal+1, &offsets);CHKERRQ(ierr);
+  {
+    PetscInt n = 0;
+
+    for (r = 0; r < numRounds; ++r) {
+      const PetscInt rr = !r ? 0 : (r == 1 ? numRounds-1 : r-1);
+
+      for (p = roundStart[rr]; p < roundStart[rr+1]; ++p) perm[p] = n++;
+    }
+  }
+  offsets[0] = 0;
+  for (p = 0; p < numLocal; ++p) offsets[p+1] = offsets[p] + sizes[p];
+  ierr = DMPlexSetChart(dm, 0, numLocal);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) {ierr = DMPlexSetConeSize(dm, perm[p], sizes[p]);CHKERRQ(ierr);}
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(maxConeSize, &cone, maxConeSize, &ornt);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) {
+    for (c = 0; c < sizes[p]; ++c) {
+      PetscInt lp;
+
+      ierr = PetscHMapIGet(g2l, lcones[offsets[p]+c], &lp);CHKERRQ(ierr);
+      cone[c] = perm[lp];
+      ornt[c] = lornts[offsets[p]+c];
+    }
+    ierr = DMPlexSetCone(dm, perm[p], cone);CHKERRQ(ierr);
+    ierr = DMPlexSetConeOrientation(dm, perm[p], ornt);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(cone, ornt);CHKERRQ(ierr);
+  ierr = PetscHMapIDestroy(&g2l);CHKERRQ(ierr);
+  ierr = PetscFree(sizes);CHKERRQ(ierr);
+  ierr = PetscFree(lcones);CHKERRQ(ierr);
+  ierr = PetscFree(lornts);CHKERRQ(ierr);
+  ierr = DMPlexSymmetrize(dm);CHKERRQ(ierr);
+  ierr = DMPlexStratify(dm);CHKERRQ(ierr);
+  /* Renumber the global point numbers, and give every shared point to the highest rank holding it */
+  {
+    PetscSF      sfGlobal;
+    PetscSFNode *remote;
+    PetscInt    *ilocal, *gnum, *owners, *rowners, nleaves = 0;
+
+    ierr = PetscMalloc1(numLocal, &gnum);CHKERRQ(ierr);
+    for (p = 0; p < numLocal; ++p) gnum[perm[p]] = gpoints[p];
+    ierr = PetscFree(gpoints);CHKERRQ(ierr);
+    ierr = PetscMalloc2(2*numLocal, &owners, 2*nDir, &rowners);CHKERRQ(ierr);
+    for (p = 0; p < numLocal; ++p) {owners[2*p] = rank; owners[2*p+1] = p;}
+    for (p = 0; p < nDir; ++p)     {rowners[2*p] = -1; rowners[2*p+1] = -1;}
+    ierr = PetscSFCreate(comm, &sfGlobal);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sfGlobal, *layout, numLocal, NULL, PETSC_OWN_POINTER, gnum);CHKERRQ(ierr);
+    ierr = PetscSFReduceBegin(sfGlobal, MPIU_2INT, owners, rowners, MPI_MAXLOC);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sfGlobal, MPIU_2INT, owners, rowners, MPI_MAXLOC);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfGlobal, MPIU_2INT, rowners, owners);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfGlobal, MPIU_2INT, rowners, owners);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfGlobal);CHKERRQ(ierr);
+    for (p = 0; p < numLocal; ++p) if (owners[2*p] != rank) ++nleaves;
+    ierr = PetscMalloc1(nleaves, &ilocal);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nleaves, &remote);CHKERRQ(ierr);
+    for (p = 0, nleaves = 0; p < numLocal; ++p) {
+      if (owners[2*p] == rank) continue;
+      ilocal[nleaves]       = p;
+      remote[nleaves].rank  = owners[2*p];
+      remote[nleaves].index = owners[2*p+1];
+      ++nleaves;
+    }
+    ierr = PetscFree2(owners, rowners);CHKERRQ(ierr);
+    ierr = PetscSFCreate(comm, &sfPoint);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(sfPoint, numLocal, nleaves, ilocal, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = DMSetPointSF(dm, sfPoint);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfPoint);CHKERRQ(ierr);
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, numLocal, gnum, PETSC_OWN_POINTER, globalPoints);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(perm, offsets);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+
+/* Give the local vertices of dm their coordinates, read in parallel in the order of the global vertex numbers */
+static PetscErrorCode DMPlexDistributeCoordinatesParallel_Static(DM dm, IS globalPoints, Vec vertexCoords)
+{
+  MPI_Comm           comm;
+  PetscSection       coordSection;
+  PetscLayout        vertexLayout;
+  PetscSF            sfVert;
+  Vec                coordinates;
+  MPI_Datatype       coordtype;
+  const PetscInt    *gpoints;
+  const PetscScalar *vcoords;
+  PetscScalar       *coords;
+  PetscInt          *vertices, spatialDim, n, N, vStart, vEnd, v, vMin = PETSC_MAX_INT, vMinGlobal;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = VecGetBlockSize(vertexCoords, &spatialDim);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(vertexCoords, &n);CHKERRQ(ierr);
+  ierr = VecGetSize(vertexCoords, &N);CHKERRQ(ierr);
+  /* Vertices are numbered contiguously, in the same order as the coordinates */
+  ierr = ISGetIndices(globalPoints, &gpoints);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) vMin = PetscMin(vMin, gpoints[v]);
+  ierr = MPIU_Allreduce(&vMin, &vMinGlobal, 1, MPIU_INT, MPI_MIN, comm);CHKERRQ(ierr);
+  ierr = PetscMalloc1(vEnd-vStart, &vertices);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) vertices[v-vStart] = gpoints[v] - vMinGlobal;
+  ierr = ISRestoreIndices(globalPoints, &gpoints);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &vertexLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(vertexLayout, n/spatialDim);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(vertexLayout, N/spatialDim);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(vertexLayout);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sfVert);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sfVert, vertexLayout, vEnd-vStart, NULL, PETSC_OWN_POINTER, vertices);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&vertexLayout);CHKERRQ(ierr);
+  ierr = PetscFree(vertices);CHKERRQ(ierr);
+  ierr = DMSetCoordinateDim(dm, spatialDim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetNumFields(coordSection, 1);CHKERRQ(ierr);
+  ierr = PetscSectionSetFieldComponents(coordSection, 0, spatialDim);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(coordSection, vStart, vEnd);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) {
+    ierr = PetscSectionSetDof(coordSection, v, spatialDim);CHKERRQ(ierr);
+    ierr = PetscSectionSetFieldDof(coordSection, v, 0, spatialDim);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(coordSection);CHKERRQ(ierr);
+  ierr = VecCreate(comm, &coordinates);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(coordinates, spatialDim);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) coordinates, "coordinates");CHKERRQ(ierr);
+  ierr = VecSetSizes(coordinates, (vEnd-vStart)*spatialDim, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecSetType(coordinates, VECSTANDARD);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(vertexCoords, &vcoords);CHKERRQ(ierr);
+  ierr = VecGetArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(spatialDim, MPIU_SCALAR, &coordtype);CHKERRMPI(ierr);
+  ierr = MPI_Type_commit(&coordtype);CHKERRMPI(ierr);
+  ierr = PetscSFBcastBegin(sfVert, coordtype, vcoords, coords);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfVert, coordtype, vcoords, coords);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&coordtype);CHKERRMPI(ierr);
+  ierr = VecRestoreArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(vertexCoords, &vcoords);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);
+  ierr = DMSetCoordinatesLocal(dm, coordinates);CHKERRQ(ierr);
+  ierr = VecDestroy(&coordinates);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Set the label value on every local copy of the points whose global numbers, read in parallel, are in stratumIS */
+static PetscErrorCode DMLabelSetStratumParallel_Static(DMLabel label, PetscInt value, IS stratumIS, PetscLayout layout, PetscSF sfGlobal)
+{
+  PetscSF         sfStratum;
+  const PetscInt *ind;
+  PetscInt       *ones, *dirFlag, *flag, n, nDir, nLocal, p;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = ISGetLocalSize(stratumIS, &n);CHKERRQ(ierr);
+  ierr = ISGetIndices(stratumIS, &ind);CHKERRQ(ierr);
+  ierr = PetscLayoutGetLocalSize(layout, &nDir);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfGlobal, NULL, &nLocal, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n, &ones);CHKERRQ(ierr);
+  ierr = PetscCalloc2(nDir, &dirFlag, nLocal, &flag);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) ones[p] = 1;
+  ierr = PetscSFCreate(PetscObjectComm((PetscObject) sfGlobal), &sfStratum);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sfStratum, layout, n, NULL, PETSC_OWN_POINTER, ind);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(stratumIS, &ind);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sfStratum, MPIU_INT, ones, dirFlag, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sfStratum, MPIU_INT, ones, dirFlag, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfStratum);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sfGlobal, MPIU_INT, dirFlag, flag);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfGlobal, MPIU_INT, dirFlag, flag);CHKERRQ(ierr);
+  for (p = 0; p < nLocal; ++p) if (flag[p]) {ierr = DMLabelSetValue(label, p, value);CHKERRQ(ierr);}
+  ierr = PetscFree(ones);CHKERRQ(ierr);
+  ierr = PetscFree2(dirFlag, flag);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 typedef struct {
   PetscMPIInt rank;
   DM          dm;
   PetscViewer viewer;
   DMLabel     label;
+  PetscLayout layout;   /* Layout of the global point numbers for a parallel load, or NULL */
+  PetscSF     sfGlobal; /* Map from local points to their global numbers for a parallel load, or NULL */
 } LabelCtx;
 
 static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5L_info_t *info, void *op_data)
@@ -845,6 +1198,13 @@ static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5
   ierr = PetscObjectGetName((PetscObject) label, &lname);
   ierr = PetscSNPrintf(group, PETSC_MAX_PATH_LEN, "/labels/%s/%s", lname, name);CHKERRQ(ierr);
   ierr = PetscViewerHDF5PushGroup(viewer, group);CHKERRQ(ierr);
+  if (((LabelCtx *) op_data)->sfGlobal) {
+    ierr = ISLoad(stratumIS, viewer);
+    ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+    ierr = DMLabelSetStratumParallel_Static(label, value, stratumIS, ((LabelCtx *) op_data)->layout, ((LabelCtx *) op_data)->sfGlobal);
+    ierr = ISDestroy(&stratumIS);
+    return (herr_t) ierr;
+  }
   {
     /* Force serial load */
     ierr = PetscViewerHDF5ReadSizes(viewer, "indices", NULL, &N);CHKERRQ(ierr);
@@ -874,7 +1234,7 @@ static herr_t ReadLabelHDF5_Static(hid_t g_id, const char *name, const H5L_info_
   return err;
 }
 
-PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
+static PetscErrorCode DMPlexLoadLabels_HDF5_Static(DM dm, PetscViewer viewer, PetscLayout layout, PetscSF sfGlobal)
 {
   LabelCtx        ctx;
   hid_t           fileId, groupId;
@@ -883,8 +1243,10 @@ PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
 
   PetscFunctionBegin;
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &ctx.rank);CHKERRMPI(ierr);
-  ctx.dm     = dm;
-  ctx.viewer = viewer;
+  ctx.dm       = dm;
+  ctx.viewer   = viewer;
+  ctx.layout   = layout;
+  ctx.sfGlobal = sfGlobal;
   ierr = PetscViewerHDF5PushGroup(viewer, "/labels");CHKERRQ(ierr);
   ierr = PetscViewerHDF5OpenGroup(viewer, &fileId, &groupId);CHKERRQ(ierr);
   PetscStackCallHDF5(H5Literate,(groupId, H5_INDEX_NAME, H5_ITER_NATIVE, &idx, ReadLabelHDF5_Static, &ctx));
@@ -893,8 +1255,115 @@ PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
-/* The first version will read everything onto proc 0, letting the user distribute
-   The next will create a naive partition, and then rebalance after reading
+PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexLoadLabels_HDF5_Static(dm, viewer, NULL, NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Each process reads a contiguous block of every dataset, and the mesh is built directly in distributed form. The
+   cells are partitioned as in the file when it was written by the same number of processes and reusePart is set, and
+   in blocks otherwise. */
+static PetscErrorCode DMPlexLoadParallel_HDF5_Static(DM dm, PetscViewer viewer, PetscBool reusePart)
+{
+  MPI_Comm        comm;
+  PetscLayout     layout;
+  PetscSF         sfGlobal;
+  Vec             vertices;
+  IS              orderIS, conesIS, cellsIS, orntsIS, partIS, globalPoints;
+  const PetscInt *order, *cones, *cells, *ornts, *gpoints;
+  PetscReal       lengthScale;
+  PetscInt        dim, Np, numPoints, numCones = 0, numCells = PETSC_DECIDE, nLocal, p;
+  PetscMPIInt     size;
+  PetscBool       hasPart;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRMPI(ierr);
+  /* Read toplogy */
+  ierr = PetscViewerHDF5PushGroup(viewer, "/topology");CHKERRQ(ierr);
+  ierr = ISCreate(comm, &orderIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) orderIS, "order");CHKERRQ(ierr);
+  ierr = ISCreate(comm, &conesIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) conesIS, "cones");CHKERRQ(ierr);
+  ierr = ISCreate(comm, &cellsIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) cellsIS, "cells");CHKERRQ(ierr);
+  ierr = ISCreate(comm, &orntsIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) orntsIS, "orientation");CHKERRQ(ierr);
+  ierr = ISCreate(comm, &partIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) partIS, "partition");CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadObjectAttribute(viewer, (PetscObject) cellsIS, "cell_dim", PETSC_INT, (void *) &dim);CHKERRQ(ierr);
+  ierr = DMSetDimension(dm, dim);CHKERRQ(ierr);
+  ierr = ISLoad(orderIS, viewer);CHKERRQ(ierr);
+  ierr = ISLoad(conesIS, viewer);CHKERRQ(ierr);
+  ierr = ISGetSize(orderIS, &Np);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(conesIS, &numPoints);CHKERRQ(ierr);
+  ierr = ISGetIndices(conesIS, &cones);CHKERRQ(ierr);
+  for (p = 0; p < numPoints; ++p) numCones += cones[p];
+  /* The cone points must be read along with the points they belong to */
+  ierr = PetscLayoutSetLocalSize(cellsIS->map, numCones);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(orntsIS->map, numCones);CHKERRQ(ierr);
+  ierr = ISLoad(cellsIS, viewer);CHKERRQ(ierr);
+  ierr = ISLoad(orntsIS, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5HasObject(viewer, (PetscObject) partIS, &hasPart);CHKERRQ(ierr);
+  if (hasPart && reusePart) {
+    PetscInt numParts;
+
+    ierr = PetscViewerHDF5ReadSizes(viewer, "partition", NULL, &numParts);CHKERRQ(ierr);
+    if (numParts == size) {
+      const PetscInt *part;
+
+      ierr = PetscLayoutSetLocalSize(partIS->map, 1);CHKERRQ(ierr);
+      ierr = ISLoad(partIS, viewer);CHKERRQ(ierr);
+      ierr = ISGetIndices(partIS, &part);CHKERRQ(ierr);
+      numCells = part[0];
+      ierr = ISRestoreIndices(partIS, &part);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = ISGetIndices(orderIS, &order);CHKERRQ(ierr);
+  ierr = ISGetIndices(cellsIS, &cells);CHKERRQ(ierr);
+  ierr = ISGetIndices(orntsIS, &ornts);CHKERRQ(ierr);
+  ierr = DMPlexBuildFromPointListParallel_Static(dm, Np, numPoints, order, cones, cells, ornts, numCells, &layout, &globalPoints);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(orderIS, &order);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(conesIS, &cones);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(cellsIS, &cells);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(orntsIS, &ornts);CHKERRQ(ierr);
+  ierr = ISDestroy(&orderIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&conesIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&cellsIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&orntsIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&partIS);CHKERRQ(ierr);
+  /* Read geometry */
+  ierr = PetscViewerHDF5PushGroup(viewer, "/geometry");CHKERRQ(ierr);
+  ierr = VecCreate(comm, &vertices);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) vertices, "vertices");CHKERRQ(ierr);
+  ierr = VecLoad(vertices, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = DMPlexGetScale(dm, PETSC_UNIT_LENGTH, &lengthScale);CHKERRQ(ierr);
+  ierr = VecScale(vertices, 1.0/lengthScale);CHKERRQ(ierr);
+  ierr = DMPlexDistributeCoordinatesParallel_Static(dm, globalPoints, vertices);CHKERRQ(ierr);
+  ierr = VecDestroy(&vertices);CHKERRQ(ierr);
+  /* Read labels */
+  ierr = ISGetLocalSize(globalPoints, &nLocal);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalPoints, &gpoints);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sfGlobal);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sfGlobal, layout, nLocal, NULL, PETSC_OWN_POINTER, gpoints);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(globalPoints, &gpoints);CHKERRQ(ierr);
+  ierr = DMPlexLoadLabels_HDF5_Static(dm, viewer, layout, sfGlobal);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfGlobal);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+  ierr = ISDestroy(&globalPoints);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* By default everything is read onto proc 0, letting the user distribute.
+   With -dm_plex_hdf5_parallel_load, each process reads a part of the file and the mesh is created already distributed,
+   with the partition stored in the file unless -dm_plex_hdf5_reuse_partition 0 is given.
 */
 PetscErrorCode DMPlexLoad_HDF5_Internal(DM dm, PetscViewer viewer)
 {
@@ -906,9 +1375,18 @@ PetscErrorCode DMPlexLoad_HDF5_Internal(DM dm, PetscViewer viewer)
   PetscInt       *cone, *ornt;
   PetscInt        dim, spatialDim, N, numVertices, vStart, vEnd, v, pEnd, p, q, maxConeSize = 0, c;
   PetscMPIInt     rank;
+  PetscBool       parallel = PETSC_FALSE, reusePart = PETSC_TRUE;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject) dm), ((PetscObject) dm)->prefix, "DMPlex HDF5 Loader Options", "PetscViewer");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dm_plex_hdf5_parallel_load", "Read the mesh in parallel and create it distributed", NULL, parallel, &parallel, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dm_plex_hdf5_reuse_partition", "Use the partition stored in the file for a parallel load on as many processes", NULL, reusePart, &reusePart, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (parallel) {
+    ierr = DMPlexLoadParallel_HDF5_Static(dm, viewer, reusePart);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &rank);CHKERRMPI(ierr);
   /* Read toplogy */
   ierr = PetscViewerHDF5PushGroup(viewer, "/topology");CHKERRQ(ierr);
@@ -1,4 +1,5 @@
 #include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
+#include <petsc/private/sectionimpl.h>
 
 /*@
   DMPlexCreateClosureIndex - Calculate an index for the given PetscSection for the closure operation on the DM
@@ -14,7 +15,7 @@
 
   Level: intermediate
 
-.seealso DMPlexVecGetClosure(), DMPlexVecRestoreClosure(), DMPlexVecSetClosure(), DMPlexMatSetClosure()
+.seealso DMPlexCreateClosureDofIndex(), DMPlexVecGetClosure(), DMPlexVecRestoreClosure(), DMPlexVecSetClosure(), DMPlexMatSetClosure()
 @*/
 PetscErrorCode DMPlexCreateClosureIndex(DM dm, PetscSection section)
 {
@@ -73,3 +74,298 @@ PetscErrorCode DMPlexCreateClosureIndex(DM dm, PetscSection section)
   ierr = ISDestroy(&closureIS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/*@
+  DMPlexCreateClosureDofIndex - Calculate an index of the dof indices in the closure of each cell for the closure operations on the DM
+
+  Not collective
+
+  Input Parameters:
++ dm         - The DM
+. section    - The section describing the layout in the local vector, or NULL to use the default section
+- idxSection - The section from which to obtain indices: the local section to accelerate DMPlexVecGetClosure() and DMPlexVecSetClosure(),
+               or the global section to accelerate DMPlexMatSetClosure()
+
+  Notes:
+  The index stores, for every cell, the dof indices of its closure with orientations and the closure permutation applied, so
+  that the closure operations become a single gather or scatter. It is attached to idxSection, and is discarded if the
+  closure permutation or the symmetries of the section change. Since the mesh is assumed not to change, the index should be
+  created after the discretization has been set up.
+
+  Sections with sign flips in their symmetries, or meshes with anchors, are not supported.
+
+  Level: intermediate
+
+.seealso DMPlexCreateClosureIndex(), DMPlexVecGetClosure(), DMPlexVecSetClosure(), DMPlexMatSetClosure(), PetscSectionGetClosureDofIndex()
+@*/
+PetscErrorCode DMPlexCreateClosureDofIndex(DM dm, PetscSection section, PetscSection idxSection)
+{
+  PetscSection   anchorSection, clDofSection;
+  IS             clDofIS;
+  PetscInt      *clDofs;
+  PetscInt       cStart, cEnd, c, Nf, f, clSize;
+  PetscBool      pointMajor;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  if (!idxSection) {ierr = DMGetLocalSection(dm, &idxSection);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(idxSection, PETSC_SECTION_CLASSID, 3);
+  ierr = DMPlexGetAnchors(dm, &anchorSection, NULL);CHKERRQ(ierr);
+  if (anchorSection) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Closure dof index is not supported with anchors");
+  ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
+  ierr = PetscSectionGetPointMajor(section, &pointMajor);CHKERRQ(ierr);
+  if (Nf && !pointMajor) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Closure dof index requires a point major section");
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PETSC_COMM_SELF, &clDofSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(clDofSection, cStart, cEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscSection clSection;
+    IS           clPoints;
+    PetscInt    *points = NULL, numPoints, p, dof, cldof = 0;
+    const PetscInt *clp;
+
+    ierr = DMPlexGetCompressedClosure(dm, section, c, &numPoints, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+    for (f = 0; f < PetscMax(1, Nf); ++f) {
+      const PetscInt    **perms = NULL;
+      const PetscScalar **flips = NULL;
+
+      if (Nf) {ierr = PetscSectionGetFieldPointSyms(section, f, numPoints, points, &perms, &flips);CHKERRQ(ierr);}
+      else    {ierr = PetscSectionGetPointSyms(section, numPoints, points, &perms, &flips);CHKERRQ(ierr);}
+      if (flips) {
+        for (p = 0; p < numPoints; ++p) if (flips[p]) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Closure dof index does not support sign flips, found in the closure of cell %D", c);
+      }
+      if (Nf) {ierr = PetscSectionRestoreFieldPointSyms(section, f, numPoints, points, &perms, &flips);CHKERRQ(ierr);}
+      else    {ierr = PetscSectionRestorePointSyms(section, numPoints, points, &perms, &flips);CHKERRQ(ierr);}
+    }
+    for (p = 0; p < numPoints*2; p += 2) {
+      ierr = PetscSectionGetDof(section, points[p], &dof);CHKERRQ(ierr);
+      cldof += dof;
+    }
+    ierr = DMPlexRestoreCompressedClosure(dm, section, c, &numPoints, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+    ierr = PetscSectionSetDof(clDofSection, c, cldof);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(clDofSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(clDofSection, &clSize);CHKERRQ(ierr);
+  ierr = PetscMalloc1(clSize, &clDofs);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *indices, numIndices, cldof, cloff;
+
+    ierr = PetscSectionGetDof(clDofSection, c, &cldof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(clDofSection, c, &cloff);CHKERRQ(ierr);
+    ierr = DMPlexGetClosureIndices(dm, section, idxSection, c, PETSC_TRUE, &numIndices, &indices, NULL, NULL);CHKERRQ(ierr);
+    if (numIndices != cldof) SETERRQ2(PetscObjectComm((PetscObject) dm), PETSC_ERR_PLIB, "Invalid size for closure %D should be %D", numIndices, cldof);
+    ierr = PetscArraycpy(&clDofs[cloff], indices, cldof);CHKERRQ(ierr);
+    ierr = DMPlexRestoreClosureIndices(dm, section, idxSection, c, PETSC_TRUE, &numIndices, &indices, NULL, NULL);CHKERRQ(ierr);
+  }
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, clSize, clDofs, PETSC_OWN_POINTER, &clDofIS);CHKERRQ(ierr);
+  ierr = PetscSectionSetClosureDofIndex(idxSection, (PetscObject) dm, clDofSection, clDofIS);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&clDofSection);CHKERRQ(ierr);
+  ierr = ISDestroy(&clDofIS);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetCellColoring - Get a coloring of the cells such that two cells of the same color share no point in their closures
+
+  Not collective
+
+  Input Parameter:
+. dm - The DM
+
+  Output Parameter:
+. coloring - The coloring, where the indices in each color are cell numbers relative to the start of the cell stratum
+
+  Notes:
+  The coloring is computed greedily on the first call and cached on the DM until the topology changes, for instance through DMPlexSetChart(), DMPlexSymmetrize(), or DMPlexSetCone() on a symmetrized mesh.
+  Since cells of one color touch disjoint sets of dofs, their contributions can be assembled concurrently.
+  The coloring is owned by the DM and should not be destroyed.
+
+  Level: intermediate
+
+.seealso DMPlexSetColoredAssembly(), DMPlexCreateClosureDofIndex()
+@*/
+PetscErrorCode DMPlexGetCellColoring(DM dm, ISColoring *coloring)
+{
+  DM_Plex         *mesh = (DM_Plex *) dm->data;
+  ISColoringValue *colors;
+  PetscInt        *cellColor, *mark;
+  PetscInt         cStart, cEnd, vStart, vEnd, c, Nc = 0;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(coloring, 2);
+  if (mesh->cellColoring) {*coloring = mesh->cellColoring; PetscFunctionReturn(0);}
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc2(cEnd-cStart, &cellColor, cEnd-cStart+1, &mark);CHKERRQ(ierr);
+  for (c = 0; c < cEnd-cStart; ++c) cellColor[c] = -1;
+  for (c = 0; c <= cEnd-cStart; ++c) mark[c]      = -1;
+  /* Cells sharing any closure point also share a vertex, so it is enough to look at the cells in the star of each vertex */
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *closure = NULL, clSize, cl, color;
+
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+    for (cl = 0; cl < clSize*2; cl += 2) {
+      PetscInt *star = NULL, starSize, s;
+
+      if ((closure[cl] < vStart) || (closure[cl] >= vEnd)) continue;
+      ierr = DMPlexGetTransitiveClosure(dm, closure[cl], PETSC_FALSE, &starSize, &star);CHKERRQ(ierr);
+      for (s = 0; s < starSize*2; s += 2) {
+        const PetscInt q = star[s];
+
+        if ((q >= cStart) && (q < cEnd) && (cellColor[q-cStart] >= 0)) mark[cellColor[q-cStart]] = c;
+      }
+      ierr = DMPlexRestoreTransitiveClosure(dm, closure[cl], PETSC_FALSE, &starSize, &star);CHKERRQ(ierr);
+    }
+    ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+    for (color = 0; mark[color] == c; ++color);
+    cellColor[c-cStart] = color;
+    Nc = PetscMax(Nc, color+1);
+  }
+  if (Nc > IS_COLORING_MAX) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_SUP, "Number of cell colors %D exceeds the maximum %D", Nc, (PetscInt) IS_COLORING_MAX);
+  ierr = PetscMalloc1(cEnd-cStart, &colors);CHKERRQ(ierr);
+  for (c = 0; c < cEnd-cStart; ++c) colors[c] = (ISColoringValue) cellColor[c];
+  ierr = PetscFree2(cellColor, mark);CHKERRQ(ierr);
+  ierr = ISColoringCreate(PETSC_COMM_SELF, Nc, cEnd-cStart, colors, PETSC_OWN_POINTER, &mesh->cellColoring);CHKERRQ(ierr);
+  ierr = PetscInfo2(dm, "Colored %D cells with %D colors\n", cEnd-cStart, Nc);CHKERRQ(ierr);
+  *coloring = mesh->cellColoring;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexSetColoredAssembly - Scatter the cell contributions to local vectors color by color
+
+  Logically collective on dm
+
+  Input Parameters:
++ dm  - The DM
+- flg - PETSC_TRUE to assemble by color
+
+  Options Database:
+. -dm_plex_colored_assembly - Assemble by color
+
+  Notes:
+  When this is set, DMPlexComputeResidual_Internal() adds the element vectors into the local residual one color of
+  DMPlexGetCellColoring() at a time, using the closure dof index of the local section (which is created if needed, see
+  DMPlexCreateClosureDofIndex()). Cells of one color are scattered concurrently when PETSc is configured with OpenMP.
+  The order of summation into shared dofs differs from the sequential assembly, so results may differ in the last bits.
+
+  Level: intermediate
+
+.seealso DMPlexGetColoredAssembly(), DMPlexGetCellColoring(), DMPlexCreateClosureDofIndex()
+@*/
+PetscErrorCode DMPlexSetColoredAssembly(DM dm, PetscBool flg)
+{
+  DM_Plex *mesh = (DM_Plex *) dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(dm, flg, 2);
+  mesh->coloredAssembly = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetColoredAssembly - Determine whether cell contributions to local vectors are scattered color by color
+
+  Not collective
+
+  Input Parameter:
+. dm  - The DM
+
+  Output Parameter:
+. flg - PETSC_TRUE if assembling by color
+
+  Level: intermediate
+
+.seealso DMPlexSetColoredAssembly(), DMPlexGetCellColoring()
+@*/
+PetscErrorCode DMPlexGetColoredAssembly(DM dm, PetscBool *flg)
+{
+  DM_Plex *mesh = (DM_Plex *) dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidBoolPointer(flg, 2);
+  *flg = mesh->coloredAssembly;
+  PetscFunctionReturn(0);
+}
+
+/*
+  DMPlexVecSetClosureColored_Internal - Add the element vectors of cells [cStart, cEnd) into v color by color
+
+  Input Parameters:
++ dm      - The DM
+. section - The local section of v
+. v       - The local vector
+. cStart  - The first cell, which must belong to the cell stratum
+. cEnd    - One past the last cell
+. stride  - The stride between element vectors in values
+. values  - The element vectors
+- mode    - ADD_VALUES or ADD_ALL_VALUES
+
+  Output Parameter:
+. done - PETSC_FALSE if colored assembly is not enabled, in which case the caller must assemble the values itself
+
+  Note: No PETSc calls are made inside the loop over the cells of a color, so it is safe to run it with threads.
+*/
+PetscErrorCode DMPlexVecSetClosureColored_Internal(DM dm, PetscSection section, Vec v, PetscInt cStart, PetscInt cEnd, PetscInt stride, const PetscScalar values[], InsertMode mode, PetscBool *done)
+{
+  DM_Plex        *mesh = (DM_Plex *) dm->data;
+  ISColoring      coloring;
+  IS             *colorIS, clDofIS;
+  PetscSection    clDofSection;
+  PetscScalar    *array;
+  const PetscInt *cldofs, *clOff, *clDof;
+  PetscInt        hStart, hEnd, Nc, color;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  if (!mesh->coloredAssembly || cStart >= cEnd) PetscFunctionReturn(0);
+  if ((mode != ADD_VALUES) && (mode != ADD_ALL_VALUES)) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_OUTOFRANGE, "Colored assembly does not support insert mode %d", mode);
+  ierr = DMPlexGetHeightStratum(dm, 0, &hStart, &hEnd);CHKERRQ(ierr);
+  if ((cStart < hStart) || (cEnd > hEnd)) PetscFunctionReturn(0);
+  ierr = PetscSectionGetClosureDofIndex(section, (PetscObject) dm, &clDofSection, &clDofIS);CHKERRQ(ierr);
+  if (!clDofIS) {
+    ierr = DMPlexCreateClosureDofIndex(dm, section, section);CHKERRQ(ierr);
+    ierr = PetscSectionGetClosureDofIndex(section, (PetscObject) dm, &clDofSection, &clDofIS);CHKERRQ(ierr);
+  }
+  if ((clDofSection->pStart != hStart) || (clDofSection->pEnd != hEnd)) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Closure dof index does not cover the cell stratum");
+  ierr = DMPlexGetCellColoring(dm, &coloring);CHKERRQ(ierr);
+  ierr = ISColoringGetIS(coloring, PETSC_USE_POINTER, &Nc, &colorIS);CHKERRQ(ierr);
+  ierr = ISGetIndices(clDofIS, &cldofs);CHKERRQ(ierr);
+  ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+  clOff = clDofSection->atlasOff;
+  clDof = clDofSection->atlasDof;
+  for (color = 0; color < Nc; ++color) {
+    const PetscInt *cells;
+    PetscInt        n, i;
+
+    ierr = ISGetLocalSize(colorIS[color], &n);CHKERRQ(ierr);
+    ierr = ISGetIndices(colorIS[color], &cells);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for
+#endif
+    for (i = 0; i < n; ++i) {
+      const PetscInt     cell = hStart + cells[i];
+      const PetscInt    *idx  = &cldofs[clOff[cells[i]]];
+      const PetscScalar *vals = &values[(cell-cStart)*stride];
+      PetscInt           d;
+
+      if ((cell < cStart) || (cell >= cEnd)) continue;
+      if (mode == ADD_ALL_VALUES) {for (d = 0; d < clDof[cells[i]]; ++d) array[idx[d] < 0 ? -(idx[d]+1) : idx[d]] += vals[d];}
+      else                        {for (d = 0; d < clDof[cells[i]]; ++d) if (idx[d] >= 0) array[idx[d]] += vals[d];}
+    }
+    ierr = ISRestoreIndices(colorIS[color], &cells);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(clDofIS, &cldofs);CHKERRQ(ierr);
+  ierr = ISColoringRestoreIS(coloring, PETSC_USE_POINTER, &colorIS);CHKERRQ(ierr);
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
@@ -1,37 +1,7 @@
 #include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
-#include <petsc/private/hashmapi.h>
-#include <petsc/private/hashmapij.h>
 
 const char * const DMPlexInterpolatedFlags[] = {"none", "partial", "mixed", "full", "DMPlexInterpolatedFlag", "DMPLEX_INTERPOLATED_", NULL};
 
-/* HashIJKL */
-
-#include <petsc/private/hashmap.h>
-
-typedef struct _PetscHashIJKLKey { PetscInt i, j, k, l; } PetscHashIJKLKey;
-
-#define PetscHashIJKLKeyHash(key) \
-  PetscHashCombine(PetscHashCombine(PetscHashInt((key).i),PetscHashInt((key).j)), \
-                   PetscHashCombine(PetscHashInt((key).k),PetscHashInt((key).l)))
-
-#define PetscHashIJKLKeyEqual(k1,k2) \
-  (((k1).i==(k2).i) ? ((k1).j==(k2).j) ? ((k1).k==(k2).k) ? ((k1).l==(k2).l) : 0 : 0 : 0)
-
-PETSC_HASH_MAP(HashIJKL, PetscHashIJKLKey, PetscInt, PetscHashIJKLKeyHash, PetscHashIJKLKeyEqual, -1)
-
-static PetscSFNode _PetscInvalidSFNode = {-1, -1};
-
-typedef struct _PetscHashIJKLRemoteKey { PetscSFNode i, j, k, l; } PetscHashIJKLRemoteKey;
-
-#define PetscHashIJKLRemoteKeyHash(key) \
-  PetscHashCombine(PetscHashCombine(PetscHashInt((key).i.rank + (key).i.index),PetscHashInt((key).j.rank + (key).j.index)), \
-                   PetscHashCombine(PetscHashInt((key).k.rank + (key).k.index),PetscHashInt((key).l.rank + (key).l.index)))
-
-#define PetscHashIJKLRemoteKeyEqual(k1,k2) \
-  (((k1).i.rank==(k2).i.rank) ? ((k1).i.index==(k2).i.index) ? ((k1).j.rank==(k2).j.rank) ? ((k1).j.index==(k2).j.index) ? ((k1).k.rank==(k2).k.rank) ? ((k1).k.index==(k2).k.index) ? ((k1).l.rank==(k2).l.rank) ? ((k1).l.index==(k2).l.index) : 0 : 0 : 0 : 0 : 0 : 0 : 0)
-
-PETSC_HASH_MAP(HashIJKLRemote, PetscHashIJKLRemoteKey, PetscSFNode, PetscHashIJKLRemoteKeyHash, PetscHashIJKLRemoteKeyEqual, _PetscInvalidSFNode)
-
 static PetscErrorCode PetscSortSFNode(PetscInt n, PetscSFNode A[])
 {
   PetscInt i;
@@ -42,7 +12,7 @@ static PetscErrorCode PetscSortSFNode(PetscInt n, PetscSFNode A[])
     PetscInt    j;
 
     for (j = i-1; j >= 0; --j) {
-      if ((A[j].rank > x.rank) || (A[j].rank == x.rank && A[j].index > x.index)) break;
+      if ((A[j].rank < x.rank) || (A[j].rank == x.rank && A[j].index < x.index)) break;
       A[j+1] = A[j];
     }
     A[j+1] = x;
@@ -326,96 +296,160 @@ PetscErrorCode DMPlexRestoreRawFaces_Internal(DM dm, DMPolytopeType ct, const Pe
   PetscFunctionReturn(0);
 }
 
-/* This interpolates faces for cells at some stratum */
-static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth, DM idm)
+#if defined(PETSC_HAVE_OPENMP)
+extern PetscInt PetscNumOMPThreads;
+#endif
+
+/*
+  DMPlexSortFaceKeys_Private - Stable LSD radix sort of face keys, using the range of point numbers as the radix
+
+  Input Parameters:
++ n       - The number of keys
+. keySize - The number of significant components in each key, at most 4
+. keys    - The keys, 4 components each with unused components set to PETSC_MAX_INT
+. kMin    - The smallest point number in the keys
+- kMax    - The largest point number in the keys
+
+  Output Parameter:
+. perm    - The keys in sorted order, with equal keys left in their original order
+
+  Note: With OpenMP, each thread counts and scatters a contiguous block of the keys. The offsets are ordered by bucket
+  and then by thread, so the sort remains stable.
+*/
+static PetscErrorCode DMPlexSortFaceKeys_Private(PetscInt n, PetscInt keySize, const PetscInt keys[], PetscInt kMin, PetscInt kMax, PetscInt perm[])
 {
-  DMLabel        ctLabel;
-  PetscHashIJKL  faceTable;
-  PetscInt       faceTypeNum[DM_NUM_POLYTOPES];
-  PetscInt       depth, d, Np, cStart, cEnd, c, fStart, fEnd;
+  const PetscInt nb = kMax - kMin + 2;
+  PetscInt      *count, *tmp, Nt = 1, off, i, k, b, t;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  for (i = 0; i < n; ++i) perm[i] = i;
+  if (!n) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_OPENMP)
+  Nt = PetscMax(1, PetscMin(PetscNumOMPThreads, n/nb));
+#endif
+  ierr = PetscMalloc2(Nt*nb, &count, n, &tmp);CHKERRQ(ierr);
+  for (k = keySize-1; k >= 0; --k) {
+    ierr = PetscArrayzero(count, Nt*nb);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(Nt) private(i)
+#endif
+    for (t = 0; t < Nt; ++t) {
+      for (i = (n*t)/Nt; i < (n*(t+1))/Nt; ++i) {
+        const PetscInt key = keys[perm[i]*4+k];
+
+        ++count[t*nb + (key == PETSC_MAX_INT ? nb-1 : key-kMin)];
+      }
+    }
+    for (b = 0, off = 0; b < nb; ++b) {
+      for (t = 0; t < Nt; ++t) {
+        const PetscInt c = count[t*nb+b];
+
+        count[t*nb+b] = off;
+        off += c;
+      }
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(Nt) private(i)
+#endif
+    for (t = 0; t < Nt; ++t) {
+      for (i = (n*t)/Nt; i < (n*(t+1))/Nt; ++i) {
+        const PetscInt key = keys[perm[i]*4+k];
+
+        tmp[count[t*nb + (key == PETSC_MAX_INT ? nb-1 : key-kMin)]++] = perm[i];
+      }
+    }
+    ierr = PetscArraycpy(perm, tmp, n);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(count, tmp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  DMPlexInterpolateFaces_Internal - This interpolates faces for cells at some stratum
+
+  Note: Every (cell, face) incidence gets the sorted vertices of the face as its key. The keys are radix sorted, so that
+  all incidences of a face are adjacent, and faces are numbered contiguously by type in the order they are first met.
+*/
+static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth, DM idm)
+{
+  DMLabel         ctLabel;
+  PetscSegBuffer  segKeys, segTypes;
+  DMPolytopeType *incType;
+  PetscInt       *keys, *perm, *incFace, *faceNum;
+  PetscInt        faceTypeNum[DM_NUM_POLYTOPES];
+  PetscInt        depth, d, Np, cStart, cEnd, c, fStart, fEnd, numInc = 0, inc, numNewFaces = 0, maxFaceSize = 0, kMin = PETSC_MAX_INT, kMax = PETSC_MIN_INT;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(DMPLEX_InterpolateFaces,dm,0,0,0);CHKERRQ(ierr);
   ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
-  ierr = PetscHashIJKLCreate(&faceTable);CHKERRQ(ierr);
   ierr = PetscArrayzero(faceTypeNum, DM_NUM_POLYTOPES);CHKERRQ(ierr);
   ierr = DMPlexGetDepthStratum(dm, cellDepth, &cStart, &cEnd);CHKERRQ(ierr);
-  /* Number new faces and save face vertices in hash table */
   ierr = DMPlexGetDepthStratum(dm, depth > cellDepth ? cellDepth : 0, NULL, &fStart);CHKERRQ(ierr);
-  fEnd = fStart;
+  /* Make a key for each (cell, face) incidence */
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 4*(cEnd-cStart)*4, &segKeys);CHKERRQ(ierr);
+  ierr = PetscSegBufferCreate(sizeof(DMPolytopeType), (cEnd-cStart)*4, &segTypes);CHKERRQ(ierr);
   for (c = cStart; c < cEnd; ++c) {
     const PetscInt       *cone, *faceSizes, *faces;
     const DMPolytopeType *faceTypes;
-    DMPolytopeType        ct;
-    PetscInt              numFaces, cf, foff = 0;
+    DMPolytopeType        ct, *types;
+    PetscInt              numCellFaces, cf, foff = 0, *key;
 
     ierr = DMPlexGetCellType(dm, c, &ct);CHKERRQ(ierr);
     ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
-    ierr = DMPlexGetRawFaces_Internal(dm, ct, cone, &numFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
-    for (cf = 0; cf < numFaces; foff += faceSizes[cf], ++cf) {
-      const PetscInt       faceSize = faceSizes[cf];
-      const DMPolytopeType faceType = faceTypes[cf];
-      const PetscInt      *face     = &faces[foff];
-      PetscHashIJKLKey     key;
-      PetscHashIter        iter;
-      PetscBool            missing;
+    ierr = DMPlexGetRawFaces_Internal(dm, ct, cone, &numCellFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
+    ierr = PetscSegBufferGet(segKeys, 4*numCellFaces, &key);CHKERRQ(ierr);
+    ierr = PetscSegBufferGet(segTypes, numCellFaces, &types);CHKERRQ(ierr);
+    for (cf = 0; cf < numCellFaces; foff += faceSizes[cf], ++cf, key += 4) {
+      const PetscInt  faceSize = faceSizes[cf];
+      const PetscInt *face     = &faces[foff];
+      PetscInt        k;
 
       if (faceSize > 4) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Do not support faces of size %D > 4", faceSize);
-      key.i = face[0];
-      key.j = faceSize > 1 ? face[1] : PETSC_MAX_INT;
-      key.k = faceSize > 2 ? face[2] : PETSC_MAX_INT;
-      key.l = faceSize > 3 ? face[3] : PETSC_MAX_INT;
-      ierr = PetscSortInt(faceSize, (PetscInt *) &key);CHKERRQ(ierr);
-      ierr = PetscHashIJKLPut(faceTable, key, &iter, &missing);CHKERRQ(ierr);
-      if (missing) {
-        ierr = PetscHashIJKLIterSet(faceTable, iter, fEnd++);CHKERRQ(ierr);
-        ++faceTypeNum[faceType];
-      }
+      for (k = 0; k < 4; ++k) key[k] = k < faceSize ? face[k] : PETSC_MAX_INT;
+      ierr = PetscSortInt(faceSize, key);CHKERRQ(ierr);
+      for (k = 0; k < faceSize; ++k) {kMin = PetscMin(kMin, key[k]); kMax = PetscMax(kMax, key[k]);}
+      maxFaceSize = PetscMax(maxFaceSize, faceSize);
+      types[cf]   = faceTypes[cf];
+    }
+    numInc += numCellFaces;
+    ierr = DMPlexRestoreRawFaces_Internal(dm, ct, cone, &numCellFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
+  }
+  ierr = PetscSegBufferExtractAlloc(segKeys, &keys);CHKERRQ(ierr);
+  ierr = PetscSegBufferExtractAlloc(segTypes, &incType);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&segKeys);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&segTypes);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numInc, &perm, numInc, &incFace);CHKERRQ(ierr);
+  /* Identify each face with the first incidence of its key */
+  ierr = DMPlexSortFaceKeys_Private(numInc, maxFaceSize, keys, kMin, kMax, perm);CHKERRQ(ierr);
+  for (inc = 0; inc < numInc; ++inc) {
+    const PetscInt *key  = &keys[perm[inc]*4];
+    const PetscInt *prev = inc ? &keys[perm[inc-1]*4] : NULL;
+
+    if (prev && key[0] == prev[0] && key[1] == prev[1] && key[2] == prev[2] && key[3] == prev[3]) {
+      incFace[perm[inc]] = incFace[perm[inc-1]];
+    } else {
+      incFace[perm[inc]] = perm[inc];
+      ++numNewFaces;
     }
-    ierr = DMPlexRestoreRawFaces_Internal(dm, ct, cone, &numFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
   }
-  /* We need to number faces contiguously among types */
+  ierr = PetscFree(keys);CHKERRQ(ierr);
+  /* We need to number faces contiguously among types, in the order they are first met */
   {
-    PetscInt faceTypeStart[DM_NUM_POLYTOPES], ct, numFT = 0;
-
-    for (ct = 0; ct < DM_NUM_POLYTOPES; ++ct) {if (faceTypeNum[ct]) ++numFT; faceTypeStart[ct] = 0;}
-    if (numFT > 1) {
-      ierr = PetscHashIJKLClear(faceTable);CHKERRQ(ierr);
-      faceTypeStart[0] = fStart;
-      for (ct = 1; ct < DM_NUM_POLYTOPES; ++ct) faceTypeStart[ct] = faceTypeStart[ct-1] + faceTypeNum[ct-1];
-      for (c = cStart; c < cEnd; ++c) {
-        const PetscInt       *cone, *faceSizes, *faces;
-        const DMPolytopeType *faceTypes;
-        DMPolytopeType        ct;
-        PetscInt              numFaces, cf, foff = 0;
-
-        ierr = DMPlexGetCellType(dm, c, &ct);CHKERRQ(ierr);
-        ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
-        ierr = DMPlexGetRawFaces_Internal(dm, ct, cone, &numFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
-        for (cf = 0; cf < numFaces; foff += faceSizes[cf], ++cf) {
-          const PetscInt       faceSize = faceSizes[cf];
-          const DMPolytopeType faceType = faceTypes[cf];
-          const PetscInt      *face     = &faces[foff];
-          PetscHashIJKLKey     key;
-          PetscHashIter        iter;
-          PetscBool            missing;
-
-          if (faceSize > 4) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Do not support faces of size %D > 4", faceSize);
-          key.i = face[0];
-          key.j = faceSize > 1 ? face[1] : PETSC_MAX_INT;
-          key.k = faceSize > 2 ? face[2] : PETSC_MAX_INT;
-          key.l = faceSize > 3 ? face[3] : PETSC_MAX_INT;
-          ierr = PetscSortInt(faceSize, (PetscInt *) &key);CHKERRQ(ierr);
-          ierr = PetscHashIJKLPut(faceTable, key, &iter, &missing);CHKERRQ(ierr);
-          if (missing) {ierr = PetscHashIJKLIterSet(faceTable, iter, faceTypeStart[faceType]++);CHKERRQ(ierr);}
-        }
-        ierr = DMPlexRestoreRawFaces_Internal(dm, ct, cone, &numFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
-      }
-      for (ct = 1; ct < DM_NUM_POLYTOPES; ++ct) {
-        if (faceTypeStart[ct] != faceTypeStart[ct-1] + faceTypeNum[ct]) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Inconsistent numbering for cell type %s, %D != %D + %D", DMPolytopeTypes[ct], faceTypeStart[ct], faceTypeStart[ct-1], faceTypeNum[ct]);
-      }
+    PetscInt faceTypeStart[DM_NUM_POLYTOPES], ct;
+
+    for (inc = 0; inc < numInc; ++inc) if (incFace[inc] == inc) ++faceTypeNum[incType[inc]];
+    faceTypeStart[0] = fStart;
+    for (ct = 1; ct < DM_NUM_POLYTOPES; ++ct) faceTypeStart[ct] = faceTypeStart[ct-1] + faceTypeNum[ct-1];
+    faceNum = perm;
+    for (inc = 0; inc < numInc; ++inc) {
+      if (incFace[inc] == inc) faceNum[inc] = faceTypeStart[incType[inc]]++;
+      incFace[inc] = faceNum[incFace[inc]];
     }
   }
+  fEnd = fStart + numNewFaces;
+  ierr = PetscLogEventEnd(DMPLEX_InterpolateFaces,dm,0,0,0);CHKERRQ(ierr);
   /* Add new points, always at the end of the numbering */
   ierr = DMPlexGetChart(dm, NULL, &Np);CHKERRQ(ierr);
   ierr = DMPlexSetChart(idm, 0, Np + (fEnd - fStart));CHKERRQ(ierr);
@@ -436,37 +470,20 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
       ierr = DMPlexSetCellType(idm, p, ct);CHKERRQ(ierr);
     }
   }
-  for (c = cStart; c < cEnd; ++c) {
+  for (c = cStart, inc = 0; c < cEnd; ++c) {
     const PetscInt       *cone, *faceSizes, *faces;
     const DMPolytopeType *faceTypes;
     DMPolytopeType        ct;
-    PetscInt              numFaces, cf, foff = 0;
+    PetscInt              numFaces, cf;
 
     ierr = DMPlexGetCellType(dm, c, &ct);CHKERRQ(ierr);
     ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
     ierr = DMPlexGetRawFaces_Internal(dm, ct, cone, &numFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
     ierr = DMPlexSetCellType(idm, c, ct);CHKERRQ(ierr);
     ierr = DMPlexSetConeSize(idm, c, numFaces);CHKERRQ(ierr);
-    for (cf = 0; cf < numFaces; foff += faceSizes[cf], ++cf) {
-      const PetscInt       faceSize = faceSizes[cf];
-      const DMPolytopeType faceType = faceTypes[cf];
-      const PetscInt      *face     = &faces[foff];
-      PetscHashIJKLKey     key;
-      PetscHashIter        iter;
-      PetscBool            missing;
-      PetscInt             f;
-
-      if (faceSize > 4) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Do not support faces of size %D > 4", faceSize);
-      key.i = face[0];
-      key.j = faceSize > 1 ? face[1] : PETSC_MAX_INT;
-      key.k = faceSize > 2 ? face[2] : PETSC_MAX_INT;
-      key.l = faceSize > 3 ? face[3] : PETSC_MAX_INT;
-      ierr = PetscSortInt(faceSize, (PetscInt *) &key);CHKERRQ(ierr);
-      ierr = PetscHashIJKLPut(faceTable, key, &iter, &missing);CHKERRQ(ierr);
-      if (missing) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Missing face (cell %D, lf %D)", c, cf);
-      ierr = PetscHashIJKLIterGet(faceTable, iter, &f);CHKERRQ(ierr);
-      ierr = DMPlexSetConeSize(idm, f, faceSize);CHKERRQ(ierr);
-      ierr = DMPlexSetCellType(idm, f, faceType);CHKERRQ(ierr);
+    for (cf = 0; cf < numFaces; ++cf, ++inc) {
+      ierr = DMPlexSetConeSize(idm, incFace[inc], faceSizes[cf]);CHKERRQ(ierr);
+      ierr = DMPlexSetCellType(idm, incFace[inc], faceTypes[cf]);CHKERRQ(ierr);
     }
     ierr = DMPlexRestoreRawFaces_Internal(dm, ct, cone, &numFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
   }
@@ -495,7 +512,7 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
       ierr = DMPlexSetConeOrientation(idm, p, cone);CHKERRQ(ierr);
     }
   }
-  for (c = cStart; c < cEnd; ++c) {
+  for (c = cStart, inc = 0; c < cEnd; ++c) {
     const PetscInt       *cone, *faceSizes, *faces;
     const DMPolytopeType *faceTypes;
     DMPolytopeType        ct;
@@ -504,24 +521,13 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
     ierr = DMPlexGetCellType(dm, c, &ct);CHKERRQ(ierr);
     ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
     ierr = DMPlexGetRawFaces_Internal(dm, ct, cone, &numFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
-    for (cf = 0; cf < numFaces; foff += faceSizes[cf], ++cf) {
+    for (cf = 0; cf < numFaces; foff += faceSizes[cf], ++cf, ++inc) {
       DMPolytopeType   faceType = faceTypes[cf];
       const PetscInt   faceSize = faceSizes[cf];
       const PetscInt  *face     = &faces[foff];
+      const PetscInt   f        = incFace[inc];
       const PetscInt  *fcone;
-      PetscHashIJKLKey key;
-      PetscHashIter    iter;
-      PetscBool        missing;
-      PetscInt         f;
 
-      if (faceSize > 4) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Do not support faces of size %D > 4", faceSize);
-      key.i = face[0];
-      key.j = faceSize > 1 ? face[1] : PETSC_MAX_INT;
-      key.k = faceSize > 2 ? face[2] : PETSC_MAX_INT;
-      key.l = faceSize > 3 ? face[3] : PETSC_MAX_INT;
-      ierr = PetscSortInt(faceSize, (PetscInt *) &key);CHKERRQ(ierr);
-      ierr = PetscHashIJKLPut(faceTable, key, &iter, &missing);CHKERRQ(ierr);
-      ierr = PetscHashIJKLIterGet(faceTable, iter, &f);CHKERRQ(ierr);
       ierr = DMPlexInsertCone(idm, c, cf, f);CHKERRQ(ierr);
       ierr = DMPlexGetCone(idm, f, &fcone);CHKERRQ(ierr);
       if (fcone[0] < 0) {ierr = DMPlexSetCone(idm, f, face);CHKERRQ(ierr);}
@@ -576,7 +582,8 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
     }
     ierr = DMPlexRestoreRawFaces_Internal(dm, ct, cone, &numFaces, &faceTypes, &faceSizes, &faces);CHKERRQ(ierr);
   }
-  ierr = PetscHashIJKLDestroy(&faceTable);CHKERRQ(ierr);
+  ierr = PetscFree(incType);CHKERRQ(ierr);
+  ierr = PetscFree2(perm, incFace);CHKERRQ(ierr);
   ierr = DMPlexSymmetrize(idm);CHKERRQ(ierr);
   ierr = DMPlexStratify(idm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -633,6 +640,7 @@ PetscErrorCode DMPlexOrientInterface_Internal(DM dm)
   ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
   ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &locals, &remotes);CHKERRQ(ierr);
   if (nroots < 0) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(DMPLEX_InterpolateOrient,dm,0,0,0);CHKERRQ(ierr);
   ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
   ierr = PetscSFGetRootRanks(sf, &nranks, &ranks, &roffset, NULL, NULL);CHKERRQ(ierr);
   ierr = DMViewFromOptions(dm, NULL, "-before_fix_dm_view");CHKERRQ(ierr);
@@ -715,6 +723,7 @@ PetscErrorCode DMPlexOrientInterface_Internal(DM dm)
   ierr = DMViewFromOptions(dm, NULL, "-after_fix_dm_view");CHKERRQ(ierr);
   ierr = PetscFree4(roots, leaves, rootsRanks, leavesRanks);CHKERRQ(ierr);
   ierr = PetscFree2(rmine1, rremote1);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_InterpolateOrient,dm,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -756,202 +765,23 @@ static PetscErrorCode SFNodeArrayViewFromOptions(MPI_Comm comm, const char opt[]
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode DMPlexMapToLocalPoint(DM dm, PetscHMapIJ remotehash, PetscSFNode remotePoint, PetscInt *localPoint)
-{
-  PetscSF         sf;
-  const PetscInt *locals;
-  PetscMPIInt     rank;
-  PetscErrorCode  ierr;
+typedef struct {
+  PetscSFNode key[4]; /* The cone of the face as sorted (owner rank, owner point) pairs, padded with PETSC_MAX_INT */
+  PetscSFNode face;   /* The face as (rank, local point) */
+} DMPlexSharedFace;
 
-  PetscFunctionBegin;
-  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &rank);CHKERRMPI(ierr);
-  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
-  ierr = PetscSFGetGraph(sf, NULL, NULL, &locals, NULL);CHKERRQ(ierr);
-  if (remotePoint.rank == rank) {
-    *localPoint = remotePoint.index;
-  } else {
-    PetscHashIJKey key;
-    PetscInt       l;
-
-    key.i = remotePoint.index;
-    key.j = remotePoint.rank;
-    ierr = PetscHMapIJGet(remotehash, key, &l);CHKERRQ(ierr);
-    if (l >= 0) {
-      *localPoint = locals[l];
-    } else PetscFunctionReturn(1);
-  }
-  PetscFunctionReturn(0);
-}
-
-static PetscErrorCode DMPlexMapToGlobalPoint(DM dm, PetscInt localPoint, PetscSFNode *remotePoint)
-{
-  PetscSF            sf;
-  const PetscInt    *locals, *rootdegree;
-  const PetscSFNode *remotes;
-  PetscInt           Nl, l;
-  PetscMPIInt        rank;
-  PetscErrorCode     ierr;
-
-  PetscFunctionBegin;
-  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &rank);CHKERRMPI(ierr);
-  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
-  ierr = PetscSFGetGraph(sf, NULL, &Nl, &locals, &remotes);CHKERRQ(ierr);
-  if (Nl < 0) goto owned;
-  ierr = PetscSFComputeDegreeBegin(sf, &rootdegree);CHKERRQ(ierr);
-  ierr = PetscSFComputeDegreeEnd(sf, &rootdegree);CHKERRQ(ierr);
-  if (rootdegree[localPoint]) goto owned;
-  ierr = PetscFindInt(localPoint, Nl, locals, &l);CHKERRQ(ierr);
-  if (l < 0) PetscFunctionReturn(1);
-  *remotePoint = remotes[l];
-  PetscFunctionReturn(0);
-  owned:
-  remotePoint->rank  = rank;
-  remotePoint->index = localPoint;
-  PetscFunctionReturn(0);
-}
-
-
-static PetscErrorCode DMPlexPointIsShared(DM dm, PetscInt p, PetscBool *isShared)
+static int DMPlexSharedFaceCompare_Private(const void *a, const void *b, void *ctx)
 {
-  PetscSF         sf;
-  const PetscInt *locals, *rootdegree;
-  PetscInt        Nl, idx;
-  PetscErrorCode  ierr;
-
-  PetscFunctionBegin;
-  *isShared = PETSC_FALSE;
-  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
-  ierr = PetscSFGetGraph(sf, NULL, &Nl, &locals, NULL);CHKERRQ(ierr);
-  if (Nl < 0) PetscFunctionReturn(0);
-  ierr = PetscFindInt(p, Nl, locals, &idx);CHKERRQ(ierr);
-  if (idx >= 0) {*isShared = PETSC_TRUE; PetscFunctionReturn(0);}
-  ierr = PetscSFComputeDegreeBegin(sf, &rootdegree);CHKERRQ(ierr);
-  ierr = PetscSFComputeDegreeEnd(sf, &rootdegree);CHKERRQ(ierr);
-  if (rootdegree[p] > 0) *isShared = PETSC_TRUE;
-  PetscFunctionReturn(0);
-}
-
-static PetscErrorCode DMPlexConeIsShared(DM dm, PetscInt p, PetscBool *isShared)
-{
-  const PetscInt *cone;
-  PetscInt        coneSize, c;
-  PetscBool       cShared = PETSC_TRUE;
-  PetscErrorCode  ierr;
-
-  PetscFunctionBegin;
-  ierr = DMPlexGetConeSize(dm, p, &coneSize);CHKERRQ(ierr);
-  ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
-  for (c = 0; c < coneSize; ++c) {
-    PetscBool pointShared;
-
-    ierr = DMPlexPointIsShared(dm, cone[c], &pointShared);CHKERRQ(ierr);
-    cShared = (PetscBool) (cShared && pointShared);
+  const DMPlexSharedFace *faces = (const DMPlexSharedFace *) ctx;
+  const PetscSFNode      *ka    = faces[*(const PetscInt *) a].key;
+  const PetscSFNode      *kb    = faces[*(const PetscInt *) b].key;
+  PetscInt                k;
+
+  for (k = 0; k < 4; ++k) {
+    if (ka[k].rank  != kb[k].rank)  return ka[k].rank  < kb[k].rank  ? -1 : 1;
+    if (ka[k].index != kb[k].index) return ka[k].index < kb[k].index ? -1 : 1;
   }
-  *isShared = coneSize ? cShared : PETSC_FALSE;
-  PetscFunctionReturn(0);
-}
-
-static PetscErrorCode DMPlexGetConeMinimum(DM dm, PetscInt p, PetscSFNode *cpmin)
-{
-  const PetscInt *cone;
-  PetscInt        coneSize, c;
-  PetscSFNode     cmin = {PETSC_MAX_INT, PETSC_MAX_INT}, missing = {-1, -1};
-  PetscErrorCode  ierr;
-
-  PetscFunctionBegin;
-  ierr = DMPlexGetConeSize(dm, p, &coneSize);CHKERRQ(ierr);
-  ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
-  for (c = 0; c < coneSize; ++c) {
-    PetscSFNode rcp;
-
-    ierr = DMPlexMapToGlobalPoint(dm, cone[c], &rcp);
-    if (ierr) {
-      cmin = missing;
-    } else {
-      cmin = (rcp.rank < cmin.rank) || (rcp.rank == cmin.rank && rcp.index < cmin.index) ? rcp : cmin;
-    }
-  }
-  *cpmin = coneSize ? cmin : missing;
-  PetscFunctionReturn(0);
-}
-
-/*
-  Each shared face has an entry in the candidates array:
-    (-1, coneSize-1), {(global cone point)}
-  where the set is missing the point p which we use as the key for the face
-*/
-static PetscErrorCode DMPlexAddSharedFace_Private(DM dm, PetscSection candidateSection, PetscSFNode candidates[], PetscHMapIJ faceHash, PetscInt p, PetscBool debug)
-{
-  MPI_Comm        comm;
-  const PetscInt *support;
-  PetscInt        supportSize, s, off = 0, idx = 0, overlap, cellHeight, height;
-  PetscMPIInt     rank;
-  PetscErrorCode  ierr;
-
-  PetscFunctionBegin;
-  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
-  ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
-  ierr = DMPlexGetOverlap(dm, &overlap);CHKERRQ(ierr);
-  ierr = DMPlexGetVTKCellHeight(dm, &cellHeight);CHKERRQ(ierr);
-  ierr = DMPlexGetPointHeight(dm, p, &height);CHKERRQ(ierr);
-  if (!overlap && height <= cellHeight+1) {
-    /* cells can't be shared for non-overlapping meshes */
-    if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]    Skipping face %D to avoid adding cell to hashmap since this is nonoverlapping mesh\n", rank, p);CHKERRQ(ierr);}
-    PetscFunctionReturn(0);
-  }
-  ierr = DMPlexGetSupportSize(dm, p, &supportSize);CHKERRQ(ierr);
-  ierr = DMPlexGetSupport(dm, p, &support);CHKERRQ(ierr);
-  if (candidates) {ierr = PetscSectionGetOffset(candidateSection, p, &off);CHKERRQ(ierr);}
-  for (s = 0; s < supportSize; ++s) {
-    const PetscInt  face = support[s];
-    const PetscInt *cone;
-    PetscSFNode     cpmin={-1,-1}, rp={-1,-1};
-    PetscInt        coneSize, c, f;
-    PetscBool       isShared = PETSC_FALSE;
-    PetscHashIJKey  key;
-
-    /* Only add point once */
-    if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]    Support face %D\n", rank, face);CHKERRQ(ierr);}
-    key.i = p;
-    key.j = face;
-    ierr = PetscHMapIJGet(faceHash, key, &f);CHKERRQ(ierr);
-    if (f >= 0) continue;
-    ierr = DMPlexConeIsShared(dm, face, &isShared);CHKERRQ(ierr);
-    ierr = DMPlexGetConeMinimum(dm, face, &cpmin);CHKERRQ(ierr);
-    ierr = DMPlexMapToGlobalPoint(dm, p, &rp);CHKERRQ(ierr);
-    if (debug) {
-      ierr = PetscSynchronizedPrintf(comm, "[%d]      Face point %D is shared: %d\n", rank, face, (int) isShared);CHKERRQ(ierr);
-      ierr = PetscSynchronizedPrintf(comm, "[%d]      Global point (%D, %D) Min Cone Point (%D, %D)\n", rank, rp.rank, rp.index, cpmin.rank, cpmin.index);CHKERRQ(ierr);
-    }
-    if (isShared && (rp.rank == cpmin.rank && rp.index == cpmin.index)) {
-      ierr = PetscHMapIJSet(faceHash, key, p);CHKERRQ(ierr);
-      if (candidates) {
-        if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]    Adding shared face %D at idx %D\n[%d]     ", rank, face, idx, rank);CHKERRQ(ierr);}
-        ierr = DMPlexGetConeSize(dm, face, &coneSize);CHKERRQ(ierr);
-        ierr = DMPlexGetCone(dm, face, &cone);CHKERRQ(ierr);
-        candidates[off+idx].rank    = -1;
-        candidates[off+idx++].index = coneSize-1;
-        candidates[off+idx].rank    = rank;
-        candidates[off+idx++].index = face;
-        for (c = 0; c < coneSize; ++c) {
-          const PetscInt cp = cone[c];
-
-          if (cp == p) continue;
-          ierr = DMPlexMapToGlobalPoint(dm, cp, &candidates[off+idx]);CHKERRQ(ierr);
-          if (debug) {ierr = PetscSynchronizedPrintf(comm, " (%D,%D)", candidates[off+idx].rank, candidates[off+idx].index);CHKERRQ(ierr);}
-          ++idx;
-        }
-        if (debug) {ierr = PetscSynchronizedPrintf(comm, "\n");CHKERRQ(ierr);}
-      } else {
-        /* Add cone size to section */
-        if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]    Scheduling shared face %D\n", rank, face);CHKERRQ(ierr);}
-        ierr = DMPlexGetConeSize(dm, face, &coneSize);CHKERRQ(ierr);
-        ierr = PetscHMapIJSet(faceHash, key, p);CHKERRQ(ierr);
-        ierr = PetscSectionAddDof(candidateSection, p, coneSize+1);CHKERRQ(ierr);
-      }
-    }
-  }
-  PetscFunctionReturn(0);
+  return 0;
 }
 
 /*@
@@ -968,22 +798,28 @@ static PetscErrorCode DMPlexAddSharedFace_Private(DM dm, PetscSection candidateS
 
   Level: developer
 
-   Note: All debugging for this process can be turned on with the options: -dm_interp_pre_view -petscsf_interp_pre_view -petscsection_interp_candidate_view -petscsection_interp_candidate_remote_view -petscsection_interp_claim_view -petscsf_interp_pre_view -dmplex_interp_debug
+   Notes:
+   Each process sends every point which may be shared, that is a point whose cone points are all shared, to the owner of its
+   smallest cone point. This rendezvous matches the copies of the point by their cones and picks the owner, so that the shared
+   points are resolved with a single gather and scatter over one PetscSF.
+
+   All debugging for this process can be turned on with the options: -dm_interp_pre_view -petscsf_interp_pre_view -interp_root_degree_view -petscsf_interp_claim_view -petscsf_interp_view
 
 .seealso: DMPlexInterpolate(), DMPlexUninterpolate()
 @*/
 PetscErrorCode DMPlexInterpolatePointSF(DM dm, PetscSF pointSF)
 {
   MPI_Comm           comm;
-  PetscHMapIJ        remoteHash;
-  PetscHMapI         claimshash;
-  PetscSection       candidateSection, candidateRemoteSection, claimSection;
-  PetscSFNode       *candidates, *candidatesRemote, *claims;
-  const PetscInt    *localPoints, *rootdegree;
+  PetscSF            sfFace;
+  PetscBT            shared, cell;
+  MPI_Datatype       facetype;
+  DMPlexSharedFace  *candidates, *rootCandidates;
+  PetscSFNode       *gpoints, *rendezvous, *winners, *leafWinners, *remotePointsNew;
   const PetscSFNode *remotePoints;
-  PetscInt           ov, Nr, r, Nl, l;
-  PetscInt           candidatesSize, candidatesRemoteSize, claimsSize;
-  PetscBool          flg, debug = PETSC_FALSE;
+  const PetscInt    *localPoints, *rootdegree, *facedegree;
+  PetscInt          *candPoints, *order, *localPointsNew;
+  PetscInt           ov, Np, Nr, Nl, l, p, cellHeight, h, numCand = 0, numRootCand = 0, r, off, NlNew;
+  PetscBool          flg;
   PetscMPIInt        rank;
   PetscErrorCode     ierr;
 
@@ -998,303 +834,145 @@ PetscErrorCode DMPlexInterpolatePointSF(DM dm, PetscSF pointSF)
   ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
   ierr = DMPlexGetOverlap(dm, &ov);CHKERRQ(ierr);
   if (ov) SETERRQ(comm, PETSC_ERR_SUP, "Interpolation of overlapped DMPlex not implemented yet");
-  ierr = PetscOptionsHasName(NULL, ((PetscObject) dm)->prefix, "-dmplex_interp_debug", &debug);CHKERRQ(ierr);
   ierr = PetscObjectViewFromOptions((PetscObject) dm, NULL, "-dm_interp_pre_view");CHKERRQ(ierr);
   ierr = PetscObjectViewFromOptions((PetscObject) pointSF, NULL, "-petscsf_interp_pre_view");CHKERRQ(ierr);
   ierr = PetscLogEventBegin(DMPLEX_InterpolateSF,dm,0,0,0);CHKERRQ(ierr);
-  /* Step 0: Precalculations */
+  /* Step 0: Give each point its canonical number (owner rank, owner point), and mark the shared points */
   ierr = PetscSFGetGraph(pointSF, &Nr, &Nl, &localPoints, &remotePoints);CHKERRQ(ierr);
   if (Nr < 0) SETERRQ(comm, PETSC_ERR_ARG_WRONGSTATE, "This DMPlex is distributed but input PointSF has no graph set");
-  ierr = PetscHMapIJCreate(&remoteHash);CHKERRQ(ierr);
-  for (l = 0; l < Nl; ++l) {
-    PetscHashIJKey key;
-    key.i = remotePoints[l].index;
-    key.j = remotePoints[l].rank;
-    ierr = PetscHMapIJSet(remoteHash, key, l);CHKERRQ(ierr);
-  }
-  /*   Compute root degree to identify shared points */
   ierr = PetscSFComputeDegreeBegin(pointSF, &rootdegree);CHKERRQ(ierr);
   ierr = PetscSFComputeDegreeEnd(pointSF, &rootdegree);CHKERRQ(ierr);
   ierr = IntArrayViewFromOptions(comm, "-interp_root_degree_view", "Root degree", "point", "degree", Nr, rootdegree);CHKERRQ(ierr);
-  /*
-  1) Loop over each leaf point $p$ at depth $d$ in the SF
-  \item Get set $F(p)$ of faces $f$ in the support of $p$ for which
-  \begin{itemize}
-    \item all cone points of $f$ are shared
-    \item $p$ is the cone point with smallest canonical number
-  \end{itemize}
-  \item Send $F(p)$ and the cone of each face to the active root point $r(p)$
-  \item At the root, if at least two faces with a given cone are present, including a local face, mark the face as shared \label{alg:rootStep} and choose the root face
-  \item Send the root face from the root back to all leaf process
-  \item Leaf processes add the shared face to the SF
-  */
-  /* Step 1: Construct section+SFNode array
-       The section has entries for all shared faces for which we have a leaf point in the cone
-       The array holds candidate shared faces, each face is refered to by the leaf point */
-  ierr = PetscSectionCreate(comm, &candidateSection);CHKERRQ(ierr);
-  ierr = PetscSectionSetChart(candidateSection, 0, Nr);CHKERRQ(ierr);
-  {
-    PetscHMapIJ faceHash;
+  /*   The interpolated points are numbered after the roots of the input SF */
+  ierr = DMPlexGetChart(dm, NULL, &Np);CHKERRQ(ierr);
+  ierr = PetscMalloc1(Np, &gpoints);CHKERRQ(ierr);
+  ierr = PetscBTCreate(Np, &shared);CHKERRQ(ierr);
+  ierr = PetscBTCreate(Np, &cell);CHKERRQ(ierr);
+  for (p = 0; p < Np; ++p) {
+    gpoints[p].rank  = rank;
+    gpoints[p].index = p;
+    if (p < Nr && rootdegree[p]) {ierr = PetscBTSet(shared, p);CHKERRQ(ierr);}
+  }
+  for (l = 0; l < Nl; ++l) {
+    const PetscInt q = localPoints ? localPoints[l] : l;
 
-    ierr = PetscHMapIJCreate(&faceHash);CHKERRQ(ierr);
-    for (l = 0; l < Nl; ++l) {
-      const PetscInt p = localPoints[l];
+    gpoints[q] = remotePoints[l];
+    ierr = PetscBTSet(shared, q);CHKERRQ(ierr);
+  }
+  /*   Cells cannot be shared in a nonoverlapping mesh */
+  ierr = DMPlexGetVTKCellHeight(dm, &cellHeight);CHKERRQ(ierr);
+  for (h = 0; h <= cellHeight; ++h) {
+    PetscInt pStart, pEnd;
 
-      if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]  First pass leaf point %D\n", rank, p);CHKERRQ(ierr);}
-      ierr = DMPlexAddSharedFace_Private(dm, candidateSection, NULL, faceHash, p, debug);CHKERRQ(ierr);
-    }
-    ierr = PetscHMapIJClear(faceHash);CHKERRQ(ierr);
-    ierr = PetscSectionSetUp(candidateSection);CHKERRQ(ierr);
-    ierr = PetscSectionGetStorageSize(candidateSection, &candidatesSize);CHKERRQ(ierr);
-    ierr = PetscMalloc1(candidatesSize, &candidates);CHKERRQ(ierr);
-    for (l = 0; l < Nl; ++l) {
-      const PetscInt p = localPoints[l];
-
-      if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]  Second pass leaf point %D\n", rank, p);CHKERRQ(ierr);}
-      ierr = DMPlexAddSharedFace_Private(dm, candidateSection, candidates, faceHash, p, debug);CHKERRQ(ierr);
-    }
-    ierr = PetscHMapIJDestroy(&faceHash);CHKERRQ(ierr);
-    if (debug) {ierr = PetscSynchronizedFlush(comm, NULL);CHKERRQ(ierr);}
+    ierr = DMPlexGetHeightStratum(dm, h, &pStart, &pEnd);CHKERRQ(ierr);
+    for (p = pStart; p < pEnd; ++p) {ierr = PetscBTSet(cell, p);CHKERRQ(ierr);}
   }
-  ierr = PetscObjectSetName((PetscObject) candidateSection, "Candidate Section");CHKERRQ(ierr);
-  ierr = PetscObjectViewFromOptions((PetscObject) candidateSection, NULL, "-petscsection_interp_candidate_view");CHKERRQ(ierr);
-  ierr = SFNodeArrayViewFromOptions(comm, "-petscsection_interp_candidate_view", "Candidates", NULL, candidatesSize, candidates);CHKERRQ(ierr);
-  /* Step 2: Gather candidate section / array pair into the root partition via inverse(multi(pointSF)). */
-  /*   Note that this section is indexed by offsets into leaves, not by point number */
-  {
-    PetscSF   sfMulti, sfInverse, sfCandidates;
-    PetscInt *remoteOffsets;
-
-    ierr = PetscSFGetMultiSF(pointSF, &sfMulti);CHKERRQ(ierr);
-    ierr = PetscSFCreateInverseSF(sfMulti, &sfInverse);CHKERRQ(ierr);
-    ierr = PetscSectionCreate(comm, &candidateRemoteSection);CHKERRQ(ierr);
-    ierr = PetscSFDistributeSection(sfInverse, candidateSection, &remoteOffsets, candidateRemoteSection);CHKERRQ(ierr);
-    ierr = PetscSFCreateSectionSF(sfInverse, candidateSection, remoteOffsets, candidateRemoteSection, &sfCandidates);CHKERRQ(ierr);
-    ierr = PetscSectionGetStorageSize(candidateRemoteSection, &candidatesRemoteSize);CHKERRQ(ierr);
-    ierr = PetscMalloc1(candidatesRemoteSize, &candidatesRemote);CHKERRQ(ierr);
-    ierr = PetscSFBcastBegin(sfCandidates, MPIU_2INT, candidates, candidatesRemote);CHKERRQ(ierr);
-    ierr = PetscSFBcastEnd(sfCandidates, MPIU_2INT, candidates, candidatesRemote);CHKERRQ(ierr);
-    ierr = PetscSFDestroy(&sfInverse);CHKERRQ(ierr);
-    ierr = PetscSFDestroy(&sfCandidates);CHKERRQ(ierr);
-    ierr = PetscFree(remoteOffsets);CHKERRQ(ierr);
-
-    ierr = PetscObjectSetName((PetscObject) candidateRemoteSection, "Remote Candidate Section");CHKERRQ(ierr);
-    ierr = PetscObjectViewFromOptions((PetscObject) candidateRemoteSection, NULL, "-petscsection_interp_candidate_remote_view");CHKERRQ(ierr);
-    ierr = SFNodeArrayViewFromOptions(comm, "-petscsection_interp_candidate_remote_view", "Remote Candidates", NULL, candidatesRemoteSize, candidatesRemote);CHKERRQ(ierr);
+  /* Step 1: A point which is not shared, but whose cone points are all shared, may be shared. Its key is its cone in
+             canonical numbering, and it is sent to the owner of the smallest cone point, which acts as a rendezvous. */
+  for (p = 0; p < Np; ++p) {
+    const PetscInt *cone;
+    PetscInt        coneSize, c;
+
+    if (PetscBTLookup(shared, p) || PetscBTLookup(cell, p)) continue;
+    ierr = DMPlexGetConeSize(dm, p, &coneSize);CHKERRQ(ierr);
+    ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
+    for (c = 0; c < coneSize; ++c) if (!PetscBTLookup(shared, cone[c])) break;
+    if (coneSize && c == coneSize) ++numCand;
   }
-  /* Step 3: At the root, if at least two faces with a given cone are present, including a local face, mark the face as shared and choose the root face */
-  {
-    PetscHashIJKLRemote faceTable;
-    PetscInt            idx, idx2;
-
-    ierr = PetscHashIJKLRemoteCreate(&faceTable);CHKERRQ(ierr);
-    /* There is a section point for every leaf attached to a given root point */
-    for (r = 0, idx = 0, idx2 = 0; r < Nr; ++r) {
-      PetscInt deg;
-
-      for (deg = 0; deg < rootdegree[r]; ++deg, ++idx) {
-        PetscInt offset, dof, d;
-
-        ierr = PetscSectionGetDof(candidateRemoteSection, idx, &dof);CHKERRQ(ierr);
-        ierr = PetscSectionGetOffset(candidateRemoteSection, idx, &offset);CHKERRQ(ierr);
-        /* dof may include many faces from the remote process */
-        for (d = 0; d < dof; ++d) {
-          const PetscInt         hidx  = offset+d;
-          const PetscInt         Np    = candidatesRemote[hidx].index+1;
-          const PetscSFNode      rface = candidatesRemote[hidx+1];
-          const PetscSFNode     *fcone = &candidatesRemote[hidx+2];
-          PetscSFNode            fcp0;
-          const PetscSFNode      pmax  = {PETSC_MAX_INT, PETSC_MAX_INT};
-          const PetscInt        *join  = NULL;
-          PetscHashIJKLRemoteKey key;
-          PetscHashIter          iter;
-          PetscBool              missing;
-          PetscInt               points[1024], p, joinSize;
-
-          if (debug) {ierr = PetscSynchronizedPrintf(PetscObjectComm((PetscObject) dm), "[%d]  Checking face (%D, %D) at (%D, %D, %D) with cone size %D\n", rank, rface.rank, rface.index, r, idx, d, Np);CHKERRQ(ierr);}
-          if (Np > 4) SETERRQ6(PETSC_COMM_SELF, PETSC_ERR_SUP, "Cannot handle face (%D, %D) at (%D, %D, %D) with %D cone points", rface.rank, rface.index, r, idx, d, Np);
-          fcp0.rank  = rank;
-          fcp0.index = r;
-          d += Np;
-          /* Put remote face in hash table */
-          key.i = fcp0;
-          key.j = fcone[0];
-          key.k = Np > 2 ? fcone[1] : pmax;
-          key.l = Np > 3 ? fcone[2] : pmax;
-          ierr = PetscSortSFNode(Np, (PetscSFNode *) &key);CHKERRQ(ierr);
-          ierr = PetscHashIJKLRemotePut(faceTable, key, &iter, &missing);CHKERRQ(ierr);
-          if (missing) {
-            if (debug) {ierr = PetscSynchronizedPrintf(PetscObjectComm((PetscObject) dm), "[%d]  Setting remote face (%D, %D)\n", rank, rface.index, rface.rank);CHKERRQ(ierr);}
-            ierr = PetscHashIJKLRemoteIterSet(faceTable, iter, rface);CHKERRQ(ierr);
-          } else {
-            PetscSFNode oface;
+  ierr = PetscMalloc4(numCand, &candidates, numCand, &candPoints, numCand, &rendezvous, numCand, &leafWinners);CHKERRQ(ierr);
+  for (p = 0, numCand = 0; p < Np; ++p) {
+    const PetscInt    *cone;
+    const PetscSFNode  pmax = {PETSC_MAX_INT, PETSC_MAX_INT};
+    PetscInt           coneSize, c;
 
-            ierr = PetscHashIJKLRemoteIterGet(faceTable, iter, &oface);CHKERRQ(ierr);
-            if ((rface.rank < oface.rank) || (rface.rank == oface.rank && rface.index < oface.index)) {
-              if (debug) {ierr = PetscSynchronizedPrintf(PetscObjectComm((PetscObject) dm), "[%d]  Replacing with remote face (%D, %D)\n", rank, rface.index, rface.rank);CHKERRQ(ierr);}
-              ierr = PetscHashIJKLRemoteIterSet(faceTable, iter, rface);CHKERRQ(ierr);
-            }
-          }
-          /* Check for local face */
-          points[0] = r;
-          for (p = 1; p < Np; ++p) {
-            ierr = DMPlexMapToLocalPoint(dm, remoteHash, fcone[p-1], &points[p]);
-            if (ierr) break; /* We got a point not in our overlap */
-            if (debug) {ierr = PetscSynchronizedPrintf(PetscObjectComm((PetscObject) dm), "[%d]  Checking local candidate %D\n", rank, points[p]);CHKERRQ(ierr);}
-          }
-          if (ierr) continue;
-          ierr = DMPlexGetJoin(dm, Np, points, &joinSize, &join);CHKERRQ(ierr);
-          if (joinSize == 1) {
-            PetscSFNode lface;
-            PetscSFNode oface;
-
-            /* Always replace with local face */
-            lface.rank  = rank;
-            lface.index = join[0];
-            ierr = PetscHashIJKLRemoteIterGet(faceTable, iter, &oface);CHKERRQ(ierr);
-            if (debug) {ierr = PetscSynchronizedPrintf(PetscObjectComm((PetscObject) dm), "[%d]  Replacing (%D, %D) with local face (%D, %D)\n", rank, oface.index, oface.rank, lface.index, lface.rank);CHKERRQ(ierr);}
-            ierr = PetscHashIJKLRemoteIterSet(faceTable, iter, lface);CHKERRQ(ierr);
-          }
-          ierr = DMPlexRestoreJoin(dm, Np, points, &joinSize, &join);CHKERRQ(ierr);
-        }
+    if (PetscBTLookup(shared, p) || PetscBTLookup(cell, p)) continue;
+    ierr = DMPlexGetConeSize(dm, p, &coneSize);CHKERRQ(ierr);
+    ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
+    for (c = 0; c < coneSize; ++c) if (!PetscBTLookup(shared, cone[c])) break;
+    if (!coneSize || c < coneSize) continue;
+    if (coneSize > 4) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_SUP, "Cannot handle face %D with %D cone points", p, coneSize);
+    for (c = 0; c < 4; ++c) candidates[numCand].key[c] = c < coneSize ? gpoints[cone[c]] : pmax;
+    ierr = PetscSortSFNode(coneSize, candidates[numCand].key);CHKERRQ(ierr);
+    candidates[numCand].face.rank  = rank;
+    candidates[numCand].face.index = p;
+    candPoints[numCand] = p;
+    rendezvous[numCand] = candidates[numCand].key[0];
+    ++numCand;
+  }
+  ierr = PetscBTDestroy(&shared);CHKERRQ(ierr);
+  ierr = PetscBTDestroy(&cell);CHKERRQ(ierr);
+  ierr = PetscFree(gpoints);CHKERRQ(ierr);
+  /* Step 2: Gather the candidates at the rendezvous */
+  ierr = PetscSFCreate(comm, &sfFace);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfFace, Nr, numCand, NULL, PETSC_OWN_POINTER, rendezvous, PETSC_COPY_VALUES);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeBegin(sfFace, &facedegree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(sfFace, &facedegree);CHKERRQ(ierr);
+  for (r = 0; r < Nr; ++r) numRootCand += facedegree[r];
+  ierr = PetscMalloc3(numRootCand, &rootCandidates, numRootCand, &winners, numRootCand, &order);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous((PetscMPIInt) (sizeof(DMPlexSharedFace)/sizeof(PetscInt)), MPIU_INT, &facetype);CHKERRMPI(ierr);
+  ierr = MPI_Type_commit(&facetype);CHKERRMPI(ierr);
+  ierr = PetscSFGatherBegin(sfFace, facetype, candidates, rootCandidates);CHKERRQ(ierr);
+  ierr = PetscSFGatherEnd(sfFace, facetype, candidates, rootCandidates);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&facetype);CHKERRMPI(ierr);
+  /* Step 3: At the rendezvous, candidates with the same key are the same face. The face is owned by the rendezvous
+             if it has a copy, and otherwise by the copy with the smallest (rank, point). */
+  for (r = 0, off = 0; r < Nr; off += facedegree[r], ++r) {
+    PetscInt i, j;
+
+    /*   The candidates at a rendezvous all contain the same point, so there are few of them and insertion sort is enough */
+    for (i = off; i < off+facedegree[r]; ++i) {
+      order[i] = i;
+      for (j = i; j > off && DMPlexSharedFaceCompare_Private(&order[j-1], &order[j], rootCandidates) > 0; --j) {
+        const PetscInt tmp = order[j];
+
+        order[j]   = order[j-1];
+        order[j-1] = tmp;
       }
-      /* Put back faces for this root */
-      for (deg = 0; deg < rootdegree[r]; ++deg, ++idx2) {
-        PetscInt offset, dof, d;
-
-        ierr = PetscSectionGetDof(candidateRemoteSection, idx2, &dof);CHKERRQ(ierr);
-        ierr = PetscSectionGetOffset(candidateRemoteSection, idx2, &offset);CHKERRQ(ierr);
-        /* dof may include many faces from the remote process */
-        for (d = 0; d < dof; ++d) {
-          const PetscInt         hidx  = offset+d;
-          const PetscInt         Np    = candidatesRemote[hidx].index+1;
-          const PetscSFNode     *fcone = &candidatesRemote[hidx+2];
-          PetscSFNode            fcp0;
-          const PetscSFNode      pmax  = {PETSC_MAX_INT, PETSC_MAX_INT};
-          PetscHashIJKLRemoteKey key;
-          PetscHashIter          iter;
-          PetscBool              missing;
-
-          if (debug) {ierr = PetscSynchronizedPrintf(PetscObjectComm((PetscObject) dm), "[%d]  Entering face at (%D, %D)\n", rank, r, idx);CHKERRQ(ierr);}
-          if (Np > 4) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Cannot handle faces with %D cone points", Np);
-          fcp0.rank  = rank;
-          fcp0.index = r;
-          d += Np;
-          /* Find remote face in hash table */
-          key.i = fcp0;
-          key.j = fcone[0];
-          key.k = Np > 2 ? fcone[1] : pmax;
-          key.l = Np > 3 ? fcone[2] : pmax;
-          ierr = PetscSortSFNode(Np, (PetscSFNode *) &key);CHKERRQ(ierr);
-          if (debug) {ierr = PetscSynchronizedPrintf(PetscObjectComm((PetscObject) dm), "[%d]    key (%D, %D) (%D, %D) (%D, %D) (%D, %D)\n", rank, key.i.rank, key.i.index, key.j.rank, key.j.index, key.k.rank, key.k.index, key.l.rank, key.l.index);CHKERRQ(ierr);}
-          ierr = PetscHashIJKLRemotePut(faceTable, key, &iter, &missing);CHKERRQ(ierr);
-          if (missing) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Root %D Idx %D ought to have an associated face", r, idx2);
-          else        {ierr = PetscHashIJKLRemoteIterGet(faceTable, iter, &candidatesRemote[hidx]);CHKERRQ(ierr);}
-        }
+    }
+    for (i = off; i < off+facedegree[r]; i = j) {
+      PetscSFNode owner = rootCandidates[order[i]].face;
+
+      for (j = i+1; j < off+facedegree[r]; ++j) {
+        const PetscSFNode face = rootCandidates[order[j]].face;
+
+        if (DMPlexSharedFaceCompare_Private(&order[i], &order[j], rootCandidates)) break;
+        if (owner.rank == rank) continue;
+        if (face.rank == rank || face.rank < owner.rank || (face.rank == owner.rank && face.index < owner.index)) owner = face;
       }
+      for (; i < j; ++i) winners[order[i]] = owner;
     }
-    if (debug) {ierr = PetscSynchronizedFlush(PetscObjectComm((PetscObject) dm), NULL);CHKERRQ(ierr);}
-    ierr = PetscHashIJKLRemoteDestroy(&faceTable);CHKERRQ(ierr);
   }
-  /* Step 4: Push back owned faces */
+  /* Step 4: Send the owner back to every copy, and add the faces owned elsewhere to the SF */
+  ierr = PetscSFScatterBegin(sfFace, MPIU_2INT, winners, leafWinners);CHKERRQ(ierr);
+  ierr = PetscSFScatterEnd(sfFace, MPIU_2INT, winners, leafWinners);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfFace);CHKERRQ(ierr);
+  ierr = SFNodeArrayViewFromOptions(comm, "-petscsf_interp_claim_view", "Claims", "point", numCand, leafWinners);CHKERRQ(ierr);
+  for (p = 0, NlNew = 0; p < numCand; ++p) if (leafWinners[p].rank != rank) ++NlNew;
+  ierr = PetscMalloc1(Nl + NlNew, &localPointsNew);CHKERRQ(ierr);
+  ierr = PetscMalloc1(Nl + NlNew, &remotePointsNew);CHKERRQ(ierr);
+  for (l = 0; l < Nl; ++l) {
+    localPointsNew[l]  = localPoints ? localPoints[l] : l;
+    remotePointsNew[l] = remotePoints[l];
+  }
+  /*   Candidates are in increasing point order, and new points are numbered after all existing points */
+  for (p = 0, l = Nl; p < numCand; ++p) {
+    if (leafWinners[p].rank == rank) continue;
+    localPointsNew[l]  = candPoints[p];
+    remotePointsNew[l] = leafWinners[p];
+    ++l;
+  }
+  ierr = PetscFree4(candidates, candPoints, rendezvous, leafWinners);CHKERRQ(ierr);
+  ierr = PetscFree3(rootCandidates, winners, order);CHKERRQ(ierr);
   {
-    PetscSF      sfMulti, sfClaims, sfPointNew;
-    PetscSFNode *remotePointsNew;
-    PetscInt    *remoteOffsets, *localPointsNew;
-    PetscInt     pStart, pEnd, r, NlNew, p;
-
-    /* 4) Push claims back to receiver via the MultiSF and derive new pointSF mapping on receiver */
-    ierr = PetscSFGetMultiSF(pointSF, &sfMulti);CHKERRQ(ierr);
-    ierr = PetscSectionCreate(comm, &claimSection);CHKERRQ(ierr);
-    ierr = PetscSFDistributeSection(sfMulti, candidateRemoteSection, &remoteOffsets, claimSection);CHKERRQ(ierr);
-    ierr = PetscSFCreateSectionSF(sfMulti, candidateRemoteSection, remoteOffsets, claimSection, &sfClaims);CHKERRQ(ierr);
-    ierr = PetscSectionGetStorageSize(claimSection, &claimsSize);CHKERRQ(ierr);
-    ierr = PetscMalloc1(claimsSize, &claims);CHKERRQ(ierr);
-    for (p = 0; p < claimsSize; ++p) claims[p].rank = -1;
-    ierr = PetscSFBcastBegin(sfClaims, MPIU_2INT, candidatesRemote, claims);CHKERRQ(ierr);
-    ierr = PetscSFBcastEnd(sfClaims, MPIU_2INT, candidatesRemote, claims);CHKERRQ(ierr);
-    ierr = PetscSFDestroy(&sfClaims);CHKERRQ(ierr);
-    ierr = PetscFree(remoteOffsets);CHKERRQ(ierr);
-    ierr = PetscObjectSetName((PetscObject) claimSection, "Claim Section");CHKERRQ(ierr);
-    ierr = PetscObjectViewFromOptions((PetscObject) claimSection, NULL, "-petscsection_interp_claim_view");CHKERRQ(ierr);
-    ierr = SFNodeArrayViewFromOptions(comm, "-petscsection_interp_claim_view", "Claims", NULL, claimsSize, claims);CHKERRQ(ierr);
-    /* Step 5) Walk the original section of local supports and add an SF entry for each updated item */
-    /* TODO I should not have to do a join here since I already put the face and its cone in the candidate section */
-    ierr = PetscHMapICreate(&claimshash);CHKERRQ(ierr);
-    for (r = 0; r < Nr; ++r) {
-      PetscInt dof, off, d;
-
-      if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]  Checking root for claims %D\n", rank, r);CHKERRQ(ierr);}
-      ierr = PetscSectionGetDof(candidateSection, r, &dof);CHKERRQ(ierr);
-      ierr = PetscSectionGetOffset(candidateSection, r, &off);CHKERRQ(ierr);
-      for (d = 0; d < dof;) {
-        if (claims[off+d].rank >= 0) {
-          const PetscInt  faceInd = off+d;
-          const PetscInt  Np      = candidates[off+d].index;
-          const PetscInt *join    = NULL;
-          PetscInt        joinSize, points[1024], c;
-
-          if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]    Found claim for remote point (%D, %D)\n", rank, claims[faceInd].rank, claims[faceInd].index);CHKERRQ(ierr);}
-          points[0] = r;
-          if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]      point %D\n", rank, points[0]);CHKERRQ(ierr);}
-          for (c = 0, d += 2; c < Np; ++c, ++d) {
-            ierr = DMPlexMapToLocalPoint(dm, remoteHash, candidates[off+d], &points[c+1]);CHKERRQ(ierr);
-            if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]      point %D\n", rank, points[c+1]);CHKERRQ(ierr);}
-          }
-          ierr = DMPlexGetJoin(dm, Np+1, points, &joinSize, &join);CHKERRQ(ierr);
-          if (joinSize == 1) {
-            if (claims[faceInd].rank == rank) {
-              if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]    Ignoring local face %D for non-remote partner\n", rank, join[0]);CHKERRQ(ierr);}
-            } else {
-              if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]    Found local face %D\n", rank, join[0]);CHKERRQ(ierr);}
-              ierr = PetscHMapISet(claimshash, join[0], faceInd);CHKERRQ(ierr);
-            }
-          } else {
-            if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]    Failed to find face\n", rank);CHKERRQ(ierr);}
-          }
-          ierr = DMPlexRestoreJoin(dm, Np+1, points, &joinSize, &join);CHKERRQ(ierr);
-        } else {
-          if (debug) {ierr = PetscSynchronizedPrintf(comm, "[%d]    No claim for point %D\n", rank, r);CHKERRQ(ierr);}
-          d += claims[off+d].index+1;
-        }
-      }
-    }
-    if (debug) {ierr = PetscSynchronizedFlush(comm, NULL);CHKERRQ(ierr);}
-    /* Step 6) Create new pointSF from hashed claims */
-    ierr = PetscHMapIGetSize(claimshash, &NlNew);CHKERRQ(ierr);
-    ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
-    ierr = PetscMalloc1(Nl + NlNew, &localPointsNew);CHKERRQ(ierr);
-    ierr = PetscMalloc1(Nl + NlNew, &remotePointsNew);CHKERRQ(ierr);
-    for (l = 0; l < Nl; ++l) {
-      localPointsNew[l] = localPoints[l];
-      remotePointsNew[l].index = remotePoints[l].index;
-      remotePointsNew[l].rank  = remotePoints[l].rank;
-    }
-    p = Nl;
-    ierr = PetscHMapIGetKeys(claimshash, &p, localPointsNew);CHKERRQ(ierr);
-    /* We sort new points, and assume they are numbered after all existing points */
-    ierr = PetscSortInt(NlNew, &localPointsNew[Nl]);CHKERRQ(ierr);
-    for (p = Nl; p < Nl + NlNew; ++p) {
-      PetscInt off;
-      ierr = PetscHMapIGet(claimshash, localPointsNew[p], &off);CHKERRQ(ierr);
-      if (claims[off].rank < 0 || claims[off].index < 0) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Invalid claim for local point %D, (%D, %D)", localPointsNew[p], claims[off].rank, claims[off].index);
-      remotePointsNew[p] = claims[off];
-    }
+    PetscSF sfPointNew;
+
     ierr = PetscSFCreate(comm, &sfPointNew);CHKERRQ(ierr);
-    ierr = PetscSFSetGraph(sfPointNew, pEnd-pStart, Nl+NlNew, localPointsNew, PETSC_OWN_POINTER, remotePointsNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(sfPointNew, Np, Nl+NlNew, localPointsNew, PETSC_OWN_POINTER, remotePointsNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
     ierr = PetscSFSetUp(sfPointNew);CHKERRQ(ierr);
     ierr = DMSetPointSF(dm, sfPointNew);CHKERRQ(ierr);
     ierr = PetscObjectViewFromOptions((PetscObject) sfPointNew, NULL, "-petscsf_interp_view");CHKERRQ(ierr);
     ierr = PetscSFDestroy(&sfPointNew);CHKERRQ(ierr);
-    ierr = PetscHMapIDestroy(&claimshash);CHKERRQ(ierr);
   }
-  ierr = PetscHMapIJDestroy(&remoteHash);CHKERRQ(ierr);
-  ierr = PetscSectionDestroy(&candidateSection);CHKERRQ(ierr);
-  ierr = PetscSectionDestroy(&candidateRemoteSection);CHKERRQ(ierr);
-  ierr = PetscSectionDestroy(&claimSection);CHKERRQ(ierr);
-  ierr = PetscFree(candidates);CHKERRQ(ierr);
-  ierr = PetscFree(candidatesRemote);CHKERRQ(ierr);
-  ierr = PetscFree(claims);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DMPLEX_InterpolateSF,dm,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -155,18 +155,76 @@ static PetscErrorCode DMPlexComputeAnchorAdjacencies(DM dm, PetscBool useCone, P
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, PetscSF sfDof, PetscBool useCone, PetscBool useClosure, PetscBool useAnchors, PetscSection *sA, PetscInt **colIdx)
+/* Forget the cached point adjacency, which must be done whenever the topology, the anchors, or the adjacency callback change */
+PetscErrorCode DMPlexResetAdjacencyGraph_Internal(DM dm)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  PetscInt       idx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (idx = 0; idx < 4; ++idx) {
+    ierr = PetscSectionDestroy(&mesh->adjSection[idx]);CHKERRQ(ierr);
+    ierr = PetscFree(mesh->adjPoints[idx]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* The point adjacency depends only on the topology, so it is computed once and shared by every section we preallocate for */
+static PetscErrorCode DMPlexGetAdjacencyGraph_Static(DM dm, PetscBool useCone, PetscBool useClosure, PetscSection *adjSec, const PetscInt *adjPoints[])
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  const PetscInt idx  = (useCone ? 1 : 0) + (useClosure ? 2 : 0);
+
+  PetscFunctionBegin;
+  if (!mesh->adjSection[idx]) {
+    PetscSection   sec;
+    PetscInt      *tmpAdj = NULL, *adj;
+    PetscInt       pStart, pEnd, p, numAdj, size = 0, maxSize;
+    PetscErrorCode ierr;
+
+    ierr = PetscLogEventBegin(DMPLEX_PreallocateAdj,dm,0,0,0);CHKERRQ(ierr);
+    ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+    ierr = PetscSectionCreate(PETSC_COMM_SELF, &sec);CHKERRQ(ierr);
+    ierr = PetscSectionSetChart(sec, pStart, pEnd);CHKERRQ(ierr);
+    /* Section offsets follow the chart order, so the adjacency can be appended as it is computed */
+    maxSize = PetscMax(1, 8*(pEnd-pStart));
+    ierr = PetscMalloc1(maxSize, &adj);CHKERRQ(ierr);
+    for (p = pStart; p < pEnd; ++p) {
+      numAdj = PETSC_DETERMINE;
+      ierr = DMPlexGetAdjacency_Internal(dm, p, useCone, useClosure, PETSC_TRUE, &numAdj, &tmpAdj);CHKERRQ(ierr);
+      ierr = PetscSectionSetDof(sec, p, numAdj);CHKERRQ(ierr);
+      if (size+numAdj > maxSize) {
+        maxSize = PetscMax(2*maxSize, size+numAdj);
+        ierr    = PetscRealloc(maxSize*sizeof(PetscInt), &adj);CHKERRQ(ierr);
+      }
+      ierr  = PetscArraycpy(&adj[size], tmpAdj, numAdj);CHKERRQ(ierr);
+      size += numAdj;
+    }
+    ierr = PetscSectionSetUp(sec);CHKERRQ(ierr);
+    ierr = PetscFree(tmpAdj);CHKERRQ(ierr);
+    mesh->adjSection[idx] = sec;
+    mesh->adjPoints[idx]  = adj;
+    ierr = PetscLogEventEnd(DMPLEX_PreallocateAdj,dm,0,0,0);CHKERRQ(ierr);
+  }
+  *adjSec    = mesh->adjSection[idx];
+  *adjPoints = mesh->adjPoints[idx];
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, PetscSF sfDof, PetscBool useCone, PetscBool useClosure, PetscSection *sA, PetscInt **colIdx)
 {
   MPI_Comm           comm;
   PetscMPIInt        size;
   PetscBool          doCommLocal, doComm, debug = PETSC_FALSE;
   PetscSF            sf, sfAdj;
-  PetscSection       section, sectionGlobal, leafSectionAdj, rootSectionAdj, sectionAdj, anchorSectionAdj;
+  PetscSection       section, sectionGlobal, leafSectionAdj, rootSectionAdj, sectionAdj, anchorSectionAdj, pointSectionAdj;
   PetscInt           nroots, nleaves, l, p, r;
   const PetscInt    *leaves;
   const PetscSFNode *remotes;
   PetscInt           dim, pStart, pEnd, numDof, globalOffStart, globalOffEnd, numCols;
-  PetscInt          *tmpAdj = NULL, *adj, *rootAdj, *anchorAdj = NULL, *cols, *remoteOffsets;
+  PetscInt          *adj, *rootAdj, *anchorAdj = NULL, *cols, *remoteOffsets, *pdof, *pgoff;
+  const PetscInt    *pointAdj, *tmpAdj;
   PetscInt           adjSize;
   PetscErrorCode     ierr;
 
@@ -216,31 +274,42 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
        Allocate memory addressed by sectionAdj (cols)
     6. Visit all owned points in the subdomain, insert dof adjacencies into cols
    ** Knowing all the column adjacencies, check ownership and sum into dnz and onz
+   The point adjacency comes from the graph cached on the DM, and each adjacent point is expanded using
+   pdof (# unconstrained dofs) and pgoff (first global dof, whether or not we own the point)
   */
   ierr = DMPlexComputeAnchorAdjacencies(dm, useCone, useClosure, &anchorSectionAdj, &anchorAdj);CHKERRQ(ierr);
+  ierr = DMPlexGetAdjacencyGraph_Static(dm, useCone, useClosure, &pointSectionAdj, &pointAdj);CHKERRQ(ierr);
+  ierr = PetscMalloc2(pEnd-pStart, &pdof, pEnd-pStart, &pgoff);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) {
+    PetscInt dof, cdof, goff;
+
+    ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetConstraintDof(section, p, &cdof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(sectionGlobal, p, &goff);CHKERRQ(ierr);
+    pdof[p-pStart]  = dof-cdof;
+    pgoff[p-pStart] = goff < 0 ? -(goff+1) : goff;
+  }
   for (l = 0; l < nleaves; ++l) {
-    PetscInt dof, off, d, q, anDof;
-    PetscInt p = leaves[l], numAdj = PETSC_DETERMINE;
+    PetscInt dof, off, d, q, anDof, numAdj, aoff, nadj = 0;
+    PetscInt p = leaves[l];
 
     if ((p < pStart) || (p >= pEnd)) continue;
     ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
     ierr = PetscSectionGetOffset(section, p, &off);CHKERRQ(ierr);
-    ierr = DMPlexGetAdjacency_Internal(dm, p, useCone, useClosure, useAnchors, &numAdj, &tmpAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetDof(pointSectionAdj, p, &numAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(pointSectionAdj, p, &aoff);CHKERRQ(ierr);
+    tmpAdj = &pointAdj[aoff];
     for (q = 0; q < numAdj; ++q) {
       const PetscInt padj = tmpAdj[q];
-      PetscInt ndof, ncdof;
 
       if ((padj < pStart) || (padj >= pEnd)) continue;
-      ierr = PetscSectionGetDof(section, padj, &ndof);CHKERRQ(ierr);
-      ierr = PetscSectionGetConstraintDof(section, padj, &ncdof);CHKERRQ(ierr);
-      for (d = off; d < off+dof; ++d) {
-        ierr = PetscSectionAddDof(leafSectionAdj, d, ndof-ncdof);CHKERRQ(ierr);
-      }
+      nadj += pdof[padj-pStart];
     }
     ierr = PetscSectionGetDof(anchorSectionAdj, p, &anDof);CHKERRQ(ierr);
-    if (anDof) {
+    nadj += anDof;
+    if (nadj) {
       for (d = off; d < off+dof; ++d) {
-        ierr = PetscSectionAddDof(leafSectionAdj, d, anDof);CHKERRQ(ierr);
+        ierr = PetscSectionAddDof(leafSectionAdj, d, nadj);CHKERRQ(ierr);
       }
     }
   }
@@ -260,29 +329,27 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
   }
   /* Add in local adjacency sizes for owned dofs on interface (roots) */
   for (p = pStart; p < pEnd; ++p) {
-    PetscInt numAdj = PETSC_DETERMINE, adof, dof, off, d, q, anDof;
+    PetscInt numAdj, aoff, adof, dof, off, d, q, anDof, nadj = 0;
 
     ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
     ierr = PetscSectionGetOffset(section, p, &off);CHKERRQ(ierr);
     if (!dof) continue;
     ierr = PetscSectionGetDof(rootSectionAdj, off, &adof);CHKERRQ(ierr);
     if (adof <= 0) continue;
-    ierr = DMPlexGetAdjacency_Internal(dm, p, useCone, useClosure, useAnchors, &numAdj, &tmpAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetDof(pointSectionAdj, p, &numAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(pointSectionAdj, p, &aoff);CHKERRQ(ierr);
+    tmpAdj = &pointAdj[aoff];
     for (q = 0; q < numAdj; ++q) {
       const PetscInt padj = tmpAdj[q];
-      PetscInt ndof, ncdof;
 
       if ((padj < pStart) || (padj >= pEnd)) continue;
-      ierr = PetscSectionGetDof(section, padj, &ndof);CHKERRQ(ierr);
-      ierr = PetscSectionGetConstraintDof(section, padj, &ncdof);CHKERRQ(ierr);
-      for (d = off; d < off+dof; ++d) {
-        ierr = PetscSectionAddDof(rootSectionAdj, d, ndof-ncdof);CHKERRQ(ierr);
-      }
+      nadj += pdof[padj-pStart];
     }
     ierr = PetscSectionGetDof(anchorSectionAdj, p, &anDof);CHKERRQ(ierr);
-    if (anDof) {
+    nadj += anDof;
+    if (nadj) {
       for (d = off; d < off+dof; ++d) {
-        ierr = PetscSectionAddDof(rootSectionAdj, d, anDof);CHKERRQ(ierr);
+        ierr = PetscSectionAddDof(rootSectionAdj, d, nadj);CHKERRQ(ierr);
       }
     }
   }
@@ -304,13 +371,15 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
   ierr = PetscSectionGetStorageSize(leafSectionAdj, &adjSize);CHKERRQ(ierr);
   ierr = PetscCalloc1(adjSize, &adj);CHKERRQ(ierr);
   for (l = 0; l < nleaves; ++l) {
-    PetscInt dof, off, d, q, anDof, anOff;
-    PetscInt p = leaves[l], numAdj = PETSC_DETERMINE;
+    PetscInt dof, off, d, q, anDof, anOff, numAdj, poff;
+    PetscInt p = leaves[l];
 
     if ((p < pStart) || (p >= pEnd)) continue;
     ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
     ierr = PetscSectionGetOffset(section, p, &off);CHKERRQ(ierr);
-    ierr = DMPlexGetAdjacency_Internal(dm, p, useCone, useClosure, useAnchors, &numAdj, &tmpAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetDof(pointSectionAdj, p, &numAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(pointSectionAdj, p, &poff);CHKERRQ(ierr);
+    tmpAdj = &pointAdj[poff];
     ierr = PetscSectionGetDof(anchorSectionAdj, p, &anDof);CHKERRQ(ierr);
     ierr = PetscSectionGetOffset(anchorSectionAdj, p, &anOff);CHKERRQ(ierr);
     for (d = off; d < off+dof; ++d) {
@@ -319,14 +388,13 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
       ierr = PetscSectionGetOffset(leafSectionAdj, d, &aoff);CHKERRQ(ierr);
       for (q = 0; q < numAdj; ++q) {
         const PetscInt padj = tmpAdj[q];
-        PetscInt ndof, ncdof, ngoff, nd;
+        PetscInt       ndof, ngoff, nd;
 
         if ((padj < pStart) || (padj >= pEnd)) continue;
-        ierr = PetscSectionGetDof(section, padj, &ndof);CHKERRQ(ierr);
-        ierr = PetscSectionGetConstraintDof(section, padj, &ncdof);CHKERRQ(ierr);
-        ierr = PetscSectionGetOffset(sectionGlobal, padj, &ngoff);CHKERRQ(ierr);
-        for (nd = 0; nd < ndof-ncdof; ++nd) {
-          adj[aoff+i] = (ngoff < 0 ? -(ngoff+1) : ngoff) + nd;
+        ndof  = pdof[padj-pStart];
+        ngoff = pgoff[padj-pStart];
+        for (nd = 0; nd < ndof; ++nd) {
+          adj[aoff+i] = ngoff + nd;
           ++i;
         }
       }
@@ -378,14 +446,16 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
   }
   /* Add in local adjacency indices for owned dofs on interface (roots) */
   for (p = pStart; p < pEnd; ++p) {
-    PetscInt numAdj = PETSC_DETERMINE, adof, dof, off, d, q, anDof, anOff;
+    PetscInt numAdj, poff, adof, dof, off, d, q, anDof, anOff;
 
     ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
     ierr = PetscSectionGetOffset(section, p, &off);CHKERRQ(ierr);
     if (!dof) continue;
     ierr = PetscSectionGetDof(rootSectionAdj, off, &adof);CHKERRQ(ierr);
     if (adof <= 0) continue;
-    ierr = DMPlexGetAdjacency_Internal(dm, p, useCone, useClosure, useAnchors, &numAdj, &tmpAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetDof(pointSectionAdj, p, &numAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(pointSectionAdj, p, &poff);CHKERRQ(ierr);
+    tmpAdj = &pointAdj[poff];
     ierr = PetscSectionGetDof(anchorSectionAdj, p, &anDof);CHKERRQ(ierr);
     ierr = PetscSectionGetOffset(anchorSectionAdj, p, &anOff);CHKERRQ(ierr);
     for (d = off; d < off+dof; ++d) {
@@ -400,14 +470,13 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
       }
       for (q = 0; q < numAdj; ++q) {
         const PetscInt padj = tmpAdj[q];
-        PetscInt ndof, ncdof, ngoff, nd;
+        PetscInt       ndof, ngoff, nd;
 
         if ((padj < pStart) || (padj >= pEnd)) continue;
-        ierr = PetscSectionGetDof(section, padj, &ndof);CHKERRQ(ierr);
-        ierr = PetscSectionGetConstraintDof(section, padj, &ncdof);CHKERRQ(ierr);
-        ierr = PetscSectionGetOffset(sectionGlobal, padj, &ngoff);CHKERRQ(ierr);
-        for (nd = 0; nd < ndof-ncdof; ++nd) {
-          rootAdj[aoff+i] = ngoff < 0 ? -(ngoff+1)+nd : ngoff+nd;
+        ndof  = pdof[padj-pStart];
+        ngoff = pgoff[padj-pStart];
+        for (nd = 0; nd < ndof; ++nd) {
+          rootAdj[aoff+i] = ngoff+nd;
           --i;
         }
       }
@@ -455,7 +524,7 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
   ierr = PetscSectionCreate(comm, &sectionAdj);CHKERRQ(ierr);
   ierr = PetscSectionSetChart(sectionAdj, globalOffStart, globalOffEnd);CHKERRQ(ierr);
   for (p = pStart; p < pEnd; ++p) {
-    PetscInt  numAdj = PETSC_DETERMINE, dof, cdof, off, goff, d, q, anDof;
+    PetscInt  numAdj, poff, dof, cdof, off, goff, d, q, anDof, nadj = 0;
     PetscBool found  = PETSC_TRUE;
 
     ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
@@ -476,25 +545,20 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
       }
     }
     if (found) continue;
-    ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
-    ierr = PetscSectionGetOffset(sectionGlobal, p, &goff);CHKERRQ(ierr);
-    ierr = DMPlexGetAdjacency_Internal(dm, p, useCone, useClosure, useAnchors, &numAdj, &tmpAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetDof(pointSectionAdj, p, &numAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(pointSectionAdj, p, &poff);CHKERRQ(ierr);
+    tmpAdj = &pointAdj[poff];
     for (q = 0; q < numAdj; ++q) {
       const PetscInt padj = tmpAdj[q];
-      PetscInt ndof, ncdof, noff;
 
       if ((padj < pStart) || (padj >= pEnd)) continue;
-      ierr = PetscSectionGetDof(section, padj, &ndof);CHKERRQ(ierr);
-      ierr = PetscSectionGetConstraintDof(section, padj, &ncdof);CHKERRQ(ierr);
-      ierr = PetscSectionGetOffset(section, padj, &noff);CHKERRQ(ierr);
-      for (d = goff; d < goff+dof-cdof; ++d) {
-        ierr = PetscSectionAddDof(sectionAdj, d, ndof-ncdof);CHKERRQ(ierr);
-      }
+      nadj += pdof[padj-pStart];
     }
     ierr = PetscSectionGetDof(anchorSectionAdj, p, &anDof);CHKERRQ(ierr);
-    if (anDof) {
+    nadj += anDof;
+    if (nadj) {
       for (d = goff; d < goff+dof-cdof; ++d) {
-        ierr = PetscSectionAddDof(sectionAdj, d, anDof);CHKERRQ(ierr);
+        ierr = PetscSectionAddDof(sectionAdj, d, nadj);CHKERRQ(ierr);
       }
     }
   }
@@ -507,7 +571,7 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
   ierr = PetscSectionGetStorageSize(sectionAdj, &numCols);CHKERRQ(ierr);
   ierr = PetscMalloc1(numCols, &cols);CHKERRQ(ierr);
   for (p = pStart; p < pEnd; ++p) {
-    PetscInt  numAdj = PETSC_DETERMINE, dof, cdof, off, goff, d, q, anDof, anOff;
+    PetscInt  numAdj, poff, dof, cdof, off, goff, d, q, anDof, anOff;
     PetscBool found  = PETSC_TRUE;
 
     ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
@@ -532,7 +596,9 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
       }
     }
     if (found) continue;
-    ierr = DMPlexGetAdjacency_Internal(dm, p, useCone, useClosure, useAnchors, &numAdj, &tmpAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetDof(pointSectionAdj, p, &numAdj);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(pointSectionAdj, p, &poff);CHKERRQ(ierr);
+    tmpAdj = &pointAdj[poff];
     ierr = PetscSectionGetDof(anchorSectionAdj, p, &anDof);CHKERRQ(ierr);
     ierr = PetscSectionGetOffset(anchorSectionAdj, p, &anOff);CHKERRQ(ierr);
     for (d = goff; d < goff+dof-cdof; ++d) {
@@ -541,18 +607,15 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
       ierr = PetscSectionGetDof(sectionAdj, d, &adof);CHKERRQ(ierr);
       ierr = PetscSectionGetOffset(sectionAdj, d, &aoff);CHKERRQ(ierr);
       for (q = 0; q < numAdj; ++q) {
-        const PetscInt  padj = tmpAdj[q];
-        PetscInt        ndof, ncdof, ngoff, nd;
-        const PetscInt *ncind;
+        const PetscInt padj = tmpAdj[q];
+        PetscInt       ndof, ngoff, nd;
 
         /* Adjacent points may not be in the section chart */
         if ((padj < pStart) || (padj >= pEnd)) continue;
-        ierr = PetscSectionGetDof(section, padj, &ndof);CHKERRQ(ierr);
-        ierr = PetscSectionGetConstraintDof(section, padj, &ncdof);CHKERRQ(ierr);
-        ierr = PetscSectionGetConstraintIndices(section, padj, &ncind);CHKERRQ(ierr);
-        ierr = PetscSectionGetOffset(sectionGlobal, padj, &ngoff);CHKERRQ(ierr);
-        for (nd = 0; nd < ndof-ncdof; ++nd, ++i) {
-          cols[aoff+i] = ngoff < 0 ? -(ngoff+1)+nd : ngoff+nd;
+        ndof  = pdof[padj-pStart];
+        ngoff = pgoff[padj-pStart];
+        for (nd = 0; nd < ndof; ++nd, ++i) {
+          cols[aoff+i] = ngoff+nd;
         }
       }
       for (q = 0; q < anDof; q++, i++) {
@@ -566,7 +629,7 @@ static PetscErrorCode DMPlexCreateAdjacencySection_Static(DM dm, PetscInt bs, Pe
   ierr = PetscSectionDestroy(&rootSectionAdj);CHKERRQ(ierr);
   ierr = PetscFree(anchorAdj);CHKERRQ(ierr);
   ierr = PetscFree(rootAdj);CHKERRQ(ierr);
-  ierr = PetscFree(tmpAdj);CHKERRQ(ierr);
+  ierr = PetscFree2(pdof, pgoff);CHKERRQ(ierr);
   /* Debugging */
   if (debug) {
     IS tmp;
@@ -642,10 +705,12 @@ static PetscErrorCode DMPlexUpdateAllocation_Static(DM dm, PetscLayout rLayout,
   PetscFunctionReturn(0);
 }
 
+/* Rows are inserted once each, sorted and without duplicates, so that MatSetValues() never has to search or shift */
 static PetscErrorCode DMPlexFillMatrix_Static(DM dm, PetscLayout rLayout, PetscInt bs, PetscInt f, PetscSection sectionAdj, const PetscInt cols[], Mat A)
 {
   PetscSection   section;
   PetscScalar   *values;
+  PetscInt      *rowCols;
   PetscInt       rStart, rEnd, r, pStart, pEnd, p, len, maxRowLen = 0;
   PetscErrorCode ierr;
 
@@ -656,6 +721,7 @@ static PetscErrorCode DMPlexFillMatrix_Static(DM dm, PetscLayout rLayout, PetscI
     maxRowLen = PetscMax(maxRowLen, len);
   }
   ierr = PetscCalloc1(maxRowLen, &values);CHKERRQ(ierr);
+  ierr = PetscMalloc1(maxRowLen, &rowCols);CHKERRQ(ierr);
   if (f >=0 && bs == 1) {
     ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
     ierr = PetscSectionGetChart(section, &pStart, &pEnd);CHKERRQ(ierr);
@@ -664,22 +730,29 @@ static PetscErrorCode DMPlexFillMatrix_Static(DM dm, PetscLayout rLayout, PetscI
 
       ierr = DMGetGlobalFieldOffset_Private(dm, p, f, &rS, &rE);CHKERRQ(ierr);
       for (r = rS; r < rE; ++r) {
-        PetscInt numCols, cStart;
+        PetscInt numCols, cStart, c0 = 0;
 
         ierr = PetscSectionGetDof(sectionAdj, r, &numCols);CHKERRQ(ierr);
         ierr = PetscSectionGetOffset(sectionAdj, r, &cStart);CHKERRQ(ierr);
-        ierr = MatSetValues(A, 1, &r, numCols, &cols[cStart], values, INSERT_VALUES);CHKERRQ(ierr);
+        ierr = PetscArraycpy(rowCols, &cols[cStart], numCols);CHKERRQ(ierr);
+        ierr = PetscSortRemoveDupsInt(&numCols, rowCols);CHKERRQ(ierr);
+        while (c0 < numCols && rowCols[c0] < 0) ++c0;
+        ierr = MatSetValues(A, 1, &r, numCols-c0, &rowCols[c0], values, INSERT_VALUES);CHKERRQ(ierr);
       }
     }
   } else {
     for (r = rStart; r < rEnd; ++r) {
-      PetscInt numCols, cStart;
+      PetscInt numCols, cStart, c0 = 0;
 
       ierr = PetscSectionGetDof(sectionAdj, r, &numCols);CHKERRQ(ierr);
       ierr = PetscSectionGetOffset(sectionAdj, r, &cStart);CHKERRQ(ierr);
-      ierr = MatSetValues(A, 1, &r, numCols, &cols[cStart], values, INSERT_VALUES);CHKERRQ(ierr);
+      ierr = PetscArraycpy(rowCols, &cols[cStart], numCols);CHKERRQ(ierr);
+      ierr = PetscSortRemoveDupsInt(&numCols, rowCols);CHKERRQ(ierr);
+      while (c0 < numCols && rowCols[c0] < 0) ++c0;
+      ierr = MatSetValues(A, 1, &r, numCols-c0, &rowCols[c0], values, INSERT_VALUES);CHKERRQ(ierr);
     }
   }
+  ierr = PetscFree(rowCols);CHKERRQ(ierr);
   ierr = PetscFree(values);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -702,6 +775,11 @@ static PetscErrorCode DMPlexFillMatrix_Static(DM dm, PetscLayout rLayout, PetscI
   Ouput Argument:
 . A - The preallocated matrix
 
+  Options Database Keys:
+. -dm_plex_cache_adjacency <bool> - Keep the point adjacency on the DM for later preallocations, the default
+
+  Note: The point adjacency depends only on the mesh, so it is computed once and reused for any section. It is discarded when the chart, the anchors, or the adjacency callback change.
+
   Level: advanced
 
 .seealso: DMCreateMatrix()
@@ -770,13 +848,13 @@ PetscErrorCode DMPlexPreallocateOperator(DM dm, PetscInt bs, PetscInt dnz[], Pet
   if (Nf < 1 || bs > 1) {
     ierr = DMGetBasicAdjacency(dm, &useCone, &useClosure);CHKERRQ(ierr);
     idx  = (useCone ? 1 : 0) + (useClosure ? 2 : 0);
-    ierr = DMPlexCreateAdjacencySection_Static(dm, bs, sfDof, useCone, useClosure, PETSC_TRUE, &sectionAdj[idx], &cols[idx]);CHKERRQ(ierr);
+    ierr = DMPlexCreateAdjacencySection_Static(dm, bs, sfDof, useCone, useClosure, &sectionAdj[idx], &cols[idx]);CHKERRQ(ierr);
     ierr = DMPlexUpdateAllocation_Static(dm, rLayout, bs, -1, sectionAdj[idx], cols[idx], dnz, onz, dnzu, onzu);CHKERRQ(ierr);
   } else {
     for (f = 0; f < Nf; ++f) {
       ierr = DMGetAdjacency(dm, f, &useCone, &useClosure);CHKERRQ(ierr);
       idx  = (useCone ? 1 : 0) + (useClosure ? 2 : 0);
-      if (!sectionAdj[idx]) {ierr = DMPlexCreateAdjacencySection_Static(dm, bs, sfDof, useCone, useClosure, PETSC_TRUE, &sectionAdj[idx], &cols[idx]);CHKERRQ(ierr);}
+      if (!sectionAdj[idx]) {ierr = DMPlexCreateAdjacencySection_Static(dm, bs, sfDof, useCone, useClosure, &sectionAdj[idx], &cols[idx]);CHKERRQ(ierr);}
       ierr = DMPlexUpdateAllocation_Static(dm, rLayout, bs, f, sectionAdj[idx], cols[idx], dnz, onz, dnzu, onzu);CHKERRQ(ierr);
     }
   }
@@ -792,6 +870,11 @@ PetscErrorCode DMPlexPreallocateOperator(DM dm, PetscInt bs, PetscInt dnz[], Pet
   if (isSymBlock || isSymSeqBlock || isSymMPIBlock) {ierr = MatSetOption(A, MAT_IGNORE_LOWER_TRIANGULAR, PETSC_TRUE);CHKERRQ(ierr);}
   /* Fill matrix with zeros */
   if (fillMatrix) {
+    PetscBool isSeqAIJ;
+
+    /* Each row is set exactly once with sorted columns, so sequential AIJ can copy rows straight into place */
+    ierr = PetscObjectTypeCompare((PetscObject) A, MATSEQAIJ, &isSeqAIJ);CHKERRQ(ierr);
+    if (isSeqAIJ) {ierr = MatSetOption(A, MAT_SORTED_FULL, PETSC_TRUE);CHKERRQ(ierr);}
     if (Nf < 1 || bs > 1) {
       ierr = DMGetBasicAdjacency(dm, &useCone, &useClosure);CHKERRQ(ierr);
       idx  = (useCone ? 1 : 0) + (useClosure ? 2 : 0);
@@ -803,11 +886,13 @@ PetscErrorCode DMPlexPreallocateOperator(DM dm, PetscInt bs, PetscInt dnz[], Pet
         ierr = DMPlexFillMatrix_Static(dm, rLayout, bs, f, sectionAdj[idx], cols[idx], A);CHKERRQ(ierr);
       }
     }
+    if (isSeqAIJ) {ierr = MatSetOption(A, MAT_SORTED_FULL, PETSC_FALSE);CHKERRQ(ierr);}
     ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
     ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   }
   ierr = PetscLayoutDestroy(&rLayout);CHKERRQ(ierr);
   for (idx = 0; idx < 4; ++idx) {ierr = PetscSectionDestroy(&sectionAdj[idx]);CHKERRQ(ierr); ierr = PetscFree(cols[idx]);CHKERRQ(ierr);}
+  if (!((DM_Plex *) dm->data)->cacheAdjacency) {ierr = DMPlexResetAdjacencyGraph_Internal(dm);CHKERRQ(ierr);}
   ierr = PetscLogEventEnd(DMPLEX_Preallocate,dm,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -3115,6 +3115,13 @@ PetscErrorCode DMPlexCellRefinerSetUp(DMPlexCellRefiner cr)
     }
   }
   ierr = DMPlexCreateCellTypeOrder_Internal(ctCell, &cr->ctOrder, &cr->ctOrderInv);CHKERRQ(ierr);
+  /* Cache the cell types, since label lookups dominate the loops over points. The cache is indexed by point, like the
+     readers of cr->cellType[], so entries below pStart are unused. */
+  ierr = PetscMalloc1(pEnd, &cr->cellType);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) {
+    ierr = DMPlexGetCellType(dm, p, &cr->cellType[p]);CHKERRQ(ierr);
+    if ((PetscInt) cr->cellType[p] < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "No cell type for point %D", p);
+  }
   /* Construct sizes and offsets for each cell type */
   if (!cr->ctStart) {
     PetscInt *ctS, *ctSN, *ctC, *ctCN;
@@ -3127,8 +3134,7 @@ PetscErrorCode DMPlexCellRefinerSetUp(DMPlexCellRefiner cr)
       PetscInt       *rsize, *cone, *ornt;
       PetscInt        Nct, n;
 
-      ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
-      if ((PetscInt) ct < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "No cell type for point %D", p);
+      ct = cr->cellType[p];
       ++ctC[ct];
       ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &cone, &ornt);CHKERRQ(ierr);
       for (n = 0; n < Nct; ++n) ctCN[rct[n]] += rsize[n];
@@ -3145,6 +3151,20 @@ PetscErrorCode DMPlexCellRefinerSetUp(DMPlexCellRefiner cr)
     cr->ctStartNew = ctSN;
   }
   ierr = CellRefinerCreateOffset_Internal(cr, cr->ctOrder, cr->ctStart, &cr->offset);CHKERRQ(ierr);
+  /* Cache the number of new points for each cell type when it does not depend on a refine type */
+  if (!cr->refineType) {
+    ierr = PetscCalloc1(DM_NUM_POLYTOPES*DM_NUM_POLYTOPES, &cr->ctNumNew);CHKERRQ(ierr);
+    for (c = 0; c < DM_NUM_POLYTOPES; ++c) {
+      const PetscInt  ct = cr->ctOrder[c];
+      DMPolytopeType *rct;
+      PetscInt       *rsize, *cone, *ornt;
+      PetscInt        Nct, n;
+
+      if (cr->ctStart[cr->ctOrder[c+1]] == cr->ctStart[ct]) continue;
+      ierr = DMPlexCellRefinerRefine(cr, (DMPolytopeType) ct, cr->ctStart[ct], NULL, &Nct, &rct, &rsize, &cone, &ornt);CHKERRQ(ierr);
+      for (n = 0; n < Nct; ++n) cr->ctNumNew[ct*DM_NUM_POLYTOPES+rct[n]] = rsize[n];
+    }
+  }
   cr->setupcalled = PETSC_TRUE;
   PetscFunctionReturn(0);
 }
@@ -3203,6 +3223,8 @@ PetscErrorCode DMPlexCellRefinerDestroy(DMPlexCellRefiner *cr)
   ierr = PetscFree2((*cr)->ctOrder, (*cr)->ctOrderInv);CHKERRQ(ierr);
   ierr = PetscFree2((*cr)->ctStart, (*cr)->ctStartNew);CHKERRQ(ierr);
   ierr = PetscFree((*cr)->offset);CHKERRQ(ierr);
+  ierr = PetscFree((*cr)->ctNumNew);CHKERRQ(ierr);
+  ierr = PetscFree((*cr)->cellType);CHKERRQ(ierr);
   for (c = 0; c < DM_NUM_POLYTOPES; ++c) {
     ierr = PetscFEDestroy(&(*cr)->coordFE[c]);CHKERRQ(ierr);
     ierr = PetscFEGeomDestroy(&(*cr)->refGeom[c]);CHKERRQ(ierr);
@@ -3401,6 +3423,16 @@ PetscErrorCode DMPlexCellRefinerGetNewPoint(DMPlexCellRefiner cr, DMPolytopeType
 
   PetscFunctionBeginHot;
   if ((p < ctS) || (p >= ctE)) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point %D is not a %s [%D, %D)", p, DMPolytopeTypes[ct], ctS, ctE);
+  if (cr->ctNumNew) {
+    /* Every point of type ct is refined the same way, so the new points are numbered in closed form */
+    const PetscInt Nr = cr->ctNumNew[ct*DM_NUM_POLYTOPES + ctNew];
+
+    off = cr->offset[ct*DM_NUM_POLYTOPES + ctNew];
+    if (off < 0 || !Nr) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Cell type %s of point %D does not produce type %s", DMPolytopeTypes[ct], p, DMPolytopeTypes[ctNew]);
+    if (r < 0 || r >= Nr) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Replica number %D should be in [0, %D) for subcell type %s in cell type %s", r, Nr, DMPolytopeTypes[ctNew], DMPolytopeTypes[ct]);
+    *pNew = ctSN + off + (p - ctS)*Nr + r;
+    PetscFunctionReturn(0);
+  }
   ierr = DMPlexCellRefinerRefine(cr, ct, p, &rt, &Nct, &rct, &rsize, &cone, &ornt);CHKERRQ(ierr);
   if (cr->refineType) {
     /* TODO Make this a function in DMLabel */
@@ -3449,20 +3481,51 @@ static PetscErrorCode DMPlexCellRefinerSetConeSizes(DMPlexCellRefiner cr, DM rdm
   PetscFunctionBegin;
   /* Must create the celltype label here so that we do not automatically try to compute the types */
   ierr = DMCreateLabel(rdm, "celltype");CHKERRQ(ierr);
-  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
-  for (p = pStart; p < pEnd; ++p) {
-    DMPolytopeType  ct;
-    DMPolytopeType *rct;
-    PetscInt       *rsize, *rcone, *rornt;
-    PetscInt        Nct, n, r;
+  if (cr->ctNumNew) {
+    /* New points of each type are contiguous, so set sizes by range and mark each type with a single stratum */
+    DMLabel   ctLabel;
+    PetscBool seen[DM_NUM_POLYTOPES];
+    PetscInt  c;
 
-    ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
-    ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
-    for (n = 0; n < Nct; ++n) {
-      for (r = 0; r < rsize[n]; ++r) {
-        ierr = DMPlexCellRefinerGetNewPoint(cr, ct, rct[n], p, r, &pNew);CHKERRQ(ierr);
-        ierr = DMPlexSetConeSize(rdm, pNew, DMPolytopeTypeGetConeSize(rct[n]));CHKERRQ(ierr);
-        ierr = DMPlexSetCellType(rdm, pNew, rct[n]);CHKERRQ(ierr);
+    ierr = DMPlexGetCellTypeLabel(rdm, &ctLabel);CHKERRQ(ierr);
+    for (c = 0; c < DM_NUM_POLYTOPES; ++c) seen[c] = PETSC_FALSE;
+    /* Strata are added in the order the point loop below would first encounter each type */
+    for (c = 0; c < DM_NUM_POLYTOPES; ++c) {
+      const PetscInt  ct = cr->ctOrder[c];
+      DMPolytopeType *rct;
+      PetscInt       *rsize, *rcone, *rornt;
+      PetscInt        Nct, n;
+
+      if (cr->ctStart[cr->ctOrder[c+1]] == cr->ctStart[ct]) continue;
+      ierr = DMPlexCellRefinerRefine(cr, (DMPolytopeType) ct, cr->ctStart[ct], NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
+      for (n = 0; n < Nct; ++n) {
+        const DMPolytopeType ctNew    = rct[n];
+        const PetscInt       coneSize = DMPolytopeTypeGetConeSize(ctNew);
+        const PetscInt       nStart   = cr->ctStartNew[ctNew];
+        const PetscInt       nEnd     = cr->ctStartNew[cr->ctOrder[cr->ctOrderInv[ctNew]+1]];
+
+        if (!rsize[n] || seen[ctNew]) continue;
+        seen[ctNew] = PETSC_TRUE;
+        for (pNew = nStart; pNew < nEnd; ++pNew) {ierr = DMPlexSetConeSize(rdm, pNew, coneSize);CHKERRQ(ierr);}
+        ierr = DMLabelSetStratumBounds(ctLabel, ctNew, nStart, nEnd);CHKERRQ(ierr);
+      }
+    }
+  } else {
+    ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+    for (p = pStart; p < pEnd; ++p) {
+      DMPolytopeType  ct;
+      DMPolytopeType *rct;
+      PetscInt       *rsize, *rcone, *rornt;
+      PetscInt        Nct, n, r;
+
+      ct = cr->cellType[p];
+      ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
+      for (n = 0; n < Nct; ++n) {
+        for (r = 0; r < rsize[n]; ++r) {
+          ierr = DMPlexCellRefinerGetNewPoint(cr, ct, rct[n], p, r, &pNew);CHKERRQ(ierr);
+          ierr = DMPlexSetConeSize(rdm, pNew, DMPolytopeTypeGetConeSize(rct[n]));CHKERRQ(ierr);
+          ierr = DMPlexSetCellType(rdm, pNew, rct[n]);CHKERRQ(ierr);
+        }
       }
     }
   }
@@ -3494,7 +3557,7 @@ static PetscErrorCode DMPlexCellRefinerSetCones(DMPlexCellRefiner cr, DM rdm)
     DMPolytopeType *rct;
     PetscInt       *rsize, *rcone, *rornt;
     PetscInt        Nct, n, r;
-    ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
+    ct = cr->cellType[p];
     ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
     ierr = DMPlexGetConeOrientation(dm, p, &ornt);CHKERRQ(ierr);
     ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
@@ -3525,7 +3588,7 @@ static PetscErrorCode DMPlexCellRefinerSetCones(DMPlexCellRefiner cr, DM rdm)
             ierr = DMPolytopeMapCell(pct, po, rcone[coff++], &pcp);CHKERRQ(ierr);
             ppp  = pp;
             pp   = pcone[pcp];
-            ierr = DMPlexGetCellType(dm, pp, &pct);CHKERRQ(ierr);
+            pct = cr->cellType[pp];
             ierr = DMPlexGetCone(dm, pp, &pcone);CHKERRQ(ierr);
             ierr = DMPlexGetConeOrientation(dm, ppp, &ppornt);CHKERRQ(ierr);
             if (po <  0 && pct != DM_POLYTOPE_POINT) {
@@ -3702,7 +3765,7 @@ static PetscErrorCode DMPlexCellRefinerSetCoordinates(DMPlexCellRefiner cr, DM r
         PetscInt       *rsize, *rcone, *rornt;
         PetscInt        dim, cNew, Nct, n, r;
 
-        ierr = DMPlexGetCellType(dm, c, &ct);CHKERRQ(ierr);
+        ct = cr->cellType[c];
         dim  = DMPolytopeTypeGetDim(ct);
         ierr = DMPlexCellRefinerRefine(cr, ct, c, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
         /* This allows for different cell types */
@@ -3754,7 +3817,7 @@ static PetscErrorCode DMPlexCellRefinerSetCoordinates(DMPlexCellRefiner cr, DM r
     PetscInt        Nct, n, r;
     PetscBool       hasVertex = PETSC_FALSE, isLocalized = PETSC_FALSE;
 
-    ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
+    ct = cr->cellType[p];
     ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
     for (n = 0; n < Nct; ++n) {
       if (rct[n] == DM_POLYTOPE_POINT) {hasVertex = PETSC_TRUE; break;}
@@ -3810,7 +3873,7 @@ static PetscErrorCode DMPlexCellRefinerSetCoordinates(DMPlexCellRefiner cr, DM r
     PetscInt        Nct, n, r;
     PetscBool       isLocalized = PETSC_FALSE;
 
-    ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
+    ct = cr->cellType[p];
     ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
     if (localizeCells && ct != DM_POLYTOPE_POINT && (p >= ocStart) && (p < ocEnd)) {
       PetscInt dof;
@@ -3945,7 +4008,7 @@ static PetscErrorCode DMPlexCellRefinerCreateSF(DMPlexCellRefiner cr, DM rdm)
     PetscInt       *rsize, *rcone, *rornt;
     PetscInt        Nct, n;
 
-    ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
+    ct = cr->cellType[p];
     ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
     for (n = 0; n < Nct; ++n) {
       numLeavesNew += rsize[n];
@@ -3961,7 +4024,7 @@ static PetscErrorCode DMPlexCellRefinerCreateSF(DMPlexCellRefiner cr, DM rdm)
       PetscInt       *rsize, *rcone, *rornt;
       PetscInt        Nct, n;
 
-      ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
+      ct = cr->cellType[p];
       ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
       for (n = 0; n < Nct; ++n) {
         ierr = PetscSectionAddDof(s, p, rsize[n]);CHKERRQ(ierr);
@@ -3984,7 +4047,7 @@ static PetscErrorCode DMPlexCellRefinerCreateSF(DMPlexCellRefiner cr, DM rdm)
 
       if (!rootdegree[p-pStart]) continue;
       ierr = PetscSectionGetOffset(s, p, &off);CHKERRQ(ierr);
-      ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
+      ct = cr->cellType[p];
       ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
       for (n = 0, m = 0; n < Nct; ++n) {
         for (r = 0; r < rsize[n]; ++r, ++m) {
@@ -4006,7 +4069,7 @@ static PetscErrorCode DMPlexCellRefinerCreateSF(DMPlexCellRefiner cr, DM rdm)
       PetscInt        Nct, n, r, q, off;
 
       ierr = PetscSectionGetOffset(s, p, &off);CHKERRQ(ierr);
-      ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
+      ct = cr->cellType[p];
       ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
       for (n = 0, q = 0; n < Nct; ++n) {
         for (r = 0; r < rsize[n]; ++r, ++m, ++q) {
@@ -4054,7 +4117,7 @@ static PetscErrorCode DMPlexCellRefinerCreateSF(DMPlexCellRefiner cr, DM rdm)
 
       ierr = PetscFindInt(rankRem, numNeighbors, neighbors, &neighbor);CHKERRQ(ierr);
       if (neighbor < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Could not locate remote rank %D", rankRem);
-      ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
+      ct = cr->cellType[p];
       ierr = DMPlexCellRefinerRefine(cr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
       for (n = 0; n < Nct; ++n) {
         for (r = 0; r < rsize[n]; ++r) {
@@ -4104,7 +4167,6 @@ static PetscErrorCode DMPlexCellRefinerCreateSF(DMPlexCellRefiner cr, DM rdm)
 
 static PetscErrorCode RefineLabel_Internal(DMPlexCellRefiner cr, DMLabel label, DMLabel labelNew)
 {
-  DM              dm = cr->dm;
   IS              valueIS;
   const PetscInt *values;
   PetscInt        defVal, Nv, val;
@@ -4134,7 +4196,7 @@ static PetscErrorCode RefineLabel_Internal(DMPlexCellRefiner cr, DMLabel label,
       PetscInt       *rsize, *rcone, *rornt;
       PetscInt        Nct, n, r, pNew;
 
-      ierr = DMPlexGetCellType(dm, point, &ct);CHKERRQ(ierr);
+      ct = cr->cellType[point];
       ierr = DMPlexCellRefinerRefine(cr, ct, point, NULL, &Nct, &rct, &rsize, &rcone, &rornt);CHKERRQ(ierr);
       for (n = 0; n < Nct; ++n) {
         for (r = 0; r < rsize[n]; ++r) {
@@ -4195,20 +4257,30 @@ PetscErrorCode DMPlexRefineUniform(DM dm, DMPlexCellRefiner cr, DM *dmRefined)
   /* Calculate number of new points of each depth */
   ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
   if (depth >= 0 && dim != depth) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_WRONG, "Mesh must be interpolated for regular refinement");
+  ierr = PetscLogEventBegin(DMPLEX_Refine,dm,0,0,0);CHKERRQ(ierr);
   /* Step 1: Set chart */
   ierr = DMPlexSetChart(rdm, 0, cr->ctStartNew[cr->ctOrder[DM_NUM_POLYTOPES]]);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(DMPLEX_RefineCones,dm,0,0,0);CHKERRQ(ierr);
   /* Step 2: Set cone/support sizes (automatically stratifies) */
   ierr = DMPlexCellRefinerSetConeSizes(cr, rdm);CHKERRQ(ierr);
   /* Step 3: Setup refined DM */
   ierr = DMSetUp(rdm);CHKERRQ(ierr);
   /* Step 4: Set cones and supports (automatically symmetrizes) */
   ierr = DMPlexCellRefinerSetCones(cr, rdm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_RefineCones,dm,0,0,0);CHKERRQ(ierr);
   /* Step 5: Create pointSF */
+  ierr = PetscLogEventBegin(DMPLEX_RefineSF,dm,0,0,0);CHKERRQ(ierr);
   ierr = DMPlexCellRefinerCreateSF(cr, rdm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_RefineSF,dm,0,0,0);CHKERRQ(ierr);
   /* Step 6: Create labels */
+  ierr = PetscLogEventBegin(DMPLEX_RefineLabels,dm,0,0,0);CHKERRQ(ierr);
   ierr = DMPlexCellRefinerCreateLabels(cr, rdm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_RefineLabels,dm,0,0,0);CHKERRQ(ierr);
   /* Step 7: Set coordinates */
+  ierr = PetscLogEventBegin(DMPLEX_RefineCoordinates,dm,0,0,0);CHKERRQ(ierr);
   ierr = DMPlexCellRefinerSetCoordinates(cr, rdm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_RefineCoordinates,dm,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_Refine,dm,0,0,0);CHKERRQ(ierr);
   *dmRefined = rdm;
   PetscFunctionReturn(0);
 }
@@ -45,6 +45,88 @@ static PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoin
   PetscFunctionReturn(0);
 }
 
+/* Map integer coordinates X[0..dim), each with b bits, to the index along the Hilbert curve (Skilling, AIP Conf. Proc. 707, 2004) */
+static PetscInt64 DMPlexHilbertIndex_Private(PetscInt dim, PetscInt b, PetscInt64 X[])
+{
+  PetscInt64 M = ((PetscInt64) 1) << (b-1), P, Q, t, h = 0;
+  PetscInt   i, bit;
+
+  /* Inverse undo excess work */
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for (i = 0; i < dim; ++i) {
+      if (X[i] & Q) X[0] ^= P;
+      else {t = (X[0] ^ X[i]) & P; X[0] ^= t; X[i] ^= t;}
+    }
+  }
+  /* Gray encode */
+  for (i = 1; i < dim; ++i) X[i] ^= X[i-1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1) if (X[dim-1] & Q) t ^= Q - 1;
+  for (i = 0; i < dim; ++i) X[i] ^= t;
+  /* Interleave the transposed bits */
+  for (bit = b-1; bit >= 0; --bit) for (i = 0; i < dim; ++i) h = (h << 1) | ((X[i] >> bit) & 1);
+  return h;
+}
+
+/* Order cells along a Hilbert curve through their vertex centroids, cperm[new cell] = old cell */
+static PetscErrorCode DMPlexCreateOrderingHilbert_Static(DM dm, PetscInt numCells, PetscInt cperm[])
+{
+  DM             cdm;
+  PetscSection   csection;
+  Vec            coordinates;
+  PetscReal     *centroids, *keys, lower[3], upper[3];
+  PetscInt       cdim, bits, c, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  if (cdim > 3) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Hilbert ordering not supported for coordinate dimension %D > 3", cdim);
+  ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+  ierr = DMGetLocalSection(cdm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  if (!coordinates) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_WRONGSTATE, "Hilbert ordering requires mesh coordinates");
+  ierr = PetscMalloc2(numCells*cdim, &centroids, numCells, &keys);CHKERRQ(ierr);
+  for (d = 0; d < cdim; ++d) {lower[d] = PETSC_MAX_REAL; upper[d] = PETSC_MIN_REAL;}
+  for (c = 0; c < numCells; ++c) {
+    PetscScalar *coords = NULL;
+    PetscInt     csize, Nv, v;
+
+    ierr = DMPlexVecGetClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+    Nv   = csize/cdim;
+    for (d = 0; d < cdim; ++d) {
+      PetscReal x = 0.0;
+
+      for (v = 0; v < Nv; ++v) x += PetscRealPart(coords[v*cdim+d]);
+      centroids[c*cdim+d] = x/Nv;
+      lower[d] = PetscMin(lower[d], centroids[c*cdim+d]);
+      upper[d] = PetscMax(upper[d], centroids[c*cdim+d]);
+    }
+    ierr = DMPlexVecRestoreClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+  }
+  /* Keep the key exactly representable as a PetscReal */
+#if defined(PETSC_USE_REAL_SINGLE)
+  bits = PetscMin(16, 24/cdim);
+#else
+  bits = 16;
+#endif
+  for (c = 0; c < numCells; ++c) {
+    const PetscInt64 maxInt = (((PetscInt64) 1) << bits) - 1;
+    PetscInt64       X[3];
+
+    for (d = 0; d < cdim; ++d) {
+      const PetscReal h = upper[d] > lower[d] ? (centroids[c*cdim+d] - lower[d])/(upper[d] - lower[d]) : 0.0;
+
+      X[d] = PetscMin(maxInt, (PetscInt64) (h*(maxInt+1)));
+    }
+    keys[c]  = (PetscReal) DMPlexHilbertIndex_Private(cdim, bits, X);
+    cperm[c] = c;
+  }
+  ierr = PetscSortRealWithArrayInt(numCells, keys, cperm);CHKERRQ(ierr);
+  ierr = PetscFree2(centroids, keys);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexGetOrdering - Calculate a reordering of the mesh
 
@@ -58,40 +140,75 @@ $     MATORDERINGND - Nested Dissection
 $     MATORDERING1WD - One-way Dissection
 $     MATORDERINGRCM - Reverse Cuthill-McKee
 $     MATORDERINGQMD - Quotient Minimum Degree
+$     DMPLEX_ORDERING_HILBERT - Hilbert space-filling curve through the cell centroids
 - label - [Optional] Label used to segregate ordering into sets, or NULL
 
 
   Output Parameter:
 . perm - The point permutation as an IS, perm[old point number] = new point number
 
-  Note: The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
+  Notes:
+  The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
   has different types of cells, and then loop over each set of reordered cells for assembly.
 
+  Cells are ordered using the cell dual graph (or the cell centroids for DMPLEX_ORDERING_HILBERT), and the lower
+  dimensional points are then numbered in order of first appearance in the closures of the reordered cells. Only the
+  local mesh is reordered, so the ordering can be computed independently on each process.
+
   Level: intermediate
 
-.seealso: MatGetOrdering()
+.seealso: MatGetOrdering(), DMPlexPermute(), DMPlexComputeOrderingMetrics()
 @*/
 PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS *perm)
 {
   PetscInt       numCells = 0;
   PetscInt      *start = NULL, *adjacency = NULL, *cperm, *clperm = NULL, *invclperm = NULL, *mask, *xls, pStart, pEnd, c, i;
+  PetscBool      isRCM, isNatural, isHilbert;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(perm, 3);
+  if (!otype) otype = MATORDERINGRCM;
+  ierr = PetscStrcmp(otype, MATORDERINGRCM, &isRCM);CHKERRQ(ierr);
+  ierr = PetscStrcmp(otype, MATORDERINGNATURAL, &isNatural);CHKERRQ(ierr);
+  ierr = PetscStrcmp(otype, DMPLEX_ORDERING_HILBERT, &isHilbert);CHKERRQ(ierr);
   ierr = DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency);CHKERRQ(ierr);
   ierr = PetscMalloc3(numCells,&cperm,numCells,&mask,numCells*2,&xls);CHKERRQ(ierr);
-  if (numCells) {
+  if (isNatural) {
+    for (c = 0; c < numCells; ++c) cperm[c] = c;
+  } else if (isHilbert) {
+    ierr = DMPlexCreateOrderingHilbert_Static(dm, numCells, cperm);CHKERRQ(ierr);
+  } else if (isRCM) {
+    if (numCells) {
+      /* Shift for Fortran numbering */
+      for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
+      for (i = 0; i <= numCells; ++i)       ++start[i];
+      ierr = SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls);CHKERRQ(ierr);
+    }
     /* Shift for Fortran numbering */
-    for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
-    for (i = 0; i <= numCells; ++i)       ++start[i];
-    ierr = SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls);CHKERRQ(ierr);
+    for (c = 0; c < numCells; ++c) --cperm[c];
+  } else if (numCells) {
+    Mat             G;
+    IS              rperm, colperm;
+    const PetscInt *rp;
+    PetscScalar    *vals;
+
+    /* Any other MatOrderingType is computed on the cell dual graph, which needs sorted rows */
+    for (c = 0; c < numCells; ++c) {ierr = PetscSortInt(start[c+1]-start[c], &adjacency[start[c]]);CHKERRQ(ierr);}
+    ierr = PetscCalloc1(start[numCells], &vals);CHKERRQ(ierr);
+    ierr = MatCreateSeqAIJWithArrays(PETSC_COMM_SELF, numCells, numCells, start, adjacency, vals, &G);CHKERRQ(ierr);
+    ierr = MatGetOrdering(G, otype, &rperm, &colperm);CHKERRQ(ierr);
+    ierr = ISGetIndices(rperm, &rp);CHKERRQ(ierr);
+    ierr = PetscArraycpy(cperm, rp, numCells);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(rperm, &rp);CHKERRQ(ierr);
+    ierr = ISDestroy(&rperm);CHKERRQ(ierr);
+    ierr = ISDestroy(&colperm);CHKERRQ(ierr);
+    ierr = MatDestroy(&G);CHKERRQ(ierr);
+    ierr = PetscFree(vals);CHKERRQ(ierr);
   }
   ierr = PetscFree(start);CHKERRQ(ierr);
   ierr = PetscFree(adjacency);CHKERRQ(ierr);
-  /* Shift for Fortran numbering */
-  for (c = 0; c < numCells; ++c) --cperm[c];
   /* Segregate */
   if (label) {
     IS              valueIS;
@@ -170,7 +287,8 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
   ierr = DMSetDimension(*pdm, dim);CHKERRQ(ierr);
   ierr = DMCopyDisc(dm, *pdm);CHKERRQ(ierr);
-  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  /* Do not force creation of the default section, it is built lazily on the permuted mesh */
+  section = dm->localSection;
   if (section) {
     ierr = PetscSectionPermute(section, perm, &sectionNew);CHKERRQ(ierr);
     ierr = DMSetLocalSection(*pdm, sectionNew);CHKERRQ(ierr);
@@ -178,7 +296,42 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   }
   plexNew = (DM_Plex *) (*pdm)->data;
   /* Ignore ltogmap, ltogmapb */
-  /* Ignore sf, sectionSF */
+  /* Renumber both ends of the point SF, every process permutes its own points */
+  {
+    PetscSF            sf, sfNew;
+    const PetscInt    *pperm, *leaves;
+    const PetscSFNode *remotes;
+    PetscInt          *leafPerm, *leavesNew, *order, nroots, nleaves, l;
+    PetscSFNode       *remotesNew;
+
+    ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+    if (nroots >= 0) {
+      ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nroots, &leafPerm);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(sf, MPIU_INT, pperm, leafPerm);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf, MPIU_INT, pperm, leafPerm);CHKERRQ(ierr);
+      /* Keep the leaves sorted, since callers search them */
+      ierr = PetscMalloc3(nleaves, &leavesNew, nleaves, &order, nleaves, &remotesNew);CHKERRQ(ierr);
+      for (l = 0; l < nleaves; ++l) {order[l] = l; leavesNew[l] = pperm[leaves ? leaves[l] : l];}
+      ierr = PetscSortIntWithPermutation(nleaves, leavesNew, order);CHKERRQ(ierr);
+      for (l = 0; l < nleaves; ++l) {
+        const PetscInt leaf = leaves ? leaves[order[l]] : order[l];
+
+        remotesNew[l].rank  = remotes[order[l]].rank;
+        remotesNew[l].index = leafPerm[leaf];
+      }
+      for (l = 0; l < nleaves; ++l) leavesNew[l] = pperm[leaves ? leaves[order[l]] : order[l]];
+      ierr = PetscSFCreate(PetscObjectComm((PetscObject) dm), &sfNew);CHKERRQ(ierr);
+      ierr = PetscSFSetGraph(sfNew, nroots, nleaves, leavesNew, PETSC_COPY_VALUES, remotesNew, PETSC_COPY_VALUES);CHKERRQ(ierr);
+      ierr = DMSetPointSF(*pdm, sfNew);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&sfNew);CHKERRQ(ierr);
+      ierr = PetscFree3(leavesNew, order, remotesNew);CHKERRQ(ierr);
+      ierr = PetscFree(leafPerm);CHKERRQ(ierr);
+      ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+    }
+  }
+  /* Ignore sectionSF, it is rebuilt from the point SF */
   /* Ignore globalVertexNumbers, globalCellNumbers */
   /* Reorder labels */
   {
@@ -279,3 +432,76 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   (*pdm)->setupcalled = PETSC_TRUE;
   PetscFunctionReturn(0);
 }
+
+/*@
+  DMPlexComputeOrderingMetrics - Measure the memory locality of the local mesh numbering
+
+  Not collective
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameters:
++ closureSpan - [Optional] The average over cells of the extent of the cell closure, measured in local dofs if a local section is set and in mesh points otherwise
+- bandwidth   - [Optional] The bandwidth of the cell dual graph, the largest difference in number between two cells sharing a face
+
+  Note: Smaller values mean that the data touched by a cell, and by its neighbors, lies closer together in memory.
+
+  Level: intermediate
+
+.seealso: DMPlexGetOrdering(), DMPlexPermute(), MatComputeBandwidth()
+@*/
+PetscErrorCode DMPlexComputeOrderingMetrics(DM dm, PetscReal *closureSpan, PetscInt *bandwidth)
+{
+  PetscSection   section;
+  PetscInt       cStart, cEnd, c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  if (closureSpan) {
+    PetscInt  *closure = NULL, clSize, cl, storage = 0;
+    PetscReal  span = 0.0;
+
+    section = dm->localSection;
+    if (section) {ierr = PetscSectionGetStorageSize(section, &storage);CHKERRQ(ierr);}
+    if (!storage) section = NULL;
+    for (c = cStart; c < cEnd; ++c) {
+      PetscInt lo = PETSC_MAX_INT, hi = PETSC_MIN_INT;
+
+      ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+      for (cl = 0; cl < clSize*2; cl += 2) {
+        const PetscInt p = closure[cl];
+
+        if (section) {
+          PetscInt dof, off;
+
+          ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
+          if (!dof) continue;
+          ierr = PetscSectionGetOffset(section, p, &off);CHKERRQ(ierr);
+          lo = PetscMin(lo, off);
+          hi = PetscMax(hi, off+dof-1);
+        } else {
+          lo = PetscMin(lo, p);
+          hi = PetscMax(hi, p);
+        }
+      }
+      ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+      if (hi >= lo) span += hi - lo + 1;
+    }
+    *closureSpan = cEnd > cStart ? span/(cEnd - cStart) : 0.0;
+  }
+  if (bandwidth) {
+    PetscInt *start = NULL, *adjacency = NULL, numCells = 0, i;
+
+    *bandwidth = 0;
+    ierr = DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency);CHKERRQ(ierr);
+    for (c = 0; c < numCells; ++c) {
+      for (i = start[c]; i < start[c+1]; ++i) *bandwidth = PetscMax(*bandwidth, PetscAbsInt(adjacency[i] - c));
+    }
+    ierr = PetscFree(start);CHKERRQ(ierr);
+    ierr = PetscFree(adjacency);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
@@ -226,7 +226,21 @@ int main(int argc, char **argv)
   test:
     suffix: 7
     args: -dim 3 -dm_plex_box_simplex 0 -dm_refine 1              -num_dof 1,0,0,0
+  # Reordering during DMSetFromOptions(), the Hilbert curve targets the closure span and not the bandwidth of a box mesh
+  test:
+    suffix: reorder_hilbert_2d
+    args: -dim 2 -dm_plex_box_simplex 0 -dm_plex_box_faces 8,8 -num_dof 1,0,0 -dm_plex_reorder hilbert -dm_plex_reorder_view
+    filter: sed -e "s/, cell bandwidth [0-9]\{1,\}//g"
+  test:
+    suffix: reorder_hilbert_3d
+    args: -dim 3 -dm_plex_box_simplex 0 -dm_plex_box_faces 4,4,4 -num_dof 1,0,0,0 -dm_plex_reorder hilbert -dm_plex_reorder_view
+    filter: sed -e "s/, cell bandwidth [0-9]\{1,\}//g"
   # Parallel tests
+  test:
+    suffix: reorder_hilbert_par
+    nsize: 2
+    args: -dim 2 -dm_plex_box_simplex 0 -dm_plex_box_faces 8,8 -num_dof 1,0,0 -dm_distribute -dm_plex_reorder hilbert -dm_plex_reorder_view -dm_plex_check_all -perm_dm_plex_check_all
+    filter: sed -e "s/, cell bandwidth [0-9]\{1,\}//g"
   # Grouping tests
   test:
     suffix: group_1
@@ -52,6 +52,7 @@ static PetscErrorCode DMPlexWriteAndReadHDF5(DM dm, const char filename[], Petsc
   ierr = DMSetType(dmnew, DMPLEX);CHKERRQ(ierr);
   ierr = DMSetOptionsPrefix(dmnew, prefix);CHKERRQ(ierr);
   ierr = DMLoad(dmnew, v);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dmnew);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject)dmnew,"Mesh_new");CHKERRQ(ierr);
 
   ierr = PetscViewerPopFormat(v);CHKERRQ(ierr);
@@ -160,6 +161,17 @@ int main(int argc, char **argv)
     args: -filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/blockcylinder-50.h5
     args: -dm_plex_create_from_hdf5_xdmf -distribute 0 -format hdf5_xdmf -second_write_read -compare
 
+  # Load HDF5 file in XDMF format in parallel, write in native format, read it back in parallel, directly distributed,
+  # with or without the stored partition, write, read dm2, and compare dm1 and dm2
+  test:
+    suffix: 5
+    requires: !complex
+    nsize: {{1 2 3}}
+    args: -filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/blockcylinder-50.h5
+    args: -dm_plex_create_from_hdf5_xdmf -distribute 0 -interpolate 1 -format hdf5_petsc -second_write_read -compare
+    args: -new_dm_plex_hdf5_parallel_load -new_dm_plex_hdf5_reuse_partition {{0 1}}
+    args: -dm_plex_check_all -new_dm_plex_check_all
+
   testset:
     # the same data and settings as dm_impls_plex_tests-ex18_9%
     requires: hdf5 !complex datafilespath
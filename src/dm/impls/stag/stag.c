@@ -467,7 +467,8 @@ PETSC_EXTERN PetscErrorCode DMCreate_Stag(DM dm)
   ierr = PetscMemzero(dm->ops,sizeof(*(dm->ops)));CHKERRQ(ierr);
   dm->ops->createcoordinatedm  = DMCreateCoordinateDM_Stag;
   dm->ops->createglobalvector  = DMCreateGlobalVector_Stag;
-  dm->ops->createinterpolation = NULL;
+  dm->ops->coarsen             = DMCoarsen_Stag;
+  dm->ops->createinterpolation = DMCreateInterpolation_Stag;
   dm->ops->createlocalvector   = DMCreateLocalVector_Stag;
   dm->ops->creatematrix        = DMCreateMatrix_Stag;
   dm->ops->destroy             = DMDestroy_Stag;
@@ -476,6 +477,7 @@ PETSC_EXTERN PetscErrorCode DMCreate_Stag(DM dm)
   dm->ops->globaltolocalend    = DMGlobalToLocalEnd_Stag;
   dm->ops->localtoglobalbegin  = DMLocalToGlobalBegin_Stag;
   dm->ops->localtoglobalend    = DMLocalToGlobalEnd_Stag;
+  dm->ops->refine              = DMRefine_Stag;
   dm->ops->setfromoptions      = DMSetFromOptions_Stag;
   switch (dim) {
     case 1: dm->ops->setup     = DMSetUp_Stag_1d; break;
@@ -0,0 +1,310 @@
+/* Grid transfer operations for geometric multigrid with DMStag: DMRefine(), DMCoarsen(), and DMCreateInterpolation() */
+#include <petsc/private/dmstagimpl.h>
+
+/* Canonical locations of a DMStag, the stratum of each, and whether each is located at a vertex
+   ("primal") or at an element center ("dual") in each direction. Each canonical location has
+   exactly one point per element, including the partial elements on the right, top, and front
+   non-periodic boundaries. */
+typedef struct {
+  DMStagStencilLocation loc;
+  PetscInt              stratum;
+  PetscBool             primal[DMSTAG_MAX_DIM];
+} DMStagCanonicalLocation;
+
+static const DMStagCanonicalLocation DMStagCanonicalLocations1d[] = {
+  {DMSTAG_LEFT,          0,{PETSC_TRUE, PETSC_FALSE,PETSC_FALSE}},
+  {DMSTAG_ELEMENT,       1,{PETSC_FALSE,PETSC_FALSE,PETSC_FALSE}}
+};
+
+static const DMStagCanonicalLocation DMStagCanonicalLocations2d[] = {
+  {DMSTAG_DOWN_LEFT,     0,{PETSC_TRUE, PETSC_TRUE, PETSC_FALSE}},
+  {DMSTAG_DOWN,          1,{PETSC_FALSE,PETSC_TRUE, PETSC_FALSE}},
+  {DMSTAG_LEFT,          1,{PETSC_TRUE, PETSC_FALSE,PETSC_FALSE}},
+  {DMSTAG_ELEMENT,       2,{PETSC_FALSE,PETSC_FALSE,PETSC_FALSE}}
+};
+
+static const DMStagCanonicalLocation DMStagCanonicalLocations3d[] = {
+  {DMSTAG_BACK_DOWN_LEFT,0,{PETSC_TRUE, PETSC_TRUE, PETSC_TRUE }},
+  {DMSTAG_BACK_DOWN,     1,{PETSC_FALSE,PETSC_TRUE, PETSC_TRUE }},
+  {DMSTAG_BACK_LEFT,     1,{PETSC_TRUE, PETSC_FALSE,PETSC_TRUE }},
+  {DMSTAG_DOWN_LEFT,     1,{PETSC_TRUE, PETSC_TRUE, PETSC_FALSE}},
+  {DMSTAG_BACK,          2,{PETSC_FALSE,PETSC_FALSE,PETSC_TRUE }},
+  {DMSTAG_DOWN,          2,{PETSC_FALSE,PETSC_TRUE, PETSC_FALSE}},
+  {DMSTAG_LEFT,          2,{PETSC_TRUE, PETSC_FALSE,PETSC_FALSE}},
+  {DMSTAG_ELEMENT,       3,{PETSC_FALSE,PETSC_FALSE,PETSC_FALSE}}
+};
+
+/* Recover the extent [gmin,gmax] in one direction from the bounding box [cmin,cmax] of the stored uniform coordinates.
+   These lie at gmin + k h/2 with h = (gmax-gmin)/N: at vertices (k even) if primal is set and at element centers (k odd)
+   if dual is set. A periodic direction has no points on its upper boundary, N vertices and N element centers. */
+static PetscErrorCode DMStagUniformCoordinateExtent_Private(PetscInt N,PetscBool periodic,PetscBool primal,PetscBool dual,PetscReal *cmin,PetscReal *cmax)
+{
+  PetscReal h;
+
+  PetscFunctionBegin;
+  if (primal && dual) {
+    if (!periodic) PetscFunctionReturn(0);
+    h = (*cmax - *cmin)/(N - 0.5);
+  } else {
+    if (primal && !periodic) PetscFunctionReturn(0);
+    h = N > 1 ? (*cmax - *cmin)/(N-1) : 0.0;
+    if (!primal) *cmin -= 0.5*h;
+  }
+  *cmax = *cmin + N*h;
+  PetscFunctionReturn(0);
+}
+
+/* Determine the extent of uniform coordinates on a DMStag, if any have been set, so that
+   they can be reproduced on refined and coarsened grids and used to compute grid spacings */
+PetscErrorCode DMStagGetUniformCoordinateBounds(DM dm,PetscBool *set,PetscReal gmin[],PetscReal gmax[])
+{
+  PetscErrorCode  ierr;
+  DM_Stag * const stag = (DM_Stag*)dm->data;
+  PetscInt        dim,d,s;
+  PetscBool       isstag,isproduct;
+  Vec             coords;
+
+  PetscFunctionBegin;
+  *set = PETSC_FALSE;
+  for (d=0; d<DMSTAG_MAX_DIM; ++d) {gmin[d] = 0.0; gmax[d] = 0.0;}
+  if (!stag->coordinateDMType) PetscFunctionReturn(0);
+  ierr = DMGetDimension(dm,&dim);CHKERRQ(ierr);
+  ierr = PetscStrcmp(stag->coordinateDMType,DMSTAG,&isstag);CHKERRQ(ierr);
+  ierr = PetscStrcmp(stag->coordinateDMType,DMPRODUCT,&isproduct);CHKERRQ(ierr);
+  if (isstag) {
+    PetscBool primal = PETSC_FALSE,dual = PETSC_FALSE;
+
+    ierr = DMGetCoordinates(dm,&coords);CHKERRQ(ierr);
+    if (!coords) PetscFunctionReturn(0);
+    ierr = DMGetBoundingBox(dm,gmin,gmax);CHKERRQ(ierr);
+    /* The coordinate DM only stores the strata with dof. Every stratum but the elements has points on grid lines in
+       every direction, and every stratum but the vertices has points between grid lines in every direction. */
+    for (s=0; s<=dim; ++s) {
+      if (!stag->dof[s]) continue;
+      if (s < dim) primal = PETSC_TRUE;
+      if (s > 0)   dual   = PETSC_TRUE;
+    }
+    for (d=0; d<dim; ++d) {
+      ierr = DMStagUniformCoordinateExtent_Private(stag->N[d],(PetscBool)(stag->boundaryType[d] == DM_BOUNDARY_PERIODIC),primal,dual,&gmin[d],&gmax[d]);CHKERRQ(ierr);
+    }
+  } else if (isproduct) {
+    DM dmc;
+
+    ierr = DMGetCoordinateDM(dm,&dmc);CHKERRQ(ierr);
+    for (d=0; d<dim; ++d) {
+      DM subdm;
+
+      ierr = DMProductGetDM(dmc,d,&subdm);CHKERRQ(ierr);
+      if (!subdm) PetscFunctionReturn(0);
+      ierr = DMGetCoordinates(subdm,&coords);CHKERRQ(ierr);
+      if (!coords) PetscFunctionReturn(0);
+      ierr = DMGetBoundingBox(subdm,&gmin[d],&gmax[d]);CHKERRQ(ierr);
+      /* The 1D sub-DMs hold coordinates on both vertices and elements */
+      ierr = DMStagUniformCoordinateExtent_Private(stag->N[d],(PetscBool)(stag->boundaryType[d] == DM_BOUNDARY_PERIODIC),PETSC_TRUE,PETSC_TRUE,&gmin[d],&gmax[d]);CHKERRQ(ierr);
+    }
+  } else PetscFunctionReturn(0);
+  *set = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* Refined and coarsened grids cover the same domain, so uniform coordinates are recreated with the same bounds */
+static PetscErrorCode DMStagTransferUniformCoordinates_Private(DM dm,DM dmnew)
+{
+  PetscErrorCode  ierr;
+  DM_Stag * const stag = (DM_Stag*)dm->data;
+  PetscReal       gmin[DMSTAG_MAX_DIM],gmax[DMSTAG_MAX_DIM];
+  PetscBool       set,isproduct;
+
+  PetscFunctionBegin;
+  ierr = DMStagGetUniformCoordinateBounds(dm,&set,gmin,gmax);CHKERRQ(ierr);
+  if (!set) PetscFunctionReturn(0);
+  ierr = PetscStrcmp(stag->coordinateDMType,DMPRODUCT,&isproduct);CHKERRQ(ierr);
+  if (isproduct) {
+    ierr = DMStagSetUniformCoordinatesProduct(dmnew,gmin[0],gmax[0],gmin[1],gmax[1],gmin[2],gmax[2]);CHKERRQ(ierr);
+  } else {
+    ierr = DMStagSetUniformCoordinatesExplicit(dmnew,gmin[0],gmax[0],gmin[1],gmax[1],gmin[2],gmax[2]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Refine or coarsen by a factor of 2 in each direction, preserving the parallel decomposition so that
+   each rank's fine elements are exactly the refinements of its coarse elements */
+static PetscErrorCode DMStagRefineCoarsen_Private(DM dm,MPI_Comm comm,PetscBool refine,DM *dmnew)
+{
+  PetscErrorCode  ierr;
+  DM_Stag * const stag = (DM_Stag*)dm->data;
+  DM_Stag         *stagnew;
+  PetscInt        dim,d,r;
+
+  PetscFunctionBegin;
+  ierr = DMGetDimension(dm,&dim);CHKERRQ(ierr);
+  if (!refine) {
+    for (d=0; d<dim; ++d) {
+      if (stag->N[d] % 2) SETERRQ2(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_WRONG,"Cannot coarsen %D elements in direction %D by a factor of 2",stag->N[d],d);
+      for (r=0; r<stag->nRanks[d]; ++r) {
+        if (stag->l[d][r] % 2) SETERRQ3(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_WRONG,"Cannot coarsen %D elements on rank %D in direction %D by a factor of 2",stag->l[d][r],r,d);
+      }
+    }
+  }
+  ierr = DMStagDuplicateWithoutSetup(dm,comm,dmnew);CHKERRQ(ierr);
+  stagnew = (DM_Stag*)(*dmnew)->data;
+  for (d=0; d<dim; ++d) {
+    stagnew->N[d] = refine ? 2*stag->N[d] : stag->N[d]/2;
+    for (r=0; r<stag->nRanks[d]; ++r) stagnew->l[d][r] = refine ? 2*stag->l[d][r] : stag->l[d][r]/2;
+  }
+  ierr = DMSetOptionsPrefix(*dmnew,((PetscObject)dm)->prefix);CHKERRQ(ierr);
+  ierr = DMSetVecType(*dmnew,dm->vectype);CHKERRQ(ierr);
+  ierr = DMSetUp(*dmnew);CHKERRQ(ierr);
+  ierr = DMStagTransferUniformCoordinates_Private(dm,*dmnew);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DMRefine_Stag(DM dm,MPI_Comm comm,DM *dmf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMStagRefineCoarsen_Private(dm,comm,PETSC_TRUE,dmf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DMCoarsen_Stag(DM dm,MPI_Comm comm,DM *dmc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMStagRefineCoarsen_Private(dm,comm,PETSC_FALSE,dmc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Interpolation between DMStag objects related by DMRefine() or DMCoarsen().
+
+  The interpolation is a tensor product of one-dimensional rules. In each direction in which a
+  point is located at a vertex, fine points which coincide with coarse points are injected and
+  the others are the average of their two coarse neighbors. In each direction in which a point
+  is located at an element center, fine points are linearly interpolated from the center of the
+  coarse element containing them and the nearer neighboring one, with weights 3/4 and 1/4, or
+  extrapolated from the two nearest coarse centers next to a non-periodic boundary. Thus all
+  locations reproduce fields which are linear in the coordinates, except in directions with a
+  single coarse element, where element-centered values are injected. Restriction is the
+  transpose, as used by PCMG.
+*/
+PetscErrorCode DMCreateInterpolation_Stag(DM dmc,DM dmf,Mat *A,Vec *vscale)
+{
+  PetscErrorCode                      ierr;
+  const DM_Stag * const               stagc = (DM_Stag*)dmc->data;
+  const DM_Stag                       *stagf;
+  const DMStagCanonicalLocation       *locs;
+  DM                                  dmcBox;
+  ISLocalToGlobalMapping              ltogf,ltogc;
+  PetscInt                            dim,dimf,d,r,nLocs,l,c,i,j,k,mf,mc,start[DMSTAG_MAX_DIM],n[DMSTAG_MAX_DIM],extra[DMSTAG_MAX_DIM];
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(dmc,DM_CLASSID,1,DMSTAG);
+  PetscValidHeaderSpecificType(dmf,DM_CLASSID,2,DMSTAG);
+  stagf = (DM_Stag*)dmf->data;
+  ierr = DMGetDimension(dmc,&dim);CHKERRQ(ierr);
+  ierr = DMGetDimension(dmf,&dimf);CHKERRQ(ierr);
+  if (dim != dimf) SETERRQ2(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Coarse and fine DMStag dimensions differ: %D != %D",dim,dimf);
+  for (d=0; d<dim+1; ++d) {
+    if (stagc->dof[d] != stagf->dof[d]) SETERRQ3(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Coarse and fine DMStag dof differ on stratum %D: %D != %D",d,stagc->dof[d],stagf->dof[d]);
+  }
+  for (d=0; d<dim; ++d) {
+    if (stagc->boundaryType[d] != stagf->boundaryType[d]) SETERRQ1(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Coarse and fine DMStag boundary types differ in direction %D",d);
+    if (2*stagc->N[d] != stagf->N[d]) SETERRQ3(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Fine DMStag is not a refinement by a factor of 2 in direction %D: %D coarse and %D fine elements",d,stagc->N[d],stagf->N[d]);
+    if (stagc->nRanks[d] != stagf->nRanks[d]) SETERRQ1(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Coarse and fine DMStag have different numbers of ranks in direction %D",d);
+    for (r=0; r<stagc->nRanks[d]; ++r) {
+      if (2*stagc->l[d][r] != stagf->l[d][r]) SETERRQ2(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Fine DMStag ownership ranges are not the refinement of the coarse ones in direction %D, rank %D; use DMRefine() or DMCoarsen()",d,r);
+    }
+  }
+  switch (dim) {
+    case 1: locs = DMStagCanonicalLocations1d; nLocs = 2; break;
+    case 2: locs = DMStagCanonicalLocations2d; nLocs = 4; break;
+    case 3: locs = DMStagCanonicalLocations3d; nLocs = 8; break;
+    default: SETERRQ1(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_OUTOFRANGE,"Unsupported dimension %D",dim);
+  }
+
+  /* Coarse points, including diagonal neighbors, are addressed with a local numbering with box ghosting.
+     The global numbering does not depend on the stencil, so another coarse DMStag can provide it. */
+  if (stagc->stencilType != DMSTAG_STENCIL_BOX || stagc->stencilWidth < 1) {
+    ierr = DMStagDuplicateWithoutSetup(dmc,MPI_COMM_NULL,&dmcBox);CHKERRQ(ierr);
+    ierr = DMStagSetStencilType(dmcBox,DMSTAG_STENCIL_BOX);CHKERRQ(ierr);
+    ierr = DMStagSetStencilWidth(dmcBox,1);CHKERRQ(ierr);
+    ierr = DMSetUp(dmcBox);CHKERRQ(ierr);
+  } else {
+    ierr = PetscObjectReference((PetscObject)dmc);CHKERRQ(ierr);
+    dmcBox = dmc;
+  }
+
+  ierr = DMStagGetEntries(dmf,&mf);CHKERRQ(ierr);
+  ierr = DMStagGetEntries(dmc,&mc);CHKERRQ(ierr);
+  ierr = MatCreate(PetscObjectComm((PetscObject)dmf),A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,mf,mc,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(*A,1<<dim,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(*A,1<<dim,NULL,1<<dim,NULL);CHKERRQ(ierr);
+  ierr = DMGetLocalToGlobalMapping(dmf,&ltogf);CHKERRQ(ierr);
+  ierr = DMGetLocalToGlobalMapping(dmcBox,&ltogc);CHKERRQ(ierr);
+  ierr = MatSetLocalToGlobalMapping(*A,ltogf,ltogc);CHKERRQ(ierr);
+
+  ierr = DMStagGetCorners(dmf,&start[0],&start[1],&start[2],&n[0],&n[1],&n[2],&extra[0],&extra[1],&extra[2]);CHKERRQ(ierr);
+  for (d=dim; d<DMSTAG_MAX_DIM; ++d) {start[d] = 0; n[d] = 1; extra[d] = 0;}
+  for (l=0; l<nLocs; ++l) {
+    const PetscInt dof = stagf->dof[locs[l].stratum];
+    PetscInt       end[DMSTAG_MAX_DIM];
+
+    if (!dof) continue;
+    for (d=0; d<DMSTAG_MAX_DIM; ++d) end[d] = start[d] + n[d] + (locs[l].primal[d] ? extra[d] : 0);
+    for (k=start[2]; k<end[2]; ++k) {
+      for (j=start[1]; j<end[1]; ++j) {
+        for (i=start[0]; i<end[0]; ++i) {
+          const PetscInt ind[DMSTAG_MAX_DIM] = {i,j,k};
+          PetscInt       nw[DMSTAG_MAX_DIM],ic[DMSTAG_MAX_DIM][2],a,b,e,ncol;
+          PetscScalar    w[DMSTAG_MAX_DIM][2],val[8];
+          DMStagStencil  row,col[8];
+          PetscInt       rowIdx,colIdx[8];
+
+          for (d=0; d<DMSTAG_MAX_DIM; ++d) {
+            if (d < dim && locs[l].primal[d] && ind[d] % 2) {
+              nw[d] = 2; ic[d][0] = (ind[d]-1)/2; ic[d][1] = (ind[d]+1)/2; w[d][0] = 0.5; w[d][1] = 0.5;
+            } else if (d < dim && !locs[l].primal[d] && stagc->N[d] > 1) {
+              /* The fine element center is a quarter of a coarse element from its own coarse element center, toward
+                 the neighbor on the side given by the parity. Past a non-periodic boundary, extrapolate instead. */
+              const PetscInt side = ind[d] % 2 ? 1 : -1;
+
+              nw[d] = 2; ic[d][0] = ind[d]/2; ic[d][1] = ind[d]/2 + side; w[d][0] = 0.75; w[d][1] = 0.25;
+              if (stagc->boundaryType[d] != DM_BOUNDARY_PERIODIC && (ic[d][1] < 0 || ic[d][1] >= stagc->N[d])) {
+                ic[d][1] = ind[d]/2 - side; w[d][0] = 1.25; w[d][1] = -0.25;
+              }
+            } else {
+              nw[d] = 1; ic[d][0] = ind[d]/2; w[d][0] = 1.0;
+            }
+          }
+          for (c=0; c<dof; ++c) {
+            row.i = i; row.j = j; row.k = k; row.loc = locs[l].loc; row.c = c;
+            ierr = DMStagStencilToIndexLocal(dmf,1,&row,&rowIdx);CHKERRQ(ierr);
+            ncol = 0;
+            for (a=0; a<nw[2]; ++a) {
+              for (b=0; b<nw[1]; ++b) {
+                for (e=0; e<nw[0]; ++e, ++ncol) {
+                  col[ncol].i = ic[0][e]; col[ncol].j = ic[1][b]; col[ncol].k = ic[2][a]; col[ncol].loc = locs[l].loc; col[ncol].c = c;
+                  val[ncol] = w[0][e]*w[1][b]*w[2][a];
+                }
+              }
+            }
+            ierr = DMStagStencilToIndexLocal(dmcBox,ncol,col,colIdx);CHKERRQ(ierr);
+            ierr = MatSetValuesLocal(*A,1,&rowIdx,ncol,colIdx,val,INSERT_VALUES);CHKERRQ(ierr);
+          }
+        }
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmcBox);CHKERRQ(ierr);
+  if (vscale) {
+    ierr = DMCreateInterpolationScale(dmc,dmf,*A,vscale);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,531 @@
+/*
+  Matrix-free staggered-grid operators on a 2D DMStag: gradient, divergence, variable-viscosity Laplacian, and Stokes.
+
+  The x- and y-velocities are component 0 on the left and down faces and the pressure is component 0 on the elements.
+  Rows are scaled by the element area (a finite volume form), as is usual when coarse grid operators are obtained by
+  rediscretization for geometric multigrid with restriction by the transpose of the interpolation. On non-periodic
+  boundaries the normal velocity is a (homogeneous) Dirichlet value and the tangential velocity has zero shear (free slip).
+*/
+#include <petsc/private/dmstagimpl.h> /*I "petscdmstag.h" I*/
+
+const char *const DMStagOperatorTypes[] = {"GRADIENT","DIVERGENCE","VISCOUS","STOKES","DMStagOperatorType","DMSTAG_OPERATOR_",NULL};
+
+typedef struct {
+  DM                 dm;
+  DMStagOperatorType type;
+  DM                 dmEta;       /* viscosity on vertices and elements */
+  Vec                etaLocal;    /* ghosted viscosity */
+  PetscInt           N[2],start[2],n[2],extra[2];
+  PetscBool          periodic[2];
+  PetscReal          h[2];
+  PetscScalar        cv,cg,cd;    /* weights of the viscous, gradient and divergence parts */
+  PetscInt           su,sv,sp;    /* slots of the x-velocity, y-velocity and pressure */
+  PetscInt           sev,see;     /* slots of the viscosity on vertices and elements */
+} DMStagOp;
+
+/* A face with a Dirichlet normal velocity */
+PETSC_STATIC_INLINE PetscBool DMStagOpWall_Private(const DMStagOp *op,PetscInt d,PetscInt i)
+{
+  return (PetscBool)(!op->periodic[d] && (i == 0 || i == op->N[d]));
+}
+
+/* Scale of the rows of Dirichlet velocities, comparable to the viscous diagonal next to them */
+PETSC_STATIC_INLINE PetscScalar DMStagOpWallScale_Private(const DMStagOp *op,PetscScalar eta)
+{
+  return 2.0*(op->h[1]/op->h[0] + op->h[0]/op->h[1])*eta;
+}
+
+/* y-velocity row kernel. With fW or fE zero, the shear across the left or right boundary is dropped and the
+   neighbor on that side is not read, so that the kernel can be used on the first and last elements. */
+PETSC_STATIC_INLINE PetscScalar DMStagOpApplyV_Private(const DMStagOp *op,PetscScalar **xj,PetscScalar **xN,PetscScalar **xS,PetscScalar **ej,PetscScalar **eS,PetscInt i,PetscReal fW,PetscReal fE)
+{
+  const PetscReal   wx = op->h[1]/op->h[0],wy = op->h[0]/op->h[1];
+  const PetscInt    sv = op->sv,sp = op->sp,sev = op->sev,see = op->see;
+  const PetscScalar vC = xj[i][sv];
+  const PetscScalar vW = fW != 0.0 ? xj[i-1][sv] : vC,vE = fE != 0.0 ? xj[i+1][sv] : vC;
+  const PetscScalar visc = wy*(ej[i][see]*(vC - xN[i][sv]) + eS[i][see]*(vC - xS[i][sv])) + wx*(ej[i+1][sev]*(vC - vE) + ej[i][sev]*(vC - vW));
+
+  return op->cv*visc + op->cg*op->h[0]*(xj[i][sp] - xS[i][sp]);
+}
+
+/* Applies the operator to the ghosted local array x, writing the owned points of the local array y.
+   The Dirichlet velocities in x are zeroed once their rows have been computed, so that the interior
+   kernels need not test for them. */
+static PetscErrorCode DMStagOpApply_Private(const DMStagOp *op,PetscScalar ***x,PetscScalar ***eta,PetscScalar ***y)
+{
+  PetscErrorCode  ierr;
+  const PetscReal wx = op->h[1]/op->h[0],wy = op->h[0]/op->h[1],hx = op->h[0],hy = op->h[1];
+  const PetscInt  su = op->su,sv = op->sv,sp = op->sp,sev = op->sev,see = op->see;
+  const PetscInt  xs = op->start[0],ys = op->start[1],xe = op->start[0]+op->n[0],ye = op->start[1]+op->n[1];
+  PetscInt        i,j,gxs,gys,gxe,gye,iu0,iu1,iv0,iv1;
+
+  PetscFunctionBegin;
+  ierr = DMStagGetGhostCorners(op->dm,&gxs,&gys,NULL,&gxe,&gye,NULL);CHKERRQ(ierr);
+  gxe += gxs; gye += gys;
+
+  /* Rows of the Dirichlet velocities */
+  iu0 = DMStagOpWall_Private(op,0,xs) ? xs+1 : xs;
+  iu1 = DMStagOpWall_Private(op,0,xe+op->extra[0]-1) ? xe+op->extra[0]-1 : xe+op->extra[0];
+  for (j=ys; j<ye; ++j) {
+    if (iu0 > xs)              y[j][xs][su]  = op->cv*DMStagOpWallScale_Private(op,eta[j][xs][see])*x[j][xs][su];
+    if (iu1 < xe+op->extra[0]) y[j][iu1][su] = op->cv*DMStagOpWallScale_Private(op,eta[j][iu1-1][see])*x[j][iu1][su];
+  }
+  for (j=ys; j<ye+op->extra[1]; ++j) {
+    if (!DMStagOpWall_Private(op,1,j)) continue;
+    for (i=xs; i<xe; ++i) y[j][i][sv] = op->cv*DMStagOpWallScale_Private(op,eta[j ? j-1 : j][i][see])*x[j][i][sv];
+  }
+  if (!op->periodic[0]) {
+    for (j=gys; j<gye; ++j) {
+      if (gxs <= 0)         x[j][0][su]        = 0.0;
+      if (gxe > op->N[0])   x[j][op->N[0]][su] = 0.0;
+    }
+  }
+  if (!op->periodic[1]) {
+    for (i=gxs; i<gxe; ++i) {
+      if (gys <= 0)         x[0][i][sv]        = 0.0;
+      if (gye > op->N[1])   x[op->N[1]][i][sv] = 0.0;
+    }
+  }
+
+  /* x-velocity rows. Across the bottom and top boundaries the shear is dropped and the row itself stands in for the missing neighbor row. */
+  for (j=ys; j<ye; ++j) {
+    const PetscReal   fS = (!op->periodic[1] && j == 0) ? 0.0 : 1.0,fN = (!op->periodic[1] && j == op->N[1]-1) ? 0.0 : 1.0;
+    PetscScalar       **xj = x[j],**xN = fN != 0.0 ? x[j+1] : x[j],**xS = fS != 0.0 ? x[j-1] : x[j],**ej = eta[j],**eN = eta[j+1],**yj = y[j];
+    const PetscScalar cv = op->cv,cg = op->cg;
+
+    PetscPragmaSIMD
+    for (i=iu0; i<iu1; ++i) {
+      const PetscScalar uC   = xj[i][su];
+      const PetscScalar visc = wx*(ej[i][see]*(uC - xj[i+1][su]) + ej[i-1][see]*(uC - xj[i-1][su])) + wy*(fN*eN[i][sev]*(uC - xN[i][su]) + fS*ej[i][sev]*(uC - xS[i][su]));
+
+      yj[i][su] = cv*visc + cg*hy*(xj[i][sp] - xj[i-1][sp]);
+    }
+  }
+
+  /* y-velocity rows; the first and last elements of a non-periodic row are peeled off */
+  iv0 = (!op->periodic[0] && xs == 0) ? PetscMin(xs+1,xe) : xs;
+  iv1 = (!op->periodic[0] && xe == op->N[0]) ? PetscMax(xe-1,iv0) : xe;
+  for (j=ys; j<ye+op->extra[1]; ++j) {
+    PetscScalar **xj = x[j],**xN,**xS,**ej = eta[j],**eS,**yj = y[j];
+
+    if (DMStagOpWall_Private(op,1,j)) continue;
+    xN = x[j+1]; xS = x[j-1]; eS = eta[j-1];
+    for (i=xs; i<iv0; ++i) yj[i][sv] = DMStagOpApplyV_Private(op,xj,xN,xS,ej,eS,i,0.0,(!op->periodic[0] && i == op->N[0]-1) ? 0.0 : 1.0);
+    PetscPragmaSIMD
+    for (i=iv0; i<iv1; ++i) yj[i][sv] = DMStagOpApplyV_Private(op,xj,xN,xS,ej,eS,i,1.0,1.0);
+    for (i=PetscMax(iv0,iv1); i<xe; ++i) yj[i][sv] = DMStagOpApplyV_Private(op,xj,xN,xS,ej,eS,i,1.0,0.0);
+  }
+
+  /* Pressure rows */
+  if (op->cd != 0.0) {
+    for (j=ys; j<ye; ++j) {
+      PetscScalar       **xj = x[j],**xN = x[j+1],**yj = y[j];
+      const PetscScalar cd = op->cd;
+
+      PetscPragmaSIMD
+      for (i=xs; i<xe; ++i) yj[i][sp] = cd*(hy*(xj[i+1][su] - xj[i][su]) + hx*(xN[i][sv] - xj[i][sv]));
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* The entries of the owned row at stencil point row, diagonal first, with the same boundary treatment as the apply */
+static PetscErrorCode DMStagOpGetRow_Private(const DMStagOp *op,PetscScalar ***eta,const DMStagStencil *row,PetscInt *ncols,DMStagStencil cols[],PetscScalar vals[])
+{
+  const PetscReal wx = op->h[1]/op->h[0],wy = op->h[0]/op->h[1],hx = op->h[0],hy = op->h[1];
+  const PetscInt  i = row->i,j = row->j,sev = op->sev,see = op->see;
+  const PetscBool hasp = (PetscBool)(op->sp != op->su);
+  PetscInt        n = 0,k;
+
+  PetscFunctionBegin;
+  for (k=0; k<7; ++k) {cols[k] = *row; cols[k].c = 0;}
+  switch (row->loc) {
+    case DMSTAG_LEFT:
+      if (DMStagOpWall_Private(op,0,i)) {
+        vals[n++] = op->cv*DMStagOpWallScale_Private(op,eta[j][i ? i-1 : i][see]);
+      } else {
+        const PetscReal   fS = (!op->periodic[1] && j == 0) ? 0.0 : 1.0,fN = (!op->periodic[1] && j == op->N[1]-1) ? 0.0 : 1.0;
+        const PetscScalar eW = eta[j][i-1][see],eE = eta[j][i][see],eS = fS*eta[j][i][sev],eN = fN*eta[j+1][i][sev];
+
+        vals[n++] = op->cv*(wx*(eE + eW) + wy*(eN + eS));
+        if (!DMStagOpWall_Private(op,0,i+1)) {cols[n].i = i+1; vals[n++] = -op->cv*wx*eE;}
+        if (!DMStagOpWall_Private(op,0,i-1)) {cols[n].i = i-1; vals[n++] = -op->cv*wx*eW;}
+        if (fN != 0.0) {cols[n].j = j+1; vals[n++] = -op->cv*wy*eN;}
+        if (fS != 0.0) {cols[n].j = j-1; vals[n++] = -op->cv*wy*eS;}
+        if (hasp) {
+          cols[n].loc = DMSTAG_ELEMENT;                   vals[n++] =  op->cg*hy;
+          cols[n].loc = DMSTAG_ELEMENT; cols[n].i = i-1;  vals[n++] = -op->cg*hy;
+        }
+      }
+      break;
+    case DMSTAG_DOWN:
+      if (DMStagOpWall_Private(op,1,j)) {
+        vals[n++] = op->cv*DMStagOpWallScale_Private(op,eta[j ? j-1 : j][i][see]);
+      } else {
+        const PetscReal   fW = (!op->periodic[0] && i == 0) ? 0.0 : 1.0,fE = (!op->periodic[0] && i == op->N[0]-1) ? 0.0 : 1.0;
+        const PetscScalar eS = eta[j-1][i][see],eN = eta[j][i][see],eW = fW*eta[j][i][sev],eE = fE*eta[j][i+1][sev];
+
+        vals[n++] = op->cv*(wy*(eN + eS) + wx*(eE + eW));
+        if (!DMStagOpWall_Private(op,1,j+1)) {cols[n].j = j+1; vals[n++] = -op->cv*wy*eN;}
+        if (!DMStagOpWall_Private(op,1,j-1)) {cols[n].j = j-1; vals[n++] = -op->cv*wy*eS;}
+        if (fE != 0.0) {cols[n].i = i+1; vals[n++] = -op->cv*wx*eE;}
+        if (fW != 0.0) {cols[n].i = i-1; vals[n++] = -op->cv*wx*eW;}
+        if (hasp) {
+          cols[n].loc = DMSTAG_ELEMENT;                   vals[n++] =  op->cg*hx;
+          cols[n].loc = DMSTAG_ELEMENT; cols[n].j = j-1;  vals[n++] = -op->cg*hx;
+        }
+      }
+      break;
+    case DMSTAG_ELEMENT:
+      vals[n++] = 0.0;
+      if (!DMStagOpWall_Private(op,0,i+1)) {cols[n].loc = DMSTAG_LEFT; cols[n].i = i+1; vals[n++] =  op->cd*hy;}
+      if (!DMStagOpWall_Private(op,0,i))   {cols[n].loc = DMSTAG_LEFT;                   vals[n++] = -op->cd*hy;}
+      if (!DMStagOpWall_Private(op,1,j+1)) {cols[n].loc = DMSTAG_DOWN; cols[n].j = j+1; vals[n++] =  op->cd*hx;}
+      if (!DMStagOpWall_Private(op,1,j))   {cols[n].loc = DMSTAG_DOWN;                   vals[n++] = -op->cd*hx;}
+      break;
+    default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Unsupported location %s",DMStagStencilLocations[row->loc]);
+  }
+  *ncols = n;
+  PetscFunctionReturn(0);
+}
+
+/* Calls fn for each owned row of the operator */
+static PetscErrorCode DMStagOpForEachRow_Private(const DMStagOp *op,PetscErrorCode (*fn)(const DMStagOp*,PetscScalar***,const DMStagStencil*,void*),void *ctx)
+{
+  PetscErrorCode ierr;
+  PetscScalar    ***eta;
+  DMStagStencil  row;
+  PetscInt       i,j;
+
+  PetscFunctionBegin;
+  ierr = DMStagVecGetArrayRead(op->dmEta,op->etaLocal,&eta);CHKERRQ(ierr);
+  row.c = 0;
+  for (j=op->start[1]; j<op->start[1]+op->n[1]+op->extra[1]; ++j) {
+    for (i=op->start[0]; i<op->start[0]+op->n[0]+op->extra[0]; ++i) {
+      row.i = i; row.j = j;
+      if (j < op->start[1]+op->n[1]) {row.loc = DMSTAG_LEFT; ierr = (*fn)(op,eta,&row,ctx);CHKERRQ(ierr);}
+      if (i == op->start[0]+op->n[0]) continue;
+      row.loc = DMSTAG_DOWN; ierr = (*fn)(op,eta,&row,ctx);CHKERRQ(ierr);
+      if (j < op->start[1]+op->n[1] && op->sp != op->su) {row.loc = DMSTAG_ELEMENT; ierr = (*fn)(op,eta,&row,ctx);CHKERRQ(ierr);}
+    }
+  }
+  ierr = DMStagVecRestoreArrayRead(op->dmEta,op->etaLocal,&eta);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMStagOpSetDiagonal_Private(const DMStagOp *op,PetscScalar ***eta,const DMStagStencil *row,void *ctx)
+{
+  PetscErrorCode ierr;
+  PetscScalar    ***d = (PetscScalar***)ctx,vals[7];
+  DMStagStencil  cols[7];
+  PetscInt       ncols,slot = row->loc == DMSTAG_LEFT ? op->su : (row->loc == DMSTAG_DOWN ? op->sv : op->sp);
+
+  PetscFunctionBegin;
+  ierr = DMStagOpGetRow_Private(op,eta,row,&ncols,cols,vals);CHKERRQ(ierr);
+  d[row->j][row->i][slot] = vals[0];
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMStagOpSetRow_Private(const DMStagOp *op,PetscScalar ***eta,const DMStagStencil *row,void *ctx)
+{
+  PetscErrorCode ierr;
+  Mat            M = (Mat)ctx;
+  PetscScalar    vals[7];
+  DMStagStencil  cols[7];
+  PetscInt       ncols;
+
+  PetscFunctionBegin;
+  ierr = DMStagOpGetRow_Private(op,eta,row,&ncols,cols,vals);CHKERRQ(ierr);
+  ierr = DMStagMatSetValuesStencil(op->dm,M,1,row,ncols,cols,vals,ADD_VALUES);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_DMStagOp(Mat A,Vec x,Vec y)
+{
+  DMStagOp       *op;
+  Vec            xl,yl;
+  PetscScalar    ***xa,***ya,***eta;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(op->dm,&xl);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(op->dm,&yl);CHKERRQ(ierr);
+  ierr = VecZeroEntries(xl);CHKERRQ(ierr);
+  ierr = VecZeroEntries(yl);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(op->dm,x,INSERT_VALUES,xl);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(op->dm,x,INSERT_VALUES,xl);CHKERRQ(ierr);
+  ierr = DMStagVecGetArray(op->dm,xl,&xa);CHKERRQ(ierr);
+  ierr = DMStagVecGetArray(op->dm,yl,&ya);CHKERRQ(ierr);
+  ierr = DMStagVecGetArrayRead(op->dmEta,op->etaLocal,&eta);CHKERRQ(ierr);
+  ierr = DMStagOpApply_Private(op,xa,eta,ya);CHKERRQ(ierr);
+  ierr = DMStagVecRestoreArrayRead(op->dmEta,op->etaLocal,&eta);CHKERRQ(ierr);
+  ierr = DMStagVecRestoreArray(op->dm,yl,&ya);CHKERRQ(ierr);
+  ierr = DMStagVecRestoreArray(op->dm,xl,&xa);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(op->dm,yl,INSERT_VALUES,y);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(op->dm,yl,INSERT_VALUES,y);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(op->dm,&yl);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(op->dm,&xl);CHKERRQ(ierr);
+  ierr = PetscLogFlops(((op->cv != 0.0 ? 15.0 : 0.0) + (op->cg != 0.0 ? 4.0 : 0.0) + (op->cd != 0.0 ? 3.5 : 0.0))*2.0*op->n[0]*op->n[1]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetDiagonal_DMStagOp(Mat A,Vec D)
+{
+  DMStagOp       *op;
+  Vec            dl;
+  PetscScalar    ***d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(op->dm,&dl);CHKERRQ(ierr);
+  ierr = VecZeroEntries(dl);CHKERRQ(ierr);
+  ierr = DMStagVecGetArray(op->dm,dl,&d);CHKERRQ(ierr);
+  ierr = DMStagOpForEachRow_Private(op,DMStagOpSetDiagonal_Private,d);CHKERRQ(ierr);
+  ierr = DMStagVecRestoreArray(op->dm,dl,&d);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(op->dm,dl,INSERT_VALUES,D);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(op->dm,dl,INSERT_VALUES,D);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(op->dm,&dl);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Assembles the operator into a MATAIJ matrix created by DMCreateMatrix() on the DMStag, converted to newtype if that differs */
+static PetscErrorCode MatConvert_DMStagOp(Mat A,MatType newtype,MatReuse reuse,Mat *B)
+{
+  DMStagOp       *op;
+  Mat            M;
+  MatType        otype;
+  char           *savedtype;
+  PetscBool      isaij;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  if (reuse == MAT_REUSE_MATRIX) {
+    M    = *B;
+    ierr = MatZeroEntries(M);CHKERRQ(ierr);
+  } else {
+    ierr = DMGetMatType(op->dm,&otype);CHKERRQ(ierr);
+    ierr = PetscStrallocpy(otype,&savedtype);CHKERRQ(ierr);
+    ierr = DMSetMatType(op->dm,MATAIJ);CHKERRQ(ierr);
+    ierr = DMCreateMatrix(op->dm,&M);CHKERRQ(ierr);
+    ierr = DMSetMatType(op->dm,savedtype);CHKERRQ(ierr);
+    ierr = PetscFree(savedtype);CHKERRQ(ierr);
+  }
+  ierr = DMStagOpForEachRow_Private(op,DMStagOpSetRow_Private,M);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(M,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(M,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  if (reuse != MAT_REUSE_MATRIX) {
+    ierr = PetscStrcmp(newtype,MATAIJ,&isaij);CHKERRQ(ierr);
+    if (!isaij && newtype) {ierr = MatConvert(M,newtype,MAT_INPLACE_MATRIX,&M);CHKERRQ(ierr);}
+  }
+  if (reuse == MAT_INPLACE_MATRIX) {
+    ierr = MatHeaderReplace(A,&M);CHKERRQ(ierr);
+  } else if (reuse == MAT_INITIAL_MATRIX) *B = M;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_DMStagOp(Mat A)
+{
+  DMStagOp       *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  ierr = VecDestroy(&op->etaLocal);CHKERRQ(ierr);
+  ierr = DMDestroy(&op->dmEta);CHKERRQ(ierr);
+  ierr = DMDestroy(&op->dm);CHKERRQ(ierr);
+  ierr = PetscFree(op);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"DMStagOperatorGetViscosityDM_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"DMStagOperatorSetViscosity_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMStagOperatorGetViscosityDM_DMStagOp(Mat A,DM *dmEta)
+{
+  DMStagOp       *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  *dmEta = op->dmEta;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMStagOperatorSetViscosity_DMStagOp(Mat A,Vec eta)
+{
+  DMStagOp       *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&op);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(op->dmEta,eta,INSERT_VALUES,op->etaLocal);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(op->dmEta,eta,INSERT_VALUES,op->etaLocal);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMStagCreateOperator - Creates a matrix-free staggered-grid gradient, divergence, viscous, or Stokes operator on a 2D DMStag
+
+   Collective on dm
+
+   Input Parameters:
++  dm   - the DMStag, with at least one dof on faces and, except for DMSTAG_OPERATOR_VISCOUS, on elements
+-  type - the operator
+
+   Output Parameter:
+.  A - the operator, a MATSHELL
+
+   Notes:
+   Component 0 on the left and down faces is the x- and y-velocity u and component 0 on the elements is the pressure p;
+   rows and columns of all other dof are zero. With the viscous part V u = -div(eta grad u), applied componentwise with
+   the viscosity eta on elements and vertices, and the gradient G p, the operators are
+.vb
+   DMSTAG_OPERATOR_VISCOUS    [V 0; 0 0]
+   DMSTAG_OPERATOR_GRADIENT   [0 G; 0 0]
+   DMSTAG_OPERATOR_DIVERGENCE [0 0; D 0]   with D = -G^T
+   DMSTAG_OPERATOR_STOKES     [V G; G^T 0]
+.ve
+   so that the viscous and Stokes operators are symmetric. Rows are scaled by the element area, the usual finite volume
+   form. The grid is uniform, with spacing taken from the coordinates set by DMStagSetUniformCoordinates() or, without
+   coordinates, from the unit square. On non-periodic boundaries the normal velocity is a homogeneous Dirichlet value,
+   whose row is a scaled identity, and the tangential velocity is free slip.
+
+   The viscosity is 1 until DMStagOperatorSetViscosity() is called. MatMult() performs one ghost update and sweeps the
+   owned points with loops that carry no boundary tests; MatGetDiagonal() is supported, so the operator may be used with
+   Jacobi and Chebyshev smoothers, and MatConvert() assembles it with the preallocation of DMCreateMatrix().
+
+   Together with DMRefine(), DMCoarsen() and DMCreateInterpolation() on DMSTAG, the operator can be rediscretized on each
+   level of a geometric multigrid hierarchy, for instance in the function given to KSPSetComputeOperators().
+
+   Only two dimensions are supported. The DMStag must have a stencil width of at least 1.
+
+   Level: intermediate
+
+.seealso: DMSTAG, DMStagOperatorType, DMStagOperatorSetViscosity(), DMStagOperatorGetViscosityDM(), DMCreateInterpolation(), DMCreateMatrix()
+@*/
+PetscErrorCode DMStagCreateOperator(DM dm,DMStagOperatorType type,Mat *A)
+{
+  PetscErrorCode    ierr;
+  DMStagOp          *op;
+  DMBoundaryType    bt[3];
+  DMStagStencilType stencilType;
+  PetscInt          dim,dof[4],stencilWidth,N[3],entries,Nglobal,d;
+  PetscReal         lo[3],hi[3];
+  PetscBool         haveCoordinates;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(dm,DM_CLASSID,1,DMSTAG);
+  PetscValidLogicalCollectiveEnum(dm,type,2);
+  PetscValidPointer(A,3);
+  ierr = DMGetDimension(dm,&dim);CHKERRQ(ierr);
+  if (dim != 2) SETERRQ1(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Staggered operators are only implemented in 2 dimensions, not %D",dim);
+  ierr = DMStagGetDOF(dm,&dof[0],&dof[1],&dof[2],NULL);CHKERRQ(ierr);
+  ierr = DMStagGetStencilType(dm,&stencilType);CHKERRQ(ierr);
+  ierr = DMStagGetStencilWidth(dm,&stencilWidth);CHKERRQ(ierr);
+  if (stencilType == DMSTAG_STENCIL_NONE || stencilWidth < 1) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_INCOMP,"Staggered operators need a stencil width of at least 1");
+  if (dof[1] < 1) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_INCOMP,"Staggered operators need at least one dof on faces");
+  if (dof[2] < 1 && type != DMSTAG_OPERATOR_VISCOUS) SETERRQ1(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_INCOMP,"The %s operator needs at least one dof on elements",DMStagOperatorTypes[type]);
+
+  ierr = PetscNew(&op);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)dm);CHKERRQ(ierr);
+  op->dm   = dm;
+  op->type = type;
+  ierr = DMStagGetGlobalSizes(dm,&N[0],&N[1],NULL);CHKERRQ(ierr);
+  ierr = DMStagGetCorners(dm,&op->start[0],&op->start[1],NULL,&op->n[0],&op->n[1],NULL,&op->extra[0],&op->extra[1],NULL);CHKERRQ(ierr);
+  ierr = DMStagGetBoundaryTypes(dm,&bt[0],&bt[1],NULL);CHKERRQ(ierr);
+  ierr = DMStagGetUniformCoordinateBounds(dm,&haveCoordinates,lo,hi);CHKERRQ(ierr);
+  for (d=0; d<2; ++d) {
+    op->N[d]        = N[d];
+    op->periodic[d] = (PetscBool)(bt[d] == DM_BOUNDARY_PERIODIC);
+    op->h[d]        = haveCoordinates ? (hi[d] - lo[d])/N[d] : 1.0/N[d];
+  }
+  switch (type) {
+    case DMSTAG_OPERATOR_GRADIENT:   op->cv = 0.0; op->cg = 1.0; op->cd =  0.0; break;
+    case DMSTAG_OPERATOR_DIVERGENCE: op->cv = 0.0; op->cg = 0.0; op->cd =  1.0; break;
+    case DMSTAG_OPERATOR_VISCOUS:    op->cv = 1.0; op->cg = 0.0; op->cd =  0.0; break;
+    case DMSTAG_OPERATOR_STOKES:     op->cv = 1.0; op->cg = 1.0; op->cd = -1.0; break;
+    default: SETERRQ1(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_OUTOFRANGE,"Unsupported operator type %d",(int)type);
+  }
+  ierr = DMStagGetLocationSlot(dm,DMSTAG_LEFT,0,&op->su);CHKERRQ(ierr);
+  ierr = DMStagGetLocationSlot(dm,DMSTAG_DOWN,0,&op->sv);CHKERRQ(ierr);
+  if (dof[2] > 0) {
+    ierr = DMStagGetLocationSlot(dm,DMSTAG_ELEMENT,0,&op->sp);CHKERRQ(ierr);
+  } else op->sp = op->su;
+
+  ierr = DMStagCreateCompatibleDMStag(dm,1,0,1,0,&op->dmEta);CHKERRQ(ierr);
+  ierr = DMStagGetLocationSlot(op->dmEta,DMSTAG_DOWN_LEFT,0,&op->sev);CHKERRQ(ierr);
+  ierr = DMStagGetLocationSlot(op->dmEta,DMSTAG_ELEMENT,0,&op->see);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(op->dmEta,&op->etaLocal);CHKERRQ(ierr);
+  ierr = VecSet(op->etaLocal,1.0);CHKERRQ(ierr);
+
+  ierr = DMStagGetEntries(dm,&entries);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&entries,&Nglobal,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)dm));CHKERRQ(ierr);
+  ierr = MatCreateShell(PetscObjectComm((PetscObject)dm),entries,entries,Nglobal,Nglobal,op,A);CHKERRQ(ierr);
+  ierr = MatSetDM(*A,dm);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_MULT,(void (*)(void))MatMult_DMStagOp);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_GET_DIAGONAL,(void (*)(void))MatGetDiagonal_DMStagOp);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_CONVERT,(void (*)(void))MatConvert_DMStagOp);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_DESTROY,(void (*)(void))MatDestroy_DMStagOp);CHKERRQ(ierr);
+  if (type == DMSTAG_OPERATOR_VISCOUS || type == DMSTAG_OPERATOR_STOKES) {
+    ierr = MatSetOption(*A,MAT_SYMMETRIC,PETSC_TRUE);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectComposeFunction((PetscObject)*A,"DMStagOperatorGetViscosityDM_C",DMStagOperatorGetViscosityDM_DMStagOp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)*A,"DMStagOperatorSetViscosity_C",DMStagOperatorSetViscosity_DMStagOp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMStagOperatorGetViscosityDM - Gets the DMStag whose global vectors hold the viscosity of a staggered operator
+
+   Not Collective
+
+   Input Parameter:
+.  A - the operator from DMStagCreateOperator()
+
+   Output Parameter:
+.  dmEta - a DMStag with the layout of the operator's DMStag and one dof on vertices and elements; owned by the operator, do not destroy
+
+   Level: intermediate
+
+.seealso: DMStagCreateOperator(), DMStagOperatorSetViscosity()
+@*/
+PetscErrorCode DMStagOperatorGetViscosityDM(Mat A,DM *dmEta)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidPointer(dmEta,2);
+  ierr = PetscUseMethod(A,"DMStagOperatorGetViscosityDM_C",(Mat,DM*),(A,dmEta));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMStagOperatorSetViscosity - Sets the viscosity of a staggered operator
+
+   Collective on A
+
+   Input Parameters:
++  A   - the operator from DMStagCreateOperator()
+-  eta - a global vector of the DMStag from DMStagOperatorGetViscosityDM(), with the viscosity on vertices and elements
+
+   Notes:
+   The values are copied, so later changes to eta are not seen by the operator.
+
+   Level: intermediate
+
+.seealso: DMStagCreateOperator(), DMStagOperatorGetViscosityDM()
+@*/
+PetscErrorCode DMStagOperatorSetViscosity(Mat A,Vec eta)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidHeaderSpecific(eta,VEC_CLASSID,2);
+  ierr = PetscUseMethod(A,"DMStagOperatorSetViscosity_C",(Mat,Vec),(A,eta));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -102,7 +102,7 @@ PetscErrorCode DMStagGetLocationDOF(DM dm,DMStagStencilLocation loc,PetscInt *do
 
 /* Convert an array of DMStagStencil objects to an array of indices into a local vector.
   The .c fields in pos must always be set (even if to 0).  */
-static PetscErrorCode DMStagStencilToIndexLocal(DM dm,PetscInt n,const DMStagStencil *pos,PetscInt *ix)
+PetscErrorCode DMStagStencilToIndexLocal(DM dm,PetscInt n,const DMStagStencil *pos,PetscInt *ix)
 {
   PetscErrorCode        ierr;
   const DM_Stag * const stag = (DM_Stag*)dm->data;
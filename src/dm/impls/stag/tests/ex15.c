@@ -0,0 +1,471 @@
+static char help[] = "Tests DMStag grid transfers and the matrix-free staggered operators of DMStagCreateOperator()\n\n";
+
+#include <petscdmstag.h>
+#include <petscksp.h>
+
+/* The domain set by DMStagSetUniformCoordinatesExplicit() in main() */
+static const PetscReal L[2] = {2.0,1.0};
+
+typedef PetscScalar (*FieldFn)(DMStagStencilLocation,const PetscReal[],const PetscReal[]);
+
+/* The position of a face or element on the uniform grid of the domain, computed without the coordinates of the DMStag */
+static PetscErrorCode GetPosition(DM dm,DMStagStencilLocation loc,PetscInt i,PetscInt j,PetscReal x[])
+{
+  PetscErrorCode ierr;
+  PetscInt       N[2];
+
+  PetscFunctionBeginUser;
+  ierr = DMStagGetGlobalSizes(dm,&N[0],&N[1],NULL);CHKERRQ(ierr);
+  x[0] = L[0]*(i + (loc == DMSTAG_LEFT ? 0.0 : 0.5))/N[0];
+  x[1] = L[1]*(j + (loc == DMSTAG_DOWN ? 0.0 : 0.5))/N[1];
+  PetscFunctionReturn(0);
+}
+
+/* Wave numbers of smooth fields which are periodic in periodic directions. In other directions the velocity vanishes
+   normal to the boundary and has no normal derivative tangential to it, matching the boundary conditions of the operators. */
+static PetscErrorCode GetWaveNumbers(DM dm,PetscReal k[])
+{
+  PetscErrorCode ierr;
+  DMBoundaryType bt[2];
+  PetscInt       d;
+
+  PetscFunctionBeginUser;
+  ierr = DMStagGetBoundaryTypes(dm,&bt[0],&bt[1],NULL);CHKERRQ(ierr);
+  for (d=0; d<2; ++d) k[d] = (bt[d] == DM_BOUNDARY_PERIODIC ? 2.0 : 1.0)*PETSC_PI/L[d];
+  PetscFunctionReturn(0);
+}
+
+static PetscScalar Pressure(DMStagStencilLocation loc,const PetscReal x[],const PetscReal k[])
+{
+  return loc == DMSTAG_ELEMENT ? PetscCosReal(k[0]*x[0])*PetscCosReal(k[1]*x[1]) : 0.0;
+}
+
+static PetscScalar PressureGradient(DMStagStencilLocation loc,const PetscReal x[],const PetscReal k[])
+{
+  if (loc == DMSTAG_LEFT) return -k[0]*PetscSinReal(k[0]*x[0])*PetscCosReal(k[1]*x[1]);
+  if (loc == DMSTAG_DOWN) return -k[1]*PetscCosReal(k[0]*x[0])*PetscSinReal(k[1]*x[1]);
+  return 0.0;
+}
+
+static PetscScalar Velocity(DMStagStencilLocation loc,const PetscReal x[],const PetscReal k[])
+{
+  if (loc == DMSTAG_LEFT) return PetscSinReal(k[0]*x[0])*PetscCosReal(k[1]*x[1]);
+  if (loc == DMSTAG_DOWN) return PetscCosReal(k[0]*x[0])*PetscSinReal(k[1]*x[1]);
+  return 0.0;
+}
+
+/* -div(grad u) for the velocity above */
+static PetscScalar VelocityLaplacian(DMStagStencilLocation loc,const PetscReal x[],const PetscReal k[])
+{
+  return (k[0]*k[0] + k[1]*k[1])*Velocity(loc,x,k);
+}
+
+static PetscScalar Linear(DMStagStencilLocation loc,const PetscReal x[],const PetscReal k[])
+{
+  return 1.0 + x[0] + 2.0*x[1];
+}
+
+static const DMStagStencilLocation locs[3] = {DMSTAG_LEFT,DMSTAG_DOWN,DMSTAG_ELEMENT};
+
+/* The range of owned points of a location, including the faces on the right and top boundaries */
+static PetscErrorCode GetLocationRange(DM dm,DMStagStencilLocation loc,PetscInt start[],PetscInt end[])
+{
+  PetscErrorCode ierr;
+  PetscInt       n[2],extra[2];
+
+  PetscFunctionBeginUser;
+  ierr = DMStagGetCorners(dm,&start[0],&start[1],NULL,&n[0],&n[1],NULL,&extra[0],&extra[1],NULL);CHKERRQ(ierr);
+  end[0] = start[0] + n[0] + (loc == DMSTAG_LEFT ? extra[0] : 0);
+  end[1] = start[1] + n[1] + (loc == DMSTAG_DOWN ? extra[1] : 0);
+  PetscFunctionReturn(0);
+}
+
+/* Sets component 0 on faces and elements to the values of a field */
+static PetscErrorCode ProjectField(DM dm,FieldFn fn,Vec x)
+{
+  PetscErrorCode ierr;
+  Vec            xl;
+  PetscScalar    ***xa;
+  PetscReal      k[2],pos[2];
+  PetscInt       l,i,j,slot,start[2],end[2];
+
+  PetscFunctionBeginUser;
+  ierr = GetWaveNumbers(dm,k);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&xl);CHKERRQ(ierr);
+  ierr = VecZeroEntries(xl);CHKERRQ(ierr);
+  ierr = DMStagVecGetArray(dm,xl,&xa);CHKERRQ(ierr);
+  for (l=0; l<3; ++l) {
+    ierr = DMStagGetLocationSlot(dm,locs[l],0,&slot);CHKERRQ(ierr);
+    ierr = GetLocationRange(dm,locs[l],start,end);CHKERRQ(ierr);
+    for (j=start[1]; j<end[1]; ++j) {
+      for (i=start[0]; i<end[0]; ++i) {
+        ierr = GetPosition(dm,locs[l],i,j,pos);CHKERRQ(ierr);
+        xa[j][i][slot] = fn(locs[l],pos,k);
+      }
+    }
+  }
+  ierr = DMStagVecRestoreArray(dm,xl,&xa);CHKERRQ(ierr);
+  ierr = DMLocalToGlobal(dm,xl,INSERT_VALUES,x);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&xl);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The maximum difference between component 0 of x, divided by scale, and a field, over the locations of the field except
+   the normal faces of non-periodic boundaries and the points closer than margin to a periodic boundary */
+static PetscErrorCode FieldError(DM dm,Vec x,PetscReal scale,FieldFn fn,PetscReal margin[],PetscReal *err)
+{
+  PetscErrorCode ierr;
+  Vec            xl;
+  PetscScalar    ***xa;
+  DMBoundaryType bt[2];
+  PetscReal      k[2],pos[2],lerr = 0.0;
+  PetscInt       N[2],l,i,j,d,slot,start[2],end[2];
+
+  PetscFunctionBeginUser;
+  ierr = GetWaveNumbers(dm,k);CHKERRQ(ierr);
+  ierr = DMStagGetBoundaryTypes(dm,&bt[0],&bt[1],NULL);CHKERRQ(ierr);
+  ierr = DMStagGetGlobalSizes(dm,&N[0],&N[1],NULL);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&xl);CHKERRQ(ierr);
+  ierr = DMGlobalToLocal(dm,x,INSERT_VALUES,xl);CHKERRQ(ierr);
+  ierr = DMStagVecGetArrayRead(dm,xl,&xa);CHKERRQ(ierr);
+  for (l=0; l<3; ++l) {
+    ierr = DMStagGetLocationSlot(dm,locs[l],0,&slot);CHKERRQ(ierr);
+    ierr = GetLocationRange(dm,locs[l],start,end);CHKERRQ(ierr);
+    for (j=start[1]; j<end[1]; ++j) {
+      for (i=start[0]; i<end[0]; ++i) {
+        const PetscInt ind[2] = {i,j};
+        PetscBool      skip = PETSC_FALSE;
+
+        ierr = GetPosition(dm,locs[l],i,j,pos);CHKERRQ(ierr);
+        for (d=0; d<2; ++d) {
+          if (bt[d] == DM_BOUNDARY_PERIODIC) {
+            if (pos[d] < margin[d] || pos[d] > L[d] - margin[d]) skip = PETSC_TRUE;
+          } else if (locs[l] == (d ? DMSTAG_DOWN : DMSTAG_LEFT) && (ind[d] == 0 || ind[d] == N[d])) skip = PETSC_TRUE;
+        }
+        if (!skip) lerr = PetscMax(lerr,PetscAbsScalar(xa[j][i][slot]/scale - fn(locs[l],pos,k)));
+      }
+    }
+  }
+  ierr = DMStagVecRestoreArrayRead(dm,xl,&xa);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&xl);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&lerr,err,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)dm));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Checks that the coordinates of the refined grid are those of the same domain with half the spacing */
+static PetscErrorCode CheckCoordinates(DM dm)
+{
+  PetscErrorCode ierr;
+  DM             dmf,cdm;
+  Vec            coords;
+  PetscScalar    ***ca;
+  PetscReal      pos[2],lerr = 0.0,err;
+  PetscInt       l,i,j,d,slot,start[2],end[2];
+
+  PetscFunctionBeginUser;
+  ierr = DMRefine(dm,PetscObjectComm((PetscObject)dm),&dmf);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDM(dmf,&cdm);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dmf,&coords);CHKERRQ(ierr);
+  ierr = DMStagVecGetArrayRead(cdm,coords,&ca);CHKERRQ(ierr);
+  for (l=0; l<3; ++l) {
+    ierr = DMStagGetLocationSlot(cdm,locs[l],0,&slot);CHKERRQ(ierr);
+    ierr = GetLocationRange(dmf,locs[l],start,end);CHKERRQ(ierr);
+    for (j=start[1]; j<end[1]; ++j) {
+      for (i=start[0]; i<end[0]; ++i) {
+        ierr = GetPosition(dmf,locs[l],i,j,pos);CHKERRQ(ierr);
+        for (d=0; d<2; ++d) lerr = PetscMax(lerr,PetscAbsScalar(ca[j][i][slot+d] - pos[d]));
+      }
+    }
+  }
+  ierr = DMStagVecRestoreArrayRead(cdm,coords,&ca);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&lerr,&err,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)dm));CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Refined coordinates %s the domain\n",err <= 1e-12 ? "cover" : "do not cover");CHKERRQ(ierr);
+  ierr = DMDestroy(&dmf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The error of an operator applied to a smooth field, compared with the exact result times the element area */
+static PetscErrorCode OperatorError(DM dm,DMStagOperatorType type,FieldFn fn,FieldFn exact,PetscReal *err)
+{
+  PetscErrorCode ierr;
+  Mat            A;
+  Vec            x,y;
+  PetscReal      margin[2] = {0.0,0.0};
+  PetscInt       N[2];
+
+  PetscFunctionBeginUser;
+  ierr = DMStagGetGlobalSizes(dm,&N[0],&N[1],NULL);CHKERRQ(ierr);
+  ierr = DMStagCreateOperator(dm,type,&A);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = ProjectField(dm,fn,x);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = FieldError(dm,y,L[0]*L[1]/(N[0]*N[1]),exact,margin,err);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Checks that the gradient and the viscous operator with unit viscosity are second order accurate */
+static PetscErrorCode CheckAccuracy(DM dm)
+{
+  PetscErrorCode ierr;
+  DM             dmf;
+  PetscReal      ec,ef;
+
+  PetscFunctionBeginUser;
+  ierr = DMRefine(dm,PetscObjectComm((PetscObject)dm),&dmf);CHKERRQ(ierr);
+  ierr = OperatorError(dm,DMSTAG_OPERATOR_GRADIENT,Pressure,PressureGradient,&ec);CHKERRQ(ierr);
+  ierr = OperatorError(dmf,DMSTAG_OPERATOR_GRADIENT,Pressure,PressureGradient,&ef);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"GRADIENT: %s\n",ef < ec/3.5 ? "second order" : "not second order");CHKERRQ(ierr);
+  ierr = OperatorError(dm,DMSTAG_OPERATOR_VISCOUS,Velocity,VelocityLaplacian,&ec);CHKERRQ(ierr);
+  ierr = OperatorError(dmf,DMSTAG_OPERATOR_VISCOUS,Velocity,VelocityLaplacian,&ef);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"VISCOUS: %s\n",ef < ec/3.5 ? "second order" : "not second order");CHKERRQ(ierr);
+  ierr = DMDestroy(&dmf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Compares the matrix-free operator with its assembled form */
+static PetscErrorCode CheckOperator(DM dm,DMStagOperatorType type,Vec eta,PetscRandom rand)
+{
+  PetscErrorCode ierr;
+  Mat            A,B;
+  Vec            x,y,z,d,e;
+  PetscReal      nrm,err,derr;
+  PetscBool      symm;
+
+  PetscFunctionBeginUser;
+  ierr = DMStagCreateOperator(dm,type,&A);CHKERRQ(ierr);
+  if (eta) {ierr = DMStagOperatorSetViscosity(A,eta);CHKERRQ(ierr);}
+  ierr = MatConvert(A,MATAIJ,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&d);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&e);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(A,d);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(B,e);CHKERRQ(ierr);
+  ierr = VecAXPY(e,-1.0,d);CHKERRQ(ierr);
+  ierr = VecNorm(e,NORM_INFINITY,&derr);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: products %s, diagonals %s\n",DMStagOperatorTypes[type],err <= 1e-12*nrm ? "match" : "differ",derr <= 1e-12 ? "match" : "differ");CHKERRQ(ierr);
+  if (type == DMSTAG_OPERATOR_VISCOUS || type == DMSTAG_OPERATOR_STOKES) {
+    ierr = MatIsSymmetric(B,1e-12,&symm);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: %s\n",DMStagOperatorTypes[type],symm ? "symmetric" : "not symmetric");CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&d);CHKERRQ(ierr);
+  ierr = VecDestroy(&e);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Checks that the divergence is the negative adjoint of the gradient, <y,G x> = -<D y,x> */
+static PetscErrorCode CheckAdjoint(DM dm,PetscRandom rand)
+{
+  PetscErrorCode ierr;
+  Mat            G,D;
+  Vec            x,y,w;
+  PetscScalar    a,b;
+
+  PetscFunctionBeginUser;
+  ierr = DMStagCreateOperator(dm,DMSTAG_OPERATOR_GRADIENT,&G);CHKERRQ(ierr);
+  ierr = DMStagCreateOperator(dm,DMSTAG_OPERATOR_DIVERGENCE,&D);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(y,rand);CHKERRQ(ierr);
+  ierr = MatMult(G,x,w);CHKERRQ(ierr);
+  ierr = VecDot(w,y,&a);CHKERRQ(ierr);
+  ierr = MatMult(D,y,w);CHKERRQ(ierr);
+  ierr = VecDot(w,x,&b);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Divergence %s the negative adjoint of the gradient\n",PetscAbsScalar(a+b) <= 1e-12*PetscAbsScalar(a) ? "is" : "is not");CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = MatDestroy(&G);CHKERRQ(ierr);
+  ierr = MatDestroy(&D);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Checks that interpolation preserves constants and reproduces linear fields and that coarsening undoes refinement */
+static PetscErrorCode CheckTransfer(DM dm)
+{
+  PetscErrorCode ierr;
+  DM             dmf,dmc;
+  Mat            P;
+  Vec            xc,xf;
+  PetscInt       N[2],Nc[2];
+  PetscReal      err,margin[2];
+
+  PetscFunctionBeginUser;
+  ierr = DMRefine(dm,PetscObjectComm((PetscObject)dm),&dmf);CHKERRQ(ierr);
+  ierr = DMCoarsen(dmf,PetscObjectComm((PetscObject)dm),&dmc);CHKERRQ(ierr);
+  ierr = DMStagGetGlobalSizes(dm,&N[0],&N[1],NULL);CHKERRQ(ierr);
+  ierr = DMStagGetGlobalSizes(dmc,&Nc[0],&Nc[1],NULL);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Coarsening %s refinement\n",N[0] == Nc[0] && N[1] == Nc[1] ? "undoes" : "does not undo");CHKERRQ(ierr);
+  ierr = DMCreateInterpolation(dm,dmf,&P,NULL);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm,&xc);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dmf,&xf);CHKERRQ(ierr);
+  ierr = VecSet(xc,1.0);CHKERRQ(ierr);
+  ierr = MatMult(P,xc,xf);CHKERRQ(ierr);
+  ierr = VecShift(xf,-1.0);CHKERRQ(ierr);
+  ierr = VecNorm(xf,NORM_INFINITY,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Interpolation %s constants\n",err <= 1e-14 ? "preserves" : "does not preserve");CHKERRQ(ierr);
+  /* Linear fields wrap around periodic boundaries, so there only the points which interpolate from a single period count */
+  ierr = ProjectField(dm,Linear,xc);CHKERRQ(ierr);
+  ierr = MatMult(P,xc,xf);CHKERRQ(ierr);
+  margin[0] = L[0]/N[0]; margin[1] = L[1]/N[1];
+  ierr = FieldError(dmf,xf,1.0,Linear,margin,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Interpolation %s linear fields\n",err <= 1e-12 ? "reproduces" : "does not reproduce");CHKERRQ(ierr);
+  ierr = VecDestroy(&xc);CHKERRQ(ierr);
+  ierr = VecDestroy(&xf);CHKERRQ(ierr);
+  ierr = MatDestroy(&P);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmc);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Solves a viscous problem with geometric multigrid, matrix-free on all but the coarsest level */
+static PetscErrorCode SolveMG(DM dmc,PetscInt nlevels)
+{
+  PetscErrorCode ierr;
+  DM             *dms;
+  Mat            *A,P;
+  KSP            ksp,smoother;
+  PC             pc;
+  Vec            x,b;
+  PetscInt       l,its;
+
+  PetscFunctionBeginUser;
+  ierr = PetscMalloc2(nlevels,&dms,nlevels,&A);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)dmc);CHKERRQ(ierr);
+  dms[0] = dmc;
+  for (l=1; l<nlevels; ++l) {ierr = DMRefine(dms[l-1],PetscObjectComm((PetscObject)dmc),&dms[l]);CHKERRQ(ierr);}
+  for (l=0; l<nlevels; ++l) {ierr = DMStagCreateOperator(dms[l],DMSTAG_OPERATOR_VISCOUS,&A[l]);CHKERRQ(ierr);}
+  ierr = MatConvert(A[0],MATAIJ,MAT_INPLACE_MATRIX,&A[0]);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PetscObjectComm((PetscObject)dmc),&ksp);CHKERRQ(ierr);
+  ierr = KSPSetType(ksp,KSPCG);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A[nlevels-1],A[nlevels-1]);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCMG);CHKERRQ(ierr);
+  ierr = PCMGSetLevels(pc,nlevels,NULL);CHKERRQ(ierr);
+  for (l=0; l<nlevels; ++l) {
+    PC spc;
+
+    ierr = PCMGGetSmoother(pc,l,&smoother);CHKERRQ(ierr);
+    ierr = KSPSetOperators(smoother,A[l],A[l]);CHKERRQ(ierr);
+    if (l) {
+      ierr = KSPSetType(smoother,KSPCHEBYSHEV);CHKERRQ(ierr);
+      ierr = KSPGetPC(smoother,&spc);CHKERRQ(ierr);
+      ierr = PCSetType(spc,PCJACOBI);CHKERRQ(ierr);
+      ierr = DMCreateInterpolation(dms[l-1],dms[l],&P,NULL);CHKERRQ(ierr);
+      ierr = PCMGSetInterpolation(pc,l,P);CHKERRQ(ierr);
+      ierr = MatDestroy(&P);CHKERRQ(ierr);
+    }
+  }
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dms[nlevels-1],&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&x);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Multigrid converged in %s 10 iterations\n",its <= 10 ? "at most" : "more than");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  for (l=0; l<nlevels; ++l) {
+    ierr = MatDestroy(&A[l]);CHKERRQ(ierr);
+    ierr = DMDestroy(&dms[l]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(dms,A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  DM             dm,dmEta;
+  Mat            A;
+  Vec            eta;
+  PetscRandom    rand;
+  PetscInt       n = 8,nlevels = 0;
+  PetscBool      periodic = PETSC_FALSE;
+  DMBoundaryType bt;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-periodic",&periodic,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-mg_nlevels",&nlevels,NULL);CHKERRQ(ierr);
+  bt   = periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+
+  if (nlevels) {
+    /* A velocity-only DMStag for the multigrid solve */
+    ierr = DMStagCreate2d(PETSC_COMM_WORLD,bt,bt,n,n,PETSC_DECIDE,PETSC_DECIDE,0,1,0,DMSTAG_STENCIL_STAR,1,NULL,NULL,&dm);CHKERRQ(ierr);
+    ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+    ierr = DMSetUp(dm);CHKERRQ(ierr);
+    ierr = DMStagSetUniformCoordinatesProduct(dm,0.0,2.0,0.0,1.0,0.0,0.0);CHKERRQ(ierr);
+    ierr = SolveMG(dm,nlevels);CHKERRQ(ierr);
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+    ierr = PetscFinalize();
+    return ierr;
+  }
+
+  ierr = DMStagCreate2d(PETSC_COMM_WORLD,bt,bt,n,n+2,PETSC_DECIDE,PETSC_DECIDE,0,1,1,DMSTAG_STENCIL_STAR,1,NULL,NULL,&dm);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  ierr = DMStagSetUniformCoordinatesExplicit(dm,0.0,2.0,0.0,1.0,0.0,0.0);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetInterval(rand,1.0,2.0);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+
+  /* A variable viscosity, taken from the DMStag of a first operator */
+  ierr = DMStagCreateOperator(dm,DMSTAG_OPERATOR_STOKES,&A);CHKERRQ(ierr);
+  ierr = DMStagOperatorGetViscosityDM(A,&dmEta);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dmEta,&eta);CHKERRQ(ierr);
+  ierr = VecSetRandom(eta,rand);CHKERRQ(ierr);
+
+  ierr = CheckOperator(dm,DMSTAG_OPERATOR_GRADIENT,NULL,rand);CHKERRQ(ierr);
+  ierr = CheckOperator(dm,DMSTAG_OPERATOR_DIVERGENCE,NULL,rand);CHKERRQ(ierr);
+  ierr = CheckOperator(dm,DMSTAG_OPERATOR_VISCOUS,eta,rand);CHKERRQ(ierr);
+  ierr = CheckOperator(dm,DMSTAG_OPERATOR_STOKES,eta,rand);CHKERRQ(ierr);
+  ierr = CheckAdjoint(dm,rand);CHKERRQ(ierr);
+  ierr = CheckCoordinates(dm);CHKERRQ(ierr);
+  ierr = CheckAccuracy(dm);CHKERRQ(ierr);
+  ierr = CheckTransfer(dm);CHKERRQ(ierr);
+
+  ierr = VecDestroy(&eta);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 4}}
+      args: -periodic {{0 1}}
+      output_file: output/ex15_1.out
+
+   test:
+      suffix: mg
+      nsize: {{1 4}}
+      args: -n 4 -mg_nlevels 3
+      output_file: output/ex15_mg.out
+
+TEST*/
@@ -514,6 +514,85 @@ PetscErrorCode DMSwarmDataBucketRemovePointAtIndex(const DMSwarmDataBucket db,co
   PetscFunctionReturn(0);
 }
 
+/*
+ Remove all points flagged in the bit array removed[] (of length db->L) with a single resize.
+ If preserve_order is PETSC_FALSE, each hole is filled with the last retained point, giving the same
+ result as calling DMSwarmDataBucketRemovePointAtIndex() on the flagged points in increasing order.
+ If preserve_order is PETSC_TRUE, the retained points are compacted while keeping their relative order.
+ */
+PetscErrorCode DMSwarmDataBucketRemovePoints(const DMSwarmDataBucket db,const PetscBT removed,const PetscBool preserve_order)
+{
+  PetscInt       f,k,p,q,L,nmove = 0;
+  PetscInt       *src,*dst;
+  PetscBool      any_active_fields;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmDataBucketQueryForActiveFields(db,&any_active_fields);CHKERRQ(ierr);
+  if (any_active_fields) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Cannot safely remove points as at least one DMSwarmDataField is currently being accessed");
+  L = db->L;
+  ierr = PetscMalloc2(L,&src,L,&dst);CHKERRQ(ierr);
+  if (preserve_order) {
+    for (p = 0, q = 0; p < L; ++p) {
+      if (PetscBTLookup(removed,p)) continue;
+      if (p != q) {src[nmove] = p; dst[nmove] = q; ++nmove;}
+      ++q;
+    }
+    L = q;
+  } else {
+    for (p = 0; p < L; ++p) {
+      if (!PetscBTLookup(removed,p)) continue;
+      /* discard flagged points at the end of the list, then move the last retained point into the hole */
+      while (L-1 > p && PetscBTLookup(removed,L-1)) --L;
+      if (L-1 == p) {L = p; break;}
+      src[nmove] = L-1; dst[nmove] = p; ++nmove;
+      --L;
+    }
+  }
+  for (f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField field = db->field[f];
+    const size_t     asize = field->atomic_size;
+    char             *data = (char*)field->data;
+
+    for (k = 0; k < nmove; ++k) {
+      ierr = PetscMemcpy(data + dst[k]*asize,data + src[k]*asize,asize);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree2(src,dst);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketSetSizes(db,L,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+ Reorder the points so that the point previously stored at perm[p] is moved to index p, for 0 <= p < db->L.
+ */
+PetscErrorCode DMSwarmDataBucketPermutePoints(const DMSwarmDataBucket db,const PetscInt perm[])
+{
+  PetscInt       f,p,L = db->L;
+  size_t         maxsize = 0;
+  char           *work;
+  PetscBool      any_active_fields;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmDataBucketQueryForActiveFields(db,&any_active_fields);CHKERRQ(ierr);
+  if (any_active_fields) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Cannot safely permute points as at least one DMSwarmDataField is currently being accessed");
+  for (f = 0; f < db->nfields; ++f) maxsize = PetscMax(maxsize,db->field[f]->atomic_size);
+  ierr = PetscMalloc(maxsize*L,&work);CHKERRQ(ierr);
+  for (f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField field = db->field[f];
+    const size_t     asize = field->atomic_size;
+    char             *data = (char*)field->data;
+
+    for (p = 0; p < L; ++p) {
+      ierr = PetscMemcpy(work + p*asize,data + perm[p]*asize,asize);CHKERRQ(ierr);
+    }
+    ierr = PetscMemcpy(data,work,L*asize);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* copy x into y */
 PetscErrorCode DMSwarmDataFieldCopyPoint(const PetscInt pid_x,const DMSwarmDataField field_x,
                         const PetscInt pid_y,const DMSwarmDataField field_y)
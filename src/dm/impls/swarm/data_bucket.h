@@ -2,6 +2,7 @@
 #define __DMSWARM_DATA_BUCKET_H__
 
 #include <petsc/private/dmswarmimpl.h>    /*I   "petscdmswarm.h"   I*/
+#include <petscbt.h>
 
 #define DMSWARM_DATA_BUCKET_BUFFER_DEFAULT -1
 #define DMSWARM_DATAFIELD_POINT_ACCESS_GUARD
@@ -79,6 +80,8 @@ PETSC_INTERN PetscErrorCode DMSwarmDataBucketView(MPI_Comm comm,DMSwarmDataBucke
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketAddPoint(DMSwarmDataBucket db);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketRemovePoint(DMSwarmDataBucket db);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketRemovePointAtIndex(const DMSwarmDataBucket db,const PetscInt index);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketRemovePoints(const DMSwarmDataBucket db,const PetscBT removed,const PetscBool preserve_order);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketPermutePoints(const DMSwarmDataBucket db,const PetscInt perm[]);
 
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketDuplicateFields(DMSwarmDataBucket dbA,DMSwarmDataBucket *dbB);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketInsertValues(DMSwarmDataBucket db1,DMSwarmDataBucket db2);
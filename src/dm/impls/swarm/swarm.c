@@ -9,6 +9,7 @@
 #include "../src/dm/impls/swarm/data_bucket.h"
 
 PetscLogEvent DMSWARM_Migrate, DMSWARM_SetSizes, DMSWARM_AddPoints, DMSWARM_RemovePoints, DMSWARM_Sort;
+PetscLogEvent DMSWARM_ProjectFields, DMSWARM_InterpolateFields;
 PetscLogEvent DMSWARM_DataExchangerTopologySetup, DMSWARM_DataExchangerBegin, DMSWARM_DataExchangerEnd;
 PetscLogEvent DMSWARM_DataExchangerSendCount, DMSWARM_DataExchangerPack;
 
@@ -861,10 +862,13 @@ PetscErrorCode DMSwarmSetLocalSizes(DM dm,PetscInt nlocal,PetscInt buffer)
 @*/
 PetscErrorCode DMSwarmSetCellDM(DM dm,DM dmcell)
 {
-  DM_Swarm *swarm = (DM_Swarm*)dm->data;
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
   swarm->dmcell = dmcell;
+  /* The neighbour ranks cached for migration belong to the previous cell DM */
+  if (swarm->migrator) {ierr = DMDestroy(&swarm->migrator->dmcell);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -1198,7 +1202,7 @@ PetscErrorCode DMSwarmAddNPoints(DM dm,PetscInt npoints)
 
    Level: beginner
 
-.seealso: DMSwarmRemovePointAtIndex()
+.seealso: DMSwarmRemovePointAtIndex(), DMSwarmRemovePoints()
 @*/
 PetscErrorCode DMSwarmRemovePoint(DM dm)
 {
@@ -1223,7 +1227,7 @@ PetscErrorCode DMSwarmRemovePoint(DM dm)
 
    Level: beginner
 
-.seealso: DMSwarmRemovePoint()
+.seealso: DMSwarmRemovePoint(), DMSwarmRemovePoints()
 @*/
 PetscErrorCode DMSwarmRemovePointAtIndex(DM dm,PetscInt idx)
 {
@@ -1237,6 +1241,50 @@ PetscErrorCode DMSwarmRemovePointAtIndex(DM dm,PetscInt idx)
   PetscFunctionReturn(0);
 }
 
+/*@
+   DMSwarmRemovePoints - Removes a set of points from the DMSwarm
+
+   Not collective
+
+   Input parameters:
++  dm - a DMSwarm
+.  n - the number of points to remove
+-  idx - the local indices of the points to remove (in any order, without duplicates)
+
+   Notes:
+   All fields are compacted with a single pass over the data and the DMSwarm is resized once, which is much
+   cheaper than calling DMSwarmRemovePointAtIndex() for each point. Each hole is filled with the last remaining point,
+   going through the holes in increasing order, which is the ordering obtained by DMSwarmRemovePointAtIndex(). If
+   DMSwarmSetSortPointsByCell() has been used, the relative order of the remaining points is preserved instead.
+
+   Level: intermediate
+
+.seealso: DMSwarmRemovePointAtIndex(), DMSwarmRemovePoint(), DMSwarmSetSortPointsByCell()
+@*/
+PetscErrorCode DMSwarmRemovePoints(DM dm,PetscInt n,const PetscInt idx[])
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscBT        removed;
+  PetscInt       i,npoints;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  if (n) PetscValidIntPointer(idx,3);
+  if (!n) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(DMSWARM_RemovePoints,0,0,0,0);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscBTCreate(npoints,&removed);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) {
+    if (idx[i] < 0 || idx[i] >= npoints) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Point index %D (entry %D) must be in [0, %D)",idx[i],i,npoints);
+    if (PetscBTLookupSet(removed,idx[i])) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Point index %D listed more than once",idx[i]);
+  }
+  ierr = DMSwarmDataBucketRemovePoints(swarm->db,removed,swarm->sort_points_by_cell);CHKERRQ(ierr);
+  ierr = PetscBTDestroy(&removed);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMSWARM_RemovePoints,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    DMSwarmCopyPoint - Copy point pj to point pi in the DMSwarm
 
@@ -1284,10 +1332,13 @@ PetscErrorCode DMSwarmMigrate_Basic(DM dm,PetscBool remove_sent_points)
    The DM will be modified to accomodate received points.
    If remove_sent_points = PETSC_TRUE, any points that were sent will be removed from the DM.
    Different styles of migration are supported. See DMSwarmSetMigrateType().
+   DMSWARM_MIGRATE_DMCELLNSCATTER communicates with the neighbor ranks of the cell DM only; see DMSwarmMigrateBegin()
+   for a split-phase variant which allows computation to overlap the communication.
+   If DMSwarmSetSortPointsByCell() has been used on a DMSWARM_PIC, the local points are re-sorted by cell after migration.
 
    Level: advanced
 
-.seealso: DMSwarmSetMigrateType()
+.seealso: DMSwarmSetMigrateType(), DMSwarmSetSortPointsByCell(), DMSwarmMigrateBegin(), DMSwarmMigrateEnd(), DMSwarmSetMigrateFields()
 @*/
 PetscErrorCode DMSwarmMigrate(DM dm,PetscBool remove_sent_points)
 {
@@ -1295,6 +1346,7 @@ PetscErrorCode DMSwarmMigrate(DM dm,PetscBool remove_sent_points)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  if (swarm->migrator && swarm->migrator->active) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_ORDER,"Cannot call DMSwarmMigrate() between DMSwarmMigrateBegin() and DMSwarmMigrateEnd()");
   ierr = PetscLogEventBegin(DMSWARM_Migrate,0,0,0,0);CHKERRQ(ierr);
   switch (swarm->migrate_type) {
     case DMSWARM_MIGRATE_BASIC:
@@ -1310,10 +1362,151 @@ PetscErrorCode DMSwarmMigrate(DM dm,PetscBool remove_sent_points)
     default:
       SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_SUP,"DMSWARM_MIGRATE type unknown");
   }
+  if (swarm->sort_points_by_cell && swarm->swarm_type == DMSWARM_PIC) {
+    ierr = DMSwarmSortPointsByCell(dm);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(DMSWARM_Migrate,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMSwarmMigrateBegin - Starts relocating points defined in the DMSwarm to other MPI-ranks
+
+   Collective on dm
+
+   Input parameters:
++  dm - the DMSwarm
+-  remove_sent_points - flag indicating if sent points should be removed from the current MPI-rank
+
+   Notes:
+   The points to be sent are determined, packed and posted with nonblocking messages; the
+   migration is completed by DMSwarmMigrateEnd(). Only DMSWARM_MIGRATE_BASIC and DMSWARM_MIGRATE_DMCELLNSCATTER are supported.
+
+   For DMSWARM_MIGRATE_DMCELLNSCATTER the local points are located in the cell DM and those which left the
+   local domain are sent to the neighbor ranks of the cell DM only. The neighbor ranks are computed once and reused
+   by subsequent migrations with the same cell DM, and the message lengths are only exchanged with the neighbors.
+
+   Only the fields selected with DMSwarmSetMigrateFields() are communicated, packed directly from the field storage.
+
+   Between DMSwarmMigrateBegin() and DMSwarmMigrateEnd() the fields of the points remaining on this rank may be
+   accessed and modified, for example to advance the particles which are away from the subdomain boundary while
+   the outgoing ones are in flight. Points must not be added or removed, and they are not located again,
+   so for DMSWARM_MIGRATE_DMCELLNSCATTER their cell index remains the one found by DMSwarmMigrateBegin().
+
+   Level: advanced
+
+.seealso: DMSwarmMigrateEnd(), DMSwarmMigrate(), DMSwarmSetMigrateFields(), DMSwarmSetMigrateType()
+@*/
+PetscErrorCode DMSwarmMigrateBegin(DM dm,PetscBool remove_sent_points)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  if (!swarm->migrator) {ierr = DMSwarmMigratorCreate(dm,&swarm->migrator);CHKERRQ(ierr);}
+  if (swarm->migrator->active) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_ORDER,"DMSwarmMigrateEnd() must be called before starting another migration");
+  ierr = PetscLogEventBegin(DMSWARM_Migrate,0,0,0,0);CHKERRQ(ierr);
+  switch (swarm->migrate_type) {
+    case DMSWARM_MIGRATE_BASIC:
+      ierr = DMSwarmMigrateBegin_Push_Basic(dm,remove_sent_points);CHKERRQ(ierr);
+      break;
+    case DMSWARM_MIGRATE_DMCELLNSCATTER:
+      ierr = DMSwarmMigrateBegin_CellDMScatter(dm,remove_sent_points);CHKERRQ(ierr);
+      break;
+    default:
+      SETERRQ1(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"DMSwarmMigrateBegin() not supported for migrate type %s",DMSwarmMigrateTypeNames[swarm->migrate_type]);
+  }
+  swarm->migrator->active = PETSC_TRUE;
   ierr = PetscLogEventEnd(DMSWARM_Migrate,0,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
+/*@
+   DMSwarmMigrateEnd - Completes the relocation of points started with DMSwarmMigrateBegin()
+
+   Collective on dm
+
+   Input parameter:
+.  dm - the DMSwarm
+
+   Notes:
+   The received points are appended to the local points. Fields which were not selected with
+   DMSwarmSetMigrateFields() are zero on the received points.
+   If DMSwarmSetSortPointsByCell() has been used on a DMSWARM_PIC, the local points are re-sorted by cell.
+
+   Level: advanced
+
+.seealso: DMSwarmMigrateBegin(), DMSwarmMigrate(), DMSwarmSetMigrateFields()
+@*/
+PetscErrorCode DMSwarmMigrateEnd(DM dm)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  if (!swarm->migrator || !swarm->migrator->active) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_ORDER,"DMSwarmMigrateBegin() must be called first");
+  ierr = PetscLogEventBegin(DMSWARM_Migrate,0,0,0,0);CHKERRQ(ierr);
+  switch (swarm->migrate_type) {
+    case DMSWARM_MIGRATE_BASIC:
+      ierr = DMSwarmMigrateEnd_Push_Basic(dm);CHKERRQ(ierr);
+      break;
+    case DMSWARM_MIGRATE_DMCELLNSCATTER:
+      ierr = DMSwarmMigrateEnd_CellDMScatter(dm);CHKERRQ(ierr);
+      break;
+    default:
+      SETERRQ1(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"DMSwarmMigrateEnd() not supported for migrate type %s",DMSwarmMigrateTypeNames[swarm->migrate_type]);
+  }
+  if (swarm->sort_points_by_cell && swarm->swarm_type == DMSWARM_PIC) {
+    ierr = DMSwarmSortPointsByCell(dm);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(DMSWARM_Migrate,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   DMSwarmSetMigrateFields - Sets the fields which are communicated when points are migrated
+
+   Collective on dm
+
+   Input parameters:
++  dm - the DMSwarm
+.  nfields - the number of fields, or 0 to communicate all registered fields (the default)
+-  fieldnames - the names of the fields
+
+   Notes:
+   The fields DMSwarmField_rank, DMSwarmPICField_coor and DMSwarmPICField_cellid are always communicated when they are registered.
+   The remaining fields are zero on the points received by a rank. Leaving out fields which are recomputed
+   after migration, such as work arrays, reduces the message sizes.
+
+   The selection is used by DMSwarmMigrateBegin()/DMSwarmMigrateEnd() and by DMSwarmMigrate() with DMSWARM_MIGRATE_DMCELLNSCATTER.
+
+   Level: advanced
+
+.seealso: DMSwarmMigrateBegin(), DMSwarmMigrate()
+@*/
+PetscErrorCode DMSwarmSetMigrateFields(DM dm,PetscInt nfields,const char *fieldnames[])
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscInt       f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  if (nfields) PetscValidPointer(fieldnames,3);
+  if (!swarm->migrator) {ierr = DMSwarmMigratorCreate(dm,&swarm->migrator);CHKERRQ(ierr);}
+  if (swarm->migrator->active) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_ORDER,"Cannot change the migrated fields between DMSwarmMigrateBegin() and DMSwarmMigrateEnd()");
+  ierr = PetscStrArrayDestroy(&swarm->migrator->fieldnames);CHKERRQ(ierr);
+  if (!nfields) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(nfields+1,&swarm->migrator->fieldnames);CHKERRQ(ierr);
+  for (f = 0; f < nfields; ++f) {
+    ierr = PetscStrallocpy(fieldnames[f],&swarm->migrator->fieldnames[f]);CHKERRQ(ierr);
+  }
+  swarm->migrator->fieldnames[nfields] = NULL;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMSwarmMigrate_GlobalToLocal_Basic(DM dm,PetscInt *globalsize);
 
 /*
@@ -1557,6 +1750,18 @@ PetscErrorCode DMSetup_Swarm(DM dm)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode DMSetFromOptions_Swarm(PetscOptionItems *PetscOptionsObject,DM dm)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"DMSwarm Options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dm_swarm_sort_points_by_cell","Keep the local points stored in increasing cell order","DMSwarmSetSortPointsByCell",swarm->sort_points_by_cell,&swarm->sort_points_by_cell,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 extern PetscErrorCode DMSwarmSortDestroy(DMSwarmSort *_ctx);
 
 PetscErrorCode DMDestroy_Swarm(DM dm)
@@ -1569,6 +1774,7 @@ PetscErrorCode DMDestroy_Swarm(DM dm)
   if (swarm->sort_context) {
     ierr = DMSwarmSortDestroy(&swarm->sort_context);CHKERRQ(ierr);
   }
+  ierr = DMSwarmMigratorDestroy(&swarm->migrator);CHKERRQ(ierr);
   ierr = PetscFree(swarm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1682,6 +1888,9 @@ $    DMSwarmFinalizeFieldRegister(dm)
  Additional high-level support is provided for Particle-In-Cell methods.
  Please refer to the man page for DMSwarmSetType().
 
+ Options Database Keys:
+. -dm_swarm_sort_points_by_cell - Keep the local points of a DMSWARM_PIC stored in increasing cell order, see DMSwarmSetSortPointsByCell()
+
  Level: beginner
 
 .seealso: DMType, DMCreate(), DMSetType()
@@ -1705,6 +1914,7 @@ PETSC_EXTERN PetscErrorCode DMCreate_Swarm(DM dm)
   swarm->migrate_type = DMSWARM_MIGRATE_BASIC;
   swarm->collect_type = DMSWARM_COLLECT_BASIC;
   swarm->migrate_error_on_missing_point = PETSC_FALSE;
+  swarm->sort_points_by_cell = PETSC_FALSE;
 
   swarm->dmcell = NULL;
   swarm->collect_view_active = PETSC_FALSE;
@@ -1713,7 +1923,7 @@ PETSC_EXTERN PetscErrorCode DMCreate_Swarm(DM dm)
   dm->dim  = 0;
   dm->ops->view                            = DMView_Swarm;
   dm->ops->load                            = NULL;
-  dm->ops->setfromoptions                  = NULL;
+  dm->ops->setfromoptions                  = DMSetFromOptions_Swarm;
   dm->ops->clone                           = NULL;
   dm->ops->setup                           = DMSetup_Swarm;
   dm->ops->createlocalsection              = NULL;
@@ -5,6 +5,37 @@
 #include "../src/dm/impls/swarm/data_bucket.h"
 #include "../src/dm/impls/swarm/data_ex.h"
 
+/*
+ Removes the points p >= pStart whose rank field is equal to r (if match is PETSC_TRUE) or differs from r (if match is PETSC_FALSE).
+ The points are removed with a single compaction of the data bucket rather than one at a time.
+*/
+static PetscErrorCode DMSwarmRemovePointsByRank_Private(DM dm,PetscInt pStart,PetscInt r,PetscBool match)
+{
+  DM_Swarm         *swarm = (DM_Swarm*)dm->data;
+  DMSwarmDataField PField;
+  PetscBT          removed;
+  PetscInt         p,npoints,nremoved = 0,*rankval;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
+  if (pStart >= npoints) PetscFunctionReturn(0);
+  ierr = PetscBTCreate(npoints,&removed);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&PField);CHKERRQ(ierr);
+  ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr);
+  for (p = pStart; p < npoints; ++p) {
+    if ((rankval[p] == r) == match) {ierr = PetscBTSet(removed,p);CHKERRQ(ierr); ++nremoved;}
+  }
+  ierr = DMSwarmDataFieldRestoreEntries(PField,(void**)&rankval);CHKERRQ(ierr);
+  if (nremoved) {
+    ierr = PetscLogEventBegin(DMSWARM_RemovePoints,0,0,0,0);CHKERRQ(ierr);
+    ierr = DMSwarmDataBucketRemovePoints(swarm->db,removed,swarm->sort_points_by_cell);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(DMSWARM_RemovePoints,0,0,0,0);CHKERRQ(ierr);
+  }
+  ierr = PetscBTDestroy(&removed);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
  User loads desired location (MPI rank) into field DMSwarm_rank
 */
@@ -55,30 +86,8 @@ PetscErrorCode DMSwarmMigrate_Push_Basic(DM dm,PetscBool remove_sent_points)
   ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
 
   if (remove_sent_points) {
-    DMSwarmDataField gfield;
-
-    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&gfield);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetAccess(gfield);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetEntries(gfield,(void**)&rankval);CHKERRQ(ierr);
-
     /* remove points which left processor */
-    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-    for (p=0; p<npoints; p++) {
-      nrank = rankval[p];
-      if (nrank != rank) {
-        /* kill point */
-        ierr = DMSwarmDataFieldRestoreAccess(gfield);CHKERRQ(ierr);
-
-        ierr = DMSwarmDataBucketRemovePointAtIndex(swarm->db,p);CHKERRQ(ierr);
-
-        ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr); /* you need to update npoints as the list size decreases! */
-        ierr = DMSwarmDataFieldGetAccess(gfield);CHKERRQ(ierr);
-        ierr = DMSwarmDataFieldGetEntries(gfield,(void**)&rankval);CHKERRQ(ierr);
-        p--; /* check replacement point */
-      }
-    }
-    ierr = DMSwarmDataFieldRestoreEntries(gfield,(void**)&rankval);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldRestoreAccess(gfield);CHKERRQ(ierr);
+    ierr = DMSwarmRemovePointsByRank_Private(dm,0,(PetscInt)rank,PETSC_FALSE);CHKERRQ(ierr);
   }
   ierr = DMSwarmDataExBegin(de);CHKERRQ(ierr);
   ierr = DMSwarmDataExEnd(de);CHKERRQ(ierr);
@@ -96,111 +105,344 @@ PetscErrorCode DMSwarmMigrate_Push_Basic(DM dm,PetscBool remove_sent_points)
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode DMSwarmMigrate_DMNeighborScatter(DM dm,DM dmcell,PetscBool remove_sent_points,PetscInt *npoints_prior_migration)
+PetscErrorCode DMSwarmMigratorCreate(DM dm,DMSwarmMigrator *migrator)
+{
+  DMSwarmMigrator m;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&m);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)dm,&m->tag_count);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)dm,&m->tag_data);CHKERRQ(ierr);
+  *migrator = m;
+  PetscFunctionReturn(0);
+}
+
+/* Frees the message lists and buffers of the current migration, keeping the neighbour ranks */
+static PetscErrorCode DMSwarmMigratorReset_Private(DMSwarmMigrator m)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(m->fields);CHKERRQ(ierr);
+  ierr = PetscFree(m->sendranks);CHKERRQ(ierr);
+  ierr = PetscFree(m->sendoffsets);CHKERRQ(ierr);
+  ierr = PetscFree(m->sendpoints);CHKERRQ(ierr);
+  ierr = PetscFree(m->recvranks);CHKERRQ(ierr);
+  ierr = PetscFree(m->recvoffsets);CHKERRQ(ierr);
+  ierr = PetscFree(m->sendbuf);CHKERRQ(ierr);
+  ierr = PetscFree(m->recvbuf);CHKERRQ(ierr);
+  ierr = PetscFree(m->requests);CHKERRQ(ierr);
+  m->nfields   = 0;
+  m->unit_size = 0;
+  m->nsend     = 0;
+  m->nrecv     = 0;
+  m->nrequests = 0;
+  m->active    = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DMSwarmMigratorDestroy(DMSwarmMigrator *migrator)
+{
+  DMSwarmMigrator m = *migrator;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (!m) PetscFunctionReturn(0);
+  if (m->active && m->nrequests) {ierr = MPI_Waitall(m->nrequests,m->requests,MPI_STATUSES_IGNORE);CHKERRMPI(ierr);}
+  ierr = DMSwarmMigratorReset_Private(m);CHKERRQ(ierr);
+  ierr = PetscFree(m->neighbors);CHKERRQ(ierr);
+  ierr = PetscStrArrayDestroy(&m->fieldnames);CHKERRQ(ierr);
+  ierr = DMDestroy(&m->dmcell);CHKERRQ(ierr);
+  ierr = PetscFree(*migrator);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+ Builds the neighbour ranks of the cell DM once and keeps them until a different cell DM is set or the cell DM changes.
+ The neighbour relation reported by DMGetNeighbors() is not required to be symmetric,
+ so the ranks which list this rank as a neighbour are added to the list.
+ Negative entries mark missing neighbours; rank 0 is a neighbour like any other.
+*/
+static PetscErrorCode DMSwarmMigratorSetUpNeighbors_Private(DM dm,DM dmcell)
 {
   DM_Swarm          *swarm = (DM_Swarm*)dm->data;
+  DMSwarmMigrator   m = swarm->migrator;
+  MPI_Comm          comm;
+  const PetscMPIInt *ranks;
+  PetscMPIInt       rank,nfrom,*from,*fromdata,*to;
+  PetscInt          r,n,nto = 0;
+  PetscObjectState  state;
   PetscErrorCode    ierr;
-  DMSwarmDataEx     de;
-  PetscInt          r,p,npoints,*rankval,n_points_recv;
-  PetscMPIInt       rank,_rank;
-  const PetscMPIInt *neighbourranks;
-  void              *point_buffer,*recv_points;
-  size_t            sizeof_dmswarm_point;
-  PetscInt          nneighbors;
-  PetscMPIInt       mynneigh,*myneigh;
 
   PetscFunctionBegin;
-  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)dm),&rank);CHKERRMPI(ierr);
-  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-  ierr = DMSwarmGetField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
-  ierr = DMSwarmDataExCreate(PetscObjectComm((PetscObject)dm),0,&de);CHKERRQ(ierr);
-  ierr = DMGetNeighbors(dmcell,&nneighbors,&neighbourranks);CHKERRQ(ierr);
-  ierr = DMSwarmDataExTopologyInitialize(de);CHKERRQ(ierr);
-  for (r=0; r<nneighbors; r++) {
-    _rank = neighbourranks[r];
-    if ((_rank != rank) && (_rank > 0)) {
-      ierr = DMSwarmDataExTopologyAddNeighbour(de,_rank);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)dmcell,&state);CHKERRQ(ierr);
+  if (m->dmcell == dmcell && m->dmcellstate == state) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(DMSWARM_DataExchangerTopologySetup,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectGetComm((PetscObject)dm,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRMPI(ierr);
+  ierr = DMGetNeighbors(dmcell,&n,&ranks);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&to);CHKERRQ(ierr);
+  for (r = 0; r < n; ++r) {
+    if (ranks[r] >= 0 && ranks[r] != rank) to[nto++] = ranks[r];
+  }
+  ierr = PetscSortRemoveDupsMPIInt(&nto,to);CHKERRQ(ierr);
+  ierr = PetscCommBuildTwoSided(comm,1,MPI_INT,(PetscMPIInt)nto,to,to,&nfrom,&from,&fromdata);CHKERRQ(ierr);
+  ierr = PetscFree(m->neighbors);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nto+nfrom,&m->neighbors);CHKERRQ(ierr);
+  ierr = PetscArraycpy(m->neighbors,to,nto);CHKERRQ(ierr);
+  ierr = PetscArraycpy(m->neighbors+nto,from,nfrom);CHKERRQ(ierr);
+  n    = nto + nfrom;
+  ierr = PetscSortRemoveDupsMPIInt(&n,m->neighbors);CHKERRQ(ierr);
+  m->nneighbors = (PetscMPIInt)n;
+  ierr = PetscFree(to);CHKERRQ(ierr);
+  ierr = PetscFree(from);CHKERRQ(ierr);
+  ierr = PetscFree(fromdata);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)dmcell);CHKERRQ(ierr);
+  ierr = DMDestroy(&m->dmcell);CHKERRQ(ierr);
+  m->dmcell      = dmcell;
+  m->dmcellstate = state;
+  ierr = PetscLogEventEnd(DMSWARM_DataExchangerTopologySetup,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+ Selects the fields to communicate: all registered fields, or those given to DMSwarmSetMigrateFields()
+ together with the rank, coordinate and cell fields which migration itself relies on.
+*/
+static PetscErrorCode DMSwarmMigratorSetUpFields_Private(DM dm)
+{
+  DM_Swarm         *swarm = (DM_Swarm*)dm->data;
+  DMSwarmMigrator  m = swarm->migrator;
+  DMSwarmDataField *gfield;
+  PetscInt         f,nf,idx;
+  PetscBool        *selected;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmDataBucketGetDMSwarmDataFields(swarm->db,&nf,&gfield);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nf,&m->fields);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nf,&selected);CHKERRQ(ierr);
+  for (f = 0; f < nf; ++f) selected[f] = m->fieldnames ? PETSC_FALSE : PETSC_TRUE;
+  if (m->fieldnames) {
+    const char *required[] = {DMSwarmField_rank,DMSwarmPICField_coor,DMSwarmPICField_cellid};
+
+    for (f = 0; m->fieldnames[f]; ++f) {
+      ierr = DMSwarmDataFieldStringFindInList(m->fieldnames[f],nf,(const DMSwarmDataField*)gfield,&idx);CHKERRQ(ierr);
+      if (idx < 0) SETERRQ1(PetscObjectComm((PetscObject)dm),PETSC_ERR_USER,"Field \"%s\" given to DMSwarmSetMigrateFields() has not been registered",m->fieldnames[f]);
+      selected[idx] = PETSC_TRUE;
     }
-  }
-  ierr = DMSwarmDataExTopologyFinalize(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataExTopologyGetNeighbours(de,&mynneigh,&myneigh);CHKERRQ(ierr);
-  ierr = DMSwarmDataExInitializeSendCount(de);CHKERRQ(ierr);
-  for (p=0; p<npoints; p++) {
-    if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-      for (r=0; r<mynneigh; r++) {
-        _rank = myneigh[r];
-        ierr = DMSwarmDataExAddToSendCount(de,_rank,1);CHKERRQ(ierr);
-      }
+    for (f = 0; f < 3; ++f) {
+      ierr = DMSwarmDataFieldStringFindInList(required[f],nf,(const DMSwarmDataField*)gfield,&idx);CHKERRQ(ierr);
+      if (idx >= 0) selected[idx] = PETSC_TRUE;
     }
   }
-  ierr = DMSwarmDataExFinalizeSendCount(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketCreatePackedArray(swarm->db,&sizeof_dmswarm_point,&point_buffer);CHKERRQ(ierr);
-  ierr = DMSwarmDataExPackInitialize(de,sizeof_dmswarm_point);CHKERRQ(ierr);
-  for (p=0; p<npoints; p++) {
-    if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-      for (r=0; r<mynneigh; r++) {
-        _rank = myneigh[r];
-        /* copy point into buffer */
-        ierr = DMSwarmDataBucketFillPackedArray(swarm->db,p,point_buffer);CHKERRQ(ierr);
-        /* insert point buffer into DMSwarmDataExchanger */
-        ierr = DMSwarmDataExPackData(de,_rank,1,point_buffer);CHKERRQ(ierr);
+  m->nfields   = 0;
+  m->unit_size = 0;
+  for (f = 0; f < nf; ++f) {
+    if (!selected[f]) continue;
+    m->fields[m->nfields++] = f;
+    m->unit_size += gfield[f]->atomic_size;
+  }
+  ierr = PetscFree(selected);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+ Packs the points listed in sendpoints[] and posts the nonblocking sends and receives.
+ The points for each destination are packed field by field straight from the data bucket storage,
+ so a message to rank sendranks[i] holds the entries of the first communicated field for all its points,
+ then those of the second field, and so on.
+*/
+static PetscErrorCode DMSwarmMigratorPostMessages_Private(DM dm,const PetscInt recvcounts[])
+{
+  DM_Swarm         *swarm = (DM_Swarm*)dm->data;
+  DMSwarmMigrator  m = swarm->migrator;
+  MPI_Comm         comm;
+  DMSwarmDataField *gfield;
+  PetscInt         i,k,f,nf;
+  size_t           foffset = 0;
+  PetscMPIInt      len;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(DMSWARM_DataExchangerPack,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectGetComm((PetscObject)dm,&comm);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m->nrecv+1,&m->recvoffsets);CHKERRQ(ierr);
+  m->recvoffsets[0] = 0;
+  for (i = 0; i < m->nrecv; ++i) m->recvoffsets[i+1] = m->recvoffsets[i] + recvcounts[i];
+  ierr = PetscMalloc1(m->unit_size*m->sendoffsets[m->nsend],&m->sendbuf);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m->unit_size*m->recvoffsets[m->nrecv],&m->recvbuf);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m->nsend+m->nrecv,&m->requests);CHKERRQ(ierr);
+  m->nrequests = 0;
+  for (i = 0; i < m->nrecv; ++i) {
+    if (!recvcounts[i]) continue;
+    ierr = PetscMPIIntCast((PetscInt)(m->unit_size*recvcounts[i]),&len);CHKERRQ(ierr);
+    ierr = MPI_Irecv(m->recvbuf + m->unit_size*m->recvoffsets[i],len,MPI_BYTE,m->recvranks[i],m->tag_data,comm,&m->requests[m->nrequests++]);CHKERRMPI(ierr);
+  }
+  ierr = DMSwarmDataBucketGetDMSwarmDataFields(swarm->db,&nf,&gfield);CHKERRQ(ierr);
+  for (f = 0; f < m->nfields; ++f) {
+    const size_t asize = gfield[m->fields[f]]->atomic_size;
+    const char   *data = (const char*)gfield[m->fields[f]]->data;
+
+    for (i = 0; i < m->nsend; ++i) {
+      const PetscInt s = m->sendoffsets[i],e = m->sendoffsets[i+1];
+      char           *dest = m->sendbuf + m->unit_size*s + foffset*(e-s);
+
+      for (k = s; k < e; ++k, dest += asize) {
+        ierr = PetscMemcpy(dest,data + asize*m->sendpoints[k],asize);CHKERRQ(ierr);
       }
     }
+    foffset += asize;
   }
-  ierr = DMSwarmDataExPackFinalize(de);CHKERRQ(ierr);
-  ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
-  if (remove_sent_points) {
-    DMSwarmDataField PField;
+  for (i = 0; i < m->nsend; ++i) {
+    const PetscInt count = m->sendoffsets[i+1] - m->sendoffsets[i];
 
-    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&PField);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr);
-    /* remove points which left processor */
-    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-    for (p=0; p<npoints; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        ierr = DMSwarmDataBucketRemovePointAtIndex(swarm->db,p);CHKERRQ(ierr);
-        ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr); /* you need to update npoints as the list size decreases! */
-        ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr); /* update date point increase realloc performed */
-        p--; /* check replacement point */
+    if (!count) continue;
+    ierr = PetscMPIIntCast((PetscInt)(m->unit_size*count),&len);CHKERRQ(ierr);
+    ierr = MPI_Isend(m->sendbuf + m->unit_size*m->sendoffsets[i],len,MPI_BYTE,m->sendranks[i],m->tag_data,comm,&m->requests[m->nrequests++]);CHKERRMPI(ierr);
+  }
+  ierr = PetscLogEventEnd(DMSWARM_DataExchangerPack,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+ Waits for the messages posted by DMSwarmMigratorPostMessages_Private() and appends the received points.
+ Fields which were not communicated are zeroed on the received points.
+*/
+static PetscErrorCode DMSwarmMigratorComplete_Private(DM dm)
+{
+  DM_Swarm         *swarm = (DM_Swarm*)dm->data;
+  DMSwarmMigrator  m = swarm->migrator;
+  DMSwarmDataField *gfield;
+  PetscInt         i,f,g,nf,npoints,nrecvpoints;
+  size_t           foffset = 0;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(DMSWARM_DataExchangerEnd,0,0,0,0);CHKERRQ(ierr);
+  if (m->nrequests) {ierr = MPI_Waitall(m->nrequests,m->requests,MPI_STATUSES_IGNORE);CHKERRMPI(ierr);}
+  m->nrequests = 0;
+  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
+  if (npoints != m->npoints_prior) SETERRQ2(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_WRONGSTATE,"Points cannot be added or removed between DMSwarmMigrateBegin() and DMSwarmMigrateEnd() (local size %D, expected %D)",npoints,m->npoints_prior);
+  nrecvpoints = m->recvoffsets[m->nrecv];
+  if (nrecvpoints) {
+    ierr = DMSwarmDataBucketSetSizes(swarm->db,npoints+nrecvpoints,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);
+    ierr = DMSwarmDataBucketGetDMSwarmDataFields(swarm->db,&nf,&gfield);CHKERRQ(ierr);
+    for (g = 0, f = 0; g < nf; ++g) {
+      const size_t asize = gfield[g]->atomic_size;
+      char         *data = (char*)gfield[g]->data + asize*npoints;
+
+      if (f == m->nfields || m->fields[f] != g) {
+        ierr = DMSwarmDataFieldZeroBlock(gfield[g],npoints,npoints+nrecvpoints);CHKERRQ(ierr);
+        continue;
+      }
+      for (i = 0; i < m->nrecv; ++i) {
+        const PetscInt s = m->recvoffsets[i],e = m->recvoffsets[i+1];
+
+        ierr = PetscMemcpy(data + asize*s,m->recvbuf + m->unit_size*s + foffset*(e-s),asize*(e-s));CHKERRQ(ierr);
       }
+      foffset += asize;
+      ++f;
     }
   }
-  ierr = DMSwarmDataBucketGetSizes(swarm->db,npoints_prior_migration,NULL,NULL);CHKERRQ(ierr);
-  ierr = DMSwarmDataExBegin(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataExEnd(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataExGetRecvData(de,&n_points_recv,(void**)&recv_points);CHKERRQ(ierr);
+  ierr = DMSwarmMigratorReset_Private(m);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMSWARM_DataExchangerEnd,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+ User loads desired location (MPI rank) into field DMSwarm_rank.
+ Unlike DMSwarmMigrate_Push_Basic(), the ranks sending to us are discovered with PetscCommBuildTwoSided(),
+ which also delivers the message lengths, and the points are packed directly from the field storage.
+*/
+PetscErrorCode DMSwarmMigrateBegin_Push_Basic(DM dm,PetscBool remove_sent_points)
+{
+  DM_Swarm        *swarm = (DM_Swarm*)dm->data;
+  DMSwarmMigrator m = swarm->migrator;
+  MPI_Comm        comm;
+  PetscMPIInt     rank,size;
+  PetscInt        p,i,npoints,nsendpoints = 0,*rankval,*dest,*sendcounts,*recvcounts;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)dm,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
+  ierr = DMSwarmMigratorSetUpFields_Private(dm);CHKERRQ(ierr);
+  m->remove_sent_points = remove_sent_points;
+
+  ierr = PetscLogEventBegin(DMSWARM_DataExchangerSendCount,0,0,0,0);CHKERRQ(ierr);
   ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketSetSizes(swarm->db,npoints + n_points_recv,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);
-  for (p=0; p<n_points_recv; p++) {
-    void *data_p = (void*)( (char*)recv_points + p*sizeof_dmswarm_point);
+  ierr = DMSwarmGetField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
+  for (p = 0; p < npoints; ++p) {
+    if (rankval[p] != rank) ++nsendpoints;
+  }
+  ierr = PetscMalloc1(nsendpoints,&dest);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nsendpoints,&m->sendpoints);CHKERRQ(ierr);
+  for (p = 0, i = 0; p < npoints; ++p) {
+    if (rankval[p] == rank) continue;
+    if (rankval[p] < 0 || rankval[p] >= size) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Point %D has destination rank %D, must be in [0,%d)",p,rankval[p],size);
+    dest[i] = rankval[p];
+    m->sendpoints[i++] = p;
+  }
+  ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
+  /* group the points by destination, keeping them in increasing order for each destination */
+  ierr = PetscSortIntWithArray(nsendpoints,dest,m->sendpoints);CHKERRQ(ierr);
+  for (i = 0; i < nsendpoints; ++i) {
+    if (!i || dest[i] != dest[i-1]) ++m->nsend;
+  }
+  ierr = PetscMalloc1(m->nsend,&m->sendranks);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m->nsend+1,&m->sendoffsets);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m->nsend,&sendcounts);CHKERRQ(ierr);
+  m->sendoffsets[0] = 0;
+  for (i = 0, p = 0; i < nsendpoints; ++i) {
+    if (!i || dest[i] != dest[i-1]) {
+      m->sendranks[p]     = (PetscMPIInt)dest[i];
+      m->sendoffsets[p+1] = m->sendoffsets[p];
+      ++p;
+    }
+    ++m->sendoffsets[p];
+  }
+  for (i = 0; i < m->nsend; ++i) {
+    sendcounts[i] = m->sendoffsets[i+1] - m->sendoffsets[i];
+    ierr = PetscSortInt(sendcounts[i],m->sendpoints + m->sendoffsets[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscCommBuildTwoSided(comm,1,MPIU_INT,m->nsend,m->sendranks,sendcounts,&m->nrecv,&m->recvranks,&recvcounts);CHKERRQ(ierr);
+  ierr = PetscSortMPIIntWithIntArray(m->nrecv,m->recvranks,recvcounts);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMSWARM_DataExchangerSendCount,0,0,0,0);CHKERRQ(ierr);
 
-    ierr = DMSwarmDataBucketInsertPackedArray(swarm->db,npoints+p,data_p);CHKERRQ(ierr);
+  ierr = DMSwarmMigratorPostMessages_Private(dm,recvcounts);CHKERRQ(ierr);
+  ierr = PetscFree(recvcounts);CHKERRQ(ierr);
+  ierr = PetscFree(sendcounts);CHKERRQ(ierr);
+  ierr = PetscFree(dest);CHKERRQ(ierr);
+  if (remove_sent_points) {
+    ierr = DMSwarmRemovePointsByRank_Private(dm,0,(PetscInt)rank,PETSC_FALSE);CHKERRQ(ierr);
   }
-  ierr = DMSwarmDataBucketDestroyPackedArray(swarm->db,&point_buffer);CHKERRQ(ierr);
-  ierr = DMSwarmDataExDestroy(de);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketGetSizes(swarm->db,&m->npoints_prior,NULL,NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm,PetscBool remove_sent_points)
+PetscErrorCode DMSwarmMigrateEnd_Push_Basic(DM dm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmMigratorComplete_Private(dm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Locates the local points in the cell DM, storing the cell index (or DMLOCATEPOINT_POINT_NOT_FOUND) in DMSwarm_rank */
+static PetscErrorCode DMSwarmLocatePoints_CellDM_Private(DM dm,DM dmcell)
 {
   DM_Swarm          *swarm = (DM_Swarm*)dm->data;
-  PetscErrorCode    ierr;
-  PetscInt          p,npoints,npointsg=0,npoints2,npoints2g,*rankval,npoints_prior_migration;
+  PetscInt          p,npoints,*rankval;
   PetscSF           sfcell = NULL;
   const PetscSFNode *LA_sfcell;
-  DM                dmcell;
   Vec               pos;
-  PetscBool         error_check = swarm->migrate_error_on_missing_point;
-  PetscMPIInt       size,rank;
+  PetscErrorCode    ierr;
 
   PetscFunctionBegin;
-  ierr = DMSwarmGetCellDM(dm,&dmcell);CHKERRQ(ierr);
-  if (!dmcell) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Only valid if cell DM provided");
-
-  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)dm),&size);CHKERRMPI(ierr);
-  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)dm),&rank);CHKERRMPI(ierr);
-
 #if 1
   {
     PetscInt *p_cellid;
@@ -234,9 +476,6 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm,PetscBool remove_sent_points)
   ierr = DMLocatePoints(dmcell, pos, DM_POINTLOCATION_NONE, &sfcell);CHKERRQ(ierr);
   ierr = DMSwarmDestroyLocalVectorFromField(dm, DMSwarmPICField_coor, &pos);CHKERRQ(ierr);
 
-  if (error_check) {
-    ierr = DMSwarmGetSize(dm,&npointsg);CHKERRQ(ierr);
-  }
   ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
   ierr = DMSwarmGetField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
   ierr = PetscSFGetGraph(sfcell, NULL, NULL, NULL, &LA_sfcell);CHKERRQ(ierr);
@@ -245,76 +484,113 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm,PetscBool remove_sent_points)
   }
   ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
   ierr = PetscSFDestroy(&sfcell);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 
-  if (size > 1) {
-    ierr = DMSwarmMigrate_DMNeighborScatter(dm,dmcell,remove_sent_points,&npoints_prior_migration);CHKERRQ(ierr);
-  } else {
-    DMSwarmDataField PField;
-    PetscInt npoints_curr;
-
-    /* remove points which the domain */
-    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&PField);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr);
-
-    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints_curr,NULL,NULL);CHKERRQ(ierr);
-    for (p=0; p<npoints_curr; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        ierr = DMSwarmDataBucketRemovePointAtIndex(swarm->db,p);CHKERRQ(ierr);
-        ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints_curr,NULL,NULL);CHKERRQ(ierr); /* you need to update npoints as the list size decreases! */
-        ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr); /* update date point increase realloc performed */
-        p--; /* check replacement point */
-      }
-    }
-    ierr = DMSwarmGetSize(dm,&npoints_prior_migration);CHKERRQ(ierr);
+/*
+ Locates the local points and sends the ones which left the local domain to every neighbour rank of the cell DM.
+ The message lengths are exchanged with the neighbours only; the points themselves are then in flight
+ until DMSwarmMigrateEnd_CellDMScatter() is called.
+*/
+PetscErrorCode DMSwarmMigrateBegin_CellDMScatter(DM dm,PetscBool remove_sent_points)
+{
+  DM_Swarm        *swarm = (DM_Swarm*)dm->data;
+  DMSwarmMigrator m = swarm->migrator;
+  MPI_Comm        comm;
+  DM              dmcell;
+  PetscMPIInt     size;
+  PetscInt        p,i,k,npoints,nlost = 0,*rankval,*sendcounts,*recvcounts;
+  MPI_Request     *reqs;
+  PetscErrorCode  ierr;
 
+  PetscFunctionBegin;
+  ierr = DMSwarmGetCellDM(dm,&dmcell);CHKERRQ(ierr);
+  if (!dmcell) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Only valid if cell DM provided");
+  ierr = PetscObjectGetComm((PetscObject)dm,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
+  if (swarm->migrate_error_on_missing_point) {
+    ierr = DMSwarmGetSize(dm,&m->npointsg);CHKERRQ(ierr);
   }
+  ierr = DMSwarmMigratorSetUpFields_Private(dm);CHKERRQ(ierr);
+  m->remove_sent_points = remove_sent_points;
+  ierr = DMSwarmLocatePoints_CellDM_Private(dm,dmcell);CHKERRQ(ierr);
 
-  /* locate points newly received */
-  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints2,NULL,NULL);CHKERRQ(ierr);
-
-#if 0
-  { /* safe alternative - however this performs two point locations on: (i) the initial points set and; (ii) the (initial + received) point set */
-    PetscScalar *LA_coor;
-    PetscInt bs;
-    DMSwarmDataField PField;
-
-    ierr = DMSwarmGetField(dm,DMSwarmPICField_coor,&bs,NULL,(void**)&LA_coor);CHKERRQ(ierr);
-    ierr = VecCreateSeqWithArray(PETSC_COMM_SELF,bs,bs*npoints2,(const PetscScalar*)LA_coor,&pos);CHKERRQ(ierr);
-    ierr = DMLocatePoints(dmcell,pos,DM_POINTLOCATION_NONE,&sfcell);CHKERRQ(ierr);
-
-    ierr = VecDestroy(&pos);CHKERRQ(ierr);
-    ierr = DMSwarmRestoreField(dm,DMSwarmPICField_coor,&bs,NULL,(void**)&LA_coor);CHKERRQ(ierr);
-
-    ierr = PetscSFGetGraph(sfcell, NULL, NULL, NULL, &LA_sfcell);CHKERRQ(ierr);
+  if (size > 1) {
+    ierr = DMSwarmMigratorSetUpNeighbors_Private(dm,dmcell);CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(DMSWARM_DataExchangerSendCount,0,0,0,0);CHKERRQ(ierr);
+    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
     ierr = DMSwarmGetField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
-    for (p=0; p<npoints2; p++) {
-      rankval[p] = LA_sfcell[p].index;
+    for (p = 0; p < npoints; ++p) {
+      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) ++nlost;
     }
-    ierr = PetscSFDestroy(&sfcell);CHKERRQ(ierr);
+    /* a point which left the local domain is sent to every neighbour */
+    m->nsend = m->nrecv = m->nneighbors;
+    ierr = PetscMalloc1(m->nsend,&m->sendranks);CHKERRQ(ierr);
+    ierr = PetscMalloc1(m->nrecv,&m->recvranks);CHKERRQ(ierr);
+    ierr = PetscArraycpy(m->sendranks,m->neighbors,m->nsend);CHKERRQ(ierr);
+    ierr = PetscArraycpy(m->recvranks,m->neighbors,m->nrecv);CHKERRQ(ierr);
+    ierr = PetscMalloc1(m->nsend+1,&m->sendoffsets);CHKERRQ(ierr);
+    ierr = PetscMalloc1(m->nsend*nlost,&m->sendpoints);CHKERRQ(ierr);
+    for (i = 0; i <= m->nsend; ++i) m->sendoffsets[i] = i*nlost;
+    for (p = 0, k = 0; p < npoints; ++p) {
+      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) m->sendpoints[k++] = p;
+    }
+    for (i = 1; i < m->nsend; ++i) {ierr = PetscArraycpy(m->sendpoints + i*nlost,m->sendpoints,nlost);CHKERRQ(ierr);}
     ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
 
-    /* remove points which left processor */
-    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&PField);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr);
-
-    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints2,NULL,NULL);CHKERRQ(ierr);
-    for (p=0; p<npoints2; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        ierr = DMSwarmDataBucketRemovePointAtIndex(swarm->db,p);CHKERRQ(ierr);
-        ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints2,NULL,NULL);CHKERRQ(ierr); /* you need to update npoints as the list size decreases! */
-        ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr); /* update date point increase realloc performed */
-        p--; /* check replacement point */
-      }
+    ierr = PetscMalloc3(m->nsend,&sendcounts,m->nrecv,&recvcounts,m->nsend+m->nrecv,&reqs);CHKERRQ(ierr);
+    for (i = 0; i < m->nrecv; ++i) {
+      ierr = MPI_Irecv(&recvcounts[i],1,MPIU_INT,m->recvranks[i],m->tag_count,comm,&reqs[i]);CHKERRMPI(ierr);
     }
+    for (i = 0; i < m->nsend; ++i) {
+      sendcounts[i] = nlost;
+      ierr = MPI_Isend(&sendcounts[i],1,MPIU_INT,m->sendranks[i],m->tag_count,comm,&reqs[m->nrecv+i]);CHKERRMPI(ierr);
+    }
+    ierr = MPI_Waitall(m->nsend+m->nrecv,reqs,MPI_STATUSES_IGNORE);CHKERRMPI(ierr);
+    ierr = PetscLogEventEnd(DMSWARM_DataExchangerSendCount,0,0,0,0);CHKERRQ(ierr);
+
+    ierr = DMSwarmMigratorPostMessages_Private(dm,recvcounts);CHKERRQ(ierr);
+    ierr = PetscFree3(sendcounts,recvcounts,reqs);CHKERRQ(ierr);
+    if (remove_sent_points) {
+      /* remove points which left processor */
+      ierr = DMSwarmRemovePointsByRank_Private(dm,0,DMLOCATEPOINT_POINT_NOT_FOUND,PETSC_TRUE);CHKERRQ(ierr);
+    }
+  } else {
+    ierr = PetscMalloc1(1,&m->sendoffsets);CHKERRQ(ierr);
+    m->sendoffsets[0] = 0;
+    ierr = DMSwarmMigratorPostMessages_Private(dm,NULL);CHKERRQ(ierr);
+    /* remove points which left the domain */
+    ierr = DMSwarmRemovePointsByRank_Private(dm,0,DMLOCATEPOINT_POINT_NOT_FOUND,PETSC_TRUE);CHKERRQ(ierr);
   }
-#endif
+  ierr = DMSwarmDataBucketGetSizes(swarm->db,&m->npoints_prior,NULL,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+ Appends the points received from the neighbours, locates them (this performs a second point location on the received points only)
+ and removes those which do not belong to the local domain.
+*/
+PetscErrorCode DMSwarmMigrateEnd_CellDMScatter(DM dm)
+{
+  DM_Swarm          *swarm = (DM_Swarm*)dm->data;
+  DMSwarmMigrator   m = swarm->migrator;
+  PetscInt          p,npoints2,npoints2g,*rankval,npoints_prior_migration = m->npoints_prior,npointsg = m->npointsg;
+  PetscSF           sfcell = NULL;
+  const PetscSFNode *LA_sfcell;
+  DM                dmcell;
+  Vec               pos;
+  PetscBool         error_check = swarm->migrate_error_on_missing_point;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmGetCellDM(dm,&dmcell);CHKERRQ(ierr);
+  ierr = DMSwarmMigratorComplete_Private(dm);CHKERRQ(ierr);
 
-  { /* this performs two point locations: (i) on the initial points set prior to communication; and (ii) on the new (received) points */
+  /* locate points newly received */
+  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints2,NULL,NULL);CHKERRQ(ierr);
+  if (npoints2 > npoints_prior_migration) {
     PetscScalar      *LA_coor;
     PetscInt         npoints_from_neighbours,bs;
-    DMSwarmDataField PField;
 
     npoints_from_neighbours = npoints2 - npoints_prior_migration;
 
@@ -335,19 +611,7 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm,PetscBool remove_sent_points)
     ierr = PetscSFDestroy(&sfcell);CHKERRQ(ierr);
 
     /* remove points which left processor */
-    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&PField);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr);
-
-    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints2,NULL,NULL);CHKERRQ(ierr);
-    for (p=npoints_prior_migration; p<npoints2; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        ierr = DMSwarmDataBucketRemovePointAtIndex(swarm->db,p);CHKERRQ(ierr);
-        ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints2,NULL,NULL);CHKERRQ(ierr); /* you need to update npoints as the list size decreases! */
-        ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr); /* update date point increase realloc performed */
-        p--; /* check replacement point */
-      }
-    }
+    ierr = DMSwarmRemovePointsByRank_Private(dm,npoints_prior_migration,DMLOCATEPOINT_POINT_NOT_FOUND,PETSC_TRUE);CHKERRQ(ierr);
   }
 
   {
@@ -371,6 +635,18 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm,PetscBool remove_sent_points)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm,PetscBool remove_sent_points)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!swarm->migrator) {ierr = DMSwarmMigratorCreate(dm,&swarm->migrator);CHKERRQ(ierr);}
+  ierr = DMSwarmMigrateBegin_CellDMScatter(dm,remove_sent_points);CHKERRQ(ierr);
+  ierr = DMSwarmMigrateEnd_CellDMScatter(dm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMSwarmMigrate_CellDMExact(DM dm,PetscBool remove_sent_points)
 {
   PetscFunctionBegin;
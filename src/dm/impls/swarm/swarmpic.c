@@ -452,6 +452,8 @@ PETSC_EXTERN PetscErrorCode DMSwarmSetPointCoordinatesCellwise(DM dm,PetscInt np
 /* Field projection API */
 extern PetscErrorCode private_DMSwarmProjectFields_DA(DM swarm,DM celldm,PetscInt project_type,PetscInt nfields,DMSwarmDataField dfield[],Vec vecs[]);
 extern PetscErrorCode private_DMSwarmProjectFields_PLEX(DM swarm,DM celldm,PetscInt project_type,PetscInt nfields,DMSwarmDataField dfield[],Vec vecs[]);
+extern PetscErrorCode private_DMSwarmInterpolateFields_DA(DM swarm,DM celldm,PetscInt nfields,DMSwarmDataField dfield[],Vec vecs[]);
+extern PetscErrorCode private_DMSwarmInterpolateFields_PLEX(DM swarm,DM celldm,PetscInt nfields,DMSwarmDataField dfield[],Vec vecs[]);
 
 /*@C
    DMSwarmProjectFields - Project a set of swarm fields onto the cell DM
@@ -485,7 +487,11 @@ extern PetscErrorCode private_DMSwarmProjectFields_PLEX(DM swarm,DM celldm,Petsc
 
    The only projection methods currently only support the DA (2D) and PLEX (triangles 2D).
 
-.seealso: DMSwarmSetType(), DMSwarmSetCellDM(), DMSwarmType
+   All fields are projected in a single pass over the points. Contributions are accumulated per cell over runs of
+   consecutive points in the same cell, so the projection is fastest when the points are stored sorted by cell,
+   see DMSwarmSetSortPointsByCell().
+
+.seealso: DMSwarmSetType(), DMSwarmSetCellDM(), DMSwarmType, DMSwarmInterpolateFields()
 @*/
 PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM dm,PetscInt nfields,const char *fieldnames[],Vec **fields,PetscBool reuse)
 {
@@ -519,6 +525,7 @@ PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM dm,PetscInt nfields,const ch
     vecs = *fields;
   }
 
+  ierr = PetscLogEventBegin(DMSWARM_ProjectFields,0,0,0,0);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject)celldm,DMDA,&isDA);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject)celldm,DMPLEX,&isPLEX);CHKERRQ(ierr);
   if (isDA) {
@@ -526,6 +533,7 @@ PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM dm,PetscInt nfields,const ch
   } else if (isPLEX) {
     ierr = private_DMSwarmProjectFields_PLEX(dm,celldm,project_type,nfields,gfield,vecs);CHKERRQ(ierr);
   } else SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Only supported for cell DMs of type DMDA and DMPLEX");
+  ierr = PetscLogEventEnd(DMSWARM_ProjectFields,0,0,0,0);CHKERRQ(ierr);
 
   ierr = PetscFree(gfield);CHKERRQ(ierr);
   if (!reuse) {
@@ -535,6 +543,66 @@ PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM dm,PetscInt nfields,const ch
   PetscFunctionReturn(0);
 }
 
+/*@C
+   DMSwarmInterpolateFields - Interpolate a set of fields defined on the cell DM onto the swarm points
+
+   Collective on dm
+
+   Input parameters:
++  dm - the DMSwarm
+.  nfields - the number of swarm fields to set
+.  fieldnames - the textual names of the swarm fields to set
+-  fields - an array of global Vec's of the cell DM, of length nfields
+
+   This is the counterpart of DMSwarmProjectFields(), using the same basis functions:
+     phi_p = \sum_i N_i(x_p) phi_i
+   where phi_i is the vertex value of the field and phi_p is the value stored in the swarm field at point p.
+
+   Level: beginner
+
+   Notes:
+   Only swarm fields registered with data type = PETSC_REAL and block size = 1 can be set.
+
+   As with DMSwarmProjectFields(), only the DA (Q1, 2D) and PLEX (triangles 2D) cell DMs are supported.
+
+   The cell data is read once per run of consecutive points in the same cell, so the interpolation is fastest when
+   the points are stored sorted by cell, see DMSwarmSetSortPointsByCell().
+
+.seealso: DMSwarmProjectFields(), DMSwarmSetType(), DMSwarmSetCellDM()
+@*/
+PETSC_EXTERN PetscErrorCode DMSwarmInterpolateFields(DM dm,PetscInt nfields,const char *fieldnames[],Vec fields[])
+{
+  DM_Swarm         *swarm = (DM_Swarm*)dm->data;
+  DMSwarmDataField *gfield;
+  DM               celldm;
+  PetscBool        isDA,isPLEX;
+  PetscInt         f;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  DMSWARMPICVALID(dm);
+  ierr = DMSwarmGetCellDM(dm,&celldm);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nfields,&gfield);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,fieldnames[f],&gfield[f]);CHKERRQ(ierr);
+    if (gfield[f]->petsc_type != PETSC_REAL) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Interpolation only valid for fields using a data type = PETSC_REAL");
+    if (gfield[f]->bs != 1) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Interpolation only valid for fields with block size = 1");
+  }
+
+  ierr = PetscLogEventBegin(DMSWARM_InterpolateFields,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMDA,&isDA);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMPLEX,&isPLEX);CHKERRQ(ierr);
+  if (isDA) {
+    ierr = private_DMSwarmInterpolateFields_DA(dm,celldm,nfields,gfield,fields);CHKERRQ(ierr);
+  } else if (isPLEX) {
+    ierr = private_DMSwarmInterpolateFields_PLEX(dm,celldm,nfields,gfield,fields);CHKERRQ(ierr);
+  } else SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Only supported for cell DMs of type DMDA and DMPLEX");
+  ierr = PetscLogEventEnd(DMSWARM_InterpolateFields,0,0,0,0);CHKERRQ(ierr);
+
+  ierr = PetscFree(gfield);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMSwarmCreatePointPerCellCount - Count the number of points within all cells in the cell DM
 
@@ -239,30 +239,35 @@ PetscErrorCode private_DMSwarmInsertPointsUsingCellDM_DA(DM dm,DM celldm,DMSwarm
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode DMSwarmProjectField_ApproxQ1_DA_2D(DM swarm,PetscReal *swarm_field,DM dm,Vec v_field)
+/*
+ All fields are projected in a single sweep over the points: the Q1 basis is evaluated once per point and shared by
+ all fields, and the contributions of consecutive points in the same cell are summed before being added to the cell
+ vertices. When the points are sorted by cell (see DMSwarmSetSortPointsByCell()) each cell is visited exactly once.
+*/
+static PetscErrorCode DMSwarmProjectFields_ApproxQ1_DA_2D(DM swarm,PetscInt nfields,PetscReal *swarm_fields[],DM dm,Vec v_fields[])
 {
-  PetscErrorCode ierr;
-  Vec v_field_l,denom_l,coor_l,denom;
-  PetscScalar *_field_l,*_denom_l;
-  PetscInt k,p,e,npoints,nel,npe;
-  PetscInt *mpfield_cell;
-  PetscReal *mpfield_coor;
-  const PetscInt *element_list;
-  const PetscInt *element;
-  PetscScalar xi_p[2],Ni[4];
+  PetscErrorCode    ierr;
+  Vec               *v_fields_l,denom_l,coor_l,denom;
+  PetscScalar       **_fields_l,*_denom_l,*elsum;
+  PetscInt          f,k,p,e,npoints,nel,npe;
+  PetscInt          *mpfield_cell;
+  PetscReal         *mpfield_coor;
+  const PetscInt    *element_list;
+  const PetscInt    *element;
   const PetscScalar *_coor;
 
   PetscFunctionBegin;
-  ierr = VecZeroEntries(v_field);CHKERRQ(ierr);
-
-  ierr = DMGetLocalVector(dm,&v_field_l);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nfields,&v_fields_l,nfields,&_fields_l,4*(nfields+1),&elsum);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = VecZeroEntries(v_fields[f]);CHKERRQ(ierr);
+    ierr = DMGetLocalVector(dm,&v_fields_l[f]);CHKERRQ(ierr);
+    ierr = VecZeroEntries(v_fields_l[f]);CHKERRQ(ierr);
+    ierr = VecGetArray(v_fields_l[f],&_fields_l[f]);CHKERRQ(ierr);
+  }
   ierr = DMGetGlobalVector(dm,&denom);CHKERRQ(ierr);
   ierr = DMGetLocalVector(dm,&denom_l);CHKERRQ(ierr);
-  ierr = VecZeroEntries(v_field_l);CHKERRQ(ierr);
   ierr = VecZeroEntries(denom);CHKERRQ(ierr);
   ierr = VecZeroEntries(denom_l);CHKERRQ(ierr);
-
-  ierr = VecGetArray(v_field_l,&_field_l);CHKERRQ(ierr);
   ierr = VecGetArray(denom_l,&_denom_l);CHKERRQ(ierr);
 
   ierr = DMGetCoordinatesLocal(dm,&coor_l);CHKERRQ(ierr);
@@ -273,35 +278,44 @@ PetscErrorCode DMSwarmProjectField_ApproxQ1_DA_2D(DM swarm,PetscReal *swarm_fiel
   ierr = DMSwarmGetField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&mpfield_coor);CHKERRQ(ierr);
   ierr = DMSwarmGetField(swarm,DMSwarmPICField_cellid,NULL,NULL,(void**)&mpfield_cell);CHKERRQ(ierr);
 
-  for (p=0; p<npoints; p++) {
-    PetscReal *coor_p;
+  for (p=0; p<npoints;) {
     const PetscScalar *x0;
     const PetscScalar *x2;
-    PetscScalar dx[2];
+    PetscReal         idx[2];
 
     e = mpfield_cell[p];
-    coor_p = &mpfield_coor[2*p];
     element = &element_list[npe*e];
 
     /* compute local coordinates: (xp-x0)/dx = (xip+1)/2 */
     x0 = &_coor[2*element[0]];
     x2 = &_coor[2*element[2]];
+    idx[0] = 2.0/PetscRealPart(x2[0] - x0[0]);
+    idx[1] = 2.0/PetscRealPart(x2[1] - x0[1]);
 
-    dx[0] = x2[0] - x0[0];
-    dx[1] = x2[1] - x0[1];
+    ierr = PetscArrayzero(elsum,4*(nfields+1));CHKERRQ(ierr);
+    for (; p<npoints && mpfield_cell[p] == e; p++) {
+      const PetscReal *coor_p = &mpfield_coor[2*p];
+      PetscReal       xi_p[2],Ni[4];
 
-    xi_p[0] = 2.0 * (coor_p[0] - x0[0])/dx[0] - 1.0;
-    xi_p[1] = 2.0 * (coor_p[1] - x0[1])/dx[1] - 1.0;
+      xi_p[0] = (coor_p[0] - PetscRealPart(x0[0]))*idx[0] - 1.0;
+      xi_p[1] = (coor_p[1] - PetscRealPart(x0[1]))*idx[1] - 1.0;
 
-    /* evaluate basis functions */
-    Ni[0] = 0.25*(1.0 - xi_p[0])*(1.0 - xi_p[1]);
-    Ni[1] = 0.25*(1.0 + xi_p[0])*(1.0 - xi_p[1]);
-    Ni[2] = 0.25*(1.0 + xi_p[0])*(1.0 + xi_p[1]);
-    Ni[3] = 0.25*(1.0 - xi_p[0])*(1.0 + xi_p[1]);
+      /* evaluate basis functions */
+      Ni[0] = 0.25*(1.0 - xi_p[0])*(1.0 - xi_p[1]);
+      Ni[1] = 0.25*(1.0 + xi_p[0])*(1.0 - xi_p[1]);
+      Ni[2] = 0.25*(1.0 + xi_p[0])*(1.0 + xi_p[1]);
+      Ni[3] = 0.25*(1.0 - xi_p[0])*(1.0 + xi_p[1]);
 
-    for (k=0; k<npe; k++) {
-      _field_l[ element[k] ] += Ni[k] * swarm_field[p];
-      _denom_l[ element[k] ] += Ni[k];
+      for (k=0; k<4; k++) elsum[k] += Ni[k];
+      for (f=0; f<nfields; f++) {
+        const PetscReal phi = swarm_fields[f][p];
+
+        for (k=0; k<4; k++) elsum[4*(f+1)+k] += Ni[k] * phi;
+      }
+    }
+    for (k=0; k<4; k++) _denom_l[element[k]] += elsum[k];
+    for (f=0; f<nfields; f++) {
+      for (k=0; k<4; k++) _fields_l[f][element[k]] += elsum[4*(f+1)+k];
     }
   }
 
@@ -309,20 +323,21 @@ PetscErrorCode DMSwarmProjectField_ApproxQ1_DA_2D(DM swarm,PetscReal *swarm_fiel
   ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&mpfield_coor);CHKERRQ(ierr);
   ierr = DMDARestoreElements(dm,&nel,&npe,&element_list);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(coor_l,&_coor);CHKERRQ(ierr);
-  ierr = VecRestoreArray(v_field_l,&_field_l);CHKERRQ(ierr);
   ierr = VecRestoreArray(denom_l,&_denom_l);CHKERRQ(ierr);
 
-  ierr = DMLocalToGlobalBegin(dm,v_field_l,ADD_VALUES,v_field);CHKERRQ(ierr);
-  ierr = DMLocalToGlobalEnd(dm,v_field_l,ADD_VALUES,v_field);CHKERRQ(ierr);
   ierr = DMLocalToGlobalBegin(dm,denom_l,ADD_VALUES,denom);CHKERRQ(ierr);
   ierr = DMLocalToGlobalEnd(dm,denom_l,ADD_VALUES,denom);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = VecRestoreArray(v_fields_l[f],&_fields_l[f]);CHKERRQ(ierr);
+    ierr = DMLocalToGlobalBegin(dm,v_fields_l[f],ADD_VALUES,v_fields[f]);CHKERRQ(ierr);
+    ierr = DMLocalToGlobalEnd(dm,v_fields_l[f],ADD_VALUES,v_fields[f]);CHKERRQ(ierr);
+    ierr = VecPointwiseDivide(v_fields[f],v_fields[f],denom);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&v_fields_l[f]);CHKERRQ(ierr);
+  }
 
-  ierr = VecPointwiseDivide(v_field,v_field,denom);CHKERRQ(ierr);
-
-  ierr = DMRestoreLocalVector(dm,&v_field_l);CHKERRQ(ierr);
   ierr = DMRestoreLocalVector(dm,&denom_l);CHKERRQ(ierr);
   ierr = DMRestoreGlobalVector(dm,&denom);CHKERRQ(ierr);
-
+  ierr = PetscFree3(v_fields_l,_fields_l,elsum);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -330,6 +345,7 @@ PetscErrorCode private_DMSwarmProjectFields_DA(DM swarm,DM celldm,PetscInt proje
 {
   PetscErrorCode ierr;
   PetscInt f,dim;
+  PetscReal **swarm_fields;
   DMDAElementType etype;
 
   PetscFunctionBegin;
@@ -339,12 +355,121 @@ PetscErrorCode private_DMSwarmProjectFields_DA(DM swarm,DM celldm,PetscInt proje
   ierr = DMGetDimension(swarm,&dim);CHKERRQ(ierr);
   switch (dim) {
     case 2:
+      ierr = PetscMalloc1(nfields,&swarm_fields);CHKERRQ(ierr);
       for (f=0; f<nfields; f++) {
-        PetscReal *swarm_field;
+        ierr = DMSwarmDataFieldGetEntries(dfield[f],(void**)&swarm_fields[f]);CHKERRQ(ierr);
+      }
+      ierr = DMSwarmProjectFields_ApproxQ1_DA_2D(swarm,nfields,swarm_fields,celldm,vecs);CHKERRQ(ierr);
+      ierr = PetscFree(swarm_fields);CHKERRQ(ierr);
+      break;
+    case 3:
+      SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"No support for 3D");
+    default:
+      break;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+ Evaluates the Q1 interpolant of each vertex field at the points, loading the element values once per run of
+ consecutive points in the same cell.
+*/
+static PetscErrorCode DMSwarmInterpolateFields_Q1_DA_2D(DM swarm,PetscInt nfields,PetscReal *swarm_fields[],DM dm,Vec v_fields[])
+{
+  PetscErrorCode    ierr;
+  Vec               *v_fields_l,coor_l;
+  const PetscScalar **_fields_l,*_coor;
+  PetscScalar       *elval;
+  PetscInt          f,k,p,e,npoints,nel,npe;
+  PetscInt          *mpfield_cell;
+  PetscReal         *mpfield_coor;
+  const PetscInt    *element_list;
+  const PetscInt    *element;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc3(nfields,&v_fields_l,nfields,&_fields_l,4*nfields,&elval);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = DMGetLocalVector(dm,&v_fields_l[f]);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(dm,v_fields[f],INSERT_VALUES,v_fields_l[f]);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalEnd(dm,v_fields[f],INSERT_VALUES,v_fields_l[f]);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(v_fields_l[f],&_fields_l[f]);CHKERRQ(ierr);
+  }
+  ierr = DMGetCoordinatesLocal(dm,&coor_l);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coor_l,&_coor);CHKERRQ(ierr);
+
+  ierr = DMDAGetElements(dm,&nel,&npe,&element_list);CHKERRQ(ierr);
+  ierr = DMSwarmGetLocalSize(swarm,&npoints);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&mpfield_coor);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(swarm,DMSwarmPICField_cellid,NULL,NULL,(void**)&mpfield_cell);CHKERRQ(ierr);
+
+  for (p=0; p<npoints;) {
+    const PetscScalar *x0;
+    const PetscScalar *x2;
+    PetscReal         idx[2];
 
-        ierr = DMSwarmDataFieldGetEntries(dfield[f],(void**)&swarm_field);CHKERRQ(ierr);
-        ierr = DMSwarmProjectField_ApproxQ1_DA_2D(swarm,swarm_field,celldm,vecs[f]);CHKERRQ(ierr);
+    e = mpfield_cell[p];
+    element = &element_list[npe*e];
+    x0 = &_coor[2*element[0]];
+    x2 = &_coor[2*element[2]];
+    idx[0] = 2.0/PetscRealPart(x2[0] - x0[0]);
+    idx[1] = 2.0/PetscRealPart(x2[1] - x0[1]);
+    for (f=0; f<nfields; f++) {
+      for (k=0; k<4; k++) elval[4*f+k] = _fields_l[f][element[k]];
+    }
+
+    for (; p<npoints && mpfield_cell[p] == e; p++) {
+      const PetscReal *coor_p = &mpfield_coor[2*p];
+      PetscReal       xi_p[2],Ni[4];
+
+      xi_p[0] = (coor_p[0] - PetscRealPart(x0[0]))*idx[0] - 1.0;
+      xi_p[1] = (coor_p[1] - PetscRealPart(x0[1]))*idx[1] - 1.0;
+
+      Ni[0] = 0.25*(1.0 - xi_p[0])*(1.0 - xi_p[1]);
+      Ni[1] = 0.25*(1.0 + xi_p[0])*(1.0 - xi_p[1]);
+      Ni[2] = 0.25*(1.0 + xi_p[0])*(1.0 + xi_p[1]);
+      Ni[3] = 0.25*(1.0 - xi_p[0])*(1.0 + xi_p[1]);
+
+      for (f=0; f<nfields; f++) {
+        PetscScalar phi = 0.0;
+
+        for (k=0; k<4; k++) phi += Ni[k] * elval[4*f+k];
+        swarm_fields[f][p] = PetscRealPart(phi);
+      }
+    }
+  }
+
+  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_cellid,NULL,NULL,(void**)&mpfield_cell);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&mpfield_coor);CHKERRQ(ierr);
+  ierr = DMDARestoreElements(dm,&nel,&npe,&element_list);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coor_l,&_coor);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = VecRestoreArrayRead(v_fields_l[f],&_fields_l[f]);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&v_fields_l[f]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(v_fields_l,_fields_l,elval);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode private_DMSwarmInterpolateFields_DA(DM swarm,DM celldm,PetscInt nfields,DMSwarmDataField dfield[],Vec vecs[])
+{
+  PetscErrorCode ierr;
+  PetscInt f,dim;
+  PetscReal **swarm_fields;
+  DMDAElementType etype;
+
+  PetscFunctionBegin;
+  ierr = DMDAGetElementType(celldm,&etype);CHKERRQ(ierr);
+  if (etype == DMDA_ELEMENT_P1) SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"Only Q1 DMDA supported");
+
+  ierr = DMGetDimension(swarm,&dim);CHKERRQ(ierr);
+  switch (dim) {
+    case 2:
+      ierr = PetscMalloc1(nfields,&swarm_fields);CHKERRQ(ierr);
+      for (f=0; f<nfields; f++) {
+        ierr = DMSwarmDataFieldGetEntries(dfield[f],(void**)&swarm_fields[f]);CHKERRQ(ierr);
       }
+      ierr = DMSwarmInterpolateFields_Q1_DA_2D(swarm,nfields,swarm_fields,celldm,vecs);CHKERRQ(ierr);
+      ierr = PetscFree(swarm_fields);CHKERRQ(ierr);
       break;
     case 3:
       SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"No support for 3D");
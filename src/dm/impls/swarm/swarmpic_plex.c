@@ -454,60 +454,59 @@ static PetscErrorCode _ComputeLocalCoordinateAffine2d(PetscReal xp[],PetscReal c
 }
 */
 
-static PetscErrorCode ComputeLocalCoordinateAffine2d(PetscReal xp[],PetscScalar coords[],PetscReal xip[],PetscReal *dJ)
+/*
+ Computes the inverse of the affine map from the reference triangle (0,0),(1,0),(0,1) to the cell with vertex coordinates
+ coords[], so that the reference coordinates of x are xi = inv (x - x0)
+*/
+static PetscErrorCode ComputeAffineInverse2d(const PetscScalar coords[],PetscReal x0[],PetscReal inv[],PetscReal *dJ)
 {
-  PetscReal x1,y1,x2,y2,x3,y3;
-  PetscReal b[2],A[2][2],inv[2][2],detJ,od;
+  PetscReal A[2][2],detJ,od;
 
   PetscFunctionBegin;
-  x1 = PetscRealPart(coords[2*0+0]);
-  x2 = PetscRealPart(coords[2*1+0]);
-  x3 = PetscRealPart(coords[2*2+0]);
-
-  y1 = PetscRealPart(coords[2*0+1]);
-  y2 = PetscRealPart(coords[2*1+1]);
-  y3 = PetscRealPart(coords[2*2+1]);
+  x0[0] = PetscRealPart(coords[2*0+0]);
+  x0[1] = PetscRealPart(coords[2*0+1]);
 
-  b[0] = xp[0] - x1;
-  b[1] = xp[1] - y1;
-
-  A[0][0] = x2-x1;   A[0][1] = x3-x1;
-  A[1][0] = y2-y1;   A[1][1] = y3-y1;
+  A[0][0] = PetscRealPart(coords[2*1+0]) - x0[0];   A[0][1] = PetscRealPart(coords[2*2+0]) - x0[0];
+  A[1][0] = PetscRealPart(coords[2*1+1]) - x0[1];   A[1][1] = PetscRealPart(coords[2*2+1]) - x0[1];
 
   detJ = A[0][0]*A[1][1] - A[0][1]*A[1][0];
   *dJ = PetscAbsReal(detJ);
   od = 1.0/detJ;
 
-  inv[0][0] =  A[1][1] * od;
-  inv[0][1] = -A[0][1] * od;
-  inv[1][0] = -A[1][0] * od;
-  inv[1][1] =  A[0][0] * od;
-
-  xip[0] = inv[0][0]*b[0] + inv[0][1]*b[1];
-  xip[1] = inv[1][0]*b[0] + inv[1][1]*b[1];
+  inv[0] =  A[1][1] * od;
+  inv[1] = -A[0][1] * od;
+  inv[2] = -A[1][0] * od;
+  inv[3] =  A[0][0] * od;
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode DMSwarmProjectField_ApproxP1_PLEX_2D(DM swarm,PetscReal *swarm_field,DM dm,Vec v_field)
+/*
+ All fields are projected in a single sweep over the points. The cell geometry is set up once per run of consecutive
+ points in the same cell, the P1 basis is evaluated once per point and shared by all fields, and the contributions of
+ the run are summed before being added to the cell closure. When the points are sorted by cell
+ (see DMSwarmSetSortPointsByCell()) each cell is visited exactly once.
+*/
+static PetscErrorCode DMSwarmProjectFields_ApproxP1_PLEX_2D(DM swarm,PetscInt nfields,PetscReal *swarm_fields[],DM dm,Vec v_fields[])
 {
-  PetscErrorCode ierr;
+  PetscErrorCode  ierr;
   const PetscReal PLEX_C_EPS = 1.0e-8;
-  Vec v_field_l,denom_l,coor_l,denom;
-  PetscInt k,p,e,npoints;
-  PetscInt *mpfield_cell;
-  PetscReal *mpfield_coor;
-  PetscReal xi_p[2];
-  PetscScalar Ni[3];
-  PetscSection coordSection;
-  PetscScalar *elcoor = NULL;
+  Vec             *v_fields_l,denom_l,coor_l,denom;
+  PetscInt        f,k,p,e,npoints;
+  PetscInt        *mpfield_cell;
+  PetscReal       *mpfield_coor;
+  PetscScalar     *elsum;
+  PetscSection    coordSection;
+  PetscScalar     *elcoor = NULL;
 
   PetscFunctionBegin;
-  ierr = VecZeroEntries(v_field);CHKERRQ(ierr);
-
-  ierr = DMGetLocalVector(dm,&v_field_l);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nfields,&v_fields_l,3*(nfields+1),&elsum);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = VecZeroEntries(v_fields[f]);CHKERRQ(ierr);
+    ierr = DMGetLocalVector(dm,&v_fields_l[f]);CHKERRQ(ierr);
+    ierr = VecZeroEntries(v_fields_l[f]);CHKERRQ(ierr);
+  }
   ierr = DMGetGlobalVector(dm,&denom);CHKERRQ(ierr);
   ierr = DMGetLocalVector(dm,&denom_l);CHKERRQ(ierr);
-  ierr = VecZeroEntries(v_field_l);CHKERRQ(ierr);
   ierr = VecZeroEntries(denom);CHKERRQ(ierr);
   ierr = VecZeroEntries(denom_l);CHKERRQ(ierr);
 
@@ -518,140 +517,200 @@ PetscErrorCode DMSwarmProjectField_ApproxP1_PLEX_2D(DM swarm,PetscReal *swarm_fi
   ierr = DMSwarmGetField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&mpfield_coor);CHKERRQ(ierr);
   ierr = DMSwarmGetField(swarm,DMSwarmPICField_cellid,NULL,NULL,(void**)&mpfield_cell);CHKERRQ(ierr);
 
-  for (p=0; p<npoints; p++) {
-    PetscReal   *coor_p,dJ;
-    PetscScalar elfield[3];
-    PetscBool   point_located;
-
-    e       = mpfield_cell[p];
-    coor_p  = &mpfield_coor[2*p];
+  for (p=0; p<npoints;) {
+    PetscReal x0[2],inv[4],dJ;
 
+    e = mpfield_cell[p];
     ierr = DMPlexVecGetClosure(dm,coordSection,coor_l,e,NULL,&elcoor);CHKERRQ(ierr);
+    ierr = ComputeAffineInverse2d(elcoor,x0,inv,&dJ);CHKERRQ(ierr);
+    ierr = PetscArrayzero(elsum,3*(nfields+1));CHKERRQ(ierr);
+
+    for (; p<npoints && mpfield_cell[p] == e; p++) {
+      const PetscReal *coor_p = &mpfield_coor[2*p];
+      PetscReal       b[2],xi_p[2],Ni[3];
+      PetscBool       point_located;
+
+      b[0] = coor_p[0] - x0[0];
+      b[1] = coor_p[1] - x0[1];
+      xi_p[0] = inv[0]*b[0] + inv[1]*b[1];
+      xi_p[1] = inv[2]*b[0] + inv[3]*b[1];
+
+      Ni[0] = 1.0 - xi_p[0] - xi_p[1];
+      Ni[1] = xi_p[0];
+      Ni[2] = xi_p[1];
+
+      point_located = PETSC_TRUE;
+      for (k=0; k<3; k++) {
+        if (Ni[k] < -PLEX_C_EPS) point_located = PETSC_FALSE;
+        if (Ni[k] > (1.0+PLEX_C_EPS)) point_located = PETSC_FALSE;
+      }
+      if (!point_located){
+        ierr = PetscPrintf(PETSC_COMM_SELF,"[Error] xi,eta = %+1.8e, %+1.8e\n",(double)xi_p[0],(double)xi_p[1]);CHKERRQ(ierr);
+        ierr = PetscPrintf(PETSC_COMM_SELF,"[Error] Failed to locate point (%1.8e,%1.8e) in local mesh (cell %D) with triangle coords (%1.8e,%1.8e) : (%1.8e,%1.8e) : (%1.8e,%1.8e)\n",(double)coor_p[0],(double)coor_p[1],e,(double)PetscRealPart(elcoor[0]),(double)PetscRealPart(elcoor[1]),(double)PetscRealPart(elcoor[2]),(double)PetscRealPart(elcoor[3]),(double)PetscRealPart(elcoor[4]),(double)PetscRealPart(elcoor[5]));CHKERRQ(ierr);
+        SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_SUP,"Failed to locate point (%1.8e,%1.8e) in local mesh (cell %D)\n",(double)coor_p[0],(double)coor_p[1],e);
+      }
 
-/*
-    while (!point_located && (failed_counter < 25)) {
-      ierr = PointInTriangle(point, coords[0], coords[1], coords[2], &point_located);CHKERRQ(ierr);
-      point.x = coor_p[0];
-      point.y = coor_p[1];
-      point.x += 1.0e-10 * (2.0 * rand()/((double)RAND_MAX)-1.0);
-      point.y += 1.0e-10 * (2.0 * rand()/((double)RAND_MAX)-1.0);
-      failed_counter++;
+      for (k=0; k<3; k++) {
+        Ni[k] = Ni[k] * dJ;
+        elsum[k] += Ni[k];
+      }
+      for (f=0; f<nfields; f++) {
+        const PetscReal phi = swarm_fields[f][p];
+
+        for (k=0; k<3; k++) elsum[3*(f+1)+k] += Ni[k] * phi;
+      }
     }
+    ierr = DMPlexVecRestoreClosure(dm,coordSection,coor_l,e,NULL,&elcoor);CHKERRQ(ierr);
 
-    if (!point_located){
-        PetscPrintf(PETSC_COMM_SELF,"Failed to locate point (%1.8e,%1.8e) in local mesh (cell %D) with triangle coords (%1.8e,%1.8e) : (%1.8e,%1.8e) : (%1.8e,%1.8e) in %D iterations\n",point.x,point.y,e,coords[0].x,coords[0].y,coords[1].x,coords[1].y,coords[2].x,coords[2].y,failed_counter);
+    ierr = DMPlexVecSetClosure(dm,NULL,denom_l,e,elsum,ADD_VALUES);CHKERRQ(ierr);
+    for (f=0; f<nfields; f++) {
+      ierr = DMPlexVecSetClosure(dm,NULL,v_fields_l[f],e,&elsum[3*(f+1)],ADD_VALUES);CHKERRQ(ierr);
     }
+  }
 
-    if (!point_located) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_SUP,"Failed to locate point (%1.8e,%1.8e) in local mesh (cell %D)\n",point.x,point.y,e);
-    else {
-      ierr = _ComputeLocalCoordinateAffine2d(coor_p,elcoor,xi_p,&dJ);CHKERRQ(ierr);
-      xi_p[0] = 0.5*(xi_p[0] + 1.0);
-      xi_p[1] = 0.5*(xi_p[1] + 1.0);
+  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_cellid,NULL,NULL,(void**)&mpfield_cell);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&mpfield_coor);CHKERRQ(ierr);
 
-      PetscPrintf(PETSC_COMM_SELF,"[p=%D] x(%+1.4e,%+1.4e) -> mapped to element %D xi(%+1.4e,%+1.4e)\n",p,point.x,point.y,e,xi_p[0],xi_p[1]);
+  ierr = DMLocalToGlobalBegin(dm,denom_l,ADD_VALUES,denom);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm,denom_l,ADD_VALUES,denom);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = DMLocalToGlobalBegin(dm,v_fields_l[f],ADD_VALUES,v_fields[f]);CHKERRQ(ierr);
+    ierr = DMLocalToGlobalEnd(dm,v_fields_l[f],ADD_VALUES,v_fields[f]);CHKERRQ(ierr);
+    ierr = VecPointwiseDivide(v_fields[f],v_fields[f],denom);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&v_fields_l[f]);CHKERRQ(ierr);
+  }
 
-    }
-*/
+  ierr = DMRestoreLocalVector(dm,&denom_l);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm,&denom);CHKERRQ(ierr);
+  ierr = PetscFree2(v_fields_l,elsum);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 
-    ierr = ComputeLocalCoordinateAffine2d(coor_p,elcoor,xi_p,&dJ);CHKERRQ(ierr);
-    /*
-    PetscPrintf(PETSC_COMM_SELF,"[p=%D] x(%+1.4e,%+1.4e) -> mapped to element %D xi(%+1.4e,%+1.4e)\n",p,point.x,point.y,e,xi_p[0],xi_p[1]);
-    */
-    /*
-     point_located = PETSC_TRUE;
-    if (xi_p[0] < 0.0) {
-      if (xi_p[0] > -PLEX_C_EPS) {
-        xi_p[0] = 0.0;
-      } else {
-        point_located = PETSC_FALSE;
-      }
-    }
-    if (xi_p[1] < 0.0) {
-      if (xi_p[1] > -PLEX_C_EPS) {
-        xi_p[1] = 0.0;
-      } else {
-        point_located = PETSC_FALSE;
-      }
-    }
-    if (xi_p[1] > (1.0-xi_p[0])) {
-      if ((xi_p[1] - 1.0 + xi_p[0]) < PLEX_C_EPS) {
-        xi_p[1] = 1.0 - xi_p[0];
-      } else {
-        point_located = PETSC_FALSE;
+PetscErrorCode private_DMSwarmProjectFields_PLEX(DM swarm,DM celldm,PetscInt project_type,PetscInt nfields,DMSwarmDataField dfield[],Vec vecs[])
+{
+  PetscErrorCode ierr;
+  PetscInt f,dim;
+  PetscReal **swarm_fields;
+
+  PetscFunctionBegin;
+  ierr = DMGetDimension(swarm,&dim);CHKERRQ(ierr);
+  switch (dim) {
+    case 2:
+      ierr = PetscMalloc1(nfields,&swarm_fields);CHKERRQ(ierr);
+      for (f=0; f<nfields; f++) {
+        ierr = DMSwarmDataFieldGetEntries(dfield[f],(void**)&swarm_fields[f]);CHKERRQ(ierr);
       }
-    }
-    if (!point_located){
-      PetscPrintf(PETSC_COMM_SELF,"[Error] xi,eta = %+1.8e, %+1.8e\n",xi_p[0],xi_p[1]);
-      PetscPrintf(PETSC_COMM_SELF,"[Error] Failed to locate point (%1.8e,%1.8e) in local mesh (cell %D) with triangle coords (%1.8e,%1.8e) : (%1.8e,%1.8e) : (%1.8e,%1.8e)\n",coor_p[0],coor_p[1],e,elcoor[0],elcoor[1],elcoor[2],elcoor[3],elcoor[4],elcoor[5]);
-    }
-    if (!point_located) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_SUP,"Failed to locate point (%1.8e,%1.8e) in local mesh (cell %D)\n",coor_p[0],coor_p[1],e);
-    */
+      ierr = DMSwarmProjectFields_ApproxP1_PLEX_2D(swarm,nfields,swarm_fields,celldm,vecs);CHKERRQ(ierr);
+      ierr = PetscFree(swarm_fields);CHKERRQ(ierr);
+      break;
+    case 3:
+      SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"No support for 3D");
+    default:
+      break;
+  }
 
-    Ni[0] = 1.0 - xi_p[0] - xi_p[1];
-    Ni[1] = xi_p[0];
-    Ni[2] = xi_p[1];
+  PetscFunctionReturn(0);
+}
 
-    point_located = PETSC_TRUE;
-    for (k=0; k<3; k++) {
-      if (PetscRealPart(Ni[k]) < -PLEX_C_EPS) point_located = PETSC_FALSE;
-      if (PetscRealPart(Ni[k]) > (1.0+PLEX_C_EPS)) point_located = PETSC_FALSE;
-    }
-    if (!point_located){
-      ierr = PetscPrintf(PETSC_COMM_SELF,"[Error] xi,eta = %+1.8e, %+1.8e\n",(double)xi_p[0],(double)xi_p[1]);CHKERRQ(ierr);
-      ierr = PetscPrintf(PETSC_COMM_SELF,"[Error] Failed to locate point (%1.8e,%1.8e) in local mesh (cell %D) with triangle coords (%1.8e,%1.8e) : (%1.8e,%1.8e) : (%1.8e,%1.8e)\n",(double)coor_p[0],(double)coor_p[1],e,(double)PetscRealPart(elcoor[0]),(double)PetscRealPart(elcoor[1]),(double)PetscRealPart(elcoor[2]),(double)PetscRealPart(elcoor[3]),(double)PetscRealPart(elcoor[4]),(double)PetscRealPart(elcoor[5]));CHKERRQ(ierr);
-    }
-    if (!point_located) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_SUP,"Failed to locate point (%1.8e,%1.8e) in local mesh (cell %D)\n",(double)coor_p[0],(double)coor_p[1],e);
+/*
+ Evaluates the P1 interpolant of each vertex field at the points, reading the cell closures once per run of
+ consecutive points in the same cell.
+*/
+static PetscErrorCode DMSwarmInterpolateFields_P1_PLEX_2D(DM swarm,PetscInt nfields,PetscReal *swarm_fields[],DM dm,Vec v_fields[])
+{
+  PetscErrorCode  ierr;
+  Vec             *v_fields_l,coor_l;
+  PetscInt        f,k,p,e,npoints;
+  PetscInt        *mpfield_cell;
+  PetscReal       *mpfield_coor;
+  PetscScalar     *elval;
+  PetscSection    coordSection;
+  PetscScalar     *elcoor = NULL;
 
-    for (k=0; k<3; k++) {
-      Ni[k] = Ni[k] * dJ;
-      elfield[k] = Ni[k] * swarm_field[p];
-    }
+  PetscFunctionBegin;
+  ierr = PetscMalloc2(nfields,&v_fields_l,3*nfields,&elval);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = DMGetLocalVector(dm,&v_fields_l[f]);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(dm,v_fields[f],INSERT_VALUES,v_fields_l[f]);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalEnd(dm,v_fields[f],INSERT_VALUES,v_fields_l[f]);CHKERRQ(ierr);
+  }
+  ierr = DMGetCoordinatesLocal(dm,&coor_l);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm,&coordSection);CHKERRQ(ierr);
 
+  ierr = DMSwarmGetLocalSize(swarm,&npoints);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&mpfield_coor);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(swarm,DMSwarmPICField_cellid,NULL,NULL,(void**)&mpfield_cell);CHKERRQ(ierr);
+
+  for (p=0; p<npoints;) {
+    PetscReal x0[2],inv[4],dJ;
+
+    e = mpfield_cell[p];
+    ierr = DMPlexVecGetClosure(dm,coordSection,coor_l,e,NULL,&elcoor);CHKERRQ(ierr);
+    ierr = ComputeAffineInverse2d(elcoor,x0,inv,&dJ);CHKERRQ(ierr);
     ierr = DMPlexVecRestoreClosure(dm,coordSection,coor_l,e,NULL,&elcoor);CHKERRQ(ierr);
+    for (f=0; f<nfields; f++) {
+      PetscScalar *clval = NULL;
+      PetscInt    csize;
+
+      ierr = DMPlexVecGetClosure(dm,NULL,v_fields_l[f],e,&csize,&clval);CHKERRQ(ierr);
+      if (csize != 3) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Cell closure of size %D, only scalar P1 fields on triangles are supported",csize);
+      for (k=0; k<3; k++) elval[3*f+k] = clval[k];
+      ierr = DMPlexVecRestoreClosure(dm,NULL,v_fields_l[f],e,&csize,&clval);CHKERRQ(ierr);
+    }
 
-    ierr = DMPlexVecSetClosure(dm, NULL,v_field_l, e, elfield, ADD_VALUES);CHKERRQ(ierr);
-    ierr = DMPlexVecSetClosure(dm, NULL,denom_l, e, Ni, ADD_VALUES);CHKERRQ(ierr);
-  }
+    for (; p<npoints && mpfield_cell[p] == e; p++) {
+      const PetscReal *coor_p = &mpfield_coor[2*p];
+      PetscReal       b[2],xi_p[2],Ni[3];
 
-  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_cellid,NULL,NULL,(void**)&mpfield_cell);CHKERRQ(ierr);
-  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&mpfield_coor);CHKERRQ(ierr);
+      b[0] = coor_p[0] - x0[0];
+      b[1] = coor_p[1] - x0[1];
+      xi_p[0] = inv[0]*b[0] + inv[1]*b[1];
+      xi_p[1] = inv[2]*b[0] + inv[3]*b[1];
 
-  ierr = DMLocalToGlobalBegin(dm,v_field_l,ADD_VALUES,v_field);CHKERRQ(ierr);
-  ierr = DMLocalToGlobalEnd(dm,v_field_l,ADD_VALUES,v_field);CHKERRQ(ierr);
-  ierr = DMLocalToGlobalBegin(dm,denom_l,ADD_VALUES,denom);CHKERRQ(ierr);
-  ierr = DMLocalToGlobalEnd(dm,denom_l,ADD_VALUES,denom);CHKERRQ(ierr);
+      Ni[0] = 1.0 - xi_p[0] - xi_p[1];
+      Ni[1] = xi_p[0];
+      Ni[2] = xi_p[1];
 
-  ierr = VecPointwiseDivide(v_field,v_field,denom);CHKERRQ(ierr);
+      for (f=0; f<nfields; f++) {
+        PetscScalar phi = 0.0;
 
-  ierr = DMRestoreLocalVector(dm,&v_field_l);CHKERRQ(ierr);
-  ierr = DMRestoreLocalVector(dm,&denom_l);CHKERRQ(ierr);
-  ierr = DMRestoreGlobalVector(dm,&denom);CHKERRQ(ierr);
+        for (k=0; k<3; k++) phi += Ni[k] * elval[3*f+k];
+        swarm_fields[f][p] = PetscRealPart(phi);
+      }
+    }
+  }
 
+  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_cellid,NULL,NULL,(void**)&mpfield_cell);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&mpfield_coor);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = DMRestoreLocalVector(dm,&v_fields_l[f]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(v_fields_l,elval);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode private_DMSwarmProjectFields_PLEX(DM swarm,DM celldm,PetscInt project_type,PetscInt nfields,DMSwarmDataField dfield[],Vec vecs[])
+PetscErrorCode private_DMSwarmInterpolateFields_PLEX(DM swarm,DM celldm,PetscInt nfields,DMSwarmDataField dfield[],Vec vecs[])
 {
   PetscErrorCode ierr;
   PetscInt f,dim;
+  PetscReal **swarm_fields;
 
   PetscFunctionBegin;
   ierr = DMGetDimension(swarm,&dim);CHKERRQ(ierr);
   switch (dim) {
     case 2:
+      ierr = PetscMalloc1(nfields,&swarm_fields);CHKERRQ(ierr);
       for (f=0; f<nfields; f++) {
-        PetscReal *swarm_field;
-
-        ierr = DMSwarmDataFieldGetEntries(dfield[f],(void**)&swarm_field);CHKERRQ(ierr);
-        ierr = DMSwarmProjectField_ApproxP1_PLEX_2D(swarm,swarm_field,celldm,vecs[f]);CHKERRQ(ierr);
+        ierr = DMSwarmDataFieldGetEntries(dfield[f],(void**)&swarm_fields[f]);CHKERRQ(ierr);
       }
+      ierr = DMSwarmInterpolateFields_P1_PLEX_2D(swarm,nfields,swarm_fields,celldm,vecs);CHKERRQ(ierr);
+      ierr = PetscFree(swarm_fields);CHKERRQ(ierr);
       break;
     case 3:
       SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"No support for 3D");
     default:
       break;
   }
-
   PetscFunctionReturn(0);
 }
 
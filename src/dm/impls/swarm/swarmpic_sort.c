@@ -3,6 +3,7 @@
 #include <petscdmplex.h>
 #include <petscdmswarm.h>
 #include <petsc/private/dmswarmimpl.h>
+#include "../src/dm/impls/swarm/data_bucket.h"
 
 int sort_CompareSwarmPoint(const void *dataA,const void *dataB)
 {
@@ -79,7 +80,13 @@ PetscErrorCode DMSwarmSortSetup(DMSwarmSort ctx,DM dm,PetscInt ncells)
   }
   ierr = DMSwarmRestoreField(dm,DMSwarmPICField_cellid,NULL,NULL,(void**)&swarm_cellid);CHKERRQ(ierr);
 
-  ierr = DMSwarmSortApplyCellIndexSort(ctx);CHKERRQ(ierr);
+  /* the list is already ordered if the points are stored sorted by cell, see DMSwarmSetSortPointsByCell() */
+  for (p=1; p<ctx->npoints; p++) {
+    if (ctx->list[p-1].cell_index > ctx->list[p].cell_index) break;
+  }
+  if (p < ctx->npoints) {
+    ierr = DMSwarmSortApplyCellIndexSort(ctx);CHKERRQ(ierr);
+  }
 
   /* sum points per cell */
   for (p=0; p<ctx->npoints; p++) {
@@ -223,7 +230,8 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM dm,PetscInt e,PetscIn
    between calls to DMSwarmSortGetAccess() and DMSwarmSortRestoreAccess().
 
    To facilitate safe removal of points using the sort context, we suggest a "two pass" strategy in which the
-   first pass "marks" points for removal, and the second pass actually removes the points from the DMSwarm.
+   first pass "marks" points for removal, and the second pass actually removes the points from the DMSwarm,
+   preferably with a single call to DMSwarmRemovePoints().
 
    Notes:
    - You must call DMSwarmSortGetAccess() before you can call DMSwarmSortGetPointsPerCell() or DMSwarmSortGetNumberOfPointsPerCell()
@@ -365,3 +373,125 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetSizes(DM dm,PetscInt *ncells,PetscInt
   if (npoints) { *npoints = swarm->sort_context->npoints; }
   PetscFunctionReturn(0);
 }
+
+/*@
+   DMSwarmSortPointsByCell - Reorders the local points of a DMSwarm so that they are stored in increasing cell order
+
+   Not collective
+
+   Input parameter:
+.  dm - a DMSwarm object of type DMSWARM_PIC
+
+   Notes:
+   All registered fields are permuted, so that after this call the points within each cell are contiguous in memory.
+   The sort is incremental: the longest prefix of points already in cell order is kept, only the remaining points
+   are sorted, and the two sequences are merged. After a migration this means only the received points are sorted.
+
+   Any point sort context obtained with DMSwarmSortGetAccess() refers to the previous ordering and must be rebuilt.
+
+   Level: advanced
+
+.seealso: DMSwarmSetSortPointsByCell(), DMSwarmSortGetAccess(), DMSwarmMigrate()
+@*/
+PetscErrorCode DMSwarmSortPointsByCell(DM dm)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscInt       *swarm_cellid,*tcell,*tidx,*perm;
+  PetscInt       p,i,j,npoints,nsorted,ntail;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  if (swarm->swarm_type != DMSWARM_PIC) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Sorting points by cell is only supported for DMSWARM_PIC");
+  ierr = DMSwarmGetLocalSize(dm,&npoints);CHKERRQ(ierr);
+  if (npoints < 2) PetscFunctionReturn(0);
+  ierr = DMSwarmGetField(dm,DMSwarmPICField_cellid,NULL,NULL,(void**)&swarm_cellid);CHKERRQ(ierr);
+  for (nsorted=1; nsorted<npoints; nsorted++) {
+    if (swarm_cellid[nsorted-1] > swarm_cellid[nsorted]) break;
+  }
+  if (nsorted == npoints) {
+    ierr = DMSwarmRestoreField(dm,DMSwarmPICField_cellid,NULL,NULL,(void**)&swarm_cellid);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscLogEventBegin(DMSWARM_Sort,0,0,0,0);CHKERRQ(ierr);
+  ntail = npoints - nsorted;
+  ierr = PetscMalloc3(ntail,&tcell,ntail,&tidx,npoints,&perm);CHKERRQ(ierr);
+  for (p=0; p<ntail; p++) {
+    tcell[p] = swarm_cellid[nsorted+p];
+    tidx[p]  = nsorted+p;
+  }
+  ierr = PetscSortIntWithArray(ntail,tcell,tidx);CHKERRQ(ierr);
+  /* merge the sorted prefix with the sorted tail */
+  for (p=0, i=0, j=0; p<npoints; p++) {
+    if (j == ntail || (i < nsorted && swarm_cellid[i] <= tcell[j])) perm[p] = i++;
+    else                                                            perm[p] = tidx[j++];
+  }
+  ierr = DMSwarmRestoreField(dm,DMSwarmPICField_cellid,NULL,NULL,(void**)&swarm_cellid);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketPermutePoints(swarm->db,perm);CHKERRQ(ierr);
+  ierr = PetscFree3(tcell,tidx,perm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMSWARM_Sort,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMSwarmSetSortPointsByCell - Sets whether the local points of a DMSwarm are kept stored in increasing cell order
+
+   Logically collective on dm
+
+   Input parameters:
++  dm - a DMSwarm object of type DMSWARM_PIC
+-  flg - PETSC_TRUE to keep the points sorted by cell
+
+   Options Database Key:
+.  -dm_swarm_sort_points_by_cell - Keep the local points sorted by cell
+
+   Notes:
+   When set, the points are sorted immediately and re-sorted incrementally after each DMSwarmMigrate(), and points removed
+   during migration or with DMSwarmRemovePoints() are compacted without changing the relative order of the remaining points.
+   Cell-ordered storage makes traversal of the points in a cell contiguous in memory, which benefits deposition and
+   interpolation kernels, and DMSwarmSortGetAccess() can skip its sort.
+
+   Level: advanced
+
+.seealso: DMSwarmGetSortPointsByCell(), DMSwarmSortPointsByCell(), DMSwarmRemovePoints(), DMSwarmMigrate()
+@*/
+PetscErrorCode DMSwarmSetSortPointsByCell(DM dm,PetscBool flg)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  PetscValidLogicalCollectiveBool(dm,flg,2);
+  swarm->sort_points_by_cell = flg;
+  if (flg && swarm->issetup && swarm->swarm_type == DMSWARM_PIC) {
+    ierr = DMSwarmSortPointsByCell(dm);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMSwarmGetSortPointsByCell - Gets whether the local points of a DMSwarm are kept stored in increasing cell order
+
+   Not collective
+
+   Input parameter:
+.  dm - a DMSwarm object
+
+   Output parameter:
+.  flg - PETSC_TRUE if the points are kept sorted by cell
+
+   Level: advanced
+
+.seealso: DMSwarmSetSortPointsByCell()
+@*/
+PetscErrorCode DMSwarmGetSortPointsByCell(DM dm,PetscBool *flg)
+{
+  DM_Swarm *swarm = (DM_Swarm*)dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  PetscValidBoolPointer(flg,2);
+  *flg = swarm->sort_points_by_cell;
+  PetscFunctionReturn(0);
+}
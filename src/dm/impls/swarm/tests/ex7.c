@@ -0,0 +1,210 @@
+static char help[] = "Tests DMSwarmProjectFields() and DMSwarmInterpolateFields() with DMDA and DMPlex cell DMs.\n";
+
+#include <petscdmda.h>
+#include <petscdmplex.h>
+#include <petscdmswarm.h>
+
+typedef struct {
+  PetscBool plex;       /* Use a DMPlex cell DM instead of a DMDA */
+  PetscInt  faces;      /* The number of DMDA cells in each direction */
+  PetscInt  layout;     /* The number of points per cell in each direction */
+  char      filename[PETSC_MAX_PATH_LEN]; /* The mesh file for the DMPlex */
+} AppCtx;
+
+static PetscReal linear(const PetscReal x[])
+{
+  return 1.0 + 2.0*x[0] - 3.0*x[1];
+}
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->plex   = PETSC_FALSE;
+  options->faces  = 8;
+  options->layout = 2;
+  ierr = PetscStrcpy(options->filename, "");CHKERRQ(ierr);
+  ierr = PetscOptionsBegin(comm, "", "Swarm projection and interpolation options", "DMSWARM");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-plex", "Use a DMPlex cell DM", "ex7.c", options->plex, &options->plex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-faces", "Number of DMDA cells in each direction", "ex7.c", options->faces, &options->faces, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-layout", "Number of points per cell in each direction", "ex7.c", options->layout, &options->layout, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsString("-filename", "The mesh file for the DMPlex", "ex7.c", options->filename, options->filename, sizeof(options->filename), NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateCellDM(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (user->plex) {
+    PetscFE fe;
+
+    ierr = DMPlexCreateFromFile(comm, user->filename, PETSC_TRUE, dm);CHKERRQ(ierr);
+    ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+    ierr = PetscFECreateLagrange(PETSC_COMM_SELF, 2, 1, PETSC_TRUE, 1, PETSC_DETERMINE, &fe);CHKERRQ(ierr);
+    ierr = DMSetField(*dm, 0, NULL, (PetscObject) fe);CHKERRQ(ierr);
+    ierr = DMCreateDS(*dm);CHKERRQ(ierr);
+    ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+  } else {
+    ierr = DMDACreate2d(comm, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DMDA_STENCIL_BOX, user->faces+1, user->faces+1, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, dm);CHKERRQ(ierr);
+    ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+    ierr = DMSetUp(*dm);CHKERRQ(ierr);
+    ierr = DMDASetUniformCoordinates(*dm, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0);CHKERRQ(ierr);
+    ierr = DMDASetElementType(*dm, DMDA_ELEMENT_Q1);CHKERRQ(ierr);
+  }
+  ierr = DMViewFromOptions(*dm, NULL, "-dm_view");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateSwarm(DM dm, AppCtx *user, DM *sw)
+{
+  PetscReal      *coords, *phi;
+  PetscInt       p, n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMCreate(PetscObjectComm((PetscObject) dm), sw);CHKERRQ(ierr);
+  ierr = DMSetType(*sw, DMSWARM);CHKERRQ(ierr);
+  ierr = DMSetDimension(*sw, 2);CHKERRQ(ierr);
+  ierr = DMSwarmSetType(*sw, DMSWARM_PIC);CHKERRQ(ierr);
+  ierr = DMSwarmSetCellDM(*sw, dm);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(*sw, "phi", 1, PETSC_REAL);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(*sw, "psi", 1, PETSC_REAL);CHKERRQ(ierr);
+  ierr = DMSwarmFinalizeFieldRegister(*sw);CHKERRQ(ierr);
+  ierr = DMSwarmSetLocalSizes(*sw, 0, 4);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(*sw);CHKERRQ(ierr);
+  if (user->plex) {ierr = DMSwarmInsertPointsUsingCellDM(*sw, DMSWARMPIC_LAYOUT_GAUSS, user->layout);CHKERRQ(ierr);}
+  else            {ierr = DMSwarmInsertPointsUsingCellDM(*sw, DMSWARMPIC_LAYOUT_REGULAR, user->layout);CHKERRQ(ierr);}
+  /* Move every point to the next cell so that the points are no longer stored in cell order, then let migration relocate them */
+  ierr = DMSwarmGetLocalSize(*sw, &n);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  for (p = 0; p < n/2; ++p) {
+    PetscInt  q = n-1-p, d;
+    PetscReal tmp;
+
+    if (p % 3) continue;
+    for (d = 0; d < 2; ++d) {tmp = coords[2*p+d]; coords[2*p+d] = coords[2*q+d]; coords[2*q+d] = tmp;}
+  }
+  ierr = DMSwarmRestoreField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  ierr = DMSwarmMigrate(*sw, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = DMSwarmGetLocalSize(*sw, &n);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(*sw, "phi", NULL, NULL, (void **) &phi);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) phi[p] = linear(&coords[2*p]);
+  ierr = DMSwarmRestoreField(*sw, "phi", NULL, NULL, (void **) &phi);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Check that the projection of a field and its interpolation back onto the points reproduce the point values */
+static PetscErrorCode TestProjectInterpolate(DM dm, DM sw)
+{
+  const char     *pnames[] = {"phi"}, *inames[] = {"psi"};
+  Vec            *fields;
+  PetscReal      *coords, *psi, err = 0.0, gerr, nrm;
+  PetscInt       p, n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmProjectFields(sw, 1, pnames, &fields, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = VecNorm(fields[0], NORM_1, &nrm);CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Projected field 1-norm: %.6f\n", (double) nrm);CHKERRQ(ierr);
+  ierr = DMSwarmInterpolateFields(sw, 1, inames, fields);CHKERRQ(ierr);
+  ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, "psi", NULL, NULL, (void **) &psi);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) err = PetscMax(err, PetscAbsReal(psi[p] - linear(&coords[2*p])));
+  ierr = DMSwarmRestoreField(sw, "psi", NULL, NULL, (void **) &psi);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&err, &gerr, 1, MPIU_REAL, MPIU_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Interpolated field error: %s\n", gerr < 0.2 ? "small" : "large");CHKERRQ(ierr);
+  ierr = VecDestroy(&fields[0]);CHKERRQ(ierr);
+  ierr = PetscFree(fields);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Check that the interpolation of a linear vertex field is exact */
+static PetscErrorCode TestInterpolateLinear(DM dm, DM sw)
+{
+  const char        *inames[] = {"psi"};
+  Vec               field, coordinates;
+  const PetscScalar *ca;
+  PetscScalar       *a;
+  PetscReal         *coords, *psi, err = 0.0, gerr;
+  PetscInt          p, n, i, nl;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = DMCreateGlobalVector(dm, &field);CHKERRQ(ierr);
+  ierr = DMGetCoordinates(dm, &coordinates);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(field, &nl);CHKERRQ(ierr);
+  ierr = VecGetArray(field, &a);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &ca);CHKERRQ(ierr);
+  for (i = 0; i < nl; ++i) {
+    PetscReal x[2];
+
+    x[0] = PetscRealPart(ca[2*i]);
+    x[1] = PetscRealPart(ca[2*i+1]);
+    a[i] = linear(x);
+  }
+  ierr = VecRestoreArrayRead(coordinates, &ca);CHKERRQ(ierr);
+  ierr = VecRestoreArray(field, &a);CHKERRQ(ierr);
+  ierr = DMSwarmInterpolateFields(sw, 1, inames, &field);CHKERRQ(ierr);
+  ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, "psi", NULL, NULL, (void **) &psi);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) err = PetscMax(err, PetscAbsReal(psi[p] - linear(&coords[2*p])));
+  ierr = DMSwarmRestoreField(sw, "psi", NULL, NULL, (void **) &psi);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&err, &gerr, 1, MPIU_REAL, MPIU_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  if (gerr > 1.0e-10) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_PLIB, "Interpolation of a linear field is not exact, error %g", (double) gerr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Linear field interpolated exactly\n");CHKERRQ(ierr);
+  ierr = VecDestroy(&field);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm, sw;
+  AppCtx         user;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = CreateCellDM(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = CreateSwarm(dm, &user, &sw);CHKERRQ(ierr);
+  ierr = TestInterpolateLinear(dm, sw);CHKERRQ(ierr);
+  ierr = TestProjectInterpolate(dm, sw);CHKERRQ(ierr);
+  ierr = DMDestroy(&sw);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  build:
+    requires: !complex double
+
+  test:
+    suffix: da
+    args: -faces 8 -layout 3
+
+  test:
+    suffix: da_sorted
+    args: -faces 8 -layout 3 -dm_swarm_sort_points_by_cell
+    output_file: output/ex7_da.out
+
+  test:
+    suffix: da_2
+    nsize: 2
+    args: -faces 8 -layout 3 -dm_swarm_sort_points_by_cell
+
+  test:
+    suffix: plex
+    args: -plex -filename ${PETSC_DIR}/share/petsc/datafiles/meshes/square.msh -dm_refine 1 -layout 2
+
+TEST*/
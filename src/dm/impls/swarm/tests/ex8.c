@@ -0,0 +1,217 @@
+static char help[] = "Tests DMSwarmMigrateBegin() and DMSwarmMigrateEnd() with a DMDA cell DM.\n";
+
+#include <petscdmda.h>
+#include <petscdmswarm.h>
+#include <petscsf.h>
+
+typedef struct {
+  PetscInt  faces;   /* The number of DMDA cells in each direction */
+  PetscInt  layout;  /* The number of points per cell in each direction */
+  PetscInt  steps;   /* The number of advection steps */
+  PetscBool split;   /* Use DMSwarmMigrateBegin()/DMSwarmMigrateEnd() instead of DMSwarmMigrate() */
+  PetscBool subset;  /* Only communicate a subset of the fields */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->faces  = 8;
+  options->layout = 2;
+  options->steps  = 4;
+  options->split  = PETSC_FALSE;
+  options->subset = PETSC_FALSE;
+  ierr = PetscOptionsBegin(comm, "", "Swarm migration options", "DMSWARM");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-faces", "Number of DMDA cells in each direction", "ex8.c", options->faces, &options->faces, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-layout", "Number of points per cell in each direction", "ex8.c", options->layout, &options->layout, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-steps", "Number of advection steps", "ex8.c", options->steps, &options->steps, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-split", "Use DMSwarmMigrateBegin()/DMSwarmMigrateEnd()", "ex8.c", options->split, &options->split, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-subset", "Only communicate the fields weight and age", "ex8.c", options->subset, &options->subset, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateSwarm(DM dm, AppCtx *user, DM *sw)
+{
+  PetscReal      *coords, *weight;
+  PetscInt       p, n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMCreate(PetscObjectComm((PetscObject) dm), sw);CHKERRQ(ierr);
+  ierr = DMSetType(*sw, DMSWARM);CHKERRQ(ierr);
+  ierr = DMSetDimension(*sw, 2);CHKERRQ(ierr);
+  ierr = DMSwarmSetType(*sw, DMSWARM_PIC);CHKERRQ(ierr);
+  ierr = DMSwarmSetCellDM(*sw, dm);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(*sw, "weight", 1, PETSC_REAL);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(*sw, "work", 1, PETSC_REAL);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(*sw, "age", 1, PETSC_INT);CHKERRQ(ierr);
+  ierr = DMSwarmFinalizeFieldRegister(*sw);CHKERRQ(ierr);
+  ierr = DMSwarmSetLocalSizes(*sw, 0, 4);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(*sw);CHKERRQ(ierr);
+  ierr = DMSwarmInsertPointsUsingCellDM(*sw, DMSWARMPIC_LAYOUT_REGULAR, user->layout);CHKERRQ(ierr);
+  if (user->subset) {
+    const char *fieldnames[] = {"weight", "age"};
+
+    ierr = DMSwarmSetMigrateFields(*sw, 2, fieldnames);CHKERRQ(ierr);
+  }
+  ierr = DMSwarmGetLocalSize(*sw, &n);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(*sw, "weight", NULL, NULL, (void **) &weight);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) weight[p] = 1.0 + coords[2*p] + 2.0*coords[2*p+1];
+  ierr = DMSwarmRestoreField(*sw, "weight", NULL, NULL, (void **) &weight);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Shift the points, wrapping them around the unit square so that none leave the domain */
+static PetscErrorCode MovePoints(DM sw)
+{
+  PetscReal      *coords, *work;
+  PetscInt       p, n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, "work", NULL, NULL, (void **) &work);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) {
+    coords[2*p+0] += 0.13; if (coords[2*p+0] >= 1.0) coords[2*p+0] -= 1.0;
+    coords[2*p+1] += 0.07; if (coords[2*p+1] >= 1.0) coords[2*p+1] -= 1.0;
+    work[p] = 1.0;
+  }
+  ierr = DMSwarmRestoreField(sw, "work", NULL, NULL, (void **) &work);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Increment the age of the local points in [pStart, pEnd) */
+static PetscErrorCode AgePoints(DM sw, PetscInt pStart, PetscInt pEnd)
+{
+  PetscInt       *age, p;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmGetField(sw, "age", NULL, NULL, (void **) &age);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) ++age[p];
+  ierr = DMSwarmRestoreField(sw, "age", NULL, NULL, (void **) &age);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Check that each point lies in its cell and report the global invariants */
+static PetscErrorCode CheckSwarm(DM dm, DM sw, PetscInt nrecv, AppCtx *user)
+{
+  Vec               pos;
+  PetscSF           cellSF = NULL;
+  const PetscSFNode *cells;
+  PetscReal         *weight, *work, lsum[2] = {0.0, 0.0}, gsum[2];
+  PetscInt          *cellid, *age, p, n, N, lcnt[3] = {0, 0, 0}, gcnt[3];
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+  ierr = DMSwarmGetSize(sw, &N);CHKERRQ(ierr);
+  ierr = DMSwarmCreateLocalVectorFromField(sw, DMSwarmPICField_coor, &pos);CHKERRQ(ierr);
+  ierr = DMLocatePoints(dm, pos, DM_POINTLOCATION_NONE, &cellSF);CHKERRQ(ierr);
+  ierr = DMSwarmDestroyLocalVectorFromField(sw, DMSwarmPICField_coor, &pos);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(cellSF, NULL, NULL, NULL, &cells);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **) &cellid);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, "weight", NULL, NULL, (void **) &weight);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, "work", NULL, NULL, (void **) &work);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, "age", NULL, NULL, (void **) &age);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) {
+    if (cells[p].index != cellid[p]) ++lcnt[0];
+    if (work[p] == 0.0) ++lcnt[1];
+    lsum[0] += weight[p];
+    lsum[1] += age[p];
+  }
+  lcnt[2] = nrecv;
+  ierr = DMSwarmRestoreField(sw, "age", NULL, NULL, (void **) &age);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw, "work", NULL, NULL, (void **) &work);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw, "weight", NULL, NULL, (void **) &weight);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **) &cellid);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&cellSF);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(lsum, gsum, 2, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject) sw));CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(lcnt, gcnt, 3, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject) sw));CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) sw), "Points %D, misplaced %D, weight %.6g, age %.6g\n", N, gcnt[0], (double) gsum[0], (double) gsum[1]);CHKERRQ(ierr);
+  /* Only the points received from another rank can have a zero work entry, and only if work was not communicated */
+  if (gcnt[1] != (user->subset ? gcnt[2] : 0)) {ierr = PetscPrintf(PetscObjectComm((PetscObject) sw), "Unexpected number of zero work entries %D\n", gcnt[1]);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TestMigrate(DM dm, DM sw, AppCtx *user)
+{
+  PetscInt       s, nprior, n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (s = 0; s < user->steps; ++s) {
+    ierr = MovePoints(sw);CHKERRQ(ierr);
+    if (user->split) {
+      ierr = DMSwarmMigrateBegin(sw, PETSC_TRUE);CHKERRQ(ierr);
+      /* The points which stayed can be updated while the others are in flight */
+      ierr = DMSwarmGetLocalSize(sw, &nprior);CHKERRQ(ierr);
+      ierr = AgePoints(sw, 0, nprior);CHKERRQ(ierr);
+      ierr = DMSwarmMigrateEnd(sw);CHKERRQ(ierr);
+      ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+      ierr = AgePoints(sw, nprior, n);CHKERRQ(ierr);
+    } else {
+      ierr = DMSwarmMigrate(sw, PETSC_TRUE);CHKERRQ(ierr);
+      ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+      ierr = AgePoints(sw, 0, n);CHKERRQ(ierr);
+      nprior = n;
+    }
+    ierr = CheckSwarm(dm, sw, n - nprior, user);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm, sw;
+  AppCtx         user;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DMDA_STENCIL_BOX, user.faces+1, user.faces+1, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, &dm);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  ierr = DMDASetUniformCoordinates(dm, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0);CHKERRQ(ierr);
+  ierr = DMDASetElementType(dm, DMDA_ELEMENT_Q1);CHKERRQ(ierr);
+  ierr = CreateSwarm(dm, &user, &sw);CHKERRQ(ierr);
+  ierr = TestMigrate(dm, sw, &user);CHKERRQ(ierr);
+  ierr = DMDestroy(&sw);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  build:
+    requires: !complex double
+
+  test:
+    suffix: 0
+    args: -faces 8 -layout 3
+
+  test:
+    suffix: split
+    args: -faces 8 -layout 3 -split
+    output_file: output/ex8_0.out
+
+  test:
+    suffix: 2
+    nsize: {{2 4}}
+    args: -faces 8 -layout 3 -split {{0 1}}
+    output_file: output/ex8_0.out
+
+  test:
+    suffix: 2_subset
+    nsize: 4
+    args: -faces 8 -layout 3 -split -subset
+    output_file: output/ex8_0.out
+
+TEST*/
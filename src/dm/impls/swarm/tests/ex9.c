@@ -0,0 +1,181 @@
+static char help[] = "Tests the order of the points after DMSwarmRemovePoints() and DMSwarmMigrate() with a DMDA cell DM.\n";
+
+#include <petscdmda.h>
+#include <petscdmswarm.h>
+#include <petscbt.h>
+
+typedef struct {
+  PetscInt faces;   /* The number of DMDA cells in each direction */
+  PetscInt layout;  /* The number of points per cell in each direction */
+  PetscInt steps;   /* The number of advection steps */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->faces  = 8;
+  options->layout = 2;
+  options->steps  = 3;
+  ierr = PetscOptionsBegin(comm, "", "Swarm point order options", "DMSWARM");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-faces", "Number of DMDA cells in each direction", "ex9.c", options->faces, &options->faces, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-layout", "Number of points per cell in each direction", "ex9.c", options->layout, &options->layout, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-steps", "Number of advection steps", "ex9.c", options->steps, &options->steps, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateSwarm(DM dm, AppCtx *user, DM *sw)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMCreate(PetscObjectComm((PetscObject) dm), sw);CHKERRQ(ierr);
+  ierr = DMSetType(*sw, DMSWARM);CHKERRQ(ierr);
+  ierr = DMSetDimension(*sw, 2);CHKERRQ(ierr);
+  ierr = DMSwarmSetType(*sw, DMSWARM_PIC);CHKERRQ(ierr);
+  ierr = DMSwarmSetCellDM(*sw, dm);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(*sw, "id", 1, PETSC_INT);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(*sw, "owner", 1, PETSC_INT);CHKERRQ(ierr);
+  ierr = DMSwarmFinalizeFieldRegister(*sw);CHKERRQ(ierr);
+  ierr = DMSwarmSetLocalSizes(*sw, 0, 4);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(*sw);CHKERRQ(ierr);
+  ierr = DMSwarmInsertPointsUsingCellDM(*sw, DMSWARMPIC_LAYOUT_REGULAR, user->layout);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Number the local points, remove some of them given in an unsorted list, and compare the order of the remaining points
+   with the one expected from DMSwarmRemovePointAtIndex() or, when the points are kept sorted by cell, with the original order */
+static PetscErrorCode TestRemovePoints(DM sw)
+{
+  PetscBT        removed;
+  PetscBool      sorted;
+  PetscInt       *id, *idx, *ref, p, n, nidx = 0, nref, lcnt = 0, gcnt;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmGetSortPointsByCell(sw, &sorted);CHKERRQ(ierr);
+  ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, "id", NULL, NULL, (void **) &id);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) id[p] = p;
+  ierr = DMSwarmRestoreField(sw, "id", NULL, NULL, (void **) &id);CHKERRQ(ierr);
+
+  /* Every third point in decreasing order, followed by the other points 1 mod 7 in increasing order */
+  ierr = PetscBTCreate(n, &removed);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n, &idx, n, &ref);CHKERRQ(ierr);
+  for (p = n-1; p >= 0; --p) if (p%3 == 0) {idx[nidx++] = p; ierr = PetscBTSet(removed, p);CHKERRQ(ierr);}
+  for (p = 0; p < n; ++p) if (p%7 == 1 && p%3) {idx[nidx++] = p; ierr = PetscBTSet(removed, p);CHKERRQ(ierr);}
+  ierr = DMSwarmRemovePoints(sw, nidx, idx);CHKERRQ(ierr);
+
+  /* The reference order */
+  for (p = 0; p < n; ++p) ref[p] = p;
+  nref = n;
+  if (sorted) {
+    for (p = 0, nref = 0; p < n; ++p) if (!PetscBTLookup(removed, p)) ref[nref++] = p;
+  } else {
+    for (p = 0; p < nref; ++p) while (p < nref && PetscBTLookup(removed, ref[p])) ref[p] = ref[--nref];
+  }
+
+  ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+  if (n != nref) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "%D points remain instead of %D", n, nref);
+  ierr = DMSwarmGetField(sw, "id", NULL, NULL, (void **) &id);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) if (id[p] != ref[p]) ++lcnt;
+  ierr = DMSwarmRestoreField(sw, "id", NULL, NULL, (void **) &id);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&lcnt, &gcnt, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject) sw));CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) sw), "Remaining points out of order after DMSwarmRemovePoints(): %D\n", gcnt);CHKERRQ(ierr);
+  ierr = PetscFree2(idx, ref);CHKERRQ(ierr);
+  ierr = PetscBTDestroy(&removed);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Shift the points, wrapping them around the unit square so that none leave the domain */
+static PetscErrorCode MovePoints(DM sw)
+{
+  PetscReal      *coords;
+  PetscInt       p, n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) {
+    coords[2*p+0] += 0.13; if (coords[2*p+0] >= 1.0) coords[2*p+0] -= 1.0;
+    coords[2*p+1] += 0.07; if (coords[2*p+1] >= 1.0) coords[2*p+1] -= 1.0;
+  }
+  ierr = DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **) &coords);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Migrate the points, count those whose cell is smaller than the cell of the previous point, check that no point is
+   lost, and check that points leaving other ranks reach rank 0, which is a neighbor like any other */
+static PetscErrorCode TestMigrate(DM sw, AppCtx *user)
+{
+  PetscInt       *cellid, *owner, s, p, n, N, Nprev, ldesc, gdesc, lrecv = 0, grecv;
+  PetscMPIInt    rank, size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) sw), &rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject) sw), &size);CHKERRMPI(ierr);
+  for (s = 0; s < user->steps; ++s) {
+    ierr = DMSwarmGetSize(sw, &Nprev);CHKERRQ(ierr);
+    ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+    ierr = DMSwarmGetField(sw, "owner", NULL, NULL, (void **) &owner);CHKERRQ(ierr);
+    for (p = 0; p < n; ++p) owner[p] = rank;
+    ierr = DMSwarmRestoreField(sw, "owner", NULL, NULL, (void **) &owner);CHKERRQ(ierr);
+    ierr = MovePoints(sw);CHKERRQ(ierr);
+    ierr = DMSwarmMigrate(sw, PETSC_TRUE);CHKERRQ(ierr);
+    ierr = DMSwarmGetSize(sw, &N);CHKERRQ(ierr);
+    ierr = DMSwarmGetLocalSize(sw, &n);CHKERRQ(ierr);
+    ierr = DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **) &cellid);CHKERRQ(ierr);
+    for (p = 1, ldesc = 0; p < n; ++p) if (cellid[p] < cellid[p-1]) ++ldesc;
+    ierr = DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **) &cellid);CHKERRQ(ierr);
+    ierr = DMSwarmGetField(sw, "owner", NULL, NULL, (void **) &owner);CHKERRQ(ierr);
+    if (!rank) for (p = 0; p < n; ++p) if (owner[p] != rank) ++lrecv;
+    ierr = DMSwarmRestoreField(sw, "owner", NULL, NULL, (void **) &owner);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(&ldesc, &gdesc, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject) sw));CHKERRQ(ierr);
+    ierr = PetscPrintf(PetscObjectComm((PetscObject) sw), "Step %D: cellid %s, %s\n", s, gdesc ? "decreasing somewhere" : "nondecreasing", N == Nprev ? "no point lost" : "points lost");CHKERRQ(ierr);
+  }
+  ierr = MPIU_Allreduce(&lrecv, &grecv, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject) sw));CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) sw), "Points from other ranks %s rank 0\n", grecv || size == 1 ? "reach" : "never reach");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm, sw;
+  AppCtx         user;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DMDA_STENCIL_BOX, user.faces+1, user.faces+1, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, &dm);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  ierr = DMDASetUniformCoordinates(dm, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0);CHKERRQ(ierr);
+  ierr = DMDASetElementType(dm, DMDA_ELEMENT_Q1);CHKERRQ(ierr);
+  ierr = CreateSwarm(dm, &user, &sw);CHKERRQ(ierr);
+  ierr = TestRemovePoints(sw);CHKERRQ(ierr);
+  ierr = TestMigrate(sw, &user);CHKERRQ(ierr);
+  ierr = DMDestroy(&sw);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  build:
+    requires: !complex double
+
+  test:
+    suffix: 0
+    args: -faces 8 -layout 3
+
+  test:
+    suffix: sort
+    nsize: {{1 2 4}}
+    args: -faces 8 -layout 3 -dm_swarm_sort_points_by_cell
+
+TEST*/
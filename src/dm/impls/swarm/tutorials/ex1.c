@@ -160,4 +160,12 @@ int main(int argc, char **argv)
     filter: grep -v DM_ | grep -v atomic
     filter_output: grep -v atomic
 
+  test:
+    suffix: sort
+    requires: double
+    args: -dm_plex_box_faces 4,2 -dm_plex_box_lower -2.0,0.0 -dm_plex_box_upper 2.0,2.0 -petscspace_degree 2 -ftop_ksp_type lsqr -ftop_pc_type none -dm_view -swarm_view -dm_swarm_sort_points_by_cell
+    filter: grep -v DM_ | grep -v atomic
+    filter_output: grep -v atomic
+    output_file: output/ex1_0.out
+
 TEST*/
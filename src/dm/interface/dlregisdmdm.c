@@ -98,6 +98,8 @@ PetscErrorCode  DMInitializePackage(void)
   ierr = PetscLogEventRegister("DMPlexDistField",        DM_CLASSID,&DMPLEX_DistributeField);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexDistData",         DM_CLASSID,&DMPLEX_DistributeData);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexInterpSF",         DM_CLASSID,&DMPLEX_InterpolateSF);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMPlexInterpFaces",      DM_CLASSID,&DMPLEX_InterpolateFaces);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMPlexInterpOrnt",       DM_CLASSID,&DMPLEX_InterpolateOrient);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexGToNBegin",        DM_CLASSID,&DMPLEX_GlobalToNaturalBegin);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexGToNEnd",          DM_CLASSID,&DMPLEX_GlobalToNaturalEnd);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexNToGBegin",        DM_CLASSID,&DMPLEX_NaturalToGlobalBegin);CHKERRQ(ierr);
@@ -105,6 +107,7 @@ PetscErrorCode  DMInitializePackage(void)
   ierr = PetscLogEventRegister("DMPlexStratify",         DM_CLASSID,&DMPLEX_Stratify);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexSymmetrize",       DM_CLASSID,&DMPLEX_Symmetrize);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexPrealloc",         DM_CLASSID,&DMPLEX_Preallocate);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMPlexPreallocAdj",      DM_CLASSID,&DMPLEX_PreallocateAdj);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexResidualFE",       DM_CLASSID,&DMPLEX_ResidualFEM);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexJacobianFE",       DM_CLASSID,&DMPLEX_JacobianFEM);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexInterpFE",         DM_CLASSID,&DMPLEX_InterpolatorFEM);CHKERRQ(ierr);
@@ -112,6 +115,11 @@ PetscErrorCode  DMInitializePackage(void)
   ierr = PetscLogEventRegister("DMPlexIntegralFEM",      DM_CLASSID,&DMPLEX_IntegralFEM);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexRebalance",        DM_CLASSID,&DMPLEX_RebalanceSharedPoints);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMPlexLocatePoints",     DM_CLASSID,&DMPLEX_LocatePoints);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMPlexRefine",           DM_CLASSID,&DMPLEX_Refine);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMPlexRefCones",         DM_CLASSID,&DMPLEX_RefineCones);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMPlexRefSF",            DM_CLASSID,&DMPLEX_RefineSF);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMPlexRefLabels",        DM_CLASSID,&DMPLEX_RefineLabels);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMPlexRefCoords",        DM_CLASSID,&DMPLEX_RefineCoordinates);CHKERRQ(ierr);
 
   ierr = PetscLogEventRegister("DMSwarmMigrate",         DM_CLASSID,&DMSWARM_Migrate);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMSwarmDETSetup",        DM_CLASSID,&DMSWARM_DataExchangerTopologySetup);CHKERRQ(ierr);
@@ -122,6 +130,8 @@ PetscErrorCode  DMInitializePackage(void)
   ierr = PetscLogEventRegister("DMSwarmAddPnts",         DM_CLASSID,&DMSWARM_AddPoints);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMSwarmRmvPnts",         DM_CLASSID,&DMSWARM_RemovePoints);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMSwarmSort",            DM_CLASSID,&DMSWARM_Sort);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMSwarmProjFields",      DM_CLASSID,&DMSWARM_ProjectFields);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMSwarmInterpFields",    DM_CLASSID,&DMSWARM_InterpolateFields);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMSwarmSetSizes",        DM_CLASSID,&DMSWARM_SetSizes);CHKERRQ(ierr);
   /* Process Info */
   {
@@ -0,0 +1,138 @@
+static char help[] = "Tests DMDACreateStencilOperator() against the assembled matrix.\n\n";
+
+#include <petscdmda.h>
+
+int main(int argc,char **argv)
+{
+  DM              da,cda;
+  Mat             A,B;
+  Vec             x,y,z,d,dB,c;
+  MatStencil      offsets[125];
+  PetscScalar     *coeffs,*ca;
+  PetscInt        dim = 2,dof = 1,sw = 1,n = 8,ne = 0,bs2,i,j,k,e,q,xs,ys,zs,xm,ym,zm,p;
+  PetscBool       box = PETSC_FALSE,periodic = PETSC_FALSE,variable = PETSC_FALSE;
+  char            convtype[256] = MATAIJ;
+  DMBoundaryType  bt;
+  DMDAStencilType st;
+  PetscRandom     rand;
+  PetscReal       nrm,err;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD,NULL,"DMDA stencil operator test","DM");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim","The dimension","",dim,&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dof","The number of components","",dof,&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sw","The stencil width","",sw,&sw,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-n","The number of grid points in each direction","",n,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-box","Use a box stencil","",box,&box,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-periodic","Use periodic boundaries","",periodic,&periodic,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-variable","Use spatially varying coefficients","",variable,&variable,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsString("-conv_type","The assembled matrix type","",convtype,convtype,sizeof(convtype),NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+
+  bt = periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+  st = box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR;
+  switch (dim) {
+  case 1: ierr = DMDACreate1d(PETSC_COMM_WORLD,bt,n,dof,sw,NULL,&da);CHKERRQ(ierr);break;
+  case 2: ierr = DMDACreate2d(PETSC_COMM_WORLD,bt,bt,st,n,n+1,PETSC_DECIDE,PETSC_DECIDE,dof,sw,NULL,NULL,&da);CHKERRQ(ierr);break;
+  default: ierr = DMDACreate3d(PETSC_COMM_WORLD,bt,bt,bt,st,n,n+1,n+2,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,dof,sw,NULL,NULL,NULL,&da);CHKERRQ(ierr);
+  }
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+
+  /* All offsets of the stencil of the DMDA */
+  for (k = (dim > 2 ? -sw : 0); k <= (dim > 2 ? sw : 0); ++k) {
+    for (j = (dim > 1 ? -sw : 0); j <= (dim > 1 ? sw : 0); ++j) {
+      for (i = -sw; i <= sw; ++i) {
+        if (!box && ((i && j) || (i && k) || (j && k))) continue;
+        offsets[ne].i = i; offsets[ne].j = j; offsets[ne].k = k; offsets[ne].c = 0;
+        ++ne;
+      }
+    }
+  }
+  bs2  = dof*dof;
+  ierr = DMDACreateStencilOperator(da,ne,offsets,&A);CHKERRQ(ierr);
+  if (variable) {
+    ierr = DMDAStencilOperatorGetCoefficientDM(A,&cda);CHKERRQ(ierr);
+    ierr = DMCreateGlobalVector(cda,&c);CHKERRQ(ierr);
+    ierr = DMDAGetCorners(da,&xs,&ys,&zs,&xm,&ym,&zm);CHKERRQ(ierr);
+    ierr = VecGetArray(c,&ca);CHKERRQ(ierr);
+    for (k = zs, p = 0; k < zs+zm; ++k) for (j = ys; j < ys+ym; ++j) for (i = xs; i < xs+xm; ++i, ++p) {
+      for (q = 0; q < ne*bs2; ++q) ca[p*ne*bs2 + q] = 1.0 + 0.5*PetscSinReal(i + 2*j + 3*k + 0.25*q);
+    }
+    ierr = VecRestoreArray(c,&ca);CHKERRQ(ierr);
+    ierr = DMDAStencilOperatorSetVariableCoefficients(A,c);CHKERRQ(ierr);
+    ierr = VecDestroy(&c);CHKERRQ(ierr);
+  } else {
+    ierr = PetscMalloc1(ne*bs2,&coeffs);CHKERRQ(ierr);
+    for (e = 0; e < ne; ++e) for (q = 0; q < bs2; ++q) coeffs[e*bs2 + q] = -1.0 - 0.1*e - 0.01*q;
+    ierr = DMDAStencilOperatorSetCoefficients(A,coeffs);CHKERRQ(ierr);
+    ierr = PetscFree(coeffs);CHKERRQ(ierr);
+  }
+  ierr = MatConvert(A,convtype,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(da,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&d);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&dB);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult %s\n",err <= PETSC_SMALL*nrm ? "matches" : "differs");CHKERRQ(ierr);
+  ierr = MatGetDiagonal(A,d);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(B,dB);CHKERRQ(ierr);
+  ierr = VecAXPY(dB,-1.0,d);CHKERRQ(ierr);
+  ierr = VecNorm(dB,NORM_INFINITY,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"MatGetDiagonal %s\n",err <= PETSC_SMALL ? "matches" : "differs");CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&d);CHKERRQ(ierr);
+  ierr = VecDestroy(&dB);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 2d
+      nsize: {{1 4}}
+      args: -box {{0 1}} -periodic {{0 1}} -variable {{0 1}} -conv_type {{aij sell}}
+      output_file: output/ex54_1.out
+
+   test:
+      suffix: 2d_dof
+      nsize: {{1 4}}
+      args: -dof 2 -sw 2 -periodic {{0 1}} -variable {{0 1}} -da_stencil_tile 3,2
+      output_file: output/ex54_1.out
+
+   test:
+      suffix: 3d
+      nsize: {{1 4}}
+      args: -dim 3 -n 6 -periodic {{0 1}} -variable {{0 1}} -da_stencil_tile 4,3,2
+      output_file: output/ex54_1.out
+
+   test:
+      suffix: 3d_box
+      nsize: 4
+      args: -dim 3 -n 6 -box -dof 2 -variable
+      output_file: output/ex54_1.out
+
+   test:
+      suffix: 1d
+      args: -dim 1 -n 16 -sw 3 -periodic {{0 1}} -variable {{0 1}}
+      output_file: output/ex54_1.out
+
+TEST*/
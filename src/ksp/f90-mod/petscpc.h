@@ -85,6 +85,7 @@
       PetscEnum, parameter :: PC_MG_FULL=2
       PetscEnum, parameter :: PC_MG_KASKADE=3
       PetscEnum, parameter :: PC_MG_CASCADE=3
+      PetscEnum, parameter :: PC_MG_MULTADDITIVE=4
 
 ! PCMGCycleType
       PetscEnum, parameter :: PC_MG_CYCLE_V = 1
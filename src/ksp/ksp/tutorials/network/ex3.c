@@ -14,15 +14,53 @@ typedef struct{
   PetscScalar val;
 } Comp1;
 
+/* Check the batched components against the values set from the global vertex index and against DMNetworkGetComponent() */
+typedef struct {
+  PetscInt key0;   /* key of Comp0 */
+  PetscInt nwrong; /* number of batched components that differ */
+} BatchCtx;
+
+static PetscErrorCode CheckBatch(DM dmnetwork,PetscInt key,PetscInt n,const PetscInt points[],void *components,const PetscInt offsets[],const PetscInt nvar[],void *ctx)
+{
+  PetscErrorCode ierr;
+  BatchCtx       *bctx = (BatchCtx*)ctx;
+  Comp0          *c0 = (Comp0*)components;
+  Comp1          *c1 = (Comp1*)components;
+  PetscInt       i,j,ncomp,compkey,offset,nv,gidx;
+  void           *component,*batched;
+
+  PetscFunctionBeginUser;
+  for (i=0; i<n; i++) {
+    ierr = DMNetworkGetGlobalVertexIndex(dmnetwork,points[i],&gidx);CHKERRQ(ierr);
+    if (key == bctx->key0) {
+      batched = &c0[i];
+      if (c0[i].id != gidx) bctx->nwrong++;
+    } else {
+      batched = &c1[i];
+      if (c1[i].val != 10.0*gidx) bctx->nwrong++;
+    }
+    ierr = DMNetworkGetNumComponents(dmnetwork,points[i],&ncomp);CHKERRQ(ierr);
+    for (j=0; j<ncomp; j++) {
+      ierr = DMNetworkGetComponent(dmnetwork,points[i],j,&compkey,&component,&nv);CHKERRQ(ierr);
+      if (compkey != key || component != batched) continue;
+      ierr = DMNetworkGetLocalVecOffset(dmnetwork,points[i],j,&offset);CHKERRQ(ierr);
+      if (offset != offsets[i] || nv != nvar[i]) bctx->nwrong++;
+      break;
+    }
+    if (j == ncomp) bctx->nwrong++;
+  }
+  PetscFunctionReturn(0);
+}
+
 int main(int argc,char ** argv)
 {
   PetscErrorCode ierr;
   PetscMPIInt    size,rank;
   DM             dmnetwork;
   PetscInt       i,j,net,Nsubnet,nsubnet,ne,nv,nvar,v,ncomp,compkey0,compkey1,compkey,goffset,row;
-  PetscInt       numVertices[10],numEdges[10],*edgelist[10],asvtx,bsvtx;
+  PetscInt       numVertices[10],numEdges[10],*edgelist[10],asvtx,bsvtx,vStart,vEnd,gidx;
   const PetscInt *vtx,*edges;
-  PetscBool      sharedv,ghost,distribute=PETSC_TRUE,test=PETSC_FALSE;
+  PetscBool      sharedv,ghost,distribute=PETSC_TRUE,test=PETSC_FALSE,batch=PETSC_FALSE;
   Vec            X;
   Comp0          comp0;
   Comp1          comp1;
@@ -137,9 +175,29 @@ int main(int argc,char ** argv)
     ierr = PetscOptionsSetValue(NULL,"-dm_plex_csr_via_mat","true");CHKERRQ(ierr); /* for parmetis */
   }
 
+  /* Store the components grouped by key; use '-batch' to test */
+  ierr = PetscOptionsGetBool(NULL,NULL,"-batch",&batch,NULL);CHKERRQ(ierr);
+  ierr = DMNetworkSetComponentBatching(dmnetwork,batch);CHKERRQ(ierr);
+
   /* Setup dmnetwork */
   ierr = DMSetUp(dmnetwork);CHKERRQ(ierr);
 
+  /* Number the batched components by their global vertex index, which CheckBatch() compares after the distribution */
+  if (batch) {
+    void *component;
+
+    ierr = DMNetworkGetVertexRange(dmnetwork,&vStart,&vEnd);CHKERRQ(ierr);
+    for (v=vStart; v<vEnd; v++) {
+      ierr = DMNetworkGetGlobalVertexIndex(dmnetwork,v,&gidx);CHKERRQ(ierr);
+      ierr = DMNetworkGetNumComponents(dmnetwork,v,&ncomp);CHKERRQ(ierr);
+      for (j=0; j<ncomp; j++) {
+        ierr = DMNetworkGetComponent(dmnetwork,v,j,&compkey,&component,NULL);CHKERRQ(ierr);
+        if (compkey == compkey0) ((Comp0*)component)->id = gidx;
+        else ((Comp1*)component)->val = 10.0*gidx;
+      }
+    }
+  }
+
   /* Redistribute the network layout; use '-distribute false' to skip */
   ierr = PetscOptionsGetBool(NULL,NULL,"-distribute",&distribute,NULL);CHKERRQ(ierr);
   if (distribute) {
@@ -175,6 +233,17 @@ int main(int argc,char ** argv)
   ierr = VecAssemblyEnd(X);CHKERRQ(ierr);
   ierr = VecView(X,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
 
+  /* Test DMNetworkComponentBatchApply() */
+  if (batch) {
+    BatchCtx bctx;
+
+    bctx.key0   = compkey0;
+    bctx.nwrong = 0;
+    ierr = DMNetworkComponentBatchApply(dmnetwork,ALL_COMPONENTS,2,CheckBatch,&bctx);CHKERRQ(ierr);
+    ierr = MPI_Allreduce(MPI_IN_PLACE,&bctx.nwrong,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Batched components %s\n",bctx.nwrong ? "differ" : "match");CHKERRQ(ierr);
+  }
+
   /* Test DMNetworkGetSubnetwork() */
   ierr = PetscOptionsGetBool(NULL,NULL,"-test_getsubnet",&test,NULL);CHKERRQ(ierr);
   if (test) {
@@ -239,4 +308,11 @@ int main(int argc,char ** argv)
       nsize: 4
       args: -options_left no
 
+   test:
+      suffix: batch
+      nsize: {{1 4}}
+      args: -options_left no -batch -distribute {{0 1}}
+      output_file: output/ex3_batch.out
+      filter: grep Batched
+
 TEST*/
@@ -10,7 +10,7 @@ int main(int argc,char ** argv)
   PetscInt       i,j,net,Nsubnet,ne,nv,nvar,v,goffset,row;
   PetscInt       *numVertices,*numEdges,**edgelist,asvtx[2],bsvtx[2];
   const PetscInt *vtx,*edges;
-  PetscBool      ghost,distribute=PETSC_TRUE;
+  PetscBool      ghost,distribute=PETSC_TRUE,localsv=PETSC_FALSE;
   Vec            X;
   PetscScalar    val;
 
@@ -59,12 +59,15 @@ int main(int argc,char ** argv)
     ierr = DMNetworkAddSubnetwork(dmnetwork,NULL,numVertices[i],numEdges[i],edgelist[i],&netNum);CHKERRQ(ierr);
   }
 
-  /* Add shared vertices -- all processes hold this info at current implementation
+  /* Add shared vertices
        net[0].0 -> net[j].0, j=0,...,Nsubnet-1
-       net[0].1 -> net[j].1, j=0,...,Nsubnet-1 */
+       net[0].1 -> net[j].1, j=0,...,Nsubnet-1
+     by all processes, or with '-local_sv' only by the process holding subnetwork j */
+  ierr = PetscOptionsGetBool(NULL,NULL,"-local_sv",&localsv,NULL);CHKERRQ(ierr);
   asvtx[0] = bsvtx[0] = 0;
   asvtx[1] = bsvtx[1] = 1;
   for (j=Nsubnet-1; j>=1; j--) {
+    if (localsv && size > 1 && rank != j) continue;
     ierr = DMNetworkAddSharedVertices(dmnetwork,0,j,2,asvtx,bsvtx);CHKERRQ(ierr);
   }
 
@@ -157,4 +160,10 @@ int main(int argc,char ** argv)
       nsize: 4
       args: -options_left no
 
+   test:
+      suffix: 4
+      nsize: 4
+      args: -options_left no -local_sv
+      output_file: output/ex4_3.out
+
 TEST*/
@@ -0,0 +1,135 @@
+static char help[] = "This example tests subnetwork coupling with the edges of each subnetwork distributed over the processes. \n\n";
+
+#include <petscdmnetwork.h>
+
+int main(int argc,char ** argv)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size,rank;
+  DM             dmnetwork;
+  PetscInt       i,j,net,Nsubnet=2,nvtx=6,ne,nv,estart,eend,N;
+  PetscInt       numVertices[3],numEdges[3],*edgelist[3],asvtx,bsvtx;
+  const PetscInt *vtx,*edges;
+  PetscBool      ghost,sharedv;
+  Vec            X;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRMPI(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nvtx",&nvtx,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nsubnet",&Nsubnet,NULL);CHKERRQ(ierr);
+  if (Nsubnet < 2 || Nsubnet > 3) SETERRQ1(PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"Number of subnetworks %D must be 2 or 3",Nsubnet);
+  if (Nsubnet == 3 && nvtx < 5) SETERRQ1(PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"Number of vertices %D of each subnetwork must be at least 5 with 3 subnetworks",nvtx);
+
+  /* Each subnetwork is a line of nvtx vertices: 0 -> 1 -> ... -> nvtx-1; every process holds a contiguous part of its edges and vertices */
+  estart = (nvtx-1)*rank/size;
+  eend   = (nvtx-1)*(rank+1)/size;
+  for (net=0; net<Nsubnet; net++) {
+    numEdges[net]    = eend - estart;
+    numVertices[net] = nvtx*(rank+1)/size - nvtx*rank/size;
+    ierr = PetscMalloc1(2*numEdges[net],&edgelist[net]);CHKERRQ(ierr);
+    for (j=0; j<numEdges[net]; j++) {
+      edgelist[net][2*j] = estart + j; edgelist[net][2*j+1] = estart + j + 1;
+    }
+  }
+
+  /* Create a dmnetwork */
+  ierr = DMNetworkCreate(PETSC_COMM_WORLD,&dmnetwork);CHKERRQ(ierr);
+  ierr = DMNetworkSetNumSubNetworks(dmnetwork,PETSC_DECIDE,Nsubnet);CHKERRQ(ierr);
+  for (net=0; net<Nsubnet; net++) {
+    ierr = DMNetworkAddSubnetwork(dmnetwork,NULL,numVertices[net],numEdges[net],edgelist[net],NULL);CHKERRQ(ierr);
+  }
+
+  /* Add shared vertices -- each pair is added only by the process holding the edges that touch it
+       net[0].0        -> net[1].nvtx-1
+       net[0].nvtx-1   -> net[1].0
+       net[0].nvtx/2   -> net[1].nvtx/2 */
+  if (!rank) {
+    asvtx = 0; bsvtx = nvtx-1;
+    ierr = DMNetworkAddSharedVertices(dmnetwork,0,1,1,&asvtx,&bsvtx);CHKERRQ(ierr);
+  }
+  if (rank == size-1) {
+    asvtx = nvtx-1; bsvtx = 0;
+    ierr = DMNetworkAddSharedVertices(dmnetwork,0,1,1,&asvtx,&bsvtx);CHKERRQ(ierr);
+  }
+  if (estart <= nvtx/2 && nvtx/2 <= eend) {
+    asvtx = bsvtx = nvtx/2;
+    ierr = DMNetworkAddSharedVertices(dmnetwork,0,1,1,&asvtx,&bsvtx);CHKERRQ(ierr);
+  }
+
+  /* With a third subnetwork, add a chain of pairs joining one vertex of each subnetwork, each pair on a different process,
+     so that the three vertices are merged only after the labels propagate along the chain
+       net[1].1        -> net[2].nvtx-2   (first process)
+       net[0].nvtx-2   -> net[1].1        (last process) */
+  if (Nsubnet == 3) {
+    if (!rank) {
+      asvtx = 1; bsvtx = nvtx-2;
+      ierr = DMNetworkAddSharedVertices(dmnetwork,1,2,1,&asvtx,&bsvtx);CHKERRQ(ierr);
+    }
+    if (rank == size-1) {
+      asvtx = nvtx-2; bsvtx = 1;
+      ierr = DMNetworkAddSharedVertices(dmnetwork,0,1,1,&asvtx,&bsvtx);CHKERRQ(ierr);
+    }
+  }
+
+  /* Setup the network layout */
+  ierr = DMNetworkLayoutSetUp(dmnetwork);CHKERRQ(ierr);
+
+  /* Add nvar=1 to the vertices of the subnetworks and nvar=2 to the shared vertices -- only owner of the shared vertex does this! */
+  for (net=0; net<Nsubnet; net++) {
+    ierr = DMNetworkGetSubnetwork(dmnetwork,net,&nv,&ne,&vtx,&edges);CHKERRQ(ierr);
+    for (i=0; i<nv; i++) {
+      ierr = DMNetworkIsSharedVertex(dmnetwork,vtx[i],&sharedv);CHKERRQ(ierr);
+      if (sharedv) continue;
+      ierr = DMNetworkAddComponent(dmnetwork,vtx[i],-1,NULL,1);CHKERRQ(ierr);
+    }
+  }
+  ierr = DMNetworkGetSharedVertices(dmnetwork,&nv,&vtx);CHKERRQ(ierr);
+  for (i=0; i<nv; i++) {
+    ierr = DMNetworkIsGhostVertex(dmnetwork,vtx[i],&ghost);CHKERRQ(ierr);
+    if (ghost) continue;
+    ierr = DMNetworkAddComponent(dmnetwork,vtx[i],-1,NULL,2);CHKERRQ(ierr);
+  }
+
+  /* Setup dmnetwork and redistribute it */
+  ierr = DMSetUp(dmnetwork);CHKERRQ(ierr);
+  ierr = DMNetworkDistribute(&dmnetwork,0);CHKERRQ(ierr);
+
+  /* The merged network has the same size on any number of processes */
+  ierr = DMCreateGlobalVector(dmnetwork,&X);CHKERRQ(ierr);
+  ierr = VecGetSize(X,&N);CHKERRQ(ierr);
+  ierr = DMNetworkGetSharedVertices(dmnetwork,&nv,&vtx);CHKERRQ(ierr);
+  for (j=0,i=0; i<nv; i++) {
+    ierr = DMNetworkIsGhostVertex(dmnetwork,vtx[i],&ghost);CHKERRQ(ierr);
+    if (!ghost) j++;
+  }
+  ierr = MPI_Allreduce(MPI_IN_PLACE,&j,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Num of shared vertices %D, size of the global vector %D\n",j,N);CHKERRQ(ierr);
+
+  /* Free work space */
+  ierr = VecDestroy(&X);CHKERRQ(ierr);
+  for (net=0; net<Nsubnet; net++) {
+    ierr = PetscFree(edgelist[net]);CHKERRQ(ierr);
+  }
+  ierr = DMDestroy(&dmnetwork);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: !single double define(PETSC_HAVE_ATTRIBUTEALIGNED)
+
+   test:
+      nsize: {{1 2 3 5}}
+      args: -options_left no
+      output_file: output/ex5_1.out
+
+   test:
+      suffix: 2
+      nsize: {{1 2 3 5}}
+      args: -nsubnet 3 -options_left no
+      output_file: output/ex5_2.out
+
+TEST*/
@@ -5,6 +5,7 @@
 #include <../src/ksp/pc/impls/gamg/gamg.h>           /*I "petscpc.h" I*/
 #include <../src/ksp/pc/impls/bjacobi/bjacobi.h> /* Hack to access same_local_solves */
 #include <../src/ksp/ksp/impls/cheby/chebyshevimpl.h>    /*I "petscksp.h" I*/
+#include <petscsf.h>
 
 #if defined(PETSC_HAVE_CUDA)
   #include <cuda_runtime.h>
@@ -52,6 +53,94 @@ PetscErrorCode PCReset_GAMG(PC pc)
   PetscFunctionReturn(0);
 }
 
+/* -------------------------------------------------------------------------- */
+/*
+   PCGAMGReductionModel_Private - Chooses the number of active processes for a coarse grid from a simple
+   cost model of MatMult() with measured parameters,
+
+     T(p) = t_nz nnz/p + t_lat min(p-1,nneigh)
+
+   t_nz is the time per nonzero of the local (diagonal block) product, measured on the slowest process,
+   t_lat is the message latency, estimated from the time of small MPI_Allreduce()s, and nneigh is the
+   largest number of processes any process receives from in MatMult() with the current layout.
+
+   Input Parameter:
+   . pc - the GAMG context, the decision is stored for the current level
+   . Cmat - the coarse grid operator with its current layout
+   . nactive - number of active processes
+   Output Parameter:
+   . a_new_size - number of processes minimizing the cost, at least one and at most nactive
+*/
+static PetscErrorCode PCGAMGReductionModel_Private(PC pc,Mat Cmat,PetscMPIInt nactive,PetscMPIInt *a_new_size)
+{
+  PetscErrorCode       ierr;
+  PC_MG                *mg       = (PC_MG*)pc->data;
+  PC_GAMG              *pc_gamg  = (PC_GAMG*)mg->innerctx;
+  PCGAMGReductionModel *model    = &pc_gamg->reduction_model[pc_gamg->current_level];
+  MPI_Comm             comm;
+  PetscMPIInt          size,p,one = 1,sum;
+  PetscBool            ismpiaij;
+  Mat                  Ad = Cmat;
+  Vec                  x,y;
+  MatInfo              info;
+  PetscInt             M,i,nrep = 5,nranks = 0,nneigh;
+  PetscLogDouble       t0,t1,nnz;
+  PetscReal            loc[2],glb[2],cost;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Cmat,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
+  ierr = PetscObjectBaseTypeCompare((PetscObject)Cmat,MATMPIAIJ,&ismpiaij);CHKERRQ(ierr);
+  if (ismpiaij) {
+    Mat_MPIAIJ *aij = (Mat_MPIAIJ*)Cmat->data;
+
+    Ad   = aij->A;
+    ierr = PetscSFSetUp(aij->Mvctx);CHKERRQ(ierr);
+    ierr = PetscSFGetRootRanks(aij->Mvctx,&nranks,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  }
+  /* time the local part of MatMult() */
+  ierr = MatGetInfo(Ad,MAT_LOCAL,&info);CHKERRQ(ierr);
+  ierr = MatCreateVecs(Ad,&x,&y);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+  ierr = MatMult(Ad,x,y);CHKERRQ(ierr); /* warm up */
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (i=0; i<nrep; i++) {ierr = MatMult(Ad,x,y);CHKERRQ(ierr);}
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  loc[0] = info.nz_used > 0 ? (PetscReal)((t1-t0)/nrep/info.nz_used) : 0.0;
+  /* time small reductions, a reduction costs about log2(size) latencies */
+  ierr = MPI_Barrier(comm);CHKERRMPI(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (i=0; i<nrep; i++) {ierr = MPI_Allreduce(&one,&sum,1,MPI_INT,MPI_SUM,comm);CHKERRMPI(ierr);}
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  loc[1] = size > 1 ? (PetscReal)((t1-t0)/nrep/PetscLog2Real((PetscReal)size)) : 0.0;
+  /* all processes must take the same decision */
+  ierr = MPIU_Allreduce(loc,glb,2,MPIU_REAL,MPIU_MAX,comm);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&nranks,&nneigh,1,MPIU_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  ierr = MatGetInfo(Cmat,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr);
+  ierr = MatGetSize(Cmat,&M,NULL);CHKERRQ(ierr);
+  nnz  = info.nz_used;
+
+  model->nactive  = nactive;
+  model->nneigh   = nneigh;
+  model->nz_time  = glb[0];
+  model->latency  = glb[1];
+  model->new_size = nactive;
+  model->cost[0]  = glb[0]*nnz/nactive + glb[1]*PetscMin(nactive-1,model->nneigh);
+  model->cost[1]  = model->cost[0];
+  for (p=1; p<nactive && p<=M; p++) {
+    cost = glb[0]*nnz/p + glb[1]*PetscMin(p-1,model->nneigh);
+    if (cost < model->cost[1]) {
+      model->cost[1]  = cost;
+      model->new_size = p;
+    }
+  }
+  *a_new_size = model->new_size;
+  ierr = PetscInfo5(pc,"Cost model: time/nonzero %g, latency %g, %D neighbors, reduce from %d to %d active processes\n",(double)model->nz_time,(double)model->latency,model->nneigh,nactive,model->new_size);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCGAMGCreateLevel_GAMG: create coarse op with RAP.  repartition and/or reduce number
@@ -135,6 +224,8 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   } else if (is_last && !pc_gamg->use_parallel_coarse_grid_solver) {
     new_size = 1;
     ierr = PetscInfo1(pc,"Force coarsest grid reduction to %d active processes\n",new_size);CHKERRQ(ierr);
+  } else if (pc_gamg->auto_rank_reduction) {
+    ierr = PCGAMGReductionModel_Private(pc,Cmat,nactive,&new_size);CHKERRQ(ierr);
   } else {
     PetscInt ncrs_eq_glob;
 #if defined(PETSC_HAVE_CUDA)
@@ -148,6 +239,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   }
   if (new_size==nactive) {
     *a_Amat_crs = Cmat; /* output - no repartitioning or reduction - could bail here */
+    pc_gamg->reduction_model[pc_gamg->current_level].used_size = nactive;
     if (new_size < size) {
       /* odd case where multiple coarse grids are on one processor or no coarsening ... */
       ierr = PetscInfo1(pc,"reduced grid using same number of processors (%d) as last grid (use larger coarse grid)\n",nactive);CHKERRQ(ierr);
@@ -186,6 +278,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
       new_size = size/rfactor; /* make new size one that is factor */
       if (new_size==nactive) { /* no repartitioning or reduction, bail out because nested here (rare) */
         *a_Amat_crs = Cmat;
+        pc_gamg->reduction_model[pc_gamg->current_level].used_size = nactive;
         ierr = PetscInfo2(pc,"Finding factorable processor set stopped reduction: new_size=%d, neq(loc)=%D\n",new_size,ncrs_eq);CHKERRQ(ierr);
         PetscFunctionReturn(0);
       }
@@ -432,6 +525,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
     ierr = ISDestroy(&new_eq_indices);CHKERRQ(ierr);
 
     *a_nactive_proc = new_size; /* output */
+    pc_gamg->reduction_model[pc_gamg->current_level].used_size = new_size;
 
     /* pinning on reduced grids, not a bad heuristic and optimization gets folded into process reduction optimization */
     if (pc_gamg->cpu_pin_coarse_grids) {
@@ -600,6 +694,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   nnztot = info.nz_used;
   ierr = PetscInfo6(pc,"level %D) N=%D, n data rows=%D, n data cols=%D, nnz/row (ave)=%d, np=%D\n",0,M,pc_gamg->data_cell_rows,pc_gamg->data_cell_cols,(int)(nnz0/(PetscReal)M+0.5),size);CHKERRQ(ierr);
 
+  ierr = PetscArrayzero(pc_gamg->reduction_model,PETSC_MG_MAXLEVELS);CHKERRQ(ierr);
   /* Get A_i and R_i */
   for (level=0, Aarr[0]=Pmat, nactivepe = size; level < (pc_gamg->Nlevels-1) && (!level || M>pc_gamg->coarse_eq_limit); level++) {
     pc_gamg->current_level = level;
@@ -1449,6 +1544,51 @@ static PetscErrorCode PCGAMGSetRankReductionFactors_GAMG(PC pc, PetscInt v[], Pe
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetAutoRankReduction - Choose the number of active processes on each coarse grid from a cost model of MatMult()
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  flg - PETSC_TRUE to use the cost model
+
+   Options Database Key:
+.  -pc_gamg_auto_rank_reduction <true,false>
+
+   Notes:
+   During the setup, the time per nonzero of the local matrix-vector product, the message latency and the number of
+   neighbors of each process are measured on every new coarse grid, and the number of active processes minimizing the
+   predicted time of MatMult() is used instead of the limit set with PCGAMGSetProcEqLim(). The measurements and the
+   decisions are printed by PCView(). A reduction factor set with PCGAMGSetRankReductionFactors() for a level has precedence.
+
+   Since the decisions depend on timings, they can differ from one run to the next.
+
+   Level: intermediate
+
+.seealso: PCGAMGSetProcEqLim(), PCGAMGSetRankReductionFactors(), PCGAMGSetRepartition()
+@*/
+PetscErrorCode PCGAMGSetAutoRankReduction(PC pc, PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetAutoRankReduction_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetAutoRankReduction_GAMG(PC pc, PetscBool flg)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->auto_rank_reduction = flg;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCGAMGSetThresholdScale - Relative threshold reduction at each level
 
@@ -1649,6 +1789,16 @@ static PetscErrorCode PCView_GAMG(PC pc,PetscViewer viewer)
   if (pc_gamg->ops->view) {
     ierr = (*pc_gamg->ops->view)(pc,viewer);CHKERRQ(ierr);
   }
+  if (pc_gamg->auto_rank_reduction) {
+    ierr = PetscViewerASCIIPrintf(viewer,"      Number of active processes chosen with a cost model of MatMult()\n");CHKERRQ(ierr);
+    for (i=0; i<PETSC_MG_MAXLEVELS; i++) {
+      PCGAMGReductionModel *model = &pc_gamg->reduction_model[i];
+
+      if (!model->nactive) continue;
+      ierr = PetscViewerASCIIPrintf(viewer,"        Level %D: %d --> %d active processes (%d chosen by the model)\n",(PetscInt)(i+1),model->nactive,model->used_size,model->new_size);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPrintf(viewer,"          time/nonzero %g, latency %g, %D neighbors, predicted MatMult() time %g --> %g\n",(double)model->nz_time,(double)model->latency,model->nneigh,(double)model->cost[0],(double)model->cost[1]);CHKERRQ(ierr);
+    }
+  }
   ierr = PCMGGetGridComplexity(pc,&gc);CHKERRQ(ierr);
   ierr = PetscViewerASCIIPrintf(viewer,"      Complexity:    grid = %g\n",gc);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1701,6 +1851,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
   if (!flag) i = 0;
   else i = n;
   do {pc_gamg->level_reduction_factors[i] = -1;} while (++i<PETSC_MG_MAXLEVELS);
+  ierr = PetscOptionsBool("-pc_gamg_auto_rank_reduction","Choose the number of active processes on coarse grids with a cost model of MatMult()","PCGAMGSetAutoRankReduction",pc_gamg->auto_rank_reduction,&pc_gamg->auto_rank_reduction,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-pc_mg_levels","Set number of MG levels","PCGAMGSetNlevels",pc_gamg->Nlevels,&pc_gamg->Nlevels,NULL);CHKERRQ(ierr);
   {
     PetscReal eminmax[2] = {0., 0.};
@@ -1732,6 +1883,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
 .   -pc_gamg_process_eq_limit <limit, default=50> - GAMG will reduce the number of MPI processes used directly on the coarse grids so that there are around <limit>
                                         equations on each process that has degrees of freedom
 .   -pc_gamg_coarse_eq_limit <limit, default=50> - Set maximum number of equations on coarsest grid to aim for.
+.   -pc_gamg_auto_rank_reduction <true,default=false> - choose the number of processes on the coarse grids from measured MatMult() and message times instead of <limit>
 .   -pc_gamg_threshold[] <thresh,default=0> - Before aggregating the graph GAMG will remove small values from the graph on each level
 -   -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
 
@@ -1756,7 +1908,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
   Level: intermediate
 
 .seealso:  PCCreate(), PCSetType(), MatSetBlockSize(), PCMGType, PCSetCoordinates(), MatSetNearNullSpace(), PCGAMGSetType(), PCGAMGAGG, PCGAMGGEO, PCGAMGCLASSICAL, PCGAMGSetProcEqLim(),
-           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation(), PCGAMGSetUseSAEstEig(), PCGAMGSetEstEigKSPMaxIt(), PCGAMGSetEstEigKSPType()
+           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation(), PCGAMGSetUseSAEstEig(), PCGAMGSetEstEigKSPMaxIt(), PCGAMGSetEstEigKSPType(), PCGAMGSetAutoRankReduction()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
@@ -1808,6 +1960,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCoarseGridLayoutType_C",PCGAMGSetCoarseGridLayoutType_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetThreshold_C",PCGAMGSetThreshold_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetRankReductionFactors_C",PCGAMGSetRankReductionFactors_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetAutoRankReduction_C",PCGAMGSetAutoRankReduction_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetThresholdScale_C",PCGAMGSetThresholdScale_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetType_C",PCGAMGSetType_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGGetType_C",PCGAMGGetType_GAMG);CHKERRQ(ierr);
@@ -1818,6 +1971,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   pc_gamg->use_parallel_coarse_grid_solver = PETSC_FALSE;
   pc_gamg->cpu_pin_coarse_grids = PETSC_FALSE;
   pc_gamg->layout_type      = PCGAMG_LAYOUT_SPREAD;
+  pc_gamg->auto_rank_reduction = PETSC_FALSE;
   pc_gamg->min_eq_proc      = 50;
   pc_gamg->coarse_eq_limit  = 50;
   for (i=0;i<PETSC_MG_MAXLEVELS;i++) pc_gamg->threshold[i] = 0.;
@@ -166,6 +166,8 @@ PetscErrorCode PCReset_MG(PC pc)
       ierr = MatDestroy(&mglevels[i+1]->restrct);CHKERRQ(ierr);
       ierr = MatDestroy(&mglevels[i+1]->interpolate);CHKERRQ(ierr);
       ierr = MatDestroy(&mglevels[i+1]->inject);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i+1]->sinterpolate);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i+1]->sinterpolateAP);CHKERRQ(ierr);
       ierr = VecDestroy(&mglevels[i+1]->rscale);CHKERRQ(ierr);
     }
     ierr = VecDestroy(&mglevels[n-1]->crx);CHKERRQ(ierr);
@@ -478,7 +480,7 @@ extern PetscErrorCode PCMGFCycle_Private(PC,PC_MG_Levels**);
 extern PetscErrorCode PCMGKCycle_Private(PC,PC_MG_Levels**);
 
 /*
-   PCApply_MG - Runs either an additive, multiplicative, Kaskadic
+   PCApply_MG - Runs either an additive (possibly with smoothed interpolation), multiplicative, Kaskadic
              or full cycle of multigrid.
 
   Note:
@@ -527,7 +529,7 @@ static PetscErrorCode PCApply_MG(PC pc,Vec b,Vec x)
     for (i=0; i<mg->cyclesperpcapply; i++) {
       ierr = PCMGMCycle_Private(pc,mglevels+levels-1,NULL);CHKERRQ(ierr);
     }
-  } else if (mg->am == PC_MG_ADDITIVE) {
+  } else if (mg->am == PC_MG_ADDITIVE || mg->am == PC_MG_MULTADDITIVE) {
     ierr = PCMGACycle_Private(pc,mglevels);CHKERRQ(ierr);
   } else if (mg->am == PC_MG_KASKADE) {
     ierr = PCMGKCycle_Private(pc,mglevels);CHKERRQ(ierr);
@@ -598,6 +600,9 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
       ierr = PCMGMultiplicativeSetCycles(pc,cycles);CHKERRQ(ierr);
     }
   }
+  if (mg->am == PC_MG_MULTADDITIVE) {
+    ierr = PetscOptionsReal("-pc_mg_multadditive_damping","Jacobi damping factor used to smooth the interpolation","None",mg->madamping,&mg->madamping,NULL);CHKERRQ(ierr);
+  }
   flg  = PETSC_FALSE;
   ierr = PetscOptionsBool("-pc_mg_log","Log times for each multigrid level","None",flg,&flg,NULL);CHKERRQ(ierr);
   if (flg) {
@@ -645,7 +650,7 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
   PetscFunctionReturn(0);
 }
 
-const char *const PCMGTypes[] = {"MULTIPLICATIVE","ADDITIVE","FULL","KASKADE","PCMGType","PC_MG",NULL};
+const char *const PCMGTypes[] = {"MULTIPLICATIVE","ADDITIVE","FULL","KASKADE","MULTADDITIVE","PCMGType","PC_MG",NULL};
 const char *const PCMGCycleTypes[] = {"invalid","v","w","PCMGCycleType","PC_MG_CYCLE",NULL};
 const char *const PCMGGalerkinTypes[] = {"both","pmat","mat","none","external","PCMGGalerkinType","PC_MG_GALERKIN",NULL};
 const char *const PCMGCoarseSpaceTypes[] = {"polynomial","harmonic","eigenvector","generalized_eigenvector","PCMGCoarseSpaceType","PCMG_POLYNOMIAL",NULL};
@@ -668,6 +673,8 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  type is %s, levels=%D cycles=%s\n", PCMGTypes[mg->am],levels,cyclename);CHKERRQ(ierr);
     if (mg->am == PC_MG_MULTIPLICATIVE) {
       ierr = PetscViewerASCIIPrintf(viewer,"    Cycles per PCApply=%d\n",mg->cyclesperpcapply);CHKERRQ(ierr);
+    } else if (mg->am == PC_MG_MULTADDITIVE) {
+      ierr = PetscViewerASCIIPrintf(viewer,"    Interpolation smoothed with Jacobi, damping factor=%g\n",(double)mg->madamping);CHKERRQ(ierr);
     }
     if (mg->galerkin == PC_MG_GALERKIN_BOTH) {
       ierr = PetscViewerASCIIPrintf(viewer,"    Using Galerkin computed coarse grid matrices\n");CHKERRQ(ierr);
@@ -1130,6 +1137,8 @@ PetscErrorCode PCSetUp_MG(PC pc)
   }
   if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
 
+  if (mg->am == PC_MG_MULTADDITIVE) {ierr = PCMGMultAdditiveSetUp_Private(pc);CHKERRQ(ierr);}
+
   /*
      Dump the interpolation/restriction matrices plus the
    Jacobian/stiffness on each level. This allows MATLAB users to
@@ -1204,11 +1213,11 @@ PetscErrorCode PCMGGetLevels(PC pc,PetscInt *levels)
    Input Parameters:
 +  pc - the preconditioner context
 -  form - multigrid form, one of PC_MG_MULTIPLICATIVE, PC_MG_ADDITIVE,
-   PC_MG_FULL, PC_MG_KASKADE
+   PC_MG_FULL, PC_MG_KASKADE, PC_MG_MULTADDITIVE
 
    Options Database Key:
 .  -pc_mg_type <form> - Sets <form>, one of multiplicative,
-   additive, full, kaskade
+   additive, full, kaskade, multadditive
 
    Level: advanced
 
@@ -1237,7 +1246,7 @@ PetscErrorCode  PCMGSetType(PC pc,PCMGType form)
 .  pc - the preconditioner context
 
    Output Parameter:
-.  type - one of PC_MG_MULTIPLICATIVE, PC_MG_ADDITIVE,PC_MG_FULL, PC_MG_KASKADE
+.  type - one of PC_MG_MULTIPLICATIVE, PC_MG_ADDITIVE,PC_MG_FULL, PC_MG_KASKADE, PC_MG_MULTADDITIVE
 
 
    Level: advanced
@@ -1739,7 +1748,8 @@ PetscErrorCode PCMGGetCoarseSpaceConstructor(const char name[], PetscErrorCode (
    Options Database Keys:
 +  -pc_mg_levels <nlevels> - number of levels including finest
 .  -pc_mg_cycle_type <v,w> - provide the cycle desired
-.  -pc_mg_type <additive,multiplicative,full,kaskade> - multiplicative is the default
+.  -pc_mg_type <additive,multiplicative,full,kaskade,multadditive> - multiplicative is the default
+.  -pc_mg_multadditive_damping <omega> - damping of the Jacobi smoother applied to the interpolation with -pc_mg_type multadditive (defaults to 2/3)
 .  -pc_mg_log - log information about time spent on each level of the solver
 .  -pc_mg_distinct_smoothup - configure up (after interpolation) and down (before restriction) smoothers separately (with different options prefixes)
 .  -pc_mg_galerkin <both,pmat,mat,none> - use Galerkin process to compute coarser operators, i.e. Acoarse = R A R'
@@ -1778,6 +1788,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_MG(PC pc)
   pc->data     = (void*)mg;
   mg->nlevels  = -1;
   mg->am       = PC_MG_MULTIPLICATIVE;
+  mg->madamping = 2.0/3.0;
   mg->galerkin = PC_MG_GALERKIN_NONE;
   mg->adaptInterpolation = PETSC_FALSE;
   mg->Nc                 = -1;
@@ -6,14 +6,16 @@
 
 PetscErrorCode PCMGACycle_Private(PC pc,PC_MG_Levels **mglevels)
 {
+  PC_MG          *mg = (PC_MG*)pc->data;
   PetscErrorCode ierr;
   PetscInt       i,l = mglevels[0]->levels;
+  PetscBool      smoothed = (mg->am == PC_MG_MULTADDITIVE) ? PETSC_TRUE : PETSC_FALSE;
 
   PetscFunctionBegin;
   /* compute RHS on each level */
   for (i=l-1; i>0; i--) {
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatRestrict(mglevels[i]->restrct,mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
+    ierr = MatRestrict(smoothed && mglevels[i]->sinterpolate ? mglevels[i]->sinterpolate : mglevels[i]->restrct,mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
   }
   /* solve separately on each level */
@@ -26,8 +28,72 @@ PetscErrorCode PCMGACycle_Private(PC pc,PC_MG_Levels **mglevels)
   }
   for (i=1; i<l; i++) {
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatInterpolateAdd(mglevels[i]->interpolate,mglevels[i-1]->x,mglevels[i]->x,mglevels[i]->x);CHKERRQ(ierr);
+    ierr = MatInterpolateAdd(smoothed && mglevels[i]->sinterpolate ? mglevels[i]->sinterpolate : mglevels[i]->interpolate,mglevels[i-1]->x,mglevels[i]->x,mglevels[i]->x);CHKERRQ(ierr);
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
 }
+
+/*
+   PCMGMultAdditiveSetUp_Private - Forms the smoothed interpolation used by the mult-additive cycle
+
+     Pbar_i = (I - omega D_i^{-1} A_i) P_i
+
+   where A_i and D_i are the operator on level i and its diagonal. The transpose of Pbar_i is used as the restriction
+   so the resulting preconditioner is symmetric whenever the level smoothers are. Since Pbar_i is formed explicitly
+   the restriction chain costs a single matrix-vector product per level, just as the plain additive cycle.
+
+   The product A_i P_i is kept, and while A_i and P_i are the same matrices with the same nonzero pattern Pbar_i is
+   recomputed in place with MAT_REUSE_MATRIX. Forming Pbar_i needs AIJ matrices; on levels where A_i or P_i is of
+   another type, such as MATMAIJ or MATSHELL, the unsmoothed interpolation and restriction are used instead.
+*/
+PetscErrorCode PCMGMultAdditiveSetUp_Private(PC pc)
+{
+  PC_MG            *mg        = (PC_MG*)pc->data;
+  PC_MG_Levels     **mglevels = mg->levels;
+  PetscErrorCode   ierr;
+  PetscInt         i,n = mglevels[0]->levels;
+  Mat              A,P;
+  Vec              dinv;
+  PetscObjectId    id[2];
+  PetscObjectState nz[2];
+  PetscBool        aijA,aijP;
+
+  PetscFunctionBegin;
+  for (i=1; i<n; i++) {
+    ierr = KSPGetOperators(mglevels[i]->smoothd,NULL,&A);CHKERRQ(ierr);
+    P    = mglevels[i]->interpolate;
+    ierr = PetscObjectBaseTypeCompareAny((PetscObject)A,&aijA,MATSEQAIJ,MATMPIAIJ,"");CHKERRQ(ierr);
+    ierr = PetscObjectBaseTypeCompareAny((PetscObject)P,&aijP,MATSEQAIJ,MATMPIAIJ,"");CHKERRQ(ierr);
+    if (!aijA || !aijP) {
+      ierr = PetscInfo3(pc,"Level %D: the smoothed interpolation needs AIJ matrices, not operator %s and interpolation %s; using the unsmoothed interpolation\n",i,((PetscObject)A)->type_name,((PetscObject)P)->type_name);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i]->sinterpolate);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i]->sinterpolateAP);CHKERRQ(ierr);
+      continue;
+    }
+    ierr = PetscObjectGetId((PetscObject)A,&id[0]);CHKERRQ(ierr);
+    ierr = PetscObjectGetId((PetscObject)P,&id[1]);CHKERRQ(ierr);
+    ierr = MatGetNonzeroState(A,&nz[0]);CHKERRQ(ierr);
+    ierr = MatGetNonzeroState(P,&nz[1]);CHKERRQ(ierr);
+    if (mglevels[i]->sinterpolateAP && id[0] == mglevels[i]->sinterpolateId[0] && id[1] == mglevels[i]->sinterpolateId[1] && nz[0] == mglevels[i]->sinterpolateNz[0] && nz[1] == mglevels[i]->sinterpolateNz[1]) {
+      ierr = MatMatMult(A,P,MAT_REUSE_MATRIX,PETSC_DEFAULT,&mglevels[i]->sinterpolateAP);CHKERRQ(ierr);
+      ierr = MatCopy(mglevels[i]->sinterpolateAP,mglevels[i]->sinterpolate,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    } else {
+      ierr = MatDestroy(&mglevels[i]->sinterpolate);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i]->sinterpolateAP);CHKERRQ(ierr);
+      ierr = MatMatMult(A,P,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&mglevels[i]->sinterpolateAP);CHKERRQ(ierr);
+      ierr = MatDuplicate(mglevels[i]->sinterpolateAP,MAT_COPY_VALUES,&mglevels[i]->sinterpolate);CHKERRQ(ierr);
+      mglevels[i]->sinterpolateId[0] = id[0]; mglevels[i]->sinterpolateId[1] = id[1];
+      mglevels[i]->sinterpolateNz[0] = nz[0]; mglevels[i]->sinterpolateNz[1] = nz[1];
+    }
+    ierr = MatCreateVecs(A,NULL,&dinv);CHKERRQ(ierr);
+    ierr = MatGetDiagonal(A,dinv);CHKERRQ(ierr);
+    ierr = VecReciprocal(dinv);CHKERRQ(ierr);
+    ierr = VecScale(dinv,-mg->madamping);CHKERRQ(ierr);
+    ierr = MatDiagonalScale(mglevels[i]->sinterpolate,dinv,NULL);CHKERRQ(ierr);
+    /* A has a nonzero diagonal, so the pattern of A P contains that of P */
+    ierr = MatAXPY(mglevels[i]->sinterpolate,1.0,P,SUBSET_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = VecDestroy(&dinv);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
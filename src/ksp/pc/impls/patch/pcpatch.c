@@ -5,6 +5,7 @@
 #include <petscsf.h>
 #include <petscbt.h>
 #include <petscds.h>
+#include <petscblaslapack.h>
 #include <../src/mat/impls/dense/seq/dense.h> /*I "petscmat.h" I*/
 
 PetscLogEvent PC_Patch_CreatePatches, PC_Patch_ComputeOp, PC_Patch_Solve, PC_Patch_Apply, PC_Patch_Prealloc;
@@ -2731,8 +2732,22 @@ static PetscErrorCode PCSetUp_PATCH(PC pc)
     ierr = VecSetUp(patch->patchUpdate);CHKERRQ(ierr);
     if (patch->save_operators) {
       ierr = PetscMalloc1(patch->npatch, &patch->mat);CHKERRQ(ierr);
+      if (patch->denseinverse) {
+        /* Store all patch inverses back to back so that the additive apply streams through one array */
+        ierr = PetscMalloc1(patch->npatch+1, &patch->denseOffsets);CHKERRQ(ierr);
+        patch->denseOffsets[0] = 0;
+        for (i = 0; i < patch->npatch; ++i) {
+          PetscInt dof;
+
+          ierr = PetscSectionGetDof(patch->gtolCounts, i+pStart, &dof);CHKERRQ(ierr);
+          patch->denseOffsets[i+1] = patch->denseOffsets[i] + dof*dof;
+        }
+        ierr = PetscCalloc1(patch->denseOffsets[patch->npatch], &patch->denseStorage);CHKERRQ(ierr);
+        ierr = PetscLogObjectMemory((PetscObject) pc, patch->denseOffsets[patch->npatch]*sizeof(PetscScalar));CHKERRQ(ierr);
+      }
       for (i = 0; i < patch->npatch; ++i) {
         ierr = PCPatchCreateMatrix_Private(pc, i, &patch->mat[i], PETSC_FALSE);CHKERRQ(ierr);
+        if (patch->denseinverse) {ierr = MatSeqDenseSetPreallocation(patch->mat[i], patch->denseStorage + patch->denseOffsets[i]);CHKERRQ(ierr);}
       }
     }
     ierr = PetscLogEventEnd(PC_Patch_CreatePatches, pc, 0, 0, 0);CHKERRQ(ierr);
@@ -2873,6 +2888,52 @@ static PetscErrorCode PCUpdateMultiplicative_PATCH_Linear(PC pc, PetscInt i, Pet
   PetscFunctionReturn(0);
 }
 
+/*
+  Additive application of the stored dense patch inverses. The patch inverses live back to back in
+  patch->denseStorage, so we gather, multiply and scatter directly on the arrays, without going
+  through the per-patch Vec/Mat interface.
+*/
+static PetscErrorCode PCApply_PATCH_DenseBatched_Private(PC pc, PetscInt pStart, PetscInt npatch, const PetscInt *iterationSet)
+{
+  PC_PATCH          *patch = (PC_PATCH *) pc->data;
+  const PetscScalar *localRHS;
+  PetscScalar       *localUpdate, *patchRHS, *patchUpdate;
+  const PetscInt    *gtolArray;
+  const PetscScalar  one = 1.0, zero = 0.0;
+  const PetscBLASInt ione = 1;
+  PetscLogDouble     flops = 0.0;
+  PetscInt           j, k;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(patch->localRHS, &localRHS);CHKERRQ(ierr);
+  ierr = VecGetArray(patch->localUpdate, &localUpdate);CHKERRQ(ierr);
+  ierr = VecGetArray(patch->patchRHS, &patchRHS);CHKERRQ(ierr);
+  ierr = VecGetArray(patch->patchUpdate, &patchUpdate);CHKERRQ(ierr);
+  ierr = ISGetIndices(patch->gtol, &gtolArray);CHKERRQ(ierr);
+  for (j = 0; j < npatch; ++j) {
+    const PetscInt i = iterationSet ? iterationSet[j] : j;
+    PetscInt       len, offset;
+    PetscBLASInt   bn;
+
+    ierr = PetscSectionGetDof(patch->gtolCounts, i+pStart, &len);CHKERRQ(ierr);
+    if (len <= 0) continue;
+    ierr = PetscSectionGetOffset(patch->gtolCounts, i+pStart, &offset);CHKERRQ(ierr);
+    ierr = PetscBLASIntCast(len, &bn);CHKERRQ(ierr);
+    for (k = 0; k < len; ++k) patchRHS[k] = localRHS[gtolArray[offset+k]];
+    PetscStackCallBLAS("BLASgemv", BLASgemv_("N", &bn, &bn, &one, patch->denseStorage + patch->denseOffsets[i], &bn, patchRHS, &ione, &zero, patchUpdate, &ione));
+    for (k = 0; k < len; ++k) localUpdate[gtolArray[offset+k]] += patchUpdate[k];
+    flops += 2.0*len*len;
+  }
+  ierr = ISRestoreIndices(patch->gtol, &gtolArray);CHKERRQ(ierr);
+  ierr = VecRestoreArray(patch->patchUpdate, &patchUpdate);CHKERRQ(ierr);
+  ierr = VecRestoreArray(patch->patchRHS, &patchRHS);CHKERRQ(ierr);
+  ierr = VecRestoreArray(patch->localUpdate, &localUpdate);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(patch->localRHS, &localRHS);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCApply_PATCH(PC pc, Vec x, Vec y)
 {
   PC_PATCH          *patch    = (PC_PATCH *) pc->data;
@@ -2911,6 +2972,13 @@ static PetscErrorCode PCApply_PATCH(PC pc, Vec x, Vec y)
   ierr = VecSet(patch->localUpdate, 0.0);CHKERRQ(ierr);
   ierr = PetscSectionGetChart(patch->gtolCounts, &pStart, NULL);CHKERRQ(ierr);
   ierr = PetscLogEventBegin(PC_Patch_Solve, pc, 0, 0, 0);CHKERRQ(ierr);
+  if (patch->denseStorage && !patch->isNonlinear && patch->local_composition_type == PC_COMPOSITE_ADDITIVE) {
+    /* The sweeps are independent for additive composition, so only the number of them matters */
+    for (sweep = 0; sweep < nsweep; sweep++) {
+      ierr = PCApply_PATCH_DenseBatched_Private(pc, pStart, end[0], patch->user_patches ? iterationSet : NULL);CHKERRQ(ierr);
+    }
+    nsweep = 0;
+  }
   for (sweep = 0; sweep < nsweep; sweep++) {
     for (j = start[sweep]; j*inc[sweep] < end[sweep]*inc[sweep]; j += inc[sweep]) {
       PetscInt i       = patch->user_patches ? iterationSet[j] : j;
@@ -3040,6 +3108,8 @@ static PetscErrorCode PCReset_PATCH(PC pc)
     for (i = 0; i < patch->npatch; ++i) {ierr = MatDestroy(&patch->mat[i]);CHKERRQ(ierr);}
     ierr = PetscFree(patch->mat);CHKERRQ(ierr);
   }
+  ierr = PetscFree(patch->denseStorage);CHKERRQ(ierr);
+  ierr = PetscFree(patch->denseOffsets);CHKERRQ(ierr);
   if (patch->matWithArtificial) {
     for (i = 0; i < patch->npatch; ++i) {ierr = MatDestroy(&patch->matWithArtificial[i]);CHKERRQ(ierr);}
     ierr = PetscFree(patch->matWithArtificial);CHKERRQ(ierr);
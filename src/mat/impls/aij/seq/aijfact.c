@@ -465,6 +465,8 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
   const PetscInt  *ddiag;
   PetscReal       rs;
   MatScalar       d;
+  PetscLogDouble  flops = 0.0;
+  PetscBool       rowsum;
 
   PetscFunctionBegin;
   /* MatPivotSetUp(): initialize shift context sctx */
@@ -488,6 +490,10 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
     sctx.shift_hi   = 1.;
   }
 
+  /* the row sums are only needed by the zero pivot tests of the shifted factorizations */
+  rowsum = (PetscBool)(info->shifttype == (PetscReal)MAT_SHIFT_NONZERO || info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE);
+  ierr = ISIdentity(isrow,&row_identity);CHKERRQ(ierr);
+  ierr = ISIdentity(isicol,&col_identity);CHKERRQ(ierr);
   ierr = ISGetIndices(isrow,&r);CHKERRQ(ierr);
   ierr = ISGetIndices(isicol,&ic);CHKERRQ(ierr);
   ierr = PetscMalloc1(n+1,&rtmp);CHKERRQ(ierr);
@@ -508,11 +514,16 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
       for  (j=0; j<nz; j++) rtmp[bjtmp[j]] = 0.0;
 
       /* load in initial (unfactored row) */
-      nz    = ai[r[i]+1] - ai[r[i]];
-      ajtmp = aj + ai[r[i]];
-      v     = aa + ai[r[i]];
-      for (j=0; j<nz; j++) {
-        rtmp[ics[ajtmp[j]]] = v[j];
+      if (row_identity && col_identity) {
+        nz    = ai[i+1] - ai[i];
+        ajtmp = aj + ai[i];
+        v     = aa + ai[i];
+        for (j=0; j<nz; j++) rtmp[ajtmp[j]] = v[j];
+      } else {
+        nz    = ai[r[i]+1] - ai[r[i]];
+        ajtmp = aj + ai[r[i]];
+        v     = aa + ai[r[i]];
+        for (j=0; j<nz; j++) rtmp[ics[ajtmp[j]]] = v[j];
       }
       /* ZeropivotApply() */
       rtmp[i] += sctx.shift_amount;  /* shift the diagonal of the matrix */
@@ -533,7 +544,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
           nz = bdiag[row]-bdiag[row+1]-1; /* num of entries in U(row,:) excluding diag */
 
           for (j=0; j<nz; j++) rtmp[pj[j]] -= multiplier * pv[j];
-          ierr = PetscLogFlops(1+2.0*nz);CHKERRQ(ierr);
+          flops += 1+2.0*nz;
         }
         row = *bjtmp++;
       }
@@ -544,17 +555,15 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
       pv = b->a + bi[i];
       pj = b->j + bi[i];
       nz = bi[i+1] - bi[i];
-      for (j=0; j<nz; j++) {
-        pv[j] = rtmp[pj[j]]; rs += PetscAbsScalar(pv[j]);
-      }
+      for (j=0; j<nz; j++) pv[j] = rtmp[pj[j]];
+      if (rowsum) for (j=0; j<nz; j++) rs += PetscAbsScalar(pv[j]);
 
       /* U part */
       pv = b->a + bdiag[i+1]+1;
       pj = b->j + bdiag[i+1]+1;
       nz = bdiag[i] - bdiag[i+1]-1;
-      for (j=0; j<nz; j++) {
-        pv[j] = rtmp[pj[j]]; rs += PetscAbsScalar(pv[j]);
-      }
+      for (j=0; j<nz; j++) pv[j] = rtmp[pj[j]];
+      if (rowsum) for (j=0; j<nz; j++) rs += PetscAbsScalar(pv[j]);
 
       sctx.rs = rs;
       sctx.pv = rtmp[i];
@@ -586,8 +595,6 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
   ierr = ISRestoreIndices(isicol,&ic);CHKERRQ(ierr);
   ierr = ISRestoreIndices(isrow,&r);CHKERRQ(ierr);
 
-  ierr = ISIdentity(isrow,&row_identity);CHKERRQ(ierr);
-  ierr = ISIdentity(isicol,&col_identity);CHKERRQ(ierr);
   if (b->inode.size) {
     C->ops->solve = MatSolve_SeqAIJ_Inode;
   } else if (row_identity && col_identity) {
@@ -602,7 +609,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
 
-  ierr = PetscLogFlops(C->cmap->n);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops + C->cmap->n);CHKERRQ(ierr);
 
   /* MatShiftView(A,info,&sctx) */
   if (sctx.nshift) {
@@ -2761,6 +2768,75 @@ PetscErrorCode MatICCFactorSymbolic_SeqAIJ_inplace(Mat fact,Mat A,IS perm,const
   PetscFunctionReturn(0);
 }
 
+/*
+   Computes the exact number of nonzeros in the Cholesky factor U of the permuted matrix A(rip,rip) from its elimination tree,
+   so that the symbolic factorization can allocate the factor once instead of growing it from a fill estimate.
+
+   Only the upper triangular part of the permuted matrix is used, as in MatCholeskyFactorSymbolic_SeqAIJ(). The row k of
+   L = U^T is traversed up the elimination tree (the row subtree) and every visited node j adds the entry U(j,k).
+   The cost is O(nnz(U)) with O(nnz(A)) extra memory, negligible compared to the merging of the rows.
+*/
+static PetscErrorCode MatCholeskyFactorSymbolicCount_SeqAIJ_Private(Mat A,const PetscInt rip[],const PetscInt riip[],PetscInt *nzu)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       am = A->rmap->n,*ai = a->i,*aj = a->j;
+  PetscInt       *li,*lj,*parent,*ancestor,*mark,i,j,k,next,total = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* li, lj: strictly lower triangular part of the permuted matrix, i.e. the transpose of the upper part used by the factorization */
+  ierr = PetscCalloc1(am+1,&li);CHKERRQ(ierr);
+  for (k=0; k<am; k++) {
+    for (j=ai[rip[k]]; j<ai[rip[k]+1]; j++) {
+      i = riip[aj[j]];
+      if (i > k) li[i+1]++;
+    }
+  }
+  for (k=0; k<am; k++) li[k+1] += li[k];
+  ierr = PetscMalloc4(li[am]+1,&lj,am,&parent,am,&ancestor,am,&mark);CHKERRQ(ierr);
+  for (k=0; k<am; k++) {
+    for (j=ai[rip[k]]; j<ai[rip[k]+1]; j++) {
+      i = riip[aj[j]];
+      if (i > k) lj[li[i]++] = k;
+    }
+  }
+  for (k=am; k>0; k--) li[k] = li[k-1];
+  li[0] = 0;
+
+  /* elimination tree with path compression */
+  for (k=0; k<am; k++) {
+    parent[k]   = -1;
+    ancestor[k] = -1;
+    for (j=li[k]; j<li[k+1]; j++) {
+      for (i=lj[j]; i != -1 && i < k; i=next) {
+        next        = ancestor[i];
+        ancestor[i] = k;
+        if (next == -1) parent[i] = k;
+      }
+    }
+  }
+
+  /* nzu[j] = 1 + number of row subtrees containing j */
+  for (k=0; k<am; k++) {
+    nzu[k]  = 1;
+    mark[k] = -1;
+  }
+  for (k=0; k<am; k++) {
+    mark[k] = k;
+    for (j=li[k]; j<li[k+1]; j++) {
+      for (i=lj[j]; mark[i] != k; i=parent[i]) {
+        nzu[i]++;
+        mark[i] = k;
+      }
+    }
+  }
+  for (k=0; k<am; k++) total += nzu[k];
+  ierr = PetscFree(li);CHKERRQ(ierr);
+  ierr = PetscFree4(lj,parent,ancestor,mark);CHKERRQ(ierr);
+  ierr = PetscInfo2(A,"Elimination tree predicts %D nonzeros in the factor of a matrix with %D nonzeros\n",total,ai[am]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS perm,const MatFactorInfo *info)
 {
   Mat_SeqAIJ         *a = (Mat_SeqAIJ*)A->data;
@@ -2803,8 +2879,10 @@ PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS perm,const Mat
   nlnk = am + 1;
   ierr = PetscLLCreate(am,am,nlnk,lnk,lnkbt);CHKERRQ(ierr);
 
-  /* initial FreeSpace size is fill*(ai[am]+am)/2 */
-  ierr          = PetscFreeSpaceGet(PetscRealIntMultTruncate(fill,(ai[am]+am)/2),&free_space);CHKERRQ(ierr);
+  /* the elimination tree gives the exact size of the factor, so the free space is obtained once */
+  ierr = MatCholeskyFactorSymbolicCount_SeqAIJ_Private(A,rip,riip,udiag);CHKERRQ(ierr);
+  for (k=0,nzk=0; k<am; k++) nzk += udiag[k];
+  ierr          = PetscFreeSpaceGet(nzk,&free_space);CHKERRQ(ierr);
   current_space = free_space;
 
   for (k=0; k<am; k++) {  /* for each active row k */
@@ -2922,8 +3000,6 @@ PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS perm,const Mat
   if (ai[am] != 0) {
     PetscReal af = fact->info.fill_ratio_needed;
     ierr = PetscInfo3(A,"Reallocs %D Fill ratio:given %g needed %g\n",reallocs,(double)fill,(double)af);CHKERRQ(ierr);
-    ierr = PetscInfo1(A,"Run with -pc_factor_fill %g or use \n",(double)af);CHKERRQ(ierr);
-    ierr = PetscInfo1(A,"PCFactorSetFill(pc,%g) for best performance.\n",(double)af);CHKERRQ(ierr);
   } else {
     ierr = PetscInfo(A,"Empty matrix\n");CHKERRQ(ierr);
   }
@@ -1165,6 +1165,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
   PetscInt        inod,nodesz,node_max,col;
   const PetscInt  *ns;
   PetscInt        *tmp_vec1,*tmp_vec2,*nsmap;
+  PetscLogDouble  flops = 0.0;
 
   PetscFunctionBegin;
   /* MatPivotSetUp(): initialize shift context sctx */
@@ -1278,7 +1279,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
             pv   = b->a + bdiag[row+1]+1;
             nz   = bdiag[row]-bdiag[row+1]-1; /* num of entries in U(row,:) excluding diag */
             for (j=0; j<nz; j++) rtmp1[pj[j]] -= mul1 * pv[j];
-            ierr = PetscLogFlops(1+2.0*nz);CHKERRQ(ierr);
+            flops += 1+2.0*nz;
           }
           row = *bjtmp++;
         }
@@ -1362,7 +1363,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
               rtmp1[col] -= mul1 * pv[j];
               rtmp2[col] -= mul2 * pv[j];
             }
-            ierr = PetscLogFlops(2+4.0*nz);CHKERRQ(ierr);
+            flops += 2+4.0*nz;
           }
           row = *bjtmp++;
         }
@@ -1403,7 +1404,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
           for (j=0; j<nz; j++) {
             col = pj[j]; rtmp2[col] -= mul1 * rtmp1[col];
           }
-          ierr = PetscLogFlops(1+2.0*nz);CHKERRQ(ierr);
+          flops += 1+2.0*nz;
         }
 
         /* finished row i+1; check zero pivot, then stick row i+1 into b->a */
@@ -1485,7 +1486,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
               rtmp2[col] -= mul2 * pv[j];
               rtmp3[col] -= mul3 * pv[j];
             }
-            ierr = PetscLogFlops(3+6.0*nz);CHKERRQ(ierr);
+            flops += 3+6.0*nz;
           }
           row = *bjtmp++;
         }
@@ -1529,7 +1530,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
             rtmp2[col] -= mul2 * rtmp1[col];
             rtmp3[col] -= mul3 * rtmp1[col];
           }
-          ierr = PetscLogFlops(2+4.0*nz);CHKERRQ(ierr);
+          flops += 2+4.0*nz;
         }
 
         /* finished row i+1; check zero pivot, then stick row i+1 into b->a */
@@ -1568,7 +1569,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
             col         = pj[j];
             rtmp3[col] -= mul3 * rtmp2[col];
           }
-          ierr = PetscLogFlops(1+2.0*nz);CHKERRQ(ierr);
+          flops += 1+2.0*nz;
         }
 
         /* finished i+2; check zero pivot, then stick row i+2 into b->a */
@@ -1651,7 +1652,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
               rtmp3[col] -= mul3 * pv[j];
               rtmp4[col] -= mul4 * pv[j];
             }
-            ierr = PetscLogFlops(4+8.0*nz);CHKERRQ(ierr);
+            flops += 4+8.0*nz;
           }
           row = *bjtmp++;
         }
@@ -1698,7 +1699,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
             rtmp3[col] -= mul3 * rtmp1[col];
             rtmp4[col] -= mul4 * rtmp1[col];
           }
-          ierr = PetscLogFlops(3+6.0*nz);CHKERRQ(ierr);
+          flops += 3+6.0*nz;
         }
 
         /* finished row i+1; check zero pivot, then stick row i+1 into b->a */
@@ -1740,7 +1741,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
             rtmp3[col] -= mul3 * rtmp2[col];
             rtmp4[col] -= mul4 * rtmp2[col];
           }
-          ierr = PetscLogFlops(4.0*nz);CHKERRQ(ierr);
+          flops += 4.0*nz;
         }
 
         /* finished i+2; check zero pivot, then stick row i+2 into b->a */
@@ -1779,7 +1780,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
             col         = pj[j];
             rtmp4[col] -= mul4 * rtmp3[col];
           }
-          ierr = PetscLogFlops(1+2.0*nz);CHKERRQ(ierr);
+          flops += 1+2.0*nz;
         }
 
         /* finished i+3; check zero pivot, then stick row i+3 into b->a */
@@ -1847,7 +1848,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
 
-  ierr = PetscLogFlops(C->cmap->n);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops + C->cmap->n);CHKERRQ(ierr);
 
   /* MatShiftView(A,info,&sctx) */
   if (sctx.nshift) {
@@ -0,0 +1,164 @@
+
+static char help[] = "Tests SeqAIJ Cholesky factorization with reordering against complete ICC, and SeqAIJ LU refactorization.\n\
+  Input parameters are:\n\
+  -lu : test LU refactorization instead of Cholesky\n\
+  -m <value>,-n <value> : grid dimensions\n\
+  -bs <value> : number of coupled unknowns per grid point\n\
+  -ordering <type> : matrix ordering used by the factorizations\n\
+  -fill <value> : expected fill given to the symbolic factorization\n\n";
+
+#include <petscmat.h>
+
+/* Five-point stencil with bs coupled unknowns per grid point; all the unknowns of a point share their nonzero pattern */
+static PetscErrorCode CreateMatrix(PetscInt m,PetscInt n,PetscInt bs,Mat *A)
+{
+  PetscInt       i,j,c,d,k,Ii,J,nb,nbrs[4];
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatCreate(PETSC_COMM_SELF,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m*n*bs,m*n*bs,m*n*bs,m*n*bs);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(*A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(*A,5*bs,NULL);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    for (j=0; j<n; j++) {
+      Ii = j + n*i; nb = 0;
+      if (i > 0)   nbrs[nb++] = Ii - n;
+      if (i < m-1) nbrs[nb++] = Ii + n;
+      if (j > 0)   nbrs[nb++] = Ii - 1;
+      if (j < n-1) nbrs[nb++] = Ii + 1;
+      for (c=0; c<bs; c++) {
+        for (d=0; d<bs; d++) {
+          v    = c == d ? 4.0 + bs : 0.5;
+          ierr = MatSetValue(*A,Ii*bs+c,Ii*bs+d,v,INSERT_VALUES);CHKERRQ(ierr);
+          for (k=0; k<nb; k++) {
+            J    = nbrs[k];
+            v    = c == d ? -1.0 : -0.1;
+            ierr = MatSetValue(*A,Ii*bs+c,J*bs+d,v,INSERT_VALUES);CHKERRQ(ierr);
+          }
+        }
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Solves with the factor F of A and returns the norm of the error */
+static PetscErrorCode CheckSolve(Mat F,Vec x,Vec b,Vec y,PetscReal *norm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatSolve(F,b,y);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,norm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,F,Ficc;
+  PetscInt       m = 6,n = 5,bs = 1,i;
+  PetscBool      lu = PETSC_FALSE;
+  PetscReal      fill = 1.0,norm,tol = 1000.*PETSC_MACHINE_EPSILON;
+  char           ordering[256] = MATORDERINGND;
+  IS             row,col;
+  MatFactorInfo  info;
+  MatInfo        minfo,minfo_icc;
+  Vec            x,y,b;
+  PetscRandom    rdm;
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRMPI(ierr);
+  if (size != 1) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_WRONG_MPI_SIZE,"This is a uniprocessor example only!");
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-fill",&fill,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetString(NULL,NULL,"-ordering",ordering,sizeof(ordering),NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-lu",&lu,NULL);CHKERRQ(ierr);
+
+  ierr = CreateMatrix(m,n,bs,&A);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rdm);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rdm);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rdm);CHKERRQ(ierr);
+  ierr = MatMult(A,x,b);CHKERRQ(ierr);
+  ierr = MatGetOrdering(A,ordering,&row,&col);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.fill = fill;
+
+  if (lu) {
+    /* LU, refactored after the values change as PCLU does with SAME_NONZERO_PATTERN; the natural ordering loads the rows
+       without the permutations, and the Inode kernel is used unless -mat_no_inode is given */
+    ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_LU,&F);CHKERRQ(ierr);
+    ierr = MatLUFactorSymbolic(F,A,row,col,&info);CHKERRQ(ierr);
+    for (i=0; i<2; i++) {
+      if (i) {
+        ierr = MatShift(A,1.0);CHKERRQ(ierr);
+        ierr = MatMult(A,x,b);CHKERRQ(ierr);
+      }
+      ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+      ierr = CheckSolve(F,x,b,y,&norm);CHKERRQ(ierr);
+      if (norm > tol) {ierr = PetscPrintf(PETSC_COMM_SELF,"LU factorization %D: norm of error %g\n",i,(double)norm);CHKERRQ(ierr);}
+    }
+    ierr = PetscPrintf(PETSC_COMM_SELF,"LU factorization and refactorization done\n");CHKERRQ(ierr);
+  } else {
+    /* Cholesky, whose symbolic factorization sizes the factor from the elimination tree */
+    ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_CHOLESKY,&F);CHKERRQ(ierr);
+    ierr = MatCholeskyFactorSymbolic(F,A,row,&info);CHKERRQ(ierr);
+    ierr = MatCholeskyFactorNumeric(F,A,&info);CHKERRQ(ierr);
+    ierr = MatGetInfo(F,MAT_LOCAL,&minfo);CHKERRQ(ierr);
+    ierr = CheckSolve(F,x,b,y,&norm);CHKERRQ(ierr);
+    if (norm > tol) {ierr = PetscPrintf(PETSC_COMM_SELF,"Cholesky: norm of error %g\n",(double)norm);CHKERRQ(ierr);}
+
+    /* ICC with enough levels for a complete factorization, whose factor grows with the levels of fill */
+    info.levels = m*n*bs;
+    info.fill   = PetscMax(fill,1.0);
+    ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ICC,&Ficc);CHKERRQ(ierr);
+    ierr = MatICCFactorSymbolic(Ficc,A,row,&info);CHKERRQ(ierr);
+    ierr = MatCholeskyFactorNumeric(Ficc,A,&info);CHKERRQ(ierr);
+    ierr = MatGetInfo(Ficc,MAT_LOCAL,&minfo_icc);CHKERRQ(ierr);
+    ierr = CheckSolve(Ficc,x,b,y,&norm);CHKERRQ(ierr);
+    if (norm > tol) {ierr = PetscPrintf(PETSC_COMM_SELF,"ICC: norm of error %g\n",(double)norm);CHKERRQ(ierr);}
+
+    if (minfo.nz_used != minfo_icc.nz_used) {
+      ierr = PetscPrintf(PETSC_COMM_SELF,"Cholesky factor has %g nonzeros, complete ICC factor %g\n",(double)minfo.nz_used,(double)minfo_icc.nz_used);CHKERRQ(ierr);
+    } else {
+      ierr = PetscPrintf(PETSC_COMM_SELF,"Cholesky and complete ICC factors have the same number of nonzeros\n");CHKERRQ(ierr);
+    }
+    ierr = MatDestroy(&Ficc);CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&F);CHKERRQ(ierr);
+  ierr = ISDestroy(&row);CHKERRQ(ierr);
+  ierr = ISDestroy(&col);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rdm);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: cholesky
+      args: -ordering {{nd rcm qmd}} -fill {{0.5 5.0}} -bs {{1 3}}
+      output_file: output/ex302_cholesky.out
+
+   test:
+      suffix: lu
+      args: -lu -ordering {{natural nd}} -mat_no_inode {{0 1}} -bs {{1 2 3 4}}
+      output_file: output/ex302_lu.out
+
+TEST*/
@@ -10,6 +10,7 @@ typedef enum {CENTROID, GRID, GRID_REPLICATED} PointType;
 typedef struct {
   PetscInt      dim;                          /* The topological mesh dimension */
   PetscBool     cellSimplex;                  /* Use simplices or hexes */
+  PetscInt      faces;                        /* The number of cells in each direction of the box mesh */
   char          filename[PETSC_MAX_PATH_LEN]; /* Import mesh from file */
   PointType     pointType;                    /* Point generation mechanism */
 } AppCtx;
@@ -36,12 +37,14 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   PetscFunctionBegin;
   options->dim           = 3;
   options->cellSimplex   = PETSC_TRUE;
+  options->faces         = 1;
   options->filename[0]   = '\0';
   options->pointType     = CENTROID;
 
   ierr = PetscOptionsBegin(comm, "", "Interpolation Options", "DMPLEX");CHKERRQ(ierr);
   ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex2.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-cell_simplex", "Use simplices if true, otherwise hexes", "ex2.c", options->cellSimplex, &options->cellSimplex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-faces", "The number of cells in each direction of the box mesh", "ex2.c", options->faces, &options->faces, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsString("-filename", "The mesh file", "ex2.c", options->filename, options->filename, sizeof(options->filename), NULL);CHKERRQ(ierr);
   pt   = options->pointType;
   ierr = PetscOptionsEList("-point_type", "The point type", "ex2.c", pointTypes, 3, pointTypes[options->pointType], &pt, NULL);CHKERRQ(ierr);
@@ -56,7 +59,7 @@ static PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *ctx, DM *dm)
   PetscInt       dim         = ctx->dim;
   PetscBool      cellSimplex = ctx->cellSimplex;
   const char    *filename    = ctx->filename;
-  const PetscInt cells[3]    = {1, 1, 1};
+  const PetscInt cells[3]    = {ctx->faces, ctx->faces, ctx->faces};
   size_t         len;
   PetscMPIInt    rank, size;
   PetscErrorCode ierr;
@@ -377,5 +380,14 @@ int main(int argc, char **argv)
     requires: ctetgen
     nsize: 2
     args: -petscspace_degree 1 -dm_refine 2 -point_type grid_replicated -petscpartitioner_type simple
+  test:
+    suffix: hex_grid
+    nsize: 3
+    args: -cell_simplex 0 -petscspace_degree 1 -dm_refine 1 -point_type grid -petscpartitioner_type simple
+  test:
+    # The interior grid points lie on partition boundaries
+    suffix: hex_grid_dist
+    nsize: 3
+    args: -cell_simplex 0 -faces 2 -petscspace_degree 1 -point_type {{grid grid_replicated}separate output} -petscpartitioner_type simple
 
 TEST*/
@@ -0,0 +1,164 @@
+static char help[] = "Tests the local finite difference Jacobian of DMDASetLocalFDJacobian() against MatFDColoring or SNESComputeJacobianDefault().\n\n";
+
+#include <petscdmda.h>
+#include <petscsnes.h>
+
+/* f_c(p) = x_c(p)^3 + sum over the stencil offsets o and components d of w(o,c,d) x_d(p+o)^2 */
+static PetscErrorCode FormFunctionLocal2d(DMDALocalInfo *info,PetscScalar **x,PetscScalar **f,void *ctx)
+{
+  PetscInt i,j,c,d,oi,oj,dof = info->dof,sw = info->sw;
+
+  PetscFunctionBeginUser;
+  for (j = info->ys; j < info->ys+info->ym; j++) {
+    for (i = info->xs; i < info->xs+info->xm; i++) {
+      for (c = 0; c < dof; c++) {
+        PetscScalar v = x[j][i*dof+c]*x[j][i*dof+c]*x[j][i*dof+c];
+
+        for (oj = -sw; oj <= sw; oj++) {
+          for (oi = -sw; oi <= sw; oi++) {
+            if (info->st == DMDA_STENCIL_STAR && oi && oj) continue;
+            if (info->bx != DM_BOUNDARY_PERIODIC && (i+oi < 0 || i+oi >= info->mx)) continue;
+            if (info->by != DM_BOUNDARY_PERIODIC && (j+oj < 0 || j+oj >= info->my)) continue;
+            for (d = 0; d < dof; d++) v += (1.0 + 0.1*c + 0.01*d)/(1 + PetscAbsInt(oi) + 2*PetscAbsInt(oj))*x[j+oj][(i+oi)*dof+d]*x[j+oj][(i+oi)*dof+d];
+          }
+        }
+        f[j][i*dof+c] = v;
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FormFunctionLocal3d(DMDALocalInfo *info,PetscScalar ***x,PetscScalar ***f,void *ctx)
+{
+  PetscInt i,j,k,c,d,oi,oj,ok,dof = info->dof,sw = info->sw;
+
+  PetscFunctionBeginUser;
+  for (k = info->zs; k < info->zs+info->zm; k++) {
+    for (j = info->ys; j < info->ys+info->ym; j++) {
+      for (i = info->xs; i < info->xs+info->xm; i++) {
+        for (c = 0; c < dof; c++) {
+          PetscScalar v = x[k][j][i*dof+c]*x[k][j][i*dof+c]*x[k][j][i*dof+c];
+
+          for (ok = -sw; ok <= sw; ok++) {
+            for (oj = -sw; oj <= sw; oj++) {
+              for (oi = -sw; oi <= sw; oi++) {
+                if (info->st == DMDA_STENCIL_STAR && ((oi && oj) || (oi && ok) || (oj && ok))) continue;
+                if (info->bx != DM_BOUNDARY_PERIODIC && (i+oi < 0 || i+oi >= info->mx)) continue;
+                if (info->by != DM_BOUNDARY_PERIODIC && (j+oj < 0 || j+oj >= info->my)) continue;
+                if (info->bz != DM_BOUNDARY_PERIODIC && (k+ok < 0 || k+ok >= info->mz)) continue;
+                for (d = 0; d < dof; d++) v += (1.0 + 0.1*c + 0.01*d)/(1 + PetscAbsInt(oi) + 2*PetscAbsInt(oj) + 3*PetscAbsInt(ok))*x[k+ok][j+oj][(i+oi)*dof+d]*x[k+ok][j+oj][(i+oi)*dof+d];
+              }
+            }
+          }
+          f[k][j][i*dof+c] = v;
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  SNES            snes;
+  DM              da;
+  Mat             A,B;
+  Vec             X;
+  PetscRandom     rand;
+  PetscInt        dim = 2,dof = 1,sw = 1,n = 15;
+  PetscBool       box = PETSC_FALSE,periodic = PETSC_FALSE,dense = PETSC_FALSE;
+  DMBoundaryType  bt;
+  DMDAStencilType st;
+  PetscReal       nrm,err;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD,NULL,"DMDA local finite difference Jacobian test","SNES");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim","The dimension, 2 or 3","",dim,&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dof","The number of components","",dof,&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sw","The stencil width","",sw,&sw,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-n","The number of grid points in each direction","",n,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-box","Use a box stencil","",box,&box,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-periodic","Use periodic boundaries","",periodic,&periodic,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dense_reference","Compare with SNESComputeJacobianDefault() instead of MatFDColoring","",dense,&dense,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+
+  bt = periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+  st = box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR;
+  if (dim == 2) {
+    ierr = DMDACreate2d(PETSC_COMM_WORLD,bt,bt,st,n,n,PETSC_DECIDE,PETSC_DECIDE,dof,sw,NULL,NULL,&da);CHKERRQ(ierr);
+  } else {
+    ierr = DMDACreate3d(PETSC_COMM_WORLD,bt,bt,bt,st,n,n,n,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,dof,sw,NULL,NULL,NULL,&da);CHKERRQ(ierr);
+  }
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+  if (dim == 2) {ierr = DMDASNESSetFunctionLocal(da,INSERT_VALUES,(DMDASNESFunction)FormFunctionLocal2d,NULL);CHKERRQ(ierr);}
+  else {ierr = DMDASNESSetFunctionLocal(da,INSERT_VALUES,(DMDASNESFunction)FormFunctionLocal3d,NULL);CHKERRQ(ierr);}
+  ierr = SNESCreate(PETSC_COMM_WORLD,&snes);CHKERRQ(ierr);
+  ierr = SNESSetDM(snes,da);CHKERRQ(ierr);
+  ierr = SNESSetFromOptions(snes);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(da,&X);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(X,rand);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,&A);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,&B);CHKERRQ(ierr);
+  if (dense) {
+    /* MatFDColoring does not handle periodic sizes which are not multiples of 2*sw+1 */
+    ierr = SNESComputeJacobianDefault(snes,X,A,A,NULL);CHKERRQ(ierr);
+  } else {
+    ierr = DMDASetLocalFDJacobian(da,PETSC_FALSE);CHKERRQ(ierr);
+    ierr = SNESComputeJacobian(snes,X,A,A);CHKERRQ(ierr);
+  }
+  ierr = DMDASetLocalFDJacobian(da,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = SNESComputeJacobian(snes,X,B,B);CHKERRQ(ierr);
+  ierr = MatNorm(A,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+  ierr = MatAXPY(B,-1.0,A,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(B,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Jacobians %s\n",err <= 1.e-4*nrm ? "match" : "differ");CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&X);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = SNESDestroy(&snes);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 2d
+      nsize: {{1 4}}
+      args: -dof {{1 3}} -box {{0 1}} -periodic {{0 1}}
+      output_file: output/ex70_1.out
+
+   test:
+      suffix: 2d_sw2
+      nsize: {{1 4}}
+      args: -dof 2 -sw 2 -box {{0 1}} -periodic {{0 1}}
+      output_file: output/ex70_1.out
+
+   test:
+      suffix: 3d
+      nsize: {{1 4}}
+      args: -dim 3 -n 6 -dof {{1 5}} -box {{0 1}} -periodic {{0 1}}
+      output_file: output/ex70_1.out
+
+   test:
+      suffix: 2d_periodic_odd
+      nsize: {{1 4}}
+      args: -periodic -dense_reference -dof 2 -sw 2 -n {{7 11}} -box {{0 1}}
+      output_file: output/ex70_1.out
+
+   test:
+      suffix: 3d_periodic_odd
+      nsize: {{1 4}}
+      args: -dim 3 -periodic -dense_reference -dof 2 -n {{7 8}} -box {{0 1}}
+      output_file: output/ex70_1.out
+
+TEST*/
@@ -28,6 +28,7 @@ typedef struct {
   PetscInt       debug;             /* The debugging level */
   RunType        runType;           /* Whether to run tests, or solve the full problem */
   PetscBool      jacobianMF;        /* Whether to calculate the Jacobian action on the fly */
+  PetscBool      closureDofIndex;   /* Whether to cache the closure dof indices of each cell */
   PetscLogEvent  createMeshEvent;
   PetscBool      showInitial, showSolution, restart, quiet, nonzInit;
   /* Domain and mesh definition */
@@ -466,6 +467,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   options->variableCoefficient = COEFF_NONE;
   options->fieldBC             = PETSC_FALSE;
   options->jacobianMF          = PETSC_FALSE;
+  options->closureDofIndex     = PETSC_FALSE;
   options->showInitial         = PETSC_FALSE;
   options->showSolution        = PETSC_FALSE;
   options->restart             = PETSC_FALSE;
@@ -510,6 +512,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
 
   ierr = PetscOptionsBool("-field_bc", "Use a field representation for the BC", "ex12.c", options->fieldBC, &options->fieldBC, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-jacobian_mf", "Calculate the action of the Jacobian on the fly", "ex12.c", options->jacobianMF, &options->jacobianMF, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-closure_dof_index", "Cache the closure dof indices of each cell", "ex12.c", options->closureDofIndex, &options->closureDofIndex, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-show_initial", "Output the initial guess for verification", "ex12.c", options->showInitial, &options->showInitial, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-show_solution", "Output the solution for verification", "ex12.c", options->showSolution, &options->showSolution, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-restart", "Read in the mesh and solution from a file", "ex12.c", options->restart, &options->restart, NULL);CHKERRQ(ierr);
@@ -1027,7 +1030,6 @@ int main(int argc, char **argv)
   Mat            A,J;         /* Jacobian matrix */
   MatNullSpace   nullSpace;   /* May be necessary for Neumann conditions */
   AppCtx         user;        /* user-defined work context */
-  JacActionCtx   userJ;       /* context for Jacobian MF action */
   PetscReal      error = 0.0; /* L_2 error in the solution */
   PetscBool      isFAS;
   PetscErrorCode ierr;
@@ -1046,27 +1048,16 @@ int main(int argc, char **argv)
   ierr = PetscObjectSetName((PetscObject) u, "potential");CHKERRQ(ierr);
 
   ierr = DMCreateMatrix(dm, &J);CHKERRQ(ierr);
-  if (user.jacobianMF) {
-    PetscInt M, m, N, n;
-
-    ierr = MatGetSize(J, &M, &N);CHKERRQ(ierr);
-    ierr = MatGetLocalSize(J, &m, &n);CHKERRQ(ierr);
-    ierr = MatCreate(PETSC_COMM_WORLD, &A);CHKERRQ(ierr);
-    ierr = MatSetSizes(A, m, n, M, N);CHKERRQ(ierr);
-    ierr = MatSetType(A, MATSHELL);CHKERRQ(ierr);
-    ierr = MatSetUp(A);CHKERRQ(ierr);
-#if 0
-    ierr = MatShellSetOperation(A, MATOP_MULT, (void (*)(void))FormJacobianAction);CHKERRQ(ierr);
-#endif
+  if (user.closureDofIndex) {
+    PetscSection section, globalSection;
 
-    userJ.dm   = dm;
-    userJ.J    = J;
-    userJ.user = &user;
-
-    ierr = DMCreateLocalVector(dm, &userJ.u);CHKERRQ(ierr);
-    if (user.fieldBC) {ierr = DMProjectFieldLocal(dm, 0.0, userJ.u, user.exactFields, INSERT_BC_VALUES, userJ.u);CHKERRQ(ierr);}
-    else              {ierr = DMProjectFunctionLocal(dm, 0.0, user.exactFuncs, NULL, INSERT_BC_VALUES, userJ.u);CHKERRQ(ierr);}
-    ierr = MatShellSetContext(A, &userJ);CHKERRQ(ierr);
+    ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+    ierr = DMGetGlobalSection(dm, &globalSection);CHKERRQ(ierr);
+    ierr = DMPlexCreateClosureDofIndex(dm, section, section);CHKERRQ(ierr);
+    ierr = DMPlexCreateClosureDofIndex(dm, section, globalSection);CHKERRQ(ierr);
+  }
+  if (user.jacobianMF) {
+    ierr = DMPlexSNESCreateJacobianMF(dm, NULL, &user, &A);CHKERRQ(ierr);
   } else {
     A = J;
   }
@@ -1238,7 +1229,6 @@ int main(int argc, char **argv)
   }
 
   ierr = MatNullSpaceDestroy(&nullSpace);CHKERRQ(ierr);
-  if (user.jacobianMF) {ierr = VecDestroy(&userJ.u);CHKERRQ(ierr);}
   if (A != J) {ierr = MatDestroy(&A);CHKERRQ(ierr);}
   ierr = MatDestroy(&J);CHKERRQ(ierr);
   ierr = VecDestroy(&u);CHKERRQ(ierr);
@@ -1710,6 +1700,26 @@ int main(int argc, char **argv)
     suffix: tensor_plex_3d
     args: -run_type test -refinement_limit 0.0 -simplex 0 -interpolate -bc_type dirichlet -petscspace_degree 1 -dim 3 -dm_refine_hierarchy 1 -cells 2,2,2
 
+  test:
+    suffix: tensor_plex_2d_closure_dof_index
+    output_file: output/ex12_tensor_plex_2d.out
+    args: -run_type test -refinement_limit 0.0 -simplex 0 -interpolate -bc_type dirichlet -petscspace_degree 1 -dm_refine_hierarchy 2 -cells 2,2 -closure_dof_index
+
+  test:
+    suffix: tensor_plex_2d_colored_assembly
+    output_file: output/ex12_tensor_plex_2d.out
+    args: -run_type test -refinement_limit 0.0 -simplex 0 -interpolate -bc_type dirichlet -petscspace_degree 1 -dm_refine_hierarchy 2 -cells 2,2 -dm_plex_colored_assembly
+
+  test:
+    suffix: tensor_plex_2d_no_adjacency_cache
+    output_file: output/ex12_tensor_plex_2d.out
+    args: -run_type test -refinement_limit 0.0 -simplex 0 -interpolate -bc_type dirichlet -petscspace_degree 1 -dm_refine_hierarchy 2 -cells 2,2 -dm_plex_cache_adjacency 0
+
+  test:
+    suffix: tensor_plex_2d_jacobian_mf
+    requires: !single
+    args: -run_type full -simplex 0 -interpolate -bc_type dirichlet -petscspace_degree 2 -cells 4,4 -jacobian_mf -ksp_type cg -pc_type jacobi -pc_use_amat -ksp_rtol 1.0e-10 -snes_monitor_short -snes_converged_reason ::ascii_info_detail
+
   test:
     suffix: tensor_p4est_3d
     requires: p4est
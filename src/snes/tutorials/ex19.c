@@ -1138,4 +1138,10 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
      suffix: asm_matconvert
      args: -mat_type aij -pc_type asm -pc_asm_sub_mat_type dense -snes_view
 
+   test:
+     # The interpolation is MATMAIJ, so the mult-additive cycle uses the unsmoothed interpolation
+     suffix: mg_multadditive_maij
+     requires: !single
+     args: -da_refine 2 -pc_type mg -pc_mg_type multadditive -ksp_type fgmres -snes_monitor_short -ksp_converged_reason
+
 TEST*/
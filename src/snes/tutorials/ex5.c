@@ -945,4 +945,14 @@ PetscErrorCode NonlinearGS(SNES snes,Vec X, Vec B, void *ctx)
      suffix: complex
      args: -snes_mf_operator -mat_mffd_complex -snes_monitor
 
+   test:
+     suffix: overlap
+     nsize: 4
+     args: -da_refine 2 -snes_monitor_short -snes_converged_reason -snes_fd_color -da_local_function_overlap
+
+   test:
+     suffix: mg_multadditive
+     requires: !single
+     args: -da_refine 3 -pc_type mg -pc_mg_type multadditive -ksp_type cg -snes_monitor_short -ksp_converged_reason
+
 TEST*/
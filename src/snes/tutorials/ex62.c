@@ -750,6 +750,15 @@ int main(int argc, char **argv)
       -ksp_type fgmres -ksp_atol 1e-5 -ksp_error_if_not_converged \
       -pc_type patch -pc_patch_partition_of_unity 0 -pc_patch_construct_codim 0 -pc_patch_construct_type vanka \
         -pc_patch_dense_inverse -pc_patch_sub_mat_type seqdense
+  test:
+    suffix: 2d_q1_p0_vanka_batched
+    requires: double !complex
+    args: -sol quadratic -dm_plex_box_simplex 0 -dm_refine 2 -vel_petscspace_degree 1 -pres_petscspace_degree 0 -petscds_jac_pre 0 \
+      -snes_rtol 1.0e-4 -snes_monitor_short -snes_converged_reason \
+      -ksp_type fgmres -ksp_atol 1e-5 -ksp_error_if_not_converged -ksp_monitor_short \
+      -pc_type patch -pc_patch_partition_of_unity 0 -pc_patch_construct_codim 0 -pc_patch_construct_type vanka \
+        -pc_patch_dense_inverse {{0 1}} -pc_patch_sub_mat_type seqdense -sub_ksp_type preonly -sub_pc_type lu -options_left no
+    output_file: output/ex62_2d_q1_p0_vanka_batched.out
   #   Vanka smoother
   test:
     suffix: 2d_q1_p0_gmg_vanka
@@ -1,5 +1,5 @@
 #include <petscdmda.h>          /*I "petscdmda.h" I*/
-#include <petsc/private/dmimpl.h>
+#include <petsc/private/dmdaimpl.h>
 #include <petsc/private/snesimpl.h>   /*I "petscsnes.h" I*/
 
 /* This structure holds the user-provided DMDA callbacks */
@@ -63,6 +63,7 @@ static PetscErrorCode SNESComputeFunction_DMDA(SNES snes,Vec X,Vec F,void *ctx)
   DMDALocalInfo  info;
   Vec            Xloc;
   void           *x,*f;
+  PetscBool      overlap;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(snes,SNES_CLASSID,1);
@@ -71,6 +72,40 @@ static PetscErrorCode SNESComputeFunction_DMDA(SNES snes,Vec X,Vec F,void *ctx)
   if (!dmdasnes->residuallocal) SETERRQ(PetscObjectComm((PetscObject)snes),PETSC_ERR_PLIB,"Corrupt context");
   ierr = SNESGetDM(snes,&dm);CHKERRQ(ierr);
   ierr = DMGetLocalVector(dm,&Xloc);CHKERRQ(ierr);
+  ierr = DMDAGetLocalFunctionOverlap(dm,&overlap);CHKERRQ(ierr);
+  if (overlap && dmdasnes->residuallocalimode == INSERT_VALUES) {
+    DMDALocalInfo binfo[6];
+    PetscInt      nb,b;
+
+    /* Compute the interior box from the owned values while the ghost update is in flight, then the boundary slabs */
+    ierr = DMDAGetLocalInfoSplit(dm,&info,&nb,binfo);CHKERRQ(ierr);
+    ierr = DMDAGlobalToLocalOwned(dm,X,Xloc);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+    ierr = DMDAVecGetArray(dm,F,&f);CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(SNES_FunctionEval,snes,X,F,0);CHKERRQ(ierr);
+    if (info.xm && info.ym && info.zm) {
+      ierr = DMDAVecGetArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+      CHKMEMQ;
+      ierr = (*dmdasnes->residuallocal)(&info,x,f,dmdasnes->residuallocalctx);CHKERRQ(ierr);
+      CHKMEMQ;
+      ierr = DMDAVecRestoreArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+    }
+    ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+    ierr = DMDAVecGetArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+    for (b = 0; b < nb; ++b) {
+      CHKMEMQ;
+      ierr = (*dmdasnes->residuallocal)(&binfo[b],x,f,dmdasnes->residuallocalctx);CHKERRQ(ierr);
+      CHKMEMQ;
+    }
+    ierr = DMDAVecRestoreArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(SNES_FunctionEval,snes,X,F,0);CHKERRQ(ierr);
+    ierr = DMDAVecRestoreArray(dm,F,&f);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&Xloc);CHKERRQ(ierr);
+    if (snes->domainerror) {
+      ierr = VecSetInf(F);CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+  }
   ierr = DMGlobalToLocalBegin(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
   ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
   ierr = DMDAGetLocalInfo(dm,&info);CHKERRQ(ierr);
@@ -139,6 +174,261 @@ static PetscErrorCode SNESComputeObjective_DMDA(SNES snes,Vec X,PetscReal *ob,vo
   PetscFunctionReturn(0);
 }
 
+PETSC_STATIC_INLINE PetscInt DMDASNESGCD_Private(PetscInt a,PetscInt b)
+{
+  while (b) {PetscInt t = a % b; a = b; b = t;}
+  return a;
+}
+
+/*
+  Colors the ghosted points so that the points of every stencil have distinct colors, either linearly, c = (a[0] i + a[1] j
+  + a[2] k) mod m, or as the product of the colorings i mod m[0], j mod m[1] and k mod m[2], whichever has fewer colors.
+  In periodic directions the coloring must be invariant under a shift by the grid size, so that the ghost copies of a
+  point have its color. Returns the color of each ghosted point and omap[kc*ncolors+qc], the stencil offset of the point
+  of color kc in the stencil around a point of color qc, or -1. Returns ncolors = 0 if no coloring is small enough.
+  MatFDColoring cannot handle periodic sizes which are not multiples of 2*sw+1 either, so the product coloring is
+  accepted up to 64 times the stencil size, which only bounds the size of omap.
+*/
+static PetscErrorCode DMDASNESFDColoring_Private(DMDALocalInfo *info,PetscInt noff,const PetscInt off[],PetscInt *ncolors,PetscInt **gcolor,PetscInt **omap)
+{
+  const PetscInt       M[3]  = {info->mx,info->my,info->mz};
+  const DMBoundaryType bt[3] = {info->bx,info->by,info->bz};
+  PetscInt             nd = 0,m[3] = {1,1,1},A[3][3] = {{0,0,0},{0,0,0},{0,0,0}},stride[3],nprod = 1;
+  PetscInt             mm,o,d,c,e,kc,qc,i,j,k,l,step[3],t[3],*dmap;
+  PetscBool            ok;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  *ncolors = 0;
+  for (d = 0; d < info->dim; ++d) {
+    for (m[d] = 2*info->sw+1; bt[d] == DM_BOUNDARY_PERIODIC && M[d] % m[d]; ++m[d]) ;
+    nprod *= m[d];
+  }
+  ierr = PetscMalloc1(PetscMax(nprod,2*noff),&dmap);CHKERRQ(ierr);
+  for (mm = noff; mm < nprod && mm <= 2*noff && !nd; ++mm) {
+    for (d = 0; d < 3; ++d) step[d] = (d < info->dim && bt[d] == DM_BOUNDARY_PERIODIC) ? mm/DMDASNESGCD_Private(M[d],mm) : 1;
+    for (t[2] = 0; t[2] < (info->dim > 2 ? mm : 1) && !nd; t[2] += step[2]) {
+      for (t[1] = 0; t[1] < (info->dim > 1 ? mm : 1) && !nd; t[1] += step[1]) {
+        for (t[0] = step[0]; t[0] < (step[0] > 1 ? mm : 2) && !nd; t[0] += step[0]) {
+          for (c = 0; c < mm; ++c) dmap[c] = -1;
+          for (o = 0, ok = PETSC_TRUE; o < noff && ok; ++o) {
+            c = ((t[0]*off[3*o] + t[1]*off[3*o+1] + t[2]*off[3*o+2]) % mm + mm) % mm;
+            if (dmap[c] >= 0) ok = PETSC_FALSE;
+            else dmap[c] = o;
+          }
+          if (ok) {nd = 1; m[0] = mm; m[1] = m[2] = 1; A[0][0] = t[0]; A[0][1] = t[1]; A[0][2] = t[2];}
+        }
+      }
+    }
+  }
+  if (!nd) {
+    if (nprod > 64*noff) {ierr = PetscFree(dmap);CHKERRQ(ierr); PetscFunctionReturn(0);}
+    nd = info->dim;
+    for (d = 0; d < nd; ++d) A[d][d] = 1;
+  }
+  stride[0] = 1;
+  for (d = 1; d < 3; ++d) stride[d] = stride[d-1]*m[d-1];
+  *ncolors = m[0]*m[1]*m[2];
+  for (c = 0; c < *ncolors; ++c) dmap[c] = -1;
+  for (o = 0; o < noff; ++o) {
+    for (d = 0, c = 0; d < nd; ++d) c += ((A[d][0]*off[3*o] + A[d][1]*off[3*o+1] + A[d][2]*off[3*o+2]) % m[d] + m[d]) % m[d]*stride[d];
+    dmap[c] = o;
+  }
+  ierr = PetscMalloc2(info->gxm*info->gym*info->gzm,gcolor,*ncolors**ncolors,omap);CHKERRQ(ierr);
+  for (k = info->gzs, l = 0; k < info->gzs+info->gzm; ++k) for (j = info->gys; j < info->gys+info->gym; ++j) for (i = info->gxs; i < info->gxs+info->gxm; ++i, ++l) {
+    for (d = 0, c = 0; d < nd; ++d) c += ((A[d][0]*i + A[d][1]*j + A[d][2]*k) % m[d] + m[d]) % m[d]*stride[d];
+    (*gcolor)[l] = c;
+  }
+  for (kc = 0; kc < *ncolors; ++kc) {
+    for (qc = 0; qc < *ncolors; ++qc) {
+      for (d = 0, c = 0; d < nd; ++d) {
+        e  = (kc/stride[d]) % m[d] - (qc/stride[d]) % m[d];
+        c += (e + m[d]) % m[d]*stride[d];
+      }
+      (*omap)[kc**ncolors+qc] = dmap[c];
+    }
+  }
+  ierr = PetscFree(dmap);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Finite difference Jacobian of the local residual function from one ghost update, see DMDASetLocalFDJacobian(). Sets
+  done to PETSC_FALSE, without computing anything, when MatFDColoring must be used instead.
+*/
+static PetscErrorCode SNESComputeJacobianLocalFD_DMDA(SNES snes,Vec X,Mat B,DMSNES_DA *dmdasnes,PetscBool *done)
+{
+  DM                     dm;
+  DM_DA                  *dd;
+  DMDALocalInfo          info;
+  ISLocalToGlobalMapping ltog;
+  Vec                    Xloc,X0loc,F0loc,Floc;
+  void                   *x,*x0,*f,*f0;
+  PetscScalar            *xa,*h,*blk;
+  const PetscScalar      *x0a,*fa,*f0a;
+  PetscReal              epsilon = PETSC_SQRT_MACHINE_EPSILON,umin = 100.0*PETSC_SQRT_MACHINE_EPSILON;
+  PetscInt               *off,*dl,*gcolor = NULL,*omap = NULL,*cstart,*cpts,*lastc,*rows,*cols,col,m,noff,sw,dof,ng,nb,o,i,j,k,l,p,lq,lp,r,c,e,kc;
+  char                   htype[8] = "ds";
+  PetscBool              localfd,ds;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  ierr  = SNESGetDM(snes,&dm);CHKERRQ(ierr);
+  ierr  = DMDAGetLocalFDJacobian(dm,&localfd);CHKERRQ(ierr);
+  if (!localfd || dmdasnes->residuallocalimode != INSERT_VALUES) PetscFunctionReturn(0);
+  dd   = (DM_DA*)dm->data;
+  ierr = DMDAGetLocalInfo(dm,&info);CHKERRQ(ierr);
+  ierr = MatGetLocalToGlobalMapping(B,&ltog,NULL);CHKERRQ(ierr);
+  sw   = info.sw;
+  dof  = info.dof;
+  {
+    const PetscInt       M[3]  = {info.mx,info.my,info.mz};
+    const DMBoundaryType bt[3] = {info.bx,info.by,info.bz};
+    PetscInt             d;
+
+    for (d = 0; d < info.dim; ++d) {
+      if ((bt[d] != DM_BOUNDARY_NONE && bt[d] != DM_BOUNDARY_PERIODIC) || (bt[d] == DM_BOUNDARY_PERIODIC && M[d] < 2*sw+1)) {
+        ierr = PetscInfo(snes,"Local finite difference Jacobian needs DM_BOUNDARY_NONE or DM_BOUNDARY_PERIODIC with at least 2*s+1 points, using MatFDColoring\n");CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+      }
+    }
+  }
+  ierr = PetscOptionsGetString(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-mat_fd_type",htype,sizeof(htype),NULL);CHKERRQ(ierr);
+  ierr = PetscStrcmp(htype,"ds",&ds);CHKERRQ(ierr);
+  if (dd->dfill || dd->ofill || !ltog || !ds) {
+    ierr = PetscInfo(snes,"Local finite difference Jacobian needs the matrix of DMCreateMatrix() without block fills and -mat_fd_type ds, using MatFDColoring\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  /* The stencil offsets and a coloring of the grid in which they have distinct colors */
+  noff = (2*sw+1)*(info.dim > 1 ? 2*sw+1 : 1)*(info.dim > 2 ? 2*sw+1 : 1);
+  ierr = PetscMalloc2(3*noff,&off,noff,&dl);CHKERRQ(ierr);
+  noff = 0;
+  for (k = (info.dim > 2 ? -sw : 0); k <= (info.dim > 2 ? sw : 0); ++k) {
+    for (j = (info.dim > 1 ? -sw : 0); j <= (info.dim > 1 ? sw : 0); ++j) {
+      for (i = -sw; i <= sw; ++i) {
+        if (info.st == DMDA_STENCIL_STAR && ((i && j) || (i && k) || (j && k))) continue;
+        off[3*noff] = i; off[3*noff+1] = j; off[3*noff+2] = k;
+        dl[noff]    = (k*info.gym + j)*info.gxm + i;
+        ++noff;
+      }
+    }
+  }
+  ierr = DMDASNESFDColoring_Private(&info,noff,off,&m,&gcolor,&omap);CHKERRQ(ierr);
+  if (!m) {
+    ierr = PetscInfo(snes,"No small stencil coloring fits the periodic grid sizes, using MatFDColoring\n");CHKERRQ(ierr);
+    ierr = PetscFree2(off,dl);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscInfo3(snes,"Local finite difference Jacobian with %D colors of %D stencil points and %D components\n",m,noff,dof);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-mat_fd_coloring_err",&epsilon,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-mat_fd_coloring_umin",&umin,NULL);CHKERRQ(ierr);
+
+  ierr = DMGetLocalVector(dm,&X0loc);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&Xloc);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&F0loc);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&Floc);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm,X,INSERT_VALUES,X0loc);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,X0loc);CHKERRQ(ierr);
+  ierr = VecCopy(X0loc,Xloc);CHKERRQ(ierr);
+
+  /* Ghosted points bucketed by color, and the inverse perturbations as in MatFDColoring */
+  ng   = info.gxm*info.gym*info.gzm;
+  nb   = noff*dof*dof;
+  ierr = PetscCalloc3(m+1,&cstart,ng,&cpts,info.xm*info.ym*info.zm*nb,&blk);CHKERRQ(ierr);
+  ierr = PetscMalloc4(ng*dof,&h,dof,&rows,noff*dof,&cols,m,&lastc);CHKERRQ(ierr);
+  for (l = 0; l < ng; ++l) ++cstart[gcolor[l]+1];
+  for (kc = 0; kc < m; ++kc) cstart[kc+1] += cstart[kc];
+  for (l = 0; l < ng; ++l) cpts[cstart[gcolor[l]]++] = l;
+  for (kc = m; kc > 0; --kc) cstart[kc] = cstart[kc-1];
+  cstart[0] = 0;
+  /* The row block of a point is complete after the last color which perturbs one of its stencil points */
+  for (l = 0; l < m; ++l) for (kc = 0, lastc[l] = -1; kc < m; ++kc) if (omap[kc*m + l] >= 0) lastc[l] = kc;
+  ierr = VecGetArrayRead(X0loc,&x0a);CHKERRQ(ierr);
+  for (l = 0; l < ng*dof; ++l) {
+    PetscScalar dx = x0a[l];
+
+    if (PetscAbsScalar(dx) < umin) dx = PetscRealPart(dx) >= 0.0 ? umin : -umin;
+    h[l] = 1.0/(epsilon*dx);
+  }
+
+  ierr = DMDAVecGetArrayRead(dm,X0loc,&x0);CHKERRQ(ierr);
+  ierr = DMDAVecGetArray(dm,F0loc,&f0);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(SNES_FunctionEval,snes,X,0,0);CHKERRQ(ierr);
+  CHKMEMQ;
+  ierr = (*dmdasnes->residuallocal)(&info,x0,f0,dmdasnes->residuallocalctx);CHKERRQ(ierr);
+  CHKMEMQ;
+  ierr = PetscLogEventEnd(SNES_FunctionEval,snes,X,0,0);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArray(dm,F0loc,&f0);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArrayRead(dm,X0loc,&x0);CHKERRQ(ierr);
+
+  ierr = VecGetArrayRead(F0loc,&f0a);CHKERRQ(ierr);
+  ierr = VecGetArray(Xloc,&xa);CHKERRQ(ierr);
+  ierr = DMDAVecGetArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+  for (kc = 0; kc < m; ++kc) {
+    /* A color without ghosted points on this process needs no residual, but may still complete row blocks */
+    for (c = 0; c < dof && cstart[kc] < cstart[kc+1]; ++c) {
+      /* Perturb component c of all copies of the points of color kc, ghosts included, and difference the owned residual */
+      for (e = cstart[kc]; e < cstart[kc+1]; ++e) xa[cpts[e]*dof+c] += 1.0/h[cpts[e]*dof+c];
+      ierr = DMDAVecGetArray(dm,Floc,&f);CHKERRQ(ierr);
+      ierr = PetscLogEventBegin(SNES_FunctionEval,snes,X,0,0);CHKERRQ(ierr);
+      CHKMEMQ;
+      ierr = (*dmdasnes->residuallocal)(&info,x,f,dmdasnes->residuallocalctx);CHKERRQ(ierr);
+      CHKMEMQ;
+      ierr = PetscLogEventEnd(SNES_FunctionEval,snes,X,0,0);CHKERRQ(ierr);
+      ierr = DMDAVecRestoreArray(dm,Floc,&f);CHKERRQ(ierr);
+      for (e = cstart[kc]; e < cstart[kc+1]; ++e) xa[cpts[e]*dof+c] = x0a[cpts[e]*dof+c];
+
+      /* Each owned point stores the column of its row block for the one perturbed stencil point, stencil points outside
+         the domain have no column */
+      ierr = VecGetArrayRead(Floc,&fa);CHKERRQ(ierr);
+      p    = 0;
+      for (k = info.zs; k < info.zs+info.zm; ++k) for (j = info.ys; j < info.ys+info.ym; ++j) for (i = info.xs; i < info.xs+info.xm; ++i, ++p) {
+        lq = ((k-info.gzs)*info.gym + (j-info.gys))*info.gxm + (i-info.gxs);
+        o  = omap[kc*m + gcolor[lq]];
+        if (o < 0) continue;
+        if (i+off[3*o] < info.gxs || i+off[3*o] >= info.gxs+info.gxm || j+off[3*o+1] < info.gys || j+off[3*o+1] >= info.gys+info.gym || k+off[3*o+2] < info.gzs || k+off[3*o+2] >= info.gzs+info.gzm) continue;
+        col = (lq + dl[o])*dof + c;
+        for (r = 0; r < dof; ++r) blk[p*nb + r*noff*dof + o*dof + c] = (fa[lq*dof+r] - f0a[lq*dof+r])*h[col];
+      }
+      ierr = VecRestoreArrayRead(Floc,&fa);CHKERRQ(ierr);
+    }
+
+    /* The row blocks completed by this color are inserted at once, with negative indices for the columns outside the domain */
+    p = 0;
+    for (k = info.zs; k < info.zs+info.zm; ++k) for (j = info.ys; j < info.ys+info.ym; ++j) for (i = info.xs; i < info.xs+info.xm; ++i, ++p) {
+      lq = ((k-info.gzs)*info.gym + (j-info.gys))*info.gxm + (i-info.gxs);
+      if (lastc[gcolor[lq]] != kc) continue;
+      for (o = 0; o < noff; ++o) {
+        const PetscBool in = (PetscBool)!(i+off[3*o] < info.gxs || i+off[3*o] >= info.gxs+info.gxm || j+off[3*o+1] < info.gys || j+off[3*o+1] >= info.gys+info.gym || k+off[3*o+2] < info.gzs || k+off[3*o+2] >= info.gzs+info.gzm);
+
+        lp = lq + dl[o];
+        for (c = 0; c < dof; ++c) cols[o*dof+c] = in ? lp*dof + c : -1;
+      }
+      for (r = 0; r < dof; ++r) rows[r] = lq*dof + r;
+      ierr = MatSetValuesLocal(B,dof,rows,noff*dof,cols,&blk[p*nb],INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = DMDAVecRestoreArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(Xloc,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(F0loc,&f0a);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(X0loc,&x0a);CHKERRQ(ierr);
+
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = PetscFree4(h,rows,cols,lastc);CHKERRQ(ierr);
+  ierr = PetscFree3(cstart,cpts,blk);CHKERRQ(ierr);
+  ierr = PetscFree2(gcolor,omap);CHKERRQ(ierr);
+  ierr = PetscFree2(off,dl);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&Floc);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&F0loc);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&Xloc);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&X0loc);CHKERRQ(ierr);
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
 
 /* Routine is called by example, hence must be labeled PETSC_EXTERN */
 PETSC_EXTERN PetscErrorCode SNESComputeJacobian_DMDA(SNES snes,Vec X,Mat A,Mat B,void *ctx)
@@ -167,34 +457,39 @@ PETSC_EXTERN PetscErrorCode SNESComputeJacobian_DMDA(SNES snes,Vec X,Mat A,Mat B
     ierr = DMRestoreLocalVector(dm,&Xloc);CHKERRQ(ierr);
   } else {
     MatFDColoring fdcoloring;
-    ierr = PetscObjectQuery((PetscObject)dm,"DMDASNES_FDCOLORING",(PetscObject*)&fdcoloring);CHKERRQ(ierr);
-    if (!fdcoloring) {
-      ISColoring coloring;
-
-      ierr = DMCreateColoring(dm,dm->coloringtype,&coloring);CHKERRQ(ierr);
-      ierr = MatFDColoringCreate(B,coloring,&fdcoloring);CHKERRQ(ierr);
-      switch (dm->coloringtype) {
-      case IS_COLORING_GLOBAL:
-        ierr = MatFDColoringSetFunction(fdcoloring,(PetscErrorCode (*)(void))SNESComputeFunction_DMDA,dmdasnes);CHKERRQ(ierr);
-        break;
-      default: SETERRQ1(PetscObjectComm((PetscObject)snes),PETSC_ERR_SUP,"No support for coloring type '%s'",ISColoringTypes[dm->coloringtype]);
+    PetscBool     done;
+
+    ierr = SNESComputeJacobianLocalFD_DMDA(snes,X,B,dmdasnes,&done);CHKERRQ(ierr);
+    if (!done) {
+      ierr = PetscObjectQuery((PetscObject)dm,"DMDASNES_FDCOLORING",(PetscObject*)&fdcoloring);CHKERRQ(ierr);
+      if (!fdcoloring) {
+        ISColoring coloring;
+
+        ierr = DMCreateColoring(dm,dm->coloringtype,&coloring);CHKERRQ(ierr);
+        ierr = MatFDColoringCreate(B,coloring,&fdcoloring);CHKERRQ(ierr);
+        switch (dm->coloringtype) {
+        case IS_COLORING_GLOBAL:
+          ierr = MatFDColoringSetFunction(fdcoloring,(PetscErrorCode (*)(void))SNESComputeFunction_DMDA,dmdasnes);CHKERRQ(ierr);
+          break;
+        default: SETERRQ1(PetscObjectComm((PetscObject)snes),PETSC_ERR_SUP,"No support for coloring type '%s'",ISColoringTypes[dm->coloringtype]);
+        }
+        ierr = PetscObjectSetOptionsPrefix((PetscObject)fdcoloring,((PetscObject)dm)->prefix);CHKERRQ(ierr);
+        ierr = MatFDColoringSetFromOptions(fdcoloring);CHKERRQ(ierr);
+        ierr = MatFDColoringSetUp(B,coloring,fdcoloring);CHKERRQ(ierr);
+        ierr = ISColoringDestroy(&coloring);CHKERRQ(ierr);
+        ierr = PetscObjectCompose((PetscObject)dm,"DMDASNES_FDCOLORING",(PetscObject)fdcoloring);CHKERRQ(ierr);
+        ierr = PetscObjectDereference((PetscObject)fdcoloring);CHKERRQ(ierr);
+
+        /* The following breaks an ugly reference counting loop that deserves a paragraph. MatFDColoringApply() will call
+         * VecDuplicate() with the state Vec and store inside the MatFDColoring. This Vec will duplicate the Vec, but the
+         * MatFDColoring is composed with the DM. We dereference the DM here so that the reference count will eventually
+         * drop to 0. Note the code in DMDestroy() that exits early for a negative reference count. That code path will be
+         * taken when the PetscObjectList for the Vec inside MatFDColoring is destroyed.
+         */
+        ierr = PetscObjectDereference((PetscObject)dm);CHKERRQ(ierr);
       }
-      ierr = PetscObjectSetOptionsPrefix((PetscObject)fdcoloring,((PetscObject)dm)->prefix);CHKERRQ(ierr);
-      ierr = MatFDColoringSetFromOptions(fdcoloring);CHKERRQ(ierr);
-      ierr = MatFDColoringSetUp(B,coloring,fdcoloring);CHKERRQ(ierr);
-      ierr = ISColoringDestroy(&coloring);CHKERRQ(ierr);
-      ierr = PetscObjectCompose((PetscObject)dm,"DMDASNES_FDCOLORING",(PetscObject)fdcoloring);CHKERRQ(ierr);
-      ierr = PetscObjectDereference((PetscObject)fdcoloring);CHKERRQ(ierr);
-
-      /* The following breaks an ugly reference counting loop that deserves a paragraph. MatFDColoringApply() will call
-       * VecDuplicate() with the state Vec and store inside the MatFDColoring. This Vec will duplicate the Vec, but the
-       * MatFDColoring is composed with the DM. We dereference the DM here so that the reference count will eventually
-       * drop to 0. Note the code in DMDestroy() that exits early for a negative reference count. That code path will be
-       * taken when the PetscObjectList for the Vec inside MatFDColoring is destroyed.
-       */
-      ierr = PetscObjectDereference((PetscObject)dm);CHKERRQ(ierr);
+      ierr = MatFDColoringApply(B,fdcoloring,X,snes);CHKERRQ(ierr);
     }
-    ierr = MatFDColoringApply(B,fdcoloring,X,snes);CHKERRQ(ierr);
   }
   /* This will be redundant if the user called both, but it's too common to forget. */
   if (A != B) {
@@ -222,9 +517,13 @@ PETSC_EXTERN PetscErrorCode SNESComputeJacobian_DMDA(SNES snes,Vec X,Mat A,Mat B
 .  f - dimensional pointer to residual, write the residual here (e.g. PetscScalar *f or **f or ***f)
 -  ctx - optional context passed above
 
+   Notes:
+   With INSERT_VALUES and DMDASetLocalFunctionOverlap() the function is called on the interior box while the ghost
+   update is in flight and then on each boundary slab, see DMDAGetLocalInfoSplit().
+
    Level: beginner
 
-.seealso: DMDASNESSetJacobianLocal(), DMSNESSetFunction(), DMDACreate1d(), DMDACreate2d(), DMDACreate3d()
+.seealso: DMDASNESSetJacobianLocal(), DMSNESSetFunction(), DMDACreate1d(), DMDACreate2d(), DMDACreate3d(), DMDASetLocalFunctionOverlap()
 @*/
 PetscErrorCode DMDASNESSetFunctionLocal(DM dm,InsertMode imode,PetscErrorCode (*func)(DMDALocalInfo*,void*,void*,void*),void *ctx)
 {
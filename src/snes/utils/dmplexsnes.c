@@ -313,6 +313,157 @@ PetscErrorCode DMInterpolationAddPoints(DMInterpolationInfo ctx, PetscInt n, Pet
   PetscFunctionReturn(0);
 }
 
+/*
+  Send each point only to the processes whose local coordinate box could contain it, rather than to every process. The lowest
+  process which locates a point owns it, so the result is the same as locating every point everywhere.
+*/
+static PetscErrorCode DMInterpolationSetUp_Routed_Private(DMInterpolationInfo ctx, DM dm)
+{
+  MPI_Comm           comm = ctx->comm;
+  const PetscInt     dim  = ctx->dim, n = ctx->nInput;
+  PetscMPIInt        rank, size, boxSize, r;
+  MPI_Datatype       pointType;
+  Vec                coordsLocal, pointVec;
+  PetscSF            routeSF, cellSF = NULL;
+  PetscSFNode       *remote;
+  const PetscScalar *coords;
+  PetscScalar       *a, *recvPoints;
+  PetscReal          lbox[6], *boxes, *sendPoints, pad = 0.0;
+  PetscMPIInt       *sendCounts, *recvCounts, *sendDispls, *remoteDispls, *pointOwner, *sendOwner, *recvOwner;
+  PetscInt          *sendPoint, *recvCell;
+  const PetscSFNode *foundCells;
+  const PetscInt    *foundPoints;
+  PetscInt           Nc, numSend = 0, numRecv = 0, numFound, missing = PETSC_MAX_INT, gmissing, rStart = 0, p, q, d, i;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(comm, &size);CHKERRMPI(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
+  /* Gather the padded box around the local coordinates of each process */
+  for (d = 0; d < dim; ++d) {lbox[d] = PETSC_MAX_REAL; lbox[dim+d] = PETSC_MIN_REAL;}
+  ierr = DMGetCoordinatesLocal(dm, &coordsLocal);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(coordsLocal, &Nc);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordsLocal, &coords);CHKERRQ(ierr);
+  for (i = 0; i < Nc; i += dim) {
+    for (d = 0; d < dim; ++d) {
+      lbox[d]     = PetscMin(lbox[d],     PetscRealPart(coords[i+d]));
+      lbox[dim+d] = PetscMax(lbox[dim+d], PetscRealPart(coords[i+d]));
+    }
+  }
+  ierr = VecRestoreArrayRead(coordsLocal, &coords);CHKERRQ(ierr);
+  if (Nc) {
+    /* Point location accepts points slightly outside of a cell */
+    for (d = 0; d < dim; ++d) pad = PetscMax(pad, lbox[dim+d] - lbox[d]);
+    pad *= 4.0*PETSC_SQRT_MACHINE_EPSILON;
+    for (d = 0; d < dim; ++d) {lbox[d] -= pad; lbox[dim+d] += pad;}
+  }
+  ierr = PetscMPIIntCast(2*dim, &boxSize);CHKERRQ(ierr);
+  ierr = PetscMalloc1(size*2*dim, &boxes);CHKERRQ(ierr);
+  ierr = MPI_Allgather(lbox, boxSize, MPIU_REAL, boxes, boxSize, MPIU_REAL, comm);CHKERRMPI(ierr);
+  /* Group copies of the points by destination process, in increasing order of the point */
+  ierr = PetscCalloc4(size, &sendCounts, size, &recvCounts, size, &sendDispls, size, &remoteDispls);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) {
+    for (r = 0; r < size; ++r) {
+      for (d = 0; d < dim; ++d) if (ctx->points[p*dim+d] < boxes[r*2*dim+d] || ctx->points[p*dim+d] > boxes[r*2*dim+dim+d]) break;
+      if (d == dim) {++sendCounts[r]; ++numSend;}
+    }
+  }
+  for (r = 1; r < size; ++r) sendDispls[r] = sendDispls[r-1] + sendCounts[r-1];
+  ierr = PetscMalloc3(numSend, &sendPoint, numSend*dim, &sendPoints, numSend, &sendOwner);CHKERRQ(ierr);
+  {
+    PetscMPIInt *fill;
+
+    ierr = PetscMalloc1(size, &fill);CHKERRQ(ierr);
+    ierr = PetscArraycpy(fill, sendDispls, size);CHKERRQ(ierr);
+    for (p = 0; p < n; ++p) {
+      for (r = 0; r < size; ++r) {
+        for (d = 0; d < dim; ++d) if (ctx->points[p*dim+d] < boxes[r*2*dim+d] || ctx->points[p*dim+d] > boxes[r*2*dim+dim+d]) break;
+        if (d == dim) {
+          sendPoint[fill[r]] = p;
+          for (d = 0; d < dim; ++d) sendPoints[fill[r]*dim+d] = ctx->points[p*dim+d];
+          ++fill[r];
+        }
+      }
+    }
+    ierr = PetscFree(fill);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(boxes);CHKERRQ(ierr);
+  /* Each received point is a leaf attached to the copy on the sending process */
+  ierr = MPI_Alltoall(sendCounts, 1, MPI_INT, recvCounts, 1, MPI_INT, comm);CHKERRMPI(ierr);
+  ierr = MPI_Alltoall(sendDispls, 1, MPI_INT, remoteDispls, 1, MPI_INT, comm);CHKERRMPI(ierr);
+  for (r = 0; r < size; ++r) numRecv += recvCounts[r];
+  ierr = PetscMalloc1(numRecv, &remote);CHKERRQ(ierr);
+  for (r = 0, q = 0; r < size; ++r) {
+    for (i = 0; i < recvCounts[r]; ++i, ++q) {remote[q].rank = r; remote[q].index = remoteDispls[r] + i;}
+  }
+  ierr = PetscSFCreate(comm, &routeSF);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(routeSF, numSend, numRecv, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscMalloc3(numRecv*dim, &recvPoints, numRecv, &recvOwner, numRecv, &recvCell);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(boxSize/2, MPIU_REAL, &pointType);CHKERRMPI(ierr);
+  ierr = MPI_Type_commit(&pointType);CHKERRMPI(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  {
+    PetscReal *recvReal;
+
+    ierr = PetscMalloc1(numRecv*dim, &recvReal);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(routeSF, pointType, sendPoints, recvReal);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(routeSF, pointType, sendPoints, recvReal);CHKERRQ(ierr);
+    for (i = 0; i < numRecv*dim; ++i) recvPoints[i] = recvReal[i];
+    ierr = PetscFree(recvReal);CHKERRQ(ierr);
+  }
+#else
+  ierr = PetscSFBcastBegin(routeSF, pointType, sendPoints, recvPoints);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(routeSF, pointType, sendPoints, recvPoints);CHKERRQ(ierr);
+#endif
+  ierr = MPI_Type_free(&pointType);CHKERRMPI(ierr);
+  /* Locate the received points in the local mesh */
+  ierr = VecCreateSeqWithArray(PETSC_COMM_SELF, dim, numRecv*dim, recvPoints, &pointVec);CHKERRQ(ierr);
+  ierr = DMLocatePoints(dm, pointVec, DM_POINTLOCATION_REMOVE, &cellSF);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(cellSF, NULL, &numFound, &foundPoints, &foundCells);CHKERRQ(ierr);
+  for (q = 0; q < numRecv; ++q) {recvOwner[q] = size; recvCell[q] = -1;}
+  for (i = 0; i < numFound; ++i) {
+    q = foundPoints ? foundPoints[i] : i;
+    if (foundCells[i].index >= 0) {recvOwner[q] = rank; recvCell[q] = foundCells[i].index;}
+  }
+  ierr = PetscSFDestroy(&cellSF);CHKERRQ(ierr);
+  /* Let the lowest process which found each point own it */
+  for (q = 0; q < numSend; ++q) sendOwner[q] = size;
+  ierr = PetscSFReduceBegin(routeSF, MPI_INT, recvOwner, sendOwner, MPI_MIN);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(routeSF, MPI_INT, recvOwner, sendOwner, MPI_MIN);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n, &pointOwner);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) pointOwner[p] = size;
+  for (q = 0; q < numSend; ++q) pointOwner[sendPoint[q]] = PetscMin(pointOwner[sendPoint[q]], sendOwner[q]);
+  for (q = 0; q < numSend; ++q) sendOwner[q] = pointOwner[sendPoint[q]];
+  ierr = MPI_Scan(&n, &rStart, 1, MPIU_INT, MPI_SUM, comm);CHKERRMPI(ierr);
+  rStart -= n;
+  for (p = 0; p < n; ++p) if (pointOwner[p] == size) {missing = rStart + p; break;}
+  ierr = MPIU_Allreduce(&missing, &gmissing, 1, MPIU_INT, MPI_MIN, comm);CHKERRQ(ierr);
+  if (gmissing != PETSC_MAX_INT) SETERRQ1(comm, PETSC_ERR_PLIB, "Point %D not located in mesh", gmissing);
+  ierr = PetscSFBcastBegin(routeSF, MPI_INT, sendOwner, recvOwner);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(routeSF, MPI_INT, sendOwner, recvOwner);CHKERRQ(ierr);
+  /* Received points arrive ordered by sending process, then by point, so owned points keep the global order */
+  for (q = 0, ctx->n = 0; q < numRecv; ++q) if (recvOwner[q] == rank) ++ctx->n;
+  ierr = PetscMalloc1(ctx->n, &ctx->cells);CHKERRQ(ierr);
+  ierr = VecCreate(comm, &ctx->coords);CHKERRQ(ierr);
+  ierr = VecSetSizes(ctx->coords, ctx->n*dim, PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(ctx->coords, dim);CHKERRQ(ierr);
+  ierr = VecSetType(ctx->coords, VECSTANDARD);CHKERRQ(ierr);
+  ierr = VecGetArray(ctx->coords, &a);CHKERRQ(ierr);
+  for (q = 0, p = 0; q < numRecv; ++q) {
+    if (recvOwner[q] != rank) continue;
+    for (d = 0; d < dim; ++d) a[p*dim+d] = recvPoints[q*dim+d];
+    ctx->cells[p++] = recvCell[q];
+  }
+  ierr = VecRestoreArray(ctx->coords, &a);CHKERRQ(ierr);
+  ierr = VecDestroy(&pointVec);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&routeSF);CHKERRQ(ierr);
+  ierr = PetscFree(pointOwner);CHKERRQ(ierr);
+  ierr = PetscFree3(recvPoints, recvOwner, recvCell);CHKERRQ(ierr);
+  ierr = PetscFree3(sendPoint, sendPoints, sendOwner);CHKERRQ(ierr);
+  ierr = PetscFree4(sendCounts, recvCounts, sendDispls, remoteDispls);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
   DMInterpolationSetUp - Computea spatial indices that add in point location during interpolation
 
@@ -323,6 +474,10 @@ PetscErrorCode DMInterpolationAddPoints(DMInterpolationInfo ctx, PetscInt n, Pet
 . dm  - the DM for the function space used for interpolation
 - redundantPoints - If PETSC_TRUE, all processes are passing in the same array of points. Otherwise, points need to be communicated among processes.
 
+  Notes:
+  When the points are not redundant, each point is only sent to the processes whose local mesh could contain it. Point location uses the
+  spatial index cached on the DM, so setting up several contexts on the same mesh does not repeat the indexing work.
+
   Level: intermediate
 
 .seealso: DMInterpolationEvaluate(), DMInterpolationAddPoints(), DMInterpolationCreate()
@@ -331,7 +486,7 @@ PetscErrorCode DMInterpolationSetUp(DMInterpolationInfo ctx, DM dm, PetscBool re
 {
   MPI_Comm          comm = ctx->comm;
   PetscScalar       *a;
-  PetscInt          p, q, i;
+  PetscInt          p, q, i, f;
   PetscMPIInt       rank, size;
   PetscErrorCode    ierr;
   Vec               pointVec;
@@ -351,6 +506,10 @@ PetscErrorCode DMInterpolationSetUp(DMInterpolationInfo ctx, DM dm, PetscBool re
   ierr = MPI_Comm_size(comm, &size);CHKERRMPI(ierr);
   ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
   if (ctx->dim < 0) SETERRQ(comm, PETSC_ERR_ARG_WRONGSTATE, "The spatial dimension has not been set");
+  if (!redundantPoints && size > 1) {
+    ierr = DMInterpolationSetUp_Routed_Private(ctx, dm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   /* Locate points */
   n = ctx->nInput;
   if (!redundantPoints) {
@@ -407,12 +566,15 @@ PetscErrorCode DMInterpolationSetUp(DMInterpolationInfo ctx, DM dm, PetscBool re
   ierr = VecSetBlockSize(ctx->coords, ctx->dim);CHKERRQ(ierr);
   ierr = VecSetType(ctx->coords,VECSTANDARD);CHKERRQ(ierr);
   ierr = VecGetArray(ctx->coords, &a);CHKERRQ(ierr);
-  for (p = 0, q = 0, i = 0; p < N; ++p) {
+  for (p = 0, q = 0, i = 0, f = 0; p < N; ++p) {
     if (globalProcs[p] == rank) {
       PetscInt d;
 
       for (d = 0; d < ctx->dim; ++d, ++i) a[i] = globalPoints[p*ctx->dim+d];
-      ctx->cells[q] = foundCells[q].index;
+      /* foundCells only holds the located points */
+      if (foundPoints) {while (foundPoints[f] != p) ++f;}
+      else f = p;
+      ctx->cells[q] = foundCells[f].index;
       ++q;
     }
   }
@@ -1244,41 +1406,20 @@ PetscErrorCode DMPlexSNESComputeBoundaryFEM(DM dm, Vec X, void *user)
   PetscFunctionReturn(0);
 }
 
-/*@
-  DMPlexComputeJacobianAction - Form the local portion of the Jacobian action Z = J(X) Y at the local solution X using pointwise functions specified by the user.
-
-  Input Parameters:
-+ dm - The mesh
-. cellIS -
-. t  - The time
-. X_tShift - The multiplier for the Jacobian with repsect to X_t
-. X  - Local solution vector
-. X_t  - Time-derivative of the local solution vector
-. Y  - Local input vector
-- user - The user context
-
-  Output Parameter:
-. Z - Local output vector
-
-  Note:
-  We form the residual one batch of elements at a time. This allows us to offload work onto an accelerator,
-  like a GPU, or vectorize on a multicore machine.
-
-  Level: developer
+/*
+  DMPlexComputeJacobianActionElements_Private - Compute the element matrices of the Jacobian J(X) on each cell of cellIS, stored in closure order
 
-.seealso: FormFunctionLocal()
-@*/
-PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscReal X_tShift, Vec X, Vec X_t, Vec Y, Vec Z, void *user)
+  The caller must free elemMat with PetscFree()
+*/
+static PetscErrorCode DMPlexComputeJacobianActionElements_Private(DM dm, IS cellIS, PetscReal t, PetscReal X_tShift, Vec X, Vec X_t, void *user, PetscScalar **elemMat)
 {
-  DM_Plex          *mesh  = (DM_Plex *) dm->data;
-  const char       *name  = "Jacobian";
-  DM                dmAux, plex, plexAux = NULL;
+  DM                dmAux, plexAux = NULL;
   DMEnclosureType   encAux;
   Vec               A;
   PetscDS           prob, probAux = NULL;
   PetscQuadrature   quad;
-  PetscSection      section, globalSection, sectionAux;
-  PetscScalar      *elemMat, *elemMatD, *u, *u_t, *a = NULL, *y, *z;
+  PetscSection      section, sectionAux;
+  PetscScalar      *elemMatD, *u, *u_t, *a = NULL;
   PetscInt          Nf, fieldI, fieldJ;
   PetscInt          totDim, totDimAux = 0;
   const PetscInt   *cells;
@@ -1288,19 +1429,7 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
   PetscErrorCode    ierr;
 
   PetscFunctionBegin;
-  ierr = PetscLogEventBegin(DMPLEX_JacobianFEM,dm,0,0,0);CHKERRQ(ierr);
-  ierr = DMSNESConvertPlex(dm, &plex, PETSC_TRUE);CHKERRQ(ierr);
-  if (!cellIS) {
-    PetscInt depth;
-
-    ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
-    ierr = DMGetStratumIS(plex, "dim", depth, &cellIS);CHKERRQ(ierr);
-    if (!cellIS) {ierr = DMGetStratumIS(plex, "depth", depth, &cellIS);CHKERRQ(ierr);}
-  } else {
-    ierr = PetscObjectReference((PetscObject) cellIS);CHKERRQ(ierr);
-  }
   ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
-  ierr = DMGetGlobalSection(dm, &globalSection);CHKERRQ(ierr);
   ierr = ISGetLocalSize(cellIS, &numCells);CHKERRQ(ierr);
   ierr = ISGetPointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
   ierr = DMGetCellDS(dm, cells ? cells[cStart] : cStart, &prob);CHKERRQ(ierr);
@@ -1317,8 +1446,8 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     ierr = DMGetDS(dmAux, &probAux);CHKERRQ(ierr);
     ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
   }
-  ierr = VecSet(Z, 0.0);CHKERRQ(ierr);
-  ierr = PetscMalloc6(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,numCells*totDim*totDim,&elemMat,hasDyn ? numCells*totDim*totDim : 0, &elemMatD,numCells*totDim,&y,totDim,&z);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numCells*totDim*totDim, elemMat);CHKERRQ(ierr);
+  ierr = PetscMalloc3(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,hasDyn ? numCells*totDim*totDim : 0, &elemMatD);CHKERRQ(ierr);
   if (dmAux) {ierr = PetscMalloc1(numCells*totDimAux, &a);CHKERRQ(ierr);}
   ierr = DMGetCoordinateField(dm, &coordField);CHKERRQ(ierr);
   for (c = cStart; c < cEnd; ++c) {
@@ -1342,11 +1471,8 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
       for (i = 0; i < totDimAux; ++i) a[cind*totDimAux+i] = x[i];
       ierr = DMPlexVecRestoreClosure(plexAux, sectionAux, A, subcell, NULL, &x);CHKERRQ(ierr);
     }
-    ierr = DMPlexVecGetClosure(dm, section, Y, cell, NULL, &x);CHKERRQ(ierr);
-    for (i = 0; i < totDim; ++i) y[cind*totDim+i] = x[i];
-    ierr = DMPlexVecRestoreClosure(dm, section, Y, cell, NULL, &x);CHKERRQ(ierr);
   }
-  ierr = PetscArrayzero(elemMat, numCells*totDim*totDim);CHKERRQ(ierr);
+  ierr = PetscArrayzero(*elemMat, numCells*totDim*totDim);CHKERRQ(ierr);
   if (hasDyn)  {ierr = PetscArrayzero(elemMatD, numCells*totDim*totDim);CHKERRQ(ierr);}
   for (fieldI = 0; fieldI < Nf; ++fieldI) {
     PetscFE  fe;
@@ -1381,8 +1507,8 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     ierr = PetscFEGeomGetChunk(cgeomFEM,0,offset,&chunkGeom);CHKERRQ(ierr);
     ierr = PetscFEGeomGetChunk(cgeomFEM,offset,numCells,&remGeom);CHKERRQ(ierr);
     for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
-      ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMat);CHKERRQ(ierr);
-      ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &elemMat[offset*totDim*totDim]);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, *elemMat);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &(*elemMat)[offset*totDim*totDim]);CHKERRQ(ierr);
       if (hasDyn) {
         ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMatD);CHKERRQ(ierr);
         ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &elemMatD[offset*totDim*totDim]);CHKERRQ(ierr);
@@ -1394,35 +1520,296 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     ierr = PetscQuadratureDestroy(&qGeom);CHKERRQ(ierr);
   }
   if (hasDyn) {
-    for (c = 0; c < numCells*totDim*totDim; ++c) elemMat[c] += X_tShift*elemMatD[c];
+    for (c = 0; c < numCells*totDim*totDim; ++c) (*elemMat)[c] += X_tShift*elemMatD[c];
   }
+  ierr = ISRestorePointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  ierr = PetscFree3(u,u_t,elemMatD);CHKERRQ(ierr);
+  ierr = PetscFree(a);CHKERRQ(ierr);
+  ierr = DMDestroy(&plexAux);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  DMPlexApplyElementMatrices_Private - Compute Z += sum_c E_c Y_c for the element matrices E_c computed by DMPlexComputeJacobianActionElements_Private()
+*/
+static PetscErrorCode DMPlexApplyElementMatrices_Private(DM dm, IS cellIS, const PetscScalar elemMat[], Vec Y, Vec Z)
+{
+  DM_Plex          *mesh  = (DM_Plex *) dm->data;
+  const char       *name  = "Jacobian";
+  PetscSection      section;
+  PetscDS           prob;
+  PetscScalar      *y, *z;
+  const PetscInt   *cells;
+  PetscInt          totDim, cStart, cEnd, c;
+  PetscBLASInt      M;
+  const PetscBLASInt one = 1;
+  const PetscScalar a = 1.0, b = 0.0;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  ierr = ISGetPointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  ierr = DMGetCellDS(dm, cells ? cells[cStart] : cStart, &prob);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(totDim, &M);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, totDim, MPIU_SCALAR, &z);CHKERRQ(ierr);
   for (c = cStart; c < cEnd; ++c) {
     const PetscInt     cell = cells ? cells[c] : c;
     const PetscInt     cind = c - cStart;
-    const PetscBLASInt M = totDim, one = 1;
-    const PetscScalar  a = 1.0, b = 0.0;
+    const PetscScalar *E    = &elemMat[cind*totDim*totDim];
 
-    PetscStackCallBLAS("BLASgemv", BLASgemv_("N", &M, &M, &a, &elemMat[cind*totDim*totDim], &M, &y[cind*totDim], &one, &b, z, &one));
+    y    = NULL;
+    ierr = DMPlexVecGetClosure(dm, section, Y, cell, NULL, &y);CHKERRQ(ierr);
+    PetscStackCallBLAS("BLASgemv", BLASgemv_("T", &M, &M, &a, E, &M, y, &one, &b, z, &one));
     if (mesh->printFEM > 1) {
-      ierr = DMPrintCellMatrix(c, name, totDim, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);
-      ierr = DMPrintCellVector(c, "Y",  totDim, &y[cind*totDim]);CHKERRQ(ierr);
+      ierr = DMPrintCellMatrix(c, name, totDim, totDim, E);CHKERRQ(ierr);
+      ierr = DMPrintCellVector(c, "Y",  totDim, y);CHKERRQ(ierr);
       ierr = DMPrintCellVector(c, "Z",  totDim, z);CHKERRQ(ierr);
     }
+    ierr = DMPlexVecRestoreClosure(dm, section, Y, cell, NULL, &y);CHKERRQ(ierr);
     ierr = DMPlexVecSetClosure(dm, section, Z, cell, z, ADD_VALUES);CHKERRQ(ierr);
   }
-  ierr = PetscFree6(u,u_t,elemMat,elemMatD,y,z);CHKERRQ(ierr);
+  ierr = DMRestoreWorkArray(dm, totDim, MPIU_SCALAR, &z);CHKERRQ(ierr);
+  ierr = ISRestorePointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*(cEnd-cStart)*totDim*totDim);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexComputeJacobianAction - Form the local portion of the Jacobian action Z = J(X) Y at the local solution X using pointwise functions specified by the user.
+
+  Input Parameters:
++ dm - The mesh
+. cellIS -
+. t  - The time
+. X_tShift - The multiplier for the Jacobian with repsect to X_t
+. X  - Local solution vector
+. X_t  - Time-derivative of the local solution vector
+. Y  - Local input vector
+- user - The user context
+
+  Output Parameter:
+. Z - Local output vector
+
+  Note:
+  We form the residual one batch of elements at a time. This allows us to offload work onto an accelerator,
+  like a GPU, or vectorize on a multicore machine.
+
+  Level: developer
+
+.seealso: FormFunctionLocal(), DMPlexSNESCreateJacobianMF()
+@*/
+PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscReal X_tShift, Vec X, Vec X_t, Vec Y, Vec Z, void *user)
+{
+  DM_Plex          *mesh  = (DM_Plex *) dm->data;
+  DM                plex;
+  PetscScalar      *elemMat;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(DMPLEX_JacobianFEM,dm,0,0,0);CHKERRQ(ierr);
+  ierr = DMSNESConvertPlex(dm, &plex, PETSC_TRUE);CHKERRQ(ierr);
+  if (!cellIS) {
+    PetscInt depth;
+
+    ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
+    ierr = DMGetStratumIS(plex, "dim", depth, &cellIS);CHKERRQ(ierr);
+    if (!cellIS) {ierr = DMGetStratumIS(plex, "depth", depth, &cellIS);CHKERRQ(ierr);}
+  } else {
+    ierr = PetscObjectReference((PetscObject) cellIS);CHKERRQ(ierr);
+  }
+  ierr = VecSet(Z, 0.0);CHKERRQ(ierr);
+  ierr = DMPlexComputeJacobianActionElements_Private(dm, cellIS, t, X_tShift, X, X_t, user, &elemMat);CHKERRQ(ierr);
+  ierr = DMPlexApplyElementMatrices_Private(dm, cellIS, elemMat, Y, Z);CHKERRQ(ierr);
+  ierr = PetscFree(elemMat);CHKERRQ(ierr);
   if (mesh->printFEM) {
     ierr = PetscPrintf(PetscObjectComm((PetscObject)Z), "Z:\n");CHKERRQ(ierr);
     ierr = VecView(Z, NULL);CHKERRQ(ierr);
   }
-  ierr = PetscFree(a);CHKERRQ(ierr);
   ierr = ISDestroy(&cellIS);CHKERRQ(ierr);
-  ierr = DMDestroy(&plexAux);CHKERRQ(ierr);
   ierr = DMDestroy(&plex);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DMPLEX_JacobianFEM,dm,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
+typedef struct {
+  DM           dm;      /* The mesh */
+  IS           cellIS;  /* The cells to integrate over */
+  Vec          X;       /* Local linearization point */
+  void        *user;    /* The user context for the pointwise functions */
+  PetscScalar *elemMat; /* Element matrices at X, NULL until the first use after the base is set */
+} DMPlexJacobianMFCtx;
+
+static PetscErrorCode DMPlexJacobianMFSetUp_Private(DMPlexJacobianMFCtx *ctx)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ctx->elemMat) PetscFunctionReturn(0);
+  if (!ctx->X) SETERRQ(PetscObjectComm((PetscObject) ctx->dm), PETSC_ERR_ARG_WRONGSTATE, "Linearization point has not been set");
+  ierr = PetscLogEventBegin(DMPLEX_JacobianFEM,ctx->dm,0,0,0);CHKERRQ(ierr);
+  ierr = DMPlexComputeJacobianActionElements_Private(ctx->dm, ctx->cellIS, 0.0, 0.0, ctx->X, NULL, ctx->user, &ctx->elemMat);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_JacobianFEM,ctx->dm,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_DMPlexJacobianMF(Mat J, Vec Y, Vec Z)
+{
+  DMPlexJacobianMFCtx *ctx;
+  Vec                  locY, locZ;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, (void **) &ctx);CHKERRQ(ierr);
+  ierr = DMPlexJacobianMFSetUp_Private(ctx);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(ctx->dm, &locY);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(ctx->dm, &locZ);CHKERRQ(ierr);
+  /* Constrained dofs are not part of the global space, so they do not contribute to the action */
+  ierr = VecSet(locY, 0.0);CHKERRQ(ierr);
+  ierr = VecSet(locZ, 0.0);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(ctx->dm, Y, INSERT_VALUES, locY);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(ctx->dm, Y, INSERT_VALUES, locY);CHKERRQ(ierr);
+  ierr = DMPlexApplyElementMatrices_Private(ctx->dm, ctx->cellIS, ctx->elemMat, locY, locZ);CHKERRQ(ierr);
+  ierr = VecSet(Z, 0.0);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(ctx->dm, locZ, ADD_VALUES, Z);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(ctx->dm, locZ, ADD_VALUES, Z);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(ctx->dm, &locY);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(ctx->dm, &locZ);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetDiagonal_DMPlexJacobianMF(Mat J, Vec D)
+{
+  DMPlexJacobianMFCtx *ctx;
+  PetscSection         section;
+  PetscDS              prob;
+  Vec                  locD;
+  PetscScalar         *d;
+  const PetscInt      *cells;
+  PetscInt             totDim, cStart, cEnd, c, i;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, (void **) &ctx);CHKERRQ(ierr);
+  ierr = DMPlexJacobianMFSetUp_Private(ctx);CHKERRQ(ierr);
+  ierr = DMGetLocalSection(ctx->dm, &section);CHKERRQ(ierr);
+  ierr = ISGetPointRange(ctx->cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  ierr = DMGetCellDS(ctx->dm, cells ? cells[cStart] : cStart, &prob);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(ctx->dm, &locD);CHKERRQ(ierr);
+  ierr = VecSet(locD, 0.0);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(ctx->dm, totDim, MPIU_SCALAR, &d);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt     cell = cells ? cells[c] : c;
+    const PetscScalar *E    = &ctx->elemMat[(c-cStart)*totDim*totDim];
+
+    for (i = 0; i < totDim; ++i) d[i] = E[i*totDim+i];
+    ierr = DMPlexVecSetClosure(ctx->dm, section, locD, cell, d, ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = DMRestoreWorkArray(ctx->dm, totDim, MPIU_SCALAR, &d);CHKERRQ(ierr);
+  ierr = ISRestorePointRange(ctx->cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  ierr = VecSet(D, 0.0);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(ctx->dm, locD, ADD_VALUES, D);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(ctx->dm, locD, ADD_VALUES, D);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(ctx->dm, &locD);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_DMPlexJacobianMF(Mat J)
+{
+  DMPlexJacobianMFCtx *ctx;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, (void **) &ctx);CHKERRQ(ierr);
+  ierr = PetscFree(ctx->elemMat);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->X);CHKERRQ(ierr);
+  ierr = ISDestroy(&ctx->cellIS);CHKERRQ(ierr);
+  ierr = DMDestroy(&ctx->dm);CHKERRQ(ierr);
+  ierr = PetscFree(ctx);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) J, "DMPlexSNESJacobianMFSetBase_C", NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexSNESJacobianMFSetBase_Plex(Mat J, Vec X)
+{
+  DMPlexJacobianMFCtx *ctx;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, (void **) &ctx);CHKERRQ(ierr);
+  if (!ctx->X) {ierr = DMCreateLocalVector(ctx->dm, &ctx->X);CHKERRQ(ierr);}
+  ierr = VecCopy(X, ctx->X);CHKERRQ(ierr);
+  ierr = PetscFree(ctx->elemMat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexSNESCreateJacobianMF - Create a matrix-free Jacobian J(X) for the pointwise functions attached to the DMPlex
+
+  Collective on dm
+
+  Input Parameters:
++ dm   - The mesh
+. X    - The local linearization point, or NULL if it is set later
+- user - The user context for the pointwise functions
+
+  Output Parameter:
+. J - The MATSHELL Jacobian
+
+  Notes:
+  The element matrices of J(X) are computed once for each linearization point and kept, so that MatMult() only
+  gathers the cell closures, applies the element matrices and scatters the result, and MatGetDiagonal() sums their
+  diagonals. Nothing is assembled, which makes this suitable for high order discretizations smoothed with Jacobi or
+  Chebyshev, with an assembled low order or approximate preconditioning matrix.
+
+  When J is passed to SNESSetJacobian() for a DM using DMPlexSetSNESLocalFEM(), the linearization point is updated by
+  DMPlexSNESComputeJacobianFEM() at each Newton step, and an assembled preconditioning matrix must be given as well.
+  Boundary Jacobian terms, basis transformations and DMs with several region DSs are not supported.
+
+  Level: intermediate
+
+.seealso: DMPlexComputeJacobianAction(), DMPlexSNESComputeJacobianFEM(), DMPlexSetSNESLocalFEM()
+@*/
+PetscErrorCode DMPlexSNESCreateJacobianMF(DM dm, Vec X, void *user, Mat *J)
+{
+  DMPlexJacobianMFCtx *ctx;
+  DM                   plex;
+  PetscSection         gSection;
+  PetscInt             depth, m, bs, Nds;
+  PetscBool            transform;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (X) PetscValidHeaderSpecific(X, VEC_CLASSID, 2);
+  PetscValidPointer(J, 4);
+  ierr = DMHasBasisTransform(dm, &transform);CHKERRQ(ierr);
+  if (transform) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Matrix-free Jacobian does not support basis transformations");
+  ierr = DMGetNumDS(dm, &Nds);CHKERRQ(ierr);
+  if (Nds > 1) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Matrix-free Jacobian does not support %D region DSs, only a single DS", Nds);
+  ierr = PetscNew(&ctx);CHKERRQ(ierr);
+  ierr = DMSNESConvertPlex(dm, &plex, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
+  ierr = DMGetStratumIS(plex, "dim", depth, &ctx->cellIS);CHKERRQ(ierr);
+  if (!ctx->cellIS) {ierr = DMGetStratumIS(plex, "depth", depth, &ctx->cellIS);CHKERRQ(ierr);}
+  ierr = DMDestroy(&plex);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
+  ctx->dm   = dm;
+  ctx->user = user;
+  ierr = DMGetGlobalSection(dm, &gSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetConstrainedStorageSize(gSection, &m);CHKERRQ(ierr);
+  ierr = DMGetBlockSize(dm, &bs);CHKERRQ(ierr);
+  ierr = MatCreateShell(PetscObjectComm((PetscObject) dm), m, m, PETSC_DETERMINE, PETSC_DETERMINE, ctx, J);CHKERRQ(ierr);
+  if (bs > 0) {ierr = MatSetBlockSize(*J, bs);CHKERRQ(ierr);}
+  ierr = MatShellSetOperation(*J, MATOP_MULT, (void (*)(void)) MatMult_DMPlexJacobianMF);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_GET_DIAGONAL, (void (*)(void)) MatGetDiagonal_DMPlexJacobianMF);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_DESTROY, (void (*)(void)) MatDestroy_DMPlexJacobianMF);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) *J, "DMPlexSNESJacobianMFSetBase_C", DMPlexSNESJacobianMFSetBase_Plex);CHKERRQ(ierr);
+  if (X) {ierr = DMPlexSNESJacobianMFSetBase_Plex(*J, X);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexSNESComputeJacobianFEM - Form the local portion of the Jacobian matrix J at the local solution X using pointwise functions specified by the user.
 
@@ -1448,10 +1835,17 @@ PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void
   IS             allcellIS;
   PetscBool      hasJac, hasPrec;
   PetscInt       Nds, s, depth;
+  PetscErrorCode (*setbase)(Mat, Vec);
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   ierr = DMGetNumDS(dm, &Nds);CHKERRQ(ierr);
+  /* A matrix-free Jacobian from DMPlexSNESCreateJacobianMF() only needs the new linearization point */
+  ierr = PetscObjectQueryFunction((PetscObject) Jac, "DMPlexSNESJacobianMFSetBase_C", &setbase);CHKERRQ(ierr);
+  if (setbase) {
+    if (Jac == JacP) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_INCOMP, "Matrix-free Jacobian from DMPlexSNESCreateJacobianMF() cannot be the preconditioning matrix, pass an assembled matrix to SNESSetJacobian()");
+    ierr = (*setbase)(Jac, X);CHKERRQ(ierr);
+  }
   ierr = DMSNESConvertPlex(dm, &plex, PETSC_TRUE);CHKERRQ(ierr);
   ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
   ierr = DMGetStratumIS(plex, "dim", depth, &allcellIS);CHKERRQ(ierr);
@@ -1475,7 +1869,10 @@ PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void
     if (!s) {
       ierr = PetscDSHasJacobian(ds, &hasJac);CHKERRQ(ierr);
       ierr = PetscDSHasJacobianPreconditioner(ds, &hasPrec);CHKERRQ(ierr);
-      if (hasJac && hasPrec) {ierr = MatZeroEntries(Jac);CHKERRQ(ierr);}
+      if (hasJac && hasPrec) {
+        if (setbase) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Matrix-free Jacobian cannot be combined with a preconditioner pointwise Jacobian");
+        ierr = MatZeroEntries(Jac);CHKERRQ(ierr);
+      }
       ierr = MatZeroEntries(JacP);CHKERRQ(ierr);
     }
     ierr = DMPlexComputeJacobian_Internal(plex, cellIS, 0.0, 0.0, X, NULL, Jac, JacP, user);CHKERRQ(ierr);
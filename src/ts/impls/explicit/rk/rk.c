@@ -775,7 +775,7 @@ static PetscErrorCode TSStep_RK(TS ts)
   TSAdapt         adapt;
   PetscInt        i,j;
   PetscInt        rejections = 0;
-  PetscBool       stageok,accept = PETSC_TRUE;
+  PetscBool       stageok,accept = PETSC_TRUE,blocked = PETSC_FALSE;
   PetscReal       next_time_step = ts->time_step;
   PetscErrorCode  ierr;
 
@@ -787,7 +787,17 @@ static PetscErrorCode TSStep_RK(TS ts)
   while (!ts->reason && rk->status != TS_STEP_COMPLETE) {
     PetscReal t = ts->ptime;
     PetscReal h = ts->time_step;
-    for (i=0; i<s; i++) {
+    /* All stages from one ghost update when the DMDA right-hand side allows it, see DMDATSSetRHSStencilWidth() */
+    if (!ts->prestage && !ts->poststage) {ierr = DMDATSComputeRHSStages_Private(ts,s,A,c,t,h,ts->vec_sol,Y,YdotRHS,&blocked);CHKERRQ(ierr);}
+    if (blocked) {
+      ierr = TSGetAdapt(ts,&adapt);CHKERRQ(ierr);
+      for (i=0; i<s; i++) {
+        rk->stage_time = t + h*c[i];
+        ierr = TSAdaptCheckStage(adapt,ts,rk->stage_time,Y[i],&stageok);CHKERRQ(ierr);
+        if (!stageok) goto reject_step;
+      }
+    }
+    for (i=0; i<s && !blocked; i++) {
       rk->stage_time = t + h*c[i];
       ierr = TSPreStage(ts,rk->stage_time);CHKERRQ(ierr);
       ierr = VecCopy(ts->vec_sol,Y[i]);CHKERRQ(ierr);
@@ -0,0 +1,165 @@
+static char help[] = "Tests temporal blocking of explicit Runge-Kutta stages on a DMDA with DMDATSSetRHSStencilWidth().\n\
+Advection-diffusion with a centered five or seven point stencil, periodic or with fixed boundary values.\n\n";
+
+#include <petscdmda.h>
+#include <petscts.h>
+
+typedef struct {
+  PetscBool periodic;
+  PetscReal a[3],nu;
+} AppCtx;
+
+static PetscErrorCode RHSFunctionLocal2d(DMDALocalInfo *info,PetscReal t,PetscScalar **u,PetscScalar **f,AppCtx *user)
+{
+  const PetscReal hx = user->periodic ? 1.0/info->mx : 1.0/(info->mx-1);
+  const PetscReal hy = user->periodic ? 1.0/info->my : 1.0/(info->my-1);
+  PetscInt        i,j;
+
+  PetscFunctionBeginUser;
+  for (j = info->ys; j < info->ys+info->ym; j++) {
+    for (i = info->xs; i < info->xs+info->xm; i++) {
+      if (!user->periodic && (i == 0 || j == 0 || i == info->mx-1 || j == info->my-1)) {f[j][i] = 0.0; continue;}
+      f[j][i] = -user->a[0]*(u[j][i+1] - u[j][i-1])/(2*hx) - user->a[1]*(u[j+1][i] - u[j-1][i])/(2*hy)
+                + user->nu*((u[j][i+1] - 2*u[j][i] + u[j][i-1])/(hx*hx) + (u[j+1][i] - 2*u[j][i] + u[j-1][i])/(hy*hy));
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode RHSFunctionLocal3d(DMDALocalInfo *info,PetscReal t,PetscScalar ***u,PetscScalar ***f,AppCtx *user)
+{
+  const PetscReal hx = user->periodic ? 1.0/info->mx : 1.0/(info->mx-1);
+  const PetscReal hy = user->periodic ? 1.0/info->my : 1.0/(info->my-1);
+  const PetscReal hz = user->periodic ? 1.0/info->mz : 1.0/(info->mz-1);
+  PetscInt        i,j,k;
+
+  PetscFunctionBeginUser;
+  for (k = info->zs; k < info->zs+info->zm; k++) {
+    for (j = info->ys; j < info->ys+info->ym; j++) {
+      for (i = info->xs; i < info->xs+info->xm; i++) {
+        if (!user->periodic && (i == 0 || j == 0 || k == 0 || i == info->mx-1 || j == info->my-1 || k == info->mz-1)) {f[k][j][i] = 0.0; continue;}
+        f[k][j][i] = -user->a[0]*(u[k][j][i+1] - u[k][j][i-1])/(2*hx) - user->a[1]*(u[k][j+1][i] - u[k][j-1][i])/(2*hy) - user->a[2]*(u[k+1][j][i] - u[k-1][j][i])/(2*hz)
+                     + user->nu*((u[k][j][i+1] - 2*u[k][j][i] + u[k][j][i-1])/(hx*hx) + (u[k][j+1][i] - 2*u[k][j][i] + u[k][j-1][i])/(hy*hy) + (u[k+1][j][i] - 2*u[k][j][i] + u[k-1][j][i])/(hz*hz));
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FormInitialSolution(DM da,Vec U,AppCtx *user)
+{
+  DMDALocalInfo  info;
+  PetscScalar    *u;
+  PetscReal      x,y,z;
+  PetscInt       i,j,k,p = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMDAGetLocalInfo(da,&info);CHKERRQ(ierr);
+  ierr = VecGetArray(U,&u);CHKERRQ(ierr);
+  for (k = info.zs; k < info.zs+info.zm; k++) {
+    for (j = info.ys; j < info.ys+info.ym; j++) {
+      for (i = info.xs; i < info.xs+info.xm; i++, p++) {
+        x    = user->periodic ? (PetscReal)i/info.mx : (PetscReal)i/(info.mx-1);
+        y    = user->periodic ? (PetscReal)j/info.my : (PetscReal)j/(info.my-1);
+        z    = info.dim < 3 ? 0.25 : (user->periodic ? (PetscReal)k/info.mz : (PetscReal)k/(info.mz-1));
+        u[p] = PetscSinReal(2*PETSC_PI*x)*PetscSinReal(2*PETSC_PI*y)*PetscSinReal(2*PETSC_PI*z) + 0.5*PetscSinReal(PETSC_PI*x);
+      }
+    }
+  }
+  ierr = VecRestoreArray(U,&u);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  TS             ts;
+  DM             da;
+  Vec            U;
+  AppCtx         user;
+  PetscInt       dim = 2,n = 24,sw = 4,steps;
+  PetscBool      block = PETSC_FALSE;
+  DMBoundaryType bt;
+  PetscReal      nrm,t;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  user.periodic = PETSC_FALSE;
+  user.a[0] = 1.0; user.a[1] = 0.5; user.a[2] = -0.25;
+  user.nu   = 0.01;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD,NULL,"Temporal blocking test","TS");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim","The dimension, 2 or 3","",dim,&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-n","The number of grid points in each direction","",n,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sw","The DMDA stencil width, at least the number of stages when blocking","",sw,&sw,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-periodic","Use periodic boundaries","",user.periodic,&user.periodic,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-block","Compute all stages of a step from one ghost update","DMDATSSetRHSStencilWidth",block,&block,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+
+  bt = user.periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+  if (dim == 2) {
+    ierr = DMDACreate2d(PETSC_COMM_WORLD,bt,bt,DMDA_STENCIL_BOX,n,n+2,PETSC_DECIDE,PETSC_DECIDE,1,sw,NULL,NULL,&da);CHKERRQ(ierr);
+  } else {
+    ierr = DMDACreate3d(PETSC_COMM_WORLD,bt,bt,bt,DMDA_STENCIL_BOX,n,n+2,n+1,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,1,sw,NULL,NULL,NULL,&da);CHKERRQ(ierr);
+  }
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+
+  ierr = TSCreate(PETSC_COMM_WORLD,&ts);CHKERRQ(ierr);
+  ierr = TSSetDM(ts,da);CHKERRQ(ierr);
+  ierr = TSSetType(ts,TSRK);CHKERRQ(ierr);
+  if (dim == 2) {ierr = DMDATSSetRHSFunctionLocal(da,INSERT_VALUES,(DMDATSRHSFunctionLocal)RHSFunctionLocal2d,&user);CHKERRQ(ierr);}
+  else {ierr = DMDATSSetRHSFunctionLocal(da,INSERT_VALUES,(DMDATSRHSFunctionLocal)RHSFunctionLocal3d,&user);CHKERRQ(ierr);}
+  ierr = DMDATSSetRHSStencilWidth(da,block ? 1 : 0);CHKERRQ(ierr);
+  ierr = TSSetMaxTime(ts,0.1);CHKERRQ(ierr);
+  ierr = TSSetTimeStep(ts,0.004);CHKERRQ(ierr);
+  ierr = TSSetExactFinalTime(ts,TS_EXACTFINALTIME_MATCHSTEP);CHKERRQ(ierr);
+  ierr = TSSetFromOptions(ts);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(da,&U);CHKERRQ(ierr);
+  ierr = FormInitialSolution(da,U,&user);CHKERRQ(ierr);
+  ierr = TSSolve(ts,U);CHKERRQ(ierr);
+  ierr = TSGetSolveTime(ts,&t);CHKERRQ(ierr);
+  ierr = TSGetStepNumber(ts,&steps);CHKERRQ(ierr);
+  ierr = VecNorm(U,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Steps %D, time %g, solution norm %.6f\n",steps,(double)t,(double)nrm);CHKERRQ(ierr);
+
+  ierr = VecDestroy(&U);CHKERRQ(ierr);
+  ierr = TSDestroy(&ts);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 2d
+      nsize: {{1 4}}
+      args: -block {{0 1}} -ts_rk_type 4
+      output_file: output/ex27_2d.out
+
+   test:
+      suffix: 2d_periodic
+      nsize: {{1 4}}
+      args: -periodic -block {{0 1}} -ts_rk_type 3bs -da_ts_block_tile 3
+      output_file: output/ex27_2d_periodic.out
+
+   test:
+      suffix: 2d_adapt
+      nsize: 4
+      args: -periodic -sw 7 -block {{0 1}} -ts_rk_type 5dp -ts_adapt_type basic -ts_rtol 1e-6 -ts_atol 1e-6
+      output_file: output/ex27_2d_adapt.out
+
+   test:
+      suffix: 3d
+      nsize: {{1 4}}
+      args: -dim 3 -n 12 -block {{0 1}} -ts_rk_type 4 -da_ts_block_tile 2
+      output_file: output/ex27_3d.out
+
+   test:
+      suffix: 3d_periodic
+      nsize: {{1 4}}
+      args: -dim 3 -n 12 -periodic -block {{0 1}} -ts_rk_type 4 -da_ts_block_tile 2
+      output_file: output/ex27_3d_periodic.out
+
+TEST*/
@@ -431,4 +431,11 @@ PetscErrorCode FormIFunctionLocal(DMDALocalInfo *info,PetscReal ptime,Field **x,
       args: -da_refine 1 -lidvelocity 100 -grashof 1e3 -ts_max_steps 10 -ts_rtol 1e-3 -ts_atol 1e-3
       requires: !complex !single
 
+    test:
+      suffix: overlap
+      nsize: 4
+      args: -da_refine 1 -lidvelocity 100 -grashof 1e3 -ts_max_steps 10 -ts_rtol 1e-3 -ts_atol 1e-3 -da_local_function_overlap
+      requires: !complex !single
+      output_file: output/ex26_asm.out
+
 TEST*/
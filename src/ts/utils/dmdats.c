@@ -15,6 +15,11 @@ typedef struct {
   void       *rhsjacobianlocalctx;
   InsertMode ifunctionlocalimode;
   InsertMode rhsfunctionlocalimode;
+
+  /* Temporal blocking of explicit Runge-Kutta stages, see DMDATSSetRHSStencilWidth() */
+  PetscInt   rhsblocksw;        /* stencil width of rhsfunctionlocal, 0 if blocking is off */
+  PetscInt   rhsblocktile;      /* tile size in the blocked directions, 0 to size the tiles from rhsblockcache */
+  PetscInt   rhsblockcache;     /* cache size in bytes the tiles should fit in */
 } DMTS_DA;
 
 static PetscErrorCode DMTSDestroy_DMDA(DMTS sdm)
@@ -59,6 +64,7 @@ static PetscErrorCode TSComputeIFunction_DMDA(TS ts,PetscReal ptime,Vec X,Vec Xd
   DMDALocalInfo  info;
   Vec            Xloc,Xdotloc;
   void           *x,*f,*xdot;
+  PetscBool      overlap;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ts,TS_CLASSID,1);
@@ -66,6 +72,46 @@ static PetscErrorCode TSComputeIFunction_DMDA(TS ts,PetscReal ptime,Vec X,Vec Xd
   PetscValidHeaderSpecific(F,VEC_CLASSID,3);
   if (!dmdats->ifunctionlocal) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_PLIB,"Corrupt context");
   ierr = TSGetDM(ts,&dm);CHKERRQ(ierr);
+  ierr = DMDAGetLocalFunctionOverlap(dm,&overlap);CHKERRQ(ierr);
+  if (overlap && dmdats->ifunctionlocalimode == INSERT_VALUES) {
+    DMDALocalInfo binfo[6];
+    PetscInt      nb,b;
+
+    /* Compute the interior box from the owned values while the ghost update of X is in flight, then the boundary slabs.
+       The DMDA has a single global-to-local scatter, so the update of Xdot can only start after that of X completes. */
+    ierr = DMDAGetLocalInfoSplit(dm,&info,&nb,binfo);CHKERRQ(ierr);
+    ierr = DMGetLocalVector(dm,&Xloc);CHKERRQ(ierr);
+    ierr = DMGetLocalVector(dm,&Xdotloc);CHKERRQ(ierr);
+    ierr = DMDAGlobalToLocalOwned(dm,X,Xloc);CHKERRQ(ierr);
+    ierr = DMDAGlobalToLocalOwned(dm,Xdot,Xdotloc);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+    ierr = DMDAVecGetArray(dm,F,&f);CHKERRQ(ierr);
+    if (info.xm && info.ym && info.zm) {
+      ierr = DMDAVecGetArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+      ierr = DMDAVecGetArrayRead(dm,Xdotloc,&xdot);CHKERRQ(ierr);
+      CHKMEMQ;
+      ierr = (*dmdats->ifunctionlocal)(&info,ptime,x,xdot,f,dmdats->ifunctionlocalctx);CHKERRQ(ierr);
+      CHKMEMQ;
+      ierr = DMDAVecRestoreArrayRead(dm,Xdotloc,&xdot);CHKERRQ(ierr);
+      ierr = DMDAVecRestoreArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+    }
+    ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(dm,Xdot,INSERT_VALUES,Xdotloc);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalEnd(dm,Xdot,INSERT_VALUES,Xdotloc);CHKERRQ(ierr);
+    ierr = DMDAVecGetArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+    ierr = DMDAVecGetArrayRead(dm,Xdotloc,&xdot);CHKERRQ(ierr);
+    for (b = 0; b < nb; ++b) {
+      CHKMEMQ;
+      ierr = (*dmdats->ifunctionlocal)(&binfo[b],ptime,x,xdot,f,dmdats->ifunctionlocalctx);CHKERRQ(ierr);
+      CHKMEMQ;
+    }
+    ierr = DMDAVecRestoreArrayRead(dm,Xdotloc,&xdot);CHKERRQ(ierr);
+    ierr = DMDAVecRestoreArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+    ierr = DMDAVecRestoreArray(dm,F,&f);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&Xdotloc);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&Xloc);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = DMGetLocalVector(dm,&Xdotloc);CHKERRQ(ierr);
   ierr = DMGlobalToLocalBegin(dm,Xdot,INSERT_VALUES,Xdotloc);CHKERRQ(ierr);
   ierr = DMGlobalToLocalEnd(dm,Xdot,INSERT_VALUES,Xdotloc);CHKERRQ(ierr);
@@ -149,6 +195,7 @@ static PetscErrorCode TSComputeRHSFunction_DMDA(TS ts,PetscReal ptime,Vec X,Vec
   DMDALocalInfo  info;
   Vec            Xloc;
   void           *x,*f;
+  PetscBool      overlap;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ts,TS_CLASSID,1);
@@ -157,6 +204,35 @@ static PetscErrorCode TSComputeRHSFunction_DMDA(TS ts,PetscReal ptime,Vec X,Vec
   if (!dmdats->rhsfunctionlocal) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_PLIB,"Corrupt context");
   ierr = TSGetDM(ts,&dm);CHKERRQ(ierr);
   ierr = DMGetLocalVector(dm,&Xloc);CHKERRQ(ierr);
+  ierr = DMDAGetLocalFunctionOverlap(dm,&overlap);CHKERRQ(ierr);
+  if (overlap && dmdats->rhsfunctionlocalimode == INSERT_VALUES) {
+    DMDALocalInfo binfo[6];
+    PetscInt      nb,b;
+
+    /* Compute the interior box from the owned values while the ghost update is in flight, then the boundary slabs */
+    ierr = DMDAGetLocalInfoSplit(dm,&info,&nb,binfo);CHKERRQ(ierr);
+    ierr = DMDAGlobalToLocalOwned(dm,X,Xloc);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+    ierr = DMDAVecGetArray(dm,F,&f);CHKERRQ(ierr);
+    if (info.xm && info.ym && info.zm) {
+      ierr = DMDAVecGetArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+      CHKMEMQ;
+      ierr = (*dmdats->rhsfunctionlocal)(&info,ptime,x,f,dmdats->rhsfunctionlocalctx);CHKERRQ(ierr);
+      CHKMEMQ;
+      ierr = DMDAVecRestoreArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+    }
+    ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+    ierr = DMDAVecGetArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+    for (b = 0; b < nb; ++b) {
+      CHKMEMQ;
+      ierr = (*dmdats->rhsfunctionlocal)(&binfo[b],ptime,x,f,dmdats->rhsfunctionlocalctx);CHKERRQ(ierr);
+      CHKMEMQ;
+    }
+    ierr = DMDAVecRestoreArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+    ierr = DMDAVecRestoreArray(dm,F,&f);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&Xloc);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = DMGlobalToLocalBegin(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
   ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
   ierr = DMDAGetLocalInfo(dm,&info);CHKERRQ(ierr);
@@ -190,6 +266,183 @@ static PetscErrorCode TSComputeRHSFunction_DMDA(TS ts,PetscReal ptime,Vec X,Vec
   PetscFunctionReturn(0);
 }
 
+/* Clips the tile [ts,te) extended by w points to the points of the ghosted box where a stage can be computed */
+static void DMDATSBlockBox_Private(const DMDALocalInfo *info,const PetscInt ts[],const PetscInt te[],PetscInt w,PetscInt bs[],PetscInt be[])
+{
+  const PetscInt       gs[3] = {info->gxs,info->gys,info->gzs};
+  const PetscInt       ge[3] = {info->gxs+info->gxm,info->gys+info->gym,info->gzs+info->gzm};
+  const PetscInt       M[3]  = {info->mx,info->my,info->mz};
+  const DMBoundaryType bt[3] = {info->bx,info->by,info->bz};
+  PetscInt             d;
+
+  for (d = 0; d < 3; ++d) {
+    if (d >= info->dim) {bs[d] = ts[d]; be[d] = te[d]; continue;}
+    bs[d] = PetscMax(ts[d]-w,gs[d]);
+    be[d] = PetscMin(te[d]+w,ge[d]);
+    if (bt[d] != DM_BOUNDARY_PERIODIC) {bs[d] = PetscMax(bs[d],0); be[d] = PetscMin(be[d],M[d]);}
+  }
+}
+
+/* Tile sizes such that the s+2 local arrays touched by the stages of one extended tile fit in the cache */
+static void DMDATSBlockTile_Private(const DMTS_DA *dmdats,const DMDALocalInfo *info,PetscInt s,PetscInt tile[])
+{
+  const PetscInt  halo  = s*dmdats->rhsblocksw;
+  const PetscReal bytes = (PetscReal)(s+2)*info->dof*sizeof(PetscScalar);
+  const PetscReal row   = bytes*(info->xm + 2*halo);
+  PetscReal       L;
+  PetscInt        n;
+
+  tile[0] = info->xm; tile[1] = info->ym; tile[2] = info->zm;
+  if (dmdats->rhsblocktile > 0) L = dmdats->rhsblocktile;
+  else {
+    switch (info->dim) {
+    case 1:  L = dmdats->rhsblockcache/bytes - 2*halo;break;
+    case 2:  L = dmdats->rhsblockcache/row - 2*halo;break;
+    default: L = PetscSqrtReal(dmdats->rhsblockcache/row) - 2*halo;
+    }
+    /* Smaller tiles spend more on redundant halo computation than they save in memory traffic */
+    L = PetscMax(L,2*halo);
+  }
+  n = (PetscInt)PetscMax(L,1.0);
+  switch (info->dim) {
+  case 1:  tile[0] = PetscMin(n,info->xm);break;
+  case 2:  tile[1] = PetscMin(n,info->ym);break;
+  default: tile[1] = PetscMin(n,info->ym); tile[2] = PetscMin(n,info->zm);
+  }
+}
+
+/*
+  Computes the stages Y[i] = X + h sum_j A[i*s+j] K[j] and K[i] = F(t + c[i] h,Y[i]) of an explicit Runge-Kutta
+  method with one ghost update of X. The owned box is swept tile by tile; stage i of a tile is computed on the tile
+  extended by (s-1-i)*sw points, which is where the later stages of the tile read it, so the tiles overlap and the
+  halo points are computed redundantly. Sets done to PETSC_FALSE, without computing anything, when the DM does not
+  use blocking.
+*/
+PetscErrorCode DMDATSComputeRHSStages_Private(TS ts,PetscInt s,const PetscReal A[],const PetscReal c[],PetscReal t,PetscReal h,Vec X,Vec Y[],Vec K[],PetscBool *done)
+{
+  DM                dm;
+  DMTS_DA           *dmdats;
+  TSRHSFunction     rhsfunction;
+  void              *ctx,*xl,*yl,**kl;
+  DMDALocalInfo     info,binfo;
+  Vec               Xloc,Yloc,*Kloc;
+  const PetscScalar *xa;
+  PetscScalar       *ya,**ka,*Ya,*Ka;
+  PetscBool         isda;
+  PetscInt          tile[3],ts0[3],te0[3],bs[3],be[3],i,j,jj,k,q,n,dof,sw;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  ierr = TSGetDM(ts,&dm);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)dm,DMDA,&isda);CHKERRQ(ierr);
+  if (!isda) PetscFunctionReturn(0);
+  ierr = DMTSGetRHSFunction(dm,&rhsfunction,&ctx);CHKERRQ(ierr);
+  if (rhsfunction != TSComputeRHSFunction_DMDA) PetscFunctionReturn(0);
+  dmdats = (DMTS_DA*)ctx;
+  if (!dmdats->rhsblocksw || dmdats->rhsfunctionlocalimode != INSERT_VALUES) PetscFunctionReturn(0);
+  ierr = DMDAGetLocalInfo(dm,&info);CHKERRQ(ierr);
+  if ((info.bx != DM_BOUNDARY_NONE && info.bx != DM_BOUNDARY_PERIODIC) || (info.dim > 1 && info.by != DM_BOUNDARY_NONE && info.by != DM_BOUNDARY_PERIODIC) || (info.dim > 2 && info.bz != DM_BOUNDARY_NONE && info.bz != DM_BOUNDARY_PERIODIC)) {
+    ierr = PetscInfo(ts,"Temporal blocking needs DM_BOUNDARY_NONE or DM_BOUNDARY_PERIODIC, computing the stages one by one\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  sw  = dmdats->rhsblocksw;
+  dof = info.dof;
+  if (info.dim > 1 && info.st != DMDA_STENCIL_BOX) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_INCOMP,"Temporal blocking needs a DMDA_STENCIL_BOX DMDA since the composed stages reach the ghost corners");
+  if (info.sw < s*sw) SETERRQ3(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_INCOMP,"Temporal blocking of %D stages with stencil width %D needs a DMDA stencil width of at least %D",s,sw,s*sw);
+
+  ierr = PetscLogEventBegin(TS_FunctionEval,ts,X,K[0],0);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&Xloc);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&Yloc);CHKERRQ(ierr);
+  ierr = PetscMalloc3(s,&Kloc,s,&kl,s,&ka);CHKERRQ(ierr);
+  for (i = 0; i < s; ++i) {ierr = DMGetLocalVector(dm,&Kloc[i]);CHKERRQ(ierr);}
+  ierr = DMGlobalToLocalBegin(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+  ierr = VecCopy(X,Y[0]);CHKERRQ(ierr);
+
+  ierr = VecGetArrayRead(Xloc,&xa);CHKERRQ(ierr);
+  ierr = VecGetArray(Yloc,&ya);CHKERRQ(ierr);
+  ierr = DMDAVecGetArrayRead(dm,Xloc,&xl);CHKERRQ(ierr);
+  ierr = DMDAVecGetArrayRead(dm,Yloc,&yl);CHKERRQ(ierr);
+  for (i = 0; i < s; ++i) {
+    ierr = VecGetArray(Kloc[i],&ka[i]);CHKERRQ(ierr);
+    ierr = DMDAVecGetArray(dm,Kloc[i],&kl[i]);CHKERRQ(ierr);
+  }
+  DMDATSBlockTile_Private(dmdats,&info,s,tile);
+  for (ts0[2] = info.zs; ts0[2] < info.zs+info.zm; ts0[2] += tile[2]) {
+    for (ts0[1] = info.ys; ts0[1] < info.ys+info.ym; ts0[1] += tile[1]) {
+      for (ts0[0] = info.xs; ts0[0] < info.xs+info.xm; ts0[0] += tile[0]) {
+        te0[0] = PetscMin(ts0[0]+tile[0],info.xs+info.xm);
+        te0[1] = PetscMin(ts0[1]+tile[1],info.ys+info.ym);
+        te0[2] = PetscMin(ts0[2]+tile[2],info.zs+info.zm);
+        for (i = 0; i < s; ++i) {
+          if (i) {
+            /* Y_i on the points read by stage i */
+            DMDATSBlockBox_Private(&info,ts0,te0,(s-i)*sw,bs,be);
+            n = (be[0]-bs[0])*dof;
+            for (k = bs[2]; k < be[2]; ++k) {
+              for (jj = bs[1]; jj < be[1]; ++jj) {
+                const PetscInt off = (((k-info.gzs)*info.gym + (jj-info.gys))*info.gxm + (bs[0]-info.gxs))*dof;
+
+                ierr = PetscArraycpy(ya+off,xa+off,n);CHKERRQ(ierr);
+                for (j = 0; j < i; ++j) {
+                  const PetscScalar w   = h*A[i*s+j];
+                  const PetscScalar *kj = ka[j]+off;
+                  PetscScalar       *yo = ya+off;
+
+                  if (w == (PetscScalar)0.0) continue;
+                  PetscPragmaSIMD
+                  for (q = 0; q < n; ++q) yo[q] += w*kj[q];
+                }
+              }
+            }
+          }
+          /* K_i on the points read by the later stages of this tile */
+          DMDATSBlockBox_Private(&info,ts0,te0,(s-1-i)*sw,bs,be);
+          binfo    = info;
+          binfo.xs = bs[0]; binfo.xm = be[0]-bs[0];
+          binfo.ys = bs[1]; binfo.ym = be[1]-bs[1];
+          binfo.zs = bs[2]; binfo.zm = be[2]-bs[2];
+          CHKMEMQ;
+          ierr = (*dmdats->rhsfunctionlocal)(&binfo,t+h*c[i],i ? yl : xl,kl[i],dmdats->rhsfunctionlocalctx);CHKERRQ(ierr);
+          CHKMEMQ;
+          /* Owned part of the tile into the global stage vectors */
+          ierr = VecGetArray(Y[i],&Ya);CHKERRQ(ierr);
+          ierr = VecGetArray(K[i],&Ka);CHKERRQ(ierr);
+          n = (te0[0]-ts0[0])*dof;
+          for (k = ts0[2]; k < te0[2]; ++k) {
+            for (jj = ts0[1]; jj < te0[1]; ++jj) {
+              const PetscInt off  = (((k-info.gzs)*info.gym + (jj-info.gys))*info.gxm + (ts0[0]-info.gxs))*dof;
+              const PetscInt goff = (((k-info.zs)*info.ym + (jj-info.ys))*info.xm + (ts0[0]-info.xs))*dof;
+
+              if (i) {ierr = PetscArraycpy(Ya+goff,ya+off,n);CHKERRQ(ierr);}
+              ierr = PetscArraycpy(Ka+goff,ka[i]+off,n);CHKERRQ(ierr);
+            }
+          }
+          ierr = VecRestoreArray(K[i],&Ka);CHKERRQ(ierr);
+          ierr = VecRestoreArray(Y[i],&Ya);CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+  for (i = 0; i < s; ++i) {
+    ierr = DMDAVecRestoreArray(dm,Kloc[i],&kl[i]);CHKERRQ(ierr);
+    ierr = VecRestoreArray(Kloc[i],&ka[i]);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&Kloc[i]);CHKERRQ(ierr);
+  }
+  ierr = DMDAVecRestoreArrayRead(dm,Yloc,&yl);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArrayRead(dm,Xloc,&xl);CHKERRQ(ierr);
+  ierr = VecRestoreArray(Yloc,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(Xloc,&xa);CHKERRQ(ierr);
+  ierr = PetscFree3(Kloc,kl,ka);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&Yloc);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&Xloc);CHKERRQ(ierr);
+  ts->rhsfuncs += s;
+  ierr = PetscLogEventEnd(TS_FunctionEval,ts,X,K[0],0);CHKERRQ(ierr);
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode TSComputeRHSJacobian_DMDA(TS ts,PetscReal ptime,Vec X,Mat A,Mat B,void *ctx)
 {
   PetscErrorCode ierr;
@@ -266,6 +519,57 @@ PetscErrorCode DMDATSSetRHSFunctionLocal(DM dm,InsertMode imode,DMDATSRHSFunctio
   PetscFunctionReturn(0);
 }
 
+/*@
+   DMDATSSetRHSStencilWidth - Declares the stencil width of the local right-hand side function, so that explicit
+   Runge-Kutta methods compute all stages of a step from a single ghost update
+
+   Logically Collective
+
+   Input Arguments:
++  dm - DMDA whose local right-hand side function is set with DMDATSSetRHSFunctionLocal() and INSERT_VALUES
+-  sw - the number of grid points in each direction the function reads around a point, or 0 to turn the blocking off
+
+   Options Database:
++  -da_ts_block_cache_size <bytes> - the cache size the tiles are chosen to fit in, default 1 MiB
+-  -da_ts_block_tile <n> - the tile size in the blocked directions, overriding the choice from the cache size
+
+   Notes:
+   The DMDA must use DMDA_STENCIL_BOX, since the composed stages reach the ghost corners, and its stencil width must
+   be at least s*sw for a method with s stages. TSRK then updates the ghost points of the
+   solution once per step and sweeps the owned box in tiles, computing all stages of a tile, each on the tile extended
+   by the halo the later stages read, while its data is in cache. The halo points are computed redundantly by the
+   neighboring tiles and processes. In 2d and 3d the tiles are whole rows in the first direction.
+
+   The local function is called on boxes extending into the ghost region, passed in the xs,ys,zs,xm,ym,zm fields of
+   the DMDALocalInfo, and must compute exactly the points of the box it is given. In periodic directions the box may
+   extend past 0 or mx-1, where the function must compute as at the periodic images of those points. Only
+   DM_BOUNDARY_NONE and DM_BOUNDARY_PERIODIC are supported; with other boundary types, or with TSSetPreStage() or
+   TSSetPostStage(), the stages are computed one by one as usual.
+
+   Level: advanced
+
+.seealso: DMDATSSetRHSFunctionLocal(), TSRK, DMDASetLocalFunctionOverlap()
+@*/
+PetscErrorCode DMDATSSetRHSStencilWidth(DM dm,PetscInt sw)
+{
+  PetscErrorCode ierr;
+  DMTS           sdm;
+  DMTS_DA        *dmdats;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  PetscValidLogicalCollectiveInt(dm,sw,2);
+  if (sw < 0) SETERRQ1(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_OUTOFRANGE,"Stencil width %D must be nonnegative",sw);
+  ierr = DMGetDMTSWrite(dm,&sdm);CHKERRQ(ierr);
+  ierr = DMDATSGetContext(dm,sdm,&dmdats);CHKERRQ(ierr);
+  dmdats->rhsblocksw    = sw;
+  dmdats->rhsblocktile  = 0;
+  dmdats->rhsblockcache = 1048576;
+  ierr = PetscOptionsGetInt(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-da_ts_block_cache_size",&dmdats->rhsblockcache,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-da_ts_block_tile",&dmdats->rhsblocktile,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMDATSSetRHSJacobianLocal - set a local residual evaluation function
 
@@ -64,6 +64,8 @@ PetscErrorCode PetscSectionCreate(MPI_Comm comm, PetscSection *s)
   (*s)->clHash             = NULL;
   (*s)->clSection          = NULL;
   (*s)->clPoints           = NULL;
+  (*s)->clDofSection       = NULL;
+  (*s)->clDofIndices       = NULL;
   PetscFunctionReturn(0);
 }
 
@@ -2119,6 +2121,16 @@ static PetscErrorCode PetscSectionResetClosurePermutation(PetscSection section)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscSectionResetClosureDofIndex(PetscSection section)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSectionDestroy(&section->clDofSection);CHKERRQ(ierr);
+  ierr = ISDestroy(&section->clDofIndices);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   PetscSectionReset - Frees all section data.
 
@@ -2159,6 +2171,7 @@ PetscErrorCode PetscSectionReset(PetscSection s)
   ierr = PetscSectionSymDestroy(&s->sym);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&s->clSection);CHKERRQ(ierr);
   ierr = ISDestroy(&s->clPoints);CHKERRQ(ierr);
+  ierr = PetscSectionResetClosureDofIndex(s);CHKERRQ(ierr);
 
   s->pStart    = -1;
   s->pEnd      = -1;
@@ -2537,7 +2550,10 @@ PetscErrorCode PetscSectionSetClosureIndex(PetscSection section, PetscObject obj
   PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
   PetscValidHeaderSpecific(clSection,PETSC_SECTION_CLASSID,3);
   PetscValidHeaderSpecific(clPoints,IS_CLASSID,4);
-  if (section->clObj != obj) {ierr = PetscSectionResetClosurePermutation(section);CHKERRQ(ierr);}
+  if (section->clObj != obj) {
+    ierr = PetscSectionResetClosurePermutation(section);CHKERRQ(ierr);
+    ierr = PetscSectionResetClosureDofIndex(section);CHKERRQ(ierr);
+  }
   section->clObj     = obj;
   ierr = PetscObjectReference((PetscObject)clSection);CHKERRQ(ierr);
   ierr = PetscObjectReference((PetscObject)clPoints);CHKERRQ(ierr);
@@ -2580,6 +2596,78 @@ PetscErrorCode PetscSectionGetClosureIndex(PetscSection section, PetscObject obj
   PetscFunctionReturn(0);
 }
 
+/*@
+  PetscSectionSetClosureDofIndex - Set a cache of the dof indices in the closure of each point in the section
+
+  Not collective
+
+  Input Parameters:
++ section      - The PetscSection
+. obj          - A PetscObject which serves as the key for this index
+. clDofSection - Section giving the number of dofs in the closure of each point
+- clDofIndices - IS giving the dof indices in each closure
+
+  Notes:
+  The indices are given in closure order, with the point symmetries and the closure permutation already applied.
+  Constrained dofs are encoded as -(idx+1). The index is discarded when the closure permutation or the symmetries
+  of the section change.
+
+  Level: advanced
+
+.seealso: PetscSectionGetClosureDofIndex(), PetscSectionSetClosureIndex(), DMPlexCreateClosureDofIndex()
+@*/
+PetscErrorCode PetscSectionSetClosureDofIndex(PetscSection section, PetscObject obj, PetscSection clDofSection, IS clDofIndices)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
+  PetscValidHeaderSpecific(clDofSection,PETSC_SECTION_CLASSID,3);
+  PetscValidHeaderSpecific(clDofIndices,IS_CLASSID,4);
+  if (section->clObj != obj) {
+    ierr = PetscSectionResetClosurePermutation(section);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&section->clSection);CHKERRQ(ierr);
+    ierr = ISDestroy(&section->clPoints);CHKERRQ(ierr);
+  }
+  section->clObj        = obj;
+  ierr = PetscObjectReference((PetscObject)clDofSection);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)clDofIndices);CHKERRQ(ierr);
+  ierr = PetscSectionResetClosureDofIndex(section);CHKERRQ(ierr);
+  section->clDofSection = clDofSection;
+  section->clDofIndices = clDofIndices;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscSectionGetClosureDofIndex - Get the cache of dof indices in the closure of each point in the section
+
+  Not collective
+
+  Input Parameters:
++ section - The PetscSection
+- obj     - A PetscObject which serves as the key for this index
+
+  Output Parameters:
++ clDofSection - Section giving the number of dofs in the closure of each point, or NULL if there is no index
+- clDofIndices - IS giving the dof indices in each closure, or NULL if there is no index
+
+  Level: advanced
+
+.seealso: PetscSectionSetClosureDofIndex(), PetscSectionGetClosureIndex(), DMPlexCreateClosureDofIndex()
+@*/
+PetscErrorCode PetscSectionGetClosureDofIndex(PetscSection section, PetscObject obj, PetscSection *clDofSection, IS *clDofIndices)
+{
+  PetscFunctionBegin;
+  if (section->clObj == obj) {
+    if (clDofSection) *clDofSection = section->clDofSection;
+    if (clDofIndices) *clDofIndices = section->clDofIndices;
+  } else {
+    if (clDofSection) *clDofSection = NULL;
+    if (clDofIndices) *clDofIndices = NULL;
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection section, PetscObject obj, PetscInt depth, PetscInt clSize, PetscCopyMode mode, PetscInt *clPerm)
 {
   PetscInt       i;
@@ -2594,6 +2682,8 @@ PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection section,
     ierr = PetscSectionDestroy(&section->clSection);CHKERRQ(ierr);
     ierr = ISDestroy(&section->clPoints);CHKERRQ(ierr);
   }
+  /* The cached closure dofs were laid out with the old permutation */
+  ierr = PetscSectionResetClosureDofIndex(section);CHKERRQ(ierr);
   section->clObj = obj;
   if (!section->clHash) {ierr = PetscClPermCreate(&section->clHash);CHKERRQ(ierr);}
   iter = kh_put(ClPerm, section->clHash, key, &new_entry);
@@ -2973,6 +3063,7 @@ PetscErrorCode PetscSectionSetSym(PetscSection section, PetscSectionSym sym)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
+  ierr = PetscSectionResetClosureDofIndex(section);CHKERRQ(ierr);
   ierr = PetscSectionSymDestroy(&(section->sym));CHKERRQ(ierr);
   if (sym) {
     PetscValidHeaderSpecific(sym,PETSC_SECTION_SYM_CLASSID,2);
@@ -3027,6 +3118,7 @@ PetscErrorCode PetscSectionSetFieldSym(PetscSection section, PetscInt field, Pet
   PetscFunctionBegin;
   PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
   if (field < 0 || field >= section->numFields) SETERRQ2(PetscObjectComm((PetscObject)section),PETSC_ERR_ARG_OUTOFRANGE,"Invalid field number %D (not in [0,%D)", field, section->numFields);
+  ierr = PetscSectionResetClosureDofIndex(section);CHKERRQ(ierr);
   ierr = PetscSectionSetSym(section->field[field],sym);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }